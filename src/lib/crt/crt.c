@@ -1,3 +1,4 @@
+#include <abi/otp.h>
 #include <abi/syscall.h>
 #include <sys.h>
 
@@ -64,7 +65,7 @@ void __crt_start(char* ipc_base, size_t ipc_size) {
 
 void sys_exit(uint64_t status) { syscall1(ABI_SYS_EXIT, status); }
 void sys_yield(void) { syscall1(ABI_SYS_YIELD, 0); }
-void sys_sleep(uint64_t ticks) { syscall1(ABI_SYS_SLEEP, ticks); }
+void sys_sleep(uint64_t ns) { syscall1(ABI_SYS_SLEEP, ns); }
 
 int sys_is_error(uint64_t ret) { return (int64_t)ret < 0; }
 uint64_t sys_handle_close(uint64_t handle) { return syscall1(ABI_SYS_HANDLE_CLOSE, handle); }
@@ -117,7 +118,9 @@ void sys_close_arrived(uint64_t result, uint64_t handles_at) {
     }
 }
 
-uint64_t sys_channel_create(uint64_t offset) { return syscall1(ABI_SYS_CHANNEL_CREATE, offset); }
+uint64_t sys_channel_create(uint64_t offset, uint64_t depth, uint64_t byte_budget) {
+    return syscall3(ABI_SYS_CHANNEL_CREATE, offset, depth, byte_budget);
+}
 uint64_t sys_channel_send(uint64_t handle, uint64_t offset, uint64_t length, uint64_t handles_offset,
                           uint64_t handle_count) {
     return syscall6(ABI_SYS_CHANNEL_SEND, handle, offset, length, handles_offset, handle_count, 0);
@@ -126,6 +129,13 @@ uint64_t sys_channel_recv(uint64_t handle, uint64_t offset, uint64_t capacity, u
                           uint64_t handle_capacity) {
     return syscall6(ABI_SYS_CHANNEL_RECV, handle, offset, capacity, handles_offset, handle_capacity, 0);
 }
+uint64_t sys_channel_call(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity, uint64_t timeout_ns) {
+    return syscall6(ABI_SYS_CHANNEL_CALL, handle, offset, length, capacity, timeout_ns, 0);
+}
+uint64_t sys_channel_reply_wait(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity,
+                                uint64_t timeout_ns) {
+    return syscall6(ABI_SYS_CHANNEL_REPLY_WAIT, handle, offset, length, capacity, timeout_ns, 0);
+}
 
 uint64_t sys_object_wait(uint64_t handle, uint64_t mask, uint64_t timeout_ns) {
     return syscall3(ABI_SYS_OBJECT_WAIT, handle, mask, timeout_ns);
@@ -139,21 +149,60 @@ uint64_t sys_port_unbind(uint64_t port, uint64_t key) { return syscall2(ABI_SYS_
 uint64_t sys_port_wait(uint64_t port, uint64_t offset, uint64_t timeout_ns) {
     return syscall3(ABI_SYS_PORT_WAIT, port, offset, timeout_ns);
 }
+uint64_t sys_port_wait_many(uint64_t port, uint64_t offset, uint64_t capacity, uint64_t timeout_ns) {
+    return syscall6(ABI_SYS_PORT_WAIT_MANY, port, offset, capacity, timeout_ns, 0, 0);
+}
 
-uint64_t sys_socket_create(uint64_t offset) { return syscall1(ABI_SYS_SOCKET_CREATE, offset); }
+uint64_t sys_socket_create(uint64_t offset, uint64_t capacity) {
+    return syscall2(ABI_SYS_SOCKET_CREATE, offset, capacity);
+}
 uint64_t sys_socket_write(uint64_t handle, uint64_t offset, uint64_t length) {
     return syscall3(ABI_SYS_SOCKET_WRITE, handle, offset, length);
 }
 uint64_t sys_socket_read(uint64_t handle, uint64_t offset, uint64_t capacity) {
     return syscall3(ABI_SYS_SOCKET_READ, handle, offset, capacity);
 }
+uint64_t sys_socket_writev(uint64_t handle, uint64_t offset, uint64_t count) {
+    return syscall3(ABI_SYS_SOCKET_WRITEV, handle, offset, count);
+}
+uint64_t sys_socket_readv(uint64_t handle, uint64_t offset, uint64_t count) {
+    return syscall3(ABI_SYS_SOCKET_READV, handle, offset, count);
+}
+uint64_t sys_socket_set_watermarks(uint64_t handle, uint64_t read_high, uint64_t write_low) {
+    return syscall3(ABI_SYS_SOCKET_SET_WATERMARKS, handle, read_high, write_low);
+}
 
 uint64_t sys_vmo_create(uint64_t size) { return syscall1(ABI_SYS_VMO_CREATE, size); }
 uint64_t sys_vmo_map(uint64_t vmo, uint64_t vaddr, uint64_t vmo_offset, uint64_t length, uint64_t prot) {
     return syscall6(ABI_SYS_VMO_MAP, vmo, vaddr, vmo_offset, length, prot, 0);
 }
 uint64_t sys_vmo_unmap(uint64_t vaddr) { return syscall1(ABI_SYS_VMO_UNMAP, vaddr); }
+uint64_t sys_vmo_detach(uint64_t vmo, uint64_t offset, uint64_t length) {
+    return syscall3(ABI_SYS_VMO_DETACH, vmo, offset, length);
+}
+
+uint64_t sys_futex_wait(const volatile uint32_t* word, uint32_t expected, uint64_t timeout_ns) {
+    return syscall3(ABI_SYS_FUTEX_WAIT, (uint64_t)(uintptr_t)word, expected, timeout_ns);
+}
+uint64_t sys_futex_wake(const volatile uint32_t* word, uint64_t count) {
+    return syscall2(ABI_SYS_FUTEX_WAKE, (uint64_t)(uintptr_t)word, count);
+}
+uint64_t sys_futex_requeue(const volatile uint32_t* word, uint32_t expected, uint64_t wake,
+                           const volatile uint32_t* target, uint64_t requeue) {
+    return syscall6(ABI_SYS_FUTEX_REQUEUE, (uint64_t)(uintptr_t)word, expected, wake, (uint64_t)(uintptr_t)target,
+                    requeue, 0);
+}
 
 uint64_t sys_task_kill(uint64_t task) { return syscall1(ABI_SYS_TASK_KILL, task); }
 uint64_t sys_task_status(uint64_t task) { return syscall1(ABI_SYS_TASK_STATUS, task); }
 uint64_t sys_task_spawn(uint64_t image, uint64_t offset) { return syscall2(ABI_SYS_TASK_SPAWN, image, offset); }
+
+uint64_t sys_obj_invoke(uint64_t handle, uint64_t opcode, uint64_t arg) {
+    return syscall3(ABI_SYS_OBJ_INVOKE, handle, opcode, arg);
+}
+uint64_t sys_type_attach_program(uint64_t handle, uint64_t offset, uint64_t count) {
+    return syscall6(ABI_SYS_TYPE_ATTACH_PROGRAM, handle, offset, count, ABI_OTP_VERSION, 0, 0);
+}
+uint64_t sys_submit(uint64_t offset, uint64_t count, uint64_t completions) {
+    return syscall3(ABI_SYS_SUBMIT, offset, count, completions);
+}
@@ -27,7 +27,7 @@ size_t sys_ipc_size(void);
 
 void sys_exit(uint64_t status);
 void sys_yield(void);
-void sys_sleep(uint64_t ticks);
+void sys_sleep(uint64_t ns);
 
 // Handle operations return a negative error code on failure; see <abi/syscall.h> for the
 // verification pipeline every one of them runs before doing anything.
@@ -54,15 +54,25 @@ void sys_copy_in(void* to, size_t offset, size_t length);
 void sys_copy_out(size_t offset, const void* from, size_t length);
 
 // Channel syscalls; like everything else, data rides in the IPC buffer and arguments are offsets
-// into it. create writes the two endpoint handles at `offset`. Messages can carry handles: send
-// reads `handle_count` uint64 handle values at `handles_offset`, recv lands arrived handles there
-// and reports their count in the high 32 bits of its return, the byte count in the low 32.
-uint64_t sys_channel_create(uint64_t offset);
+// into it. create writes the two endpoint handles at `offset`; `depth` messages and `byte_budget`
+// payload bytes bound each direction's queue (0 for either takes the default). Messages can carry
+// handles: send reads `handle_count` uint64 handle values at `handles_offset`, recv lands arrived
+// handles there and reports their count in the high 32 bits of its return, the byte count in the
+// low 32.
+uint64_t sys_channel_create(uint64_t offset, uint64_t depth, uint64_t byte_budget);
 uint64_t sys_channel_send(uint64_t handle, uint64_t offset, uint64_t length, uint64_t handles_offset,
                           uint64_t handle_count);
 uint64_t sys_channel_recv(uint64_t handle, uint64_t offset, uint64_t capacity, uint64_t handles_offset,
                           uint64_t handle_capacity);
 
+// Synchronous request/reply, one syscall per side per round trip. The outgoing message is read at
+// `offset` and the incoming one written over it; the return is its byte count. No handles ride
+// either way. A server passes ABI_CHANNEL_NO_REPLY as its first reply_wait's length. A timeout of
+// 0 waits forever.
+uint64_t sys_channel_call(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity, uint64_t timeout_ns);
+uint64_t sys_channel_reply_wait(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity,
+                                uint64_t timeout_ns);
+
 // Drain a channel to exhaustion: every queued message lands at msg_at (bytes, up to msg_cap) and
 // handles_at (arrived handles, up to handle_cap) and goes through consume(ctx, recv's return
 // value); a message wider than either window is discarded by the kernel and skipped here, so a
@@ -95,15 +105,23 @@ uint64_t sys_task_kill(uint64_t task);
 uint64_t sys_task_status(uint64_t task);
 uint64_t sys_task_spawn(uint64_t image, uint64_t offset);
 uint64_t sys_port_wait(uint64_t port, uint64_t offset, uint64_t timeout_ns);
+// Drains up to `capacity` pending packets back to back at `offset`, blocking only while none are
+// pending; returns how many landed.
+uint64_t sys_port_wait_many(uint64_t port, uint64_t offset, uint64_t capacity, uint64_t timeout_ns);
 
 // Sockets: a byte-stream pair with no message boundaries. create writes the two endpoint handles
-// at `offset`; write appends up to `length` bytes from the IPC buffer and returns how many the
+// at `offset`, each direction buffering `capacity` bytes (0 = one page); write appends up to `length` bytes from the IPC buffer and returns how many the
 // peer's buffer took (short = backpressure, ABI_ERR_WOULD_BLOCK-style only when zero fit --
 // capacity_exhausted); read takes up to `capacity` buffered bytes into the IPC buffer and
 // returns the count, ABI_ERR_WOULD_BLOCK when empty, ABI_ERR_PEER_CLOSED when empty for good.
-uint64_t sys_socket_create(uint64_t offset);
+// The v forms take `count` (offset, length) uint64 pairs staged at `offset` and move them as one
+// stream; set_watermarks raises the READABLE and lowers the WRITABLE thresholds on one end.
+uint64_t sys_socket_create(uint64_t offset, uint64_t capacity);
 uint64_t sys_socket_write(uint64_t handle, uint64_t offset, uint64_t length);
 uint64_t sys_socket_read(uint64_t handle, uint64_t offset, uint64_t capacity);
+uint64_t sys_socket_writev(uint64_t handle, uint64_t offset, uint64_t count);
+uint64_t sys_socket_readv(uint64_t handle, uint64_t offset, uint64_t count);
+uint64_t sys_socket_set_watermarks(uint64_t handle, uint64_t read_high, uint64_t write_low);
 
 // User-controlled memory: create an anonymous VMO, map it (vaddr 0 = kernel picks; map returns
 // the mapped base), unmap the whole mapping containing an address. Sizes, offsets, and addresses
@@ -112,6 +130,50 @@ uint64_t sys_socket_read(uint64_t handle, uint64_t offset, uint64_t capacity);
 uint64_t sys_vmo_create(uint64_t size);
 uint64_t sys_vmo_map(uint64_t vmo, uint64_t vaddr, uint64_t vmo_offset, uint64_t length, uint64_t prot);
 uint64_t sys_vmo_unmap(uint64_t vaddr);
+// Move [offset, offset + length) of a VMO's pages into a new VMO and return its handle, ready to
+// send through a channel: zero-copy bulk transfer. The range reads back zero-filled afterwards.
+uint64_t sys_vmo_detach(uint64_t vmo, uint64_t offset, uint64_t length);
+
+// Futexes: the one syscall family that takes an address, and only as the name of a 4-byte word of
+// mapped memory -- the kernel keys it on the VMO page behind the address, so tasks sharing a VMO
+// meet on the same word wherever each mapped it. wait sleeps while the word holds `expected`
+// (ABI_ERR_WOULD_BLOCK at once if not; a timeout of 0 waits forever); wake rouses up to `count`
+// sleepers; requeue wakes up to `wake` and moves up to `requeue` more onto `target` unwoken. Use
+// them through the mutex and condition variable below rather than directly.
+uint64_t sys_futex_wait(const volatile uint32_t* word, uint32_t expected, uint64_t timeout_ns);
+uint64_t sys_futex_wake(const volatile uint32_t* word, uint64_t count);
+uint64_t sys_futex_requeue(const volatile uint32_t* word, uint32_t expected, uint64_t wake,
+                           const volatile uint32_t* target, uint64_t requeue);
+
+// A mutex and condition variable over futex words, zero-initialized ready for use. Locking an
+// unheld mutex and unlocking one nobody waits for never enter the kernel. Either may live in a VMO
+// shared between tasks. A broadcast moves all but one waiter straight onto the mutex, so they wake
+// one unlock at a time instead of all at once.
+typedef struct mutex {
+    uint32_t state; /* 0 unlocked, 1 locked, 2 locked with sleepers possible */
+} mutex;
+typedef struct cond {
+    uint32_t sequence; /* bumped by every signal and broadcast */
+    mutex* mutex;      /* the mutex its waiters last used, for broadcast to requeue onto */
+} cond;
+void mutex_lock(mutex* m);
+int mutex_trylock(mutex* m); /* 1 if taken, 0 if held elsewhere */
+void mutex_unlock(mutex* m);
+void cond_wait(cond* c, mutex* m); /* m must be held; held again on return */
+void cond_signal(cond* c);
+void cond_broadcast(cond* c);
+
+// Type-defined operations: invoke runs the pipeline on `opcode` and returns what the type's
+// transaction program completed it with (or its error); attach hands the kernel `count`
+// abi_otp_insn structs staged at `offset`, built against this header's ABI_OTP_VERSION. See
+// <abi/otp.h> for the instruction set and <abi/syscall.h> for the rights involved.
+uint64_t sys_obj_invoke(uint64_t handle, uint64_t opcode, uint64_t arg);
+uint64_t sys_type_attach_program(uint64_t handle, uint64_t offset, uint64_t count);
+
+// Batched submission: run `count` abi_submit_entry structs staged at `offset`, posting one
+// abi_submit_completion each at `completions`, for a single kernel entry. Returns how many ran.
+// See <abi/submit.h> for the operations a batch may carry.
+uint64_t sys_submit(uint64_t offset, uint64_t count, uint64_t completions);
 
 // The heap, first-fit over VMO-backed arenas the runtime maps as needed. Arenas are never
 // returned to the kernel; free() recycles blocks within them.
@@ -0,0 +1,65 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <sys.h>
+
+// Mutex and condition variable over futex words. Everything a fast path needs is one atomic on the
+// word itself; the kernel is entered only to sleep on a word that says someone must, or to wake
+// a sleeper the word says may exist. The futex wait's value check closes the race between reading
+// the word and sleeping, so a wake can never fall between them.
+
+#define UNLOCKED 0u
+#define LOCKED 1u
+#define CONTENDED 2u /* locked, and the holder's unlock must wake */
+
+#define WAKE_ALL UINT32_MAX
+
+static uint32_t exchange(uint32_t* word, uint32_t value) { return __atomic_exchange_n(word, value, __ATOMIC_ACQUIRE); }
+
+// Sleep until the mutex is ours, marking it CONTENDED on the way in: this thread cannot know
+// whether others sleep behind it, so its own unlock must assume they do.
+static void lock_contended(mutex* m) {
+    while (exchange(&m->state, CONTENDED) != UNLOCKED) { (void)sys_futex_wait(&m->state, CONTENDED, 0); }
+}
+
+void mutex_lock(mutex* m) {
+    uint32_t expected = UNLOCKED;
+    if (__atomic_compare_exchange_n(&m->state, &expected, LOCKED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) { return; }
+    lock_contended(m);
+}
+
+int mutex_trylock(mutex* m) {
+    uint32_t expected = UNLOCKED;
+    return __atomic_compare_exchange_n(&m->state, &expected, LOCKED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+void mutex_unlock(mutex* m) {
+    if (__atomic_exchange_n(&m->state, UNLOCKED, __ATOMIC_RELEASE) == CONTENDED) {
+        (void)sys_futex_wake(&m->state, 1);
+    }
+}
+
+// The sequence is read before the mutex is dropped, so a signal sent after the unlock changes it
+// and the futex wait refuses to sleep. Waking may find the mutex's own queue was where a broadcast
+// left this thread, with others behind it, hence the contended relock.
+void cond_wait(cond* c, mutex* m) {
+    uint32_t sequence = __atomic_load_n(&c->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&c->mutex, m, __ATOMIC_RELAXED);
+    mutex_unlock(m);
+    (void)sys_futex_wait(&c->sequence, sequence, 0);
+    lock_contended(m);
+}
+
+void cond_signal(cond* c) {
+    __atomic_fetch_add(&c->sequence, 1, __ATOMIC_RELEASE);
+    (void)sys_futex_wake(&c->sequence, 1);
+}
+
+// Wake one waiter and requeue the rest onto the mutex, which they would only queue on one by one
+// anyway. A signal or broadcast landing between the bump and the requeue changes the sequence
+// again, so the requeue refuses and everyone is woken plainly -- spurious wakes, never lost ones.
+void cond_broadcast(cond* c) {
+    mutex* m          = __atomic_load_n(&c->mutex, __ATOMIC_RELAXED);
+    uint32_t sequence = __atomic_add_fetch(&c->sequence, 1, __ATOMIC_RELEASE);
+    if (m != NULL && !sys_is_error(sys_futex_requeue(&c->sequence, sequence, 1, &m->state, WAKE_ALL))) { return; }
+    (void)sys_futex_wake(&c->sequence, WAKE_ALL);
+}
@@ -92,7 +92,7 @@ uint64_t send_message(uint64_t channel, uint32_t opcode, uint32_t status, uint64
 // the rest.
 void serve_connect(size_t requester, uint64_t txid, const char* name, size_t name_len, size_t server) {
     uint64_t ends[2];
-    if (sys_is_error(sys_channel_create(PAIR_AT))) {
+    if (sys_is_error(sys_channel_create(PAIR_AT, 0, 0))) {
         (void)send_message(g_children[requester].mailbox, ABI_COORD_OP_CONNECT, static_cast<uint32_t>(-4), txid,
                            nullptr, 0, nullptr);
         return;
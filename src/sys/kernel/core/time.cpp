@@ -10,12 +10,19 @@ ktl::atomic<uint64_t> kernel::time::_timestamp_hz = 0;
 uint64_t kernel::time::_anchor_timestamp          = 0;
 time_ns_t kernel::time::_anchor_ns                = 0;
 
-// Every scheduling core ticks for preemption; only the boot core advances kernel time.
+// Every scheduling core's timer interrupt lands here. Before the cycle counter is adopted the boot
+// core's periodic tick is the clock; afterwards the interrupt only drives the scheduler, which
+// reprograms this core's one-shot timer on the way out.
 void kernel::time::tick() {
-    if (kernel::sched::on_boot_core()) { _now.fetch_add(1, ktl::memory_order::relaxed); }
+    if (!high_resolution() && kernel::sched::on_boot_core()) { _now.fetch_add(1, ktl::memory_order::relaxed); }
     kernel::sched::on_tick();
+    kernel::sched::rearm_timer();
 }
-ktime_t kernel::time::now() { return _now.load(ktl::memory_order::relaxed); }
+ktime_t kernel::time::now() {
+    if (!high_resolution() || _ns_per_tick == 0) { return _now.load(ktl::memory_order::relaxed); }
+    return static_cast<ktime_t>(ns_since_boot() / _ns_per_tick);
+}
+bool kernel::time::high_resolution() { return _timestamp_hz.load(ktl::memory_order::acquire) != 0; }
 time_ns_t kernel::time::ns_since_boot() {
     // Acquire pairs with the release in use_timestamp_clock(): a nonzero rate
     // guarantees the anchor fields are visible.
@@ -41,6 +48,15 @@ void kernel::time::use_timestamp_clock() {
     _anchor_ns        = ktime_to_ns(now());
     _timestamp_hz.store(hz, ktl::memory_order::release);
 }
+uint64_t kernel::time::ns_to_timestamp(time_ns_t ns) {
+    uint64_t hz = _timestamp_hz.load(ktl::memory_order::acquire);
+    if (hz == 0) { return 0; }
+    uint64_t delta = (ns > _anchor_ns) ? static_cast<uint64_t>(ns - _anchor_ns) : 0;
+    // Same split as ns_since_boot, rounding the remainder up instead of down.
+    uint64_t whole = (delta / 1'000'000'000ull) * hz;
+    uint64_t part  = ((delta % 1'000'000'000ull) * hz + 999'999'999ull) / 1'000'000'000ull;
+    return _anchor_timestamp + whole + part;
+}
 time_ns_t kernel::time::ktime_to_ns(ktime_t ktime) { return (time_ns_t)((uint64_t)ktime * (uint64_t)_ns_per_tick); }
 ktime_t kernel::time::ns_to_ticks_ceil(uint64_t ns) {
     uint64_t per = (uint64_t)_ns_per_tick;
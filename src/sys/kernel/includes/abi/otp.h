@@ -0,0 +1,141 @@
+#pragma once
+
+#include <stdint.h>
+
+// Object Transaction Programs: the instruction layout a server fills in to attach an in-kernel
+// fast path to one of its types (docs/Design/Object Transaction Programs.md). Public ABI,
+// installed beside <abi/syscall.h>. This header is the whole authoring surface -- a program is an
+// array of abi_otp_insn built in ordinary C, handed to SYS_TYPE_ATTACH_PROGRAM. There is no
+// assembler and no separate bytecode format.
+//
+// The instruction set makes unsafe programs unrepresentable rather than verifying them: control
+// flow only moves forward, there is no division, and data access names fixed offsets into
+// kernel-managed regions. Attachment still validates structure, bounds and budget once, so a
+// malformed program never runs, but nothing is checked again per execution.
+//
+// Execution state is a register file of ABI_OTP_REGISTERS 64-bit registers, all zero at entry,
+// plus one condition flag, false at entry. Every program ends in one of the three outcomes of the
+// object model's three-path dispatch: REJECT returns an error to the caller, COMPLETE returns a
+// value, DISPATCH forwards the operation to the type's server as if no program were attached.
+// Storage stores and signal changes take effect only on COMPLETE; a rejected or dispatched
+// operation leaves the object exactly as it found it.
+
+// The instruction set revision this header describes. Attachment names the revision a program was
+// built against; a kernel refuses revisions newer than its own.
+#define ABI_OTP_VERSION 1u
+
+// The system limit on program length, in instructions. Every executed path is at most this long:
+// with no backward jumps, the worst case is a straight run through every instruction.
+#define ABI_OTP_MAX_INSNS 256u
+#define ABI_OTP_REGISTERS 8u
+
+// In the src field of an ALU or compare instruction: the operand is imm, not a register.
+#define ABI_OTP_SRC_IMM 0xFFu
+
+typedef struct abi_otp_insn {
+    uint8_t op;    /* ABI_OTP_OP_* */
+    uint8_t dst;   /* destination (or left operand) register */
+    uint8_t src;   /* source register, or ABI_OTP_SRC_IMM */
+    uint8_t width; /* storage access width in bytes: 1, 2, 4 or 8 */
+    uint32_t off;  /* storage offset, metadata field, or forward jump distance */
+    uint64_t imm;  /* immediate operand, signal mask, or reject error */
+} abi_otp_insn;
+
+#ifdef __cplusplus
+static_assert(sizeof(abi_otp_insn) == 16, "an instruction is exactly two words");
+#endif
+
+// Termination. REJECT's imm is the error returned, a negative value in the error band described
+// at SYS_HANDLE_CLOSE. COMPLETE returns register src; keep completed values clear of that band,
+// since the caller cannot tell them apart from errors.
+#define ABI_OTP_OP_REJECT 0u
+#define ABI_OTP_OP_COMPLETE 1u
+#define ABI_OTP_OP_DISPATCH 2u
+
+// Data movement. LDM loads metadata field off (ABI_OTP_META_*). LDS and STS load (zero-extended)
+// and store `width` bytes at byte offset off of the object's inline storage; offset + width must
+// fit the storage size the type declared at registration.
+#define ABI_OTP_OP_LDI 3u /* dst = imm */
+#define ABI_OTP_OP_MOV 4u /* dst = src */
+#define ABI_OTP_OP_LDM 5u
+#define ABI_OTP_OP_LDS 6u
+#define ABI_OTP_OP_STS 7u
+
+// Arithmetic: dst = dst <op> operand, wrapping. Shift amounts are imm only, below 64.
+#define ABI_OTP_OP_ADD 8u
+#define ABI_OTP_OP_SUB 9u
+#define ABI_OTP_OP_MUL 10u
+#define ABI_OTP_OP_AND 11u
+#define ABI_OTP_OP_OR 12u
+#define ABI_OTP_OP_XOR 13u
+#define ABI_OTP_OP_SHL 14u
+#define ABI_OTP_OP_SHR 15u
+
+// Comparison: flag = dst <relation> operand, unsigned. TEST sets the flag when dst & operand is
+// nonzero.
+#define ABI_OTP_OP_CMP_EQ 16u
+#define ABI_OTP_OP_CMP_NE 17u
+#define ABI_OTP_OP_CMP_LT 18u
+#define ABI_OTP_OP_CMP_GE 19u
+#define ABI_OTP_OP_TEST 20u
+
+// Control flow: skip `off` instructions forward (the target is pc + 1 + off), unconditionally or
+// on the flag. A target past the last instruction fails attachment.
+#define ABI_OTP_OP_JMP 21u
+#define ABI_OTP_OP_JT 22u
+#define ABI_OTP_OP_JF 23u
+
+// Signals on the invoked object: assert or deassert the bits in imm (32-bit masks).
+#define ABI_OTP_OP_SIGNAL_SET 24u
+#define ABI_OTP_OP_SIGNAL_CLEAR 25u
+
+// Metadata fields for LDM, fixed for the duration of one execution. OPCODE and ARG are the
+// SYS_OBJ_INVOKE arguments; there is deliberately no field naming the object itself.
+#define ABI_OTP_META_RIGHTS 0u  /* the invoking handle's rights */
+#define ABI_OTP_META_OPCODE 1u  /* the type-defined operation */
+#define ABI_OTP_META_ARG 2u     /* its argument */
+#define ABI_OTP_META_SIGNALS 3u /* the object's signals at entry */
+#define ABI_OTP_META_COUNT 4u
+
+#ifdef __cplusplus
+namespace abi::otp {
+
+using insn                        = ::abi_otp_insn;
+constexpr uint32_t VERSION        = ABI_OTP_VERSION;
+constexpr uint32_t MAX_INSNS      = ABI_OTP_MAX_INSNS;
+constexpr uint32_t REGISTERS      = ABI_OTP_REGISTERS;
+constexpr uint8_t SRC_IMM         = ABI_OTP_SRC_IMM;
+constexpr uint8_t OP_REJECT       = ABI_OTP_OP_REJECT;
+constexpr uint8_t OP_COMPLETE     = ABI_OTP_OP_COMPLETE;
+constexpr uint8_t OP_DISPATCH     = ABI_OTP_OP_DISPATCH;
+constexpr uint8_t OP_LDI          = ABI_OTP_OP_LDI;
+constexpr uint8_t OP_MOV          = ABI_OTP_OP_MOV;
+constexpr uint8_t OP_LDM          = ABI_OTP_OP_LDM;
+constexpr uint8_t OP_LDS          = ABI_OTP_OP_LDS;
+constexpr uint8_t OP_STS          = ABI_OTP_OP_STS;
+constexpr uint8_t OP_ADD          = ABI_OTP_OP_ADD;
+constexpr uint8_t OP_SUB          = ABI_OTP_OP_SUB;
+constexpr uint8_t OP_MUL          = ABI_OTP_OP_MUL;
+constexpr uint8_t OP_AND          = ABI_OTP_OP_AND;
+constexpr uint8_t OP_OR           = ABI_OTP_OP_OR;
+constexpr uint8_t OP_XOR          = ABI_OTP_OP_XOR;
+constexpr uint8_t OP_SHL          = ABI_OTP_OP_SHL;
+constexpr uint8_t OP_SHR          = ABI_OTP_OP_SHR;
+constexpr uint8_t OP_CMP_EQ       = ABI_OTP_OP_CMP_EQ;
+constexpr uint8_t OP_CMP_NE       = ABI_OTP_OP_CMP_NE;
+constexpr uint8_t OP_CMP_LT       = ABI_OTP_OP_CMP_LT;
+constexpr uint8_t OP_CMP_GE       = ABI_OTP_OP_CMP_GE;
+constexpr uint8_t OP_TEST         = ABI_OTP_OP_TEST;
+constexpr uint8_t OP_JMP          = ABI_OTP_OP_JMP;
+constexpr uint8_t OP_JT           = ABI_OTP_OP_JT;
+constexpr uint8_t OP_JF           = ABI_OTP_OP_JF;
+constexpr uint8_t OP_SIGNAL_SET   = ABI_OTP_OP_SIGNAL_SET;
+constexpr uint8_t OP_SIGNAL_CLEAR = ABI_OTP_OP_SIGNAL_CLEAR;
+constexpr uint32_t META_RIGHTS    = ABI_OTP_META_RIGHTS;
+constexpr uint32_t META_OPCODE    = ABI_OTP_META_OPCODE;
+constexpr uint32_t META_ARG       = ABI_OTP_META_ARG;
+constexpr uint32_t META_SIGNALS   = ABI_OTP_META_SIGNALS;
+constexpr uint32_t META_COUNT     = ABI_OTP_META_COUNT;
+
+}  // namespace abi::otp
+#endif
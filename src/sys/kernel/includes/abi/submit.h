@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+// Batched submission: the entry and completion layouts for SYS_SUBMIT (<abi/syscall.h>). Public
+// ABI, installed beside <abi/syscall.h>. A server that drains a port and answers many channels
+// otherwise pays one kernel entry and exit per operation; SYS_SUBMIT runs a whole vector of them
+// for one.
+//
+// Both arrays live in the calling thread's IPC buffer, like every other syscall input, so no user
+// pointer crosses the boundary: an entry's arguments are exactly the registers the operation takes
+// as its own syscall, and any offsets among them are IPC-buffer offsets as usual. Entries run in
+// order, each to completion, and each posts its completion -- the value the operation would have
+// returned as its own syscall, errors included -- before the next starts. One failing entry does
+// not stop the batch.
+//
+// Nothing in a batch blocks. The operations that may appear are the ones that never wait; the port
+// dequeues are SYS_PORT_WAIT and SYS_PORT_WAIT_MANY made non-blocking, returning ABI_ERR_WOULD_BLOCK
+// on an empty port with their timeouts ignored. Any other operation, SYS_SUBMIT itself included, completes with the
+// invalid_operation error without running.
+
+// The most entries one SYS_SUBMIT takes.
+#define ABI_SUBMIT_MAX_ENTRIES 64u
+
+typedef struct abi_submit_entry {
+    uint64_t op;        /* syscall number: one of the operations listed below */
+    uint64_t user_data; /* copied to the completion untouched, to match the two up */
+    uint64_t args[5];   /* the operation's arg0..arg4; unused trailing args are ignored */
+} abi_submit_entry;
+
+typedef struct abi_submit_completion {
+    uint64_t user_data; /* the entry's user_data */
+    uint64_t result;    /* the operation's return value or error */
+} abi_submit_completion;
+
+#ifdef __cplusplus
+static_assert(sizeof(abi_submit_entry) == 56, "an entry is seven words");
+static_assert(sizeof(abi_submit_completion) == 16, "a completion is two words");
+#endif
+
+// The operations a batch may carry, by syscall number: SYS_CHANNEL_SEND, SYS_CHANNEL_RECV,
+// SYS_SOCKET_WRITE, SYS_SOCKET_READ, SYS_SOCKET_WRITEV, SYS_SOCKET_READV, SYS_HANDLE_CLOSE,
+// SYS_FUTEX_WAKE, and SYS_PORT_WAIT and SYS_PORT_WAIT_MANY (as non-blocking dequeues).
@@ -13,7 +13,7 @@
 // The syscall number names the operation; a handle argument names the object it acts on.
 #define ABI_SYS_EXIT 0ull /* arg0 = exit status; the low 32 bits are recorded on the task */
 #define ABI_SYS_YIELD 1ull
-#define ABI_SYS_SLEEP 2ull /* arg0 = kernel ticks */
+#define ABI_SYS_SLEEP 2ull /* arg0 = nanoseconds */
 // arg0 = offset into this thread's IPC buffer, arg1 = byte count. Returns bytes written, or a
 // negative error. No pointer crosses the boundary: the buffer is the only memory a syscall
 // reads from the caller, and the kernel already knows where its pages are.
@@ -50,13 +50,20 @@
 // arg4 many, at most CHANNEL_MAX_MESSAGE_HANDLES; sending any requires the transfer right on the
 // channel handle. Each is removed from the sender's table and rides the message; the receiver's
 // recv names where arrived handles land (arg3) and how many it has room for (arg4). A handle in
-// transit lives in the kernel's own table, so a channel that dies with messages queued closes
-// them like any other handle. Once a send has begun consuming handles they belong to the message:
-// a send that fails partway closes what it took, and a message dropped unread closes what it
-// carried. The transferred handle arrives with a new value but the same rights.
+// transit is held by the message itself, in no table, so a channel that dies with messages
+// queued closes them like any other handle. Once a send has begun consuming handles they belong
+// to the message: a send that fails partway closes what it took, and a message dropped unread
+// closes what it carried. The transferred handle arrives with a new value but the same rights.
+//
+// Each direction queues up to a depth of messages and a budget of payload bytes, both chosen at
+// create and the same both ways: the default depth is ABI_CHANNEL_QUEUE_DEPTH, at most
+// ABI_CHANNEL_MAX_QUEUE_DEPTH, and the default budget is whatever the depth can hold, at most
+// ABI_CHANNEL_MAX_BYTE_BUDGET -- out of range past either. An empty queue takes any one message,
+// so a budget below a message's size slows the sender to one at a time rather than wedging it.
 #define ABI_SYS_CHANNEL_CREATE                                       \
     7ull /* arg0 = IPC-buffer offset where the kernel writes the two \
-            endpoint handles as two uint64s. Returns 0. */
+            endpoint handles as two uint64s, arg1 = queue depth (0 = \
+            default), arg2 = byte budget (0 = default). Returns 0. */
 #define ABI_SYS_CHANNEL_SEND                                           \
     8ull /* arg0 = handle (needs the write right), arg1 = IPC-buffer   \
             offset, arg2 = length, arg3 = IPC-buffer offset of handles \
@@ -72,7 +79,11 @@
             ERR_TRUNCATED, so the next recv sees the next message. */
 
 // The most handles one message can carry.
-#define ABI_CHANNEL_MAX_MESSAGE_HANDLES 4ull
+#define ABI_CHANNEL_MAX_MESSAGE_HANDLES 8ull
+
+#define ABI_CHANNEL_QUEUE_DEPTH 8ull
+#define ABI_CHANNEL_MAX_QUEUE_DEPTH 256ull
+#define ABI_CHANNEL_MAX_BYTE_BUDGET (ABI_CHANNEL_MAX_QUEUE_DEPTH * 4096ull)
 
 // Error returns a user program must branch on, as signed values of the negative band described at
 // SYS_HANDLE_CLOSE. The full band is still kernel-internal; codes are installed here one by one
@@ -159,9 +170,13 @@
 // Direction is a property of the handle, not the object: an end without the write right is a
 // read-only stream, so a pipe is this same pair with the opposing right stripped from each side.
 // Data moves only through the IPC buffer, like every other syscall.
+//
+// Each direction buffers one page unless create asks for more: the capacity is rounded up to whole
+// pages, at most ABI_SOCKET_MAX_CAPACITY, and out of range past that.
 #define ABI_SYS_SOCKET_CREATE                                     \
     21ull /* arg0 = IPC-buffer offset where the kernel writes the \
-             two endpoint handles as two uint64s. Returns 0. */
+             two endpoint handles as two uint64s, arg1 = bytes    \
+             per direction (0 = one page). Returns 0. */
 #define ABI_SYS_SOCKET_WRITE                                 \
     22ull /* arg0 = handle (needs the write right), arg1 =   \
              IPC-buffer offset, arg2 = length. Returns bytes \
@@ -170,9 +185,34 @@
     23ull /* arg0 = handle (needs the read right), arg1 = \
              IPC-buffer offset, arg2 = capacity. Returns bytes read. */
 
+// Signal thresholds on one end, so a waiter wakes per batch instead of per byte: READABLE asserts
+// only once at least arg1 bytes are buffered for this end (1..capacity), and WRITABLE, once cleared
+// by a full peer buffer, reasserts only when the peer has drained to arg2 bytes (0..capacity - 1).
+// A fresh end has 1 and capacity - 1. A hangup asserts READABLE on any remainder regardless.
+#define ABI_SYS_SOCKET_SET_WATERMARKS                     \
+    30ull /* arg0 = handle (needs the wait right), arg1 = \
+             read high-water, arg2 = write low-water.     \
+             Returns 0. */
+
+// Vectored forms: arg1 is the IPC-buffer offset of up to ABI_SOCKET_MAX_IOVECS ranges, each two
+// uint64s (IPC-buffer offset, length), moved in order as one write or read would move their
+// concatenation -- short at the first range the buffer fills or empties on. Every range is checked
+// against the IPC buffer before any byte moves.
+#define ABI_SYS_SOCKET_WRITEV                                   \
+    31ull /* arg0 = handle (needs the write right), arg1 =      \
+             IPC-buffer offset of the ranges, arg2 = range      \
+             count. Returns bytes accepted, possibly short. */
+#define ABI_SYS_SOCKET_READV                                    \
+    32ull /* arg0 = handle (needs the read right), arg1 =       \
+             IPC-buffer offset of the ranges, arg2 = range      \
+             count. Returns bytes read. */
+
+#define ABI_SOCKET_MAX_CAPACITY (64ull * 1024)
+#define ABI_SOCKET_MAX_IOVECS 16ull
+
 // Socket endpoint signals: the same shape as the channel bits. READABLE while bytes are
 // buffered, WRITABLE while the peer's buffer has room, PEER_CLOSED once the opposite endpoint
-// is destroyed.
+// is destroyed. SYS_SOCKET_SET_WATERMARKS moves the first two off their one-byte thresholds.
 #define ABI_SOCKET_SIGNAL_READABLE (1ull << 0)
 #define ABI_SOCKET_SIGNAL_WRITABLE (1ull << 1)
 #define ABI_SOCKET_SIGNAL_PEER_CLOSED (1ull << 2)
@@ -189,6 +229,39 @@
     20ull /* arg0 = any address inside a mapping. Removes the \
              whole mapping containing it. Returns 0. */
 
+// Bulk transfer: move a page-aligned range of a VMO's pages into a new VMO and return its handle,
+// to send through a channel like any other. The frames move rather than copy -- the sender's
+// mappings of the range are zapped and the range reads back zero-filled -- so a payload of any
+// size costs a few PTE updates. Every mapping of the source must be in the caller's own address
+// space, and a large page mapping it must lie wholly inside the range.
+#define ABI_SYS_VMO_DETACH                                         \
+    33ull /* arg0 = VMO handle (needs the read and write rights), \
+             arg1 = byte offset into the VMO, arg2 = length.      \
+             Returns the new VMO handle (read and write rights). */
+
+// Futexes: block on a 32-bit word of mapped memory until another thread wakes it, the slow path
+// under user mutexes and condition variables whose fast path never enters the kernel. The address
+// names the word but is never dereferenced: the kernel resolves it through the caller's own
+// mappings to (VMO, offset) and keys the wait on that, so tasks mapping the same VMO page at any
+// addresses share its futexes. Addresses must be 4-byte aligned (invalid_operation) and inside a
+// readable mapping (out_of_range). Wait checks the word against arg1 atomically with going to
+// sleep -- ERR_WOULD_BLOCK, without sleeping, if it differs -- and returns 0 when woken, including
+// by a wake that raced the check; waiters wake oldest first. Requeue is the condition variable's
+// broadcast: it wakes some waiters and moves the rest onto a second word's queue unwoken, after
+// the same check on the first word.
+#define ABI_SYS_FUTEX_WAIT                                        \
+    34ull /* arg0 = address, arg1 = expected value, arg2 =        \
+             timeout ns (0 = forever). Returns 0, ERR_WOULD_BLOCK \
+             or ERR_TIMED_OUT. */
+#define ABI_SYS_FUTEX_WAKE                                \
+    35ull /* arg0 = address, arg1 = most waiters to wake. \
+             Returns the number woken. */
+#define ABI_SYS_FUTEX_REQUEUE                                      \
+    36ull /* arg0 = address, arg1 = expected value, arg2 = most    \
+             waiters to wake, arg3 = target address, arg4 = most   \
+             waiters to move. Returns the number woken plus moved, \
+             or ERR_WOULD_BLOCK. */
+
 // Spawn a task from an executable image. Holding the image VMO is the whole authority -- there is
 // no ambient spawn privilege and no kernel-side list of programs; images arrive as IMAGE messages
 // (<abi/message.h>) or wherever else a VMO handle travels. The kernel parses the image (static
@@ -204,10 +277,81 @@
              new task handle then the bootstrap channel handle,   \
              two uint64s. Returns 0. */
 
+// Type-defined operations and their transaction programs (<abi/otp.h>). Invoke names an operation
+// by an opcode the object's type defines and runs the three-path pipeline on it: the program
+// attached to the type, if any, rejects it (its error comes back), completes it in the kernel (its
+// value comes back), or dispatches it to the type's server. No type has a server behind it yet,
+// so an operation that reaches dispatch fails with invalid_operation.
+//
+// Attaching a program needs the program right on a handle to any object of the type, and replaces
+// the type's previous program; invocations already running finish on the one they started with.
+// The program right is minted only with the authority over a type, never by default, so no
+// kernel-created handle carries it. Attachment validates the whole program first and fails with
+// nothing attached: unknown opcodes, bad registers, jumps past the end, or a last instruction that
+// is not a termination are invalid_operation; storage accesses outside the type's declared inline
+// storage are out_of_range; programs over the length or cost budget are capacity_exhausted.
+#define ABI_SYS_OBJ_INVOKE                              \
+    24ull /* arg0 = handle, arg1 = type-defined opcode, \
+             arg2 = argument. Returns the program's value. */
+#define ABI_SYS_TYPE_ATTACH_PROGRAM                                \
+    25ull /* arg0 = handle (needs the program right), arg1 =       \
+             IPC-buffer offset of the abi_otp_insn array, arg2 =   \
+             instruction count, arg3 = ABI_OTP_VERSION the program \
+             was built against. Returns 0. */
+
+// Synchronous channel calls: one syscall per side per round trip, where the non-blocking pattern
+// takes four (send, wait, recv on each side). Call sends a request and blocks for the reply on the
+// same endpoint; reply-and-wait sends a reply and blocks for the next request. Each hands the CPU
+// directly to the thread parked on the other end, bypassing the run queue, when that thread may
+// run on the caller's core. Both move the message through the IPC buffer in place -- the outgoing
+// message is read from arg1, the incoming one written over it -- and carry no handles: an incoming
+// message with handles is discarded like one over capacity, failing with ERR_TRUNCATED. Errors are
+// those of send, then of recv; a timeout lapsing fails with ERR_TIMED_OUT. Call fails with
+// invalid_operation, sending nothing, while a message is already queued on the endpoint: it would
+// be taken for the reply.
+#define ABI_SYS_CHANNEL_CALL                                                \
+    26ull /* arg0 = handle (needs read + write + wait rights), arg1 =       \
+             IPC-buffer offset, arg2 = request length, arg3 = reply         \
+             capacity, arg4 = timeout ns (0 = forever). Returns the reply   \
+             byte count. */
+#define ABI_SYS_CHANNEL_REPLY_WAIT                                          \
+    27ull /* arg0 = handle (needs read + write + wait rights), arg1 =       \
+             IPC-buffer offset, arg2 = reply length, or CHANNEL_NO_REPLY    \
+             to only wait (a server's first request), arg3 = request        \
+             capacity, arg4 = timeout ns (0 = forever). Returns the request \
+             byte count. */
+
+// SYS_CHANNEL_REPLY_WAIT's arg2 when there is no reply to send.
+#define ABI_CHANNEL_NO_REPLY (~0ull)
+
+// Batched submission (<abi/submit.h>): run up to ABI_SUBMIT_MAX_ENTRIES non-blocking operations for
+// one kernel entry. Out of range, with nothing run, if either array does not fit the IPC buffer or
+// the count is over the limit. A thread killed mid-batch stops between entries; the return value
+// says how many completions were posted.
+#define ABI_SYS_SUBMIT                                               \
+    28ull /* arg0 = IPC-buffer offset of the abi_submit_entry array, \
+             arg1 = entry count, arg2 = IPC-buffer offset of the     \
+             abi_submit_completion array, one per entry. Returns the \
+             number of entries run. */
+
+// SYS_PORT_WAIT that drains up to arg2 pending packets at once, oldest first, written back to back
+// from arg1 in SYS_PORT_WAIT's 16-byte layout. Blocks only while none are pending, so it returns as
+// soon as one is. Out of range if the count is zero or over ABI_PORT_WAIT_MAX_PACKETS, or if that
+// many packets do not fit the IPC buffer at the offset.
+#define ABI_SYS_PORT_WAIT_MANY                                 \
+    29ull /* arg0 = port handle (needs read + wait rights),    \
+             arg1 = IPC-buffer offset of the packet array,     \
+             arg2 = packet capacity, arg3 = timeout ns         \
+             (0 = forever). Returns the packet count, or       \
+             timed_out. */
+#define ABI_PORT_WAIT_MAX_PACKETS 64ull
+
 // Signal bits, as returned and waited on through SYS_OBJECT_WAIT. Meanings are per object type;
 // the channel bits are the first installed as ABI. The kernel manages all three: READABLE while
 // the endpoint has queued messages, WRITABLE while the peer has queue room, PEER_CLOSED once the
-// opposite endpoint is destroyed.
+// opposite endpoint is destroyed. WRITABLE has hysteresis: once a full queue (or a refused send)
+// clears it, it reasserts only after the peer drains to half its depth and half its byte budget,
+// so a blocked sender wakes to a batch of room rather than to each freed slot.
 #define ABI_CHANNEL_SIGNAL_READABLE (1ull << 0)
 #define ABI_CHANNEL_SIGNAL_WRITABLE (1ull << 1)
 #define ABI_CHANNEL_SIGNAL_PEER_CLOSED (1ull << 2)
@@ -241,6 +385,9 @@ constexpr uint64_t SYS_CHANNEL_CREATE          = ABI_SYS_CHANNEL_CREATE;
 constexpr uint64_t SYS_CHANNEL_SEND            = ABI_SYS_CHANNEL_SEND;
 constexpr uint64_t SYS_CHANNEL_RECV            = ABI_SYS_CHANNEL_RECV;
 constexpr uint64_t CHANNEL_MAX_MESSAGE_HANDLES = ABI_CHANNEL_MAX_MESSAGE_HANDLES;
+constexpr uint64_t CHANNEL_QUEUE_DEPTH         = ABI_CHANNEL_QUEUE_DEPTH;
+constexpr uint64_t CHANNEL_MAX_QUEUE_DEPTH     = ABI_CHANNEL_MAX_QUEUE_DEPTH;
+constexpr uint64_t CHANNEL_MAX_BYTE_BUDGET     = ABI_CHANNEL_MAX_BYTE_BUDGET;
 constexpr int64_t ERR_TRUNCATED                = ABI_ERR_TRUNCATED;
 constexpr int64_t ERR_WOULD_BLOCK              = ABI_ERR_WOULD_BLOCK;
 constexpr int64_t ERR_PEER_CLOSED              = ABI_ERR_PEER_CLOSED;
@@ -253,6 +400,14 @@ constexpr uint64_t SYS_PORT_WAIT               = ABI_SYS_PORT_WAIT;
 constexpr uint64_t SYS_TASK_KILL               = ABI_SYS_TASK_KILL;
 constexpr uint64_t SYS_TASK_STATUS             = ABI_SYS_TASK_STATUS;
 constexpr uint64_t SYS_TASK_SPAWN              = ABI_SYS_TASK_SPAWN;
+constexpr uint64_t SYS_OBJ_INVOKE              = ABI_SYS_OBJ_INVOKE;
+constexpr uint64_t SYS_TYPE_ATTACH_PROGRAM     = ABI_SYS_TYPE_ATTACH_PROGRAM;
+constexpr uint64_t SYS_CHANNEL_CALL            = ABI_SYS_CHANNEL_CALL;
+constexpr uint64_t SYS_CHANNEL_REPLY_WAIT      = ABI_SYS_CHANNEL_REPLY_WAIT;
+constexpr uint64_t CHANNEL_NO_REPLY            = ABI_CHANNEL_NO_REPLY;
+constexpr uint64_t SYS_SUBMIT                  = ABI_SYS_SUBMIT;
+constexpr uint64_t SYS_PORT_WAIT_MANY          = ABI_SYS_PORT_WAIT_MANY;
+constexpr uint64_t PORT_WAIT_MAX_PACKETS       = ABI_PORT_WAIT_MAX_PACKETS;
 constexpr uint64_t TASK_EXIT_EXITED            = ABI_TASK_EXIT_EXITED;
 constexpr uint64_t TASK_EXIT_KILLED            = ABI_TASK_EXIT_KILLED;
 constexpr uint64_t TASK_EXIT_FAULTED           = ABI_TASK_EXIT_FAULTED;
@@ -263,9 +418,18 @@ constexpr uint64_t VM_PROT_EXEC                = ABI_VM_PROT_EXEC;
 constexpr uint64_t SYS_VMO_CREATE              = ABI_SYS_VMO_CREATE;
 constexpr uint64_t SYS_VMO_MAP                 = ABI_SYS_VMO_MAP;
 constexpr uint64_t SYS_VMO_UNMAP               = ABI_SYS_VMO_UNMAP;
+constexpr uint64_t SYS_VMO_DETACH              = ABI_SYS_VMO_DETACH;
+constexpr uint64_t SYS_FUTEX_WAIT              = ABI_SYS_FUTEX_WAIT;
+constexpr uint64_t SYS_FUTEX_WAKE              = ABI_SYS_FUTEX_WAKE;
+constexpr uint64_t SYS_FUTEX_REQUEUE           = ABI_SYS_FUTEX_REQUEUE;
 constexpr uint64_t SYS_SOCKET_CREATE           = ABI_SYS_SOCKET_CREATE;
 constexpr uint64_t SYS_SOCKET_WRITE            = ABI_SYS_SOCKET_WRITE;
 constexpr uint64_t SYS_SOCKET_READ             = ABI_SYS_SOCKET_READ;
+constexpr uint64_t SYS_SOCKET_SET_WATERMARKS   = ABI_SYS_SOCKET_SET_WATERMARKS;
+constexpr uint64_t SYS_SOCKET_WRITEV           = ABI_SYS_SOCKET_WRITEV;
+constexpr uint64_t SYS_SOCKET_READV            = ABI_SYS_SOCKET_READV;
+constexpr uint64_t SOCKET_MAX_CAPACITY         = ABI_SOCKET_MAX_CAPACITY;
+constexpr uint64_t SOCKET_MAX_IOVECS           = ABI_SOCKET_MAX_IOVECS;
 constexpr uint64_t SOCKET_SIGNAL_READABLE      = ABI_SOCKET_SIGNAL_READABLE;
 constexpr uint64_t SOCKET_SIGNAL_WRITABLE      = ABI_SOCKET_SIGNAL_WRITABLE;
 constexpr uint64_t SOCKET_SIGNAL_PEER_CLOSED   = ABI_SOCKET_SIGNAL_PEER_CLOSED;
@@ -34,6 +34,10 @@ uintptr_t active_translation_root();
 /// Halt until the next interrupt (hlt / wfi). Call with interrupts enabled.
 void wait_for_interrupt();
 
+/// Busy-wait hint for one spin-loop iteration (pause / Zihintpause pause, a nop on harts without
+/// it): yields pipeline resources to an SMT sibling and eases the exit from the loop.
+void cpu_relax();
+
 /// Interrupt core `core_index` so it leaves wait_for_interrupt() and revisits the run queue. The
 /// receiving side needs no handler logic beyond acknowledging the interrupt.
 void send_reschedule_ipi(size_t core_index);
@@ -52,25 +56,36 @@ uintptr_t prepare_thread_stack(uintptr_t stack_top, void (*entry)(void*), void*
 /// Its rate is a board property; see kernel::platform::timestamp_hz().
 uint64_t timestamp();
 
-/// Per-thread user FP/SIMD register state, saved and restored across user-thread context switches.
-/// These are per-arch facts, not a shared format: x86_64's FXSAVE area (512 bytes, 16-aligned),
-/// riscv64's f0-f31 plus fcsr (260 bytes, padded to 8). Neither XSAVE (CPUID-derived size,
-/// 64-aligned) nor the V extension (VLEN-scaled) fits a compile-time constant; whichever arrives
-/// first makes the area dynamically sized.
+/// Per-thread user FP/SIMD register state. These are per-arch facts, not a shared format: on
+/// x86_64 an XSAVE area covering x87, SSE and AVX (832 bytes, 64-aligned; the first 512 are the
+/// FXSAVE image, which is all a CPU without XSAVE uses), on riscv64 f0-f31 plus fcsr (260 bytes,
+/// padded to 8). Wider state -- AVX-512, the V extension -- is not enabled, so the size stays a
+/// compile-time constant.
 #if defined(__riscv)
 inline constexpr size_t FPU_AREA_SIZE  = 264;
 inline constexpr size_t FPU_AREA_ALIGN = 8;
 #else
-inline constexpr size_t FPU_AREA_SIZE  = 512;
-inline constexpr size_t FPU_AREA_ALIGN = 16;
+inline constexpr size_t FPU_AREA_SIZE  = 832;
+inline constexpr size_t FPU_AREA_ALIGN = 64;
 #endif
 /// Write the architecture's nonzero program-entry FP state into `area` (exceptions masked,
-/// round-to-nearest). The area arrives zeroed -- Thread zero-initializes it -- and zero covers
-/// everything else: cleared registers, empty x87 tags, no accrued flags.
+/// round-to-nearest). The area arrives zeroed -- the FPU arena hands out zeroed slots -- and zero
+/// covers everything else: cleared registers, empty x87 tags, no accrued flags.
 void fpu_init(void* area);
 void fpu_save(void* area);
 void fpu_restore(void* area);
 
+/// Lazy switching. User FP/SIMD state is loaded on a thread's first FP instruction after it is
+/// switched in, not at the switch, unless the core still holds it. The calling core's trap is
+/// armed while the running user thread's state is not in the registers (x86_64: CR0.TS, so the
+/// instruction raises #NM; riscv64: sstatus.FS Off on the return to user, so it raises an illegal
+/// instruction) and the trap handler calls sched::fpu_first_use(). Interrupts off.
+void fpu_set_trap(bool armed);
+/// Whether the running user thread may have changed its loaded state since it was last saved,
+/// consuming the mark. x86_64 has no dirty bit and answers true whenever the trap is disarmed
+/// (XSAVEOPT skips what did not change); riscv64 reads sstatus.FS as trap entry found it.
+bool fpu_take_dirty();
+
 /// Publish the current kernel stack top for user-to-kernel transitions.
 void set_kernel_stack(uintptr_t top);
 /// Drops to user mode at `entry`; never returns. The thread's IPC buffer base and size arrive in the
@@ -20,6 +20,11 @@
 #define CONFIG_KERNEL_TESTING 1
 #define CONFIG_KERNEL_SHELL 1
 #define CONFIG_MAX_OBJECT_TYPES 64
+// The largest inline storage a type may declare at registration, in bytes.
+#define CONFIG_OBJECT_MAX_INLINE_STORAGE 256
+// Worst-case cost a transaction program may reach at attachment, in the units of obj/otp.cpp's
+// per-opcode table (a register op is 1).
+#define CONFIG_OTP_MAX_COST 512
 
 // Kernel thread stacks: physically contiguous, used through the HHDM mapping.
 #define CONFIG_KERNEL_STACK_SIZE (16 * 1024)
@@ -27,11 +32,22 @@
 #define CONFIG_KERNEL_STACK_TRIPWIRE_MARGIN 4096
 // Round-robin timeslice in kernel ticks (1 tick = 1 ms on both timers today).
 #define CONFIG_SCHED_TIMESLICE_TICKS 10
-// Scheduler trace ring capacity in records (~32 bytes each; always-on flight recorder).
+// Scheduler trace: each core records into its own ring (~32 bytes per record; always-on flight
+// recorder), and a dump merges the rings newest-first into at most CONFIG_SCHED_TRACE_EVENTS.
 #define CONFIG_SCHED_TRACE_EVENTS 512
+#define CONFIG_SCHED_TRACE_EVENTS_PER_CORE 256
 #define CONFIG_LOCKDEP_MAX_HELD 16
-#define CONFIG_LOCKDEP_MAX_LOCKS 128
+#define CONFIG_LOCKDEP_MAX_LOCKS 208
 #define CONFIG_LOCKDEP_MAX_EDGES 512
+// Debug lock classes (distinct lock names) with contention counters; see lockdep::snapshot_classes.
+#define CONFIG_LOCKDEP_MAX_CLASSES 32
+// Per-spinlock acquire, contended-acquire and longest-wait counters (debug builds only: they are
+// found through the lock's lockdep identity).
+#define CONFIG_SPINLOCK_STATS 1
+// Iterations a mutex contender spins while the owner is running on another core before parking.
+#define CONFIG_MUTEX_SPIN_LIMIT 4096
+// Default fault-around window of a new VMO binding, in pages (power of two; 1 disables).
+#define CONFIG_VM_FAULT_AROUND_PAGES 16
 
 // Testing overrides
 #ifndef PRODUCT_DEBUG
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <kernel/mm/vm_aspace.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Per-arch PTE codec and MMU primitives behind the shared page walk in
@@ -37,6 +38,13 @@ uint64_t make_table_ptr(vm_paddr_t child, uint64_t leaf_flags);
 // Widen an existing intermediate for the same reason; no-op on riscv64.
 void widen_table_ptr(uint64_t& slot, uint64_t leaf_flags);
 uint64_t make_leaf(vm_paddr_t paddr, uint64_t flags);
+// A terminal entry above the deepest level (2 MiB or 1 GiB), from leaf_flags().
+uint64_t make_large_leaf(vm_paddr_t paddr, uint64_t flags);
+// The large-leaf form of a deepest-level entry, same address and attributes; 0
+// when its attributes have no large encoding (an x86_64 PAT-indexed page).
+uint64_t pte_promote(uint64_t entry);
+// Whether the MMU takes leaves of this size (LARGE_PAGE_2M or LARGE_PAGE_1G).
+bool large_page_supported(size_t size);
 uint64_t leaf_flags(vm_prot_t prot, vm_cache_mode cache);
 vm_translation attrs_from_pte(uint64_t entry, vm_paddr_t paddr);
 
@@ -47,6 +55,8 @@ void flush_tlb_page(vm_paddr_t root, uintptr_t vaddr);
 // Invalidate one page's translation on every core in core_mask (bit n = dense core n), none of
 // which is the caller. The caller established that the space is live on each of them.
 void shootdown_tlb_page(uint64_t core_mask, uintptr_t vaddr);
+// The same for every page of [vaddr, vaddr + size), in one round trip.
+void shootdown_tlb_range(uint64_t core_mask, uintptr_t vaddr, size_t size);
 // Post-install flush for a brand-new leaf: pre-Svvptc riscv64 may cache the
 // failed translation that faulted us here; a no-op on x86_64.
 void flush_new_leaf(vm_paddr_t root, uintptr_t vaddr);
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace kernel::mm {
+
+// Free-list bookkeeping for one free block, stored in the block's first frame.
+struct buddy_link {
+    uint64_t next;
+    uint64_t prev;
+    uint64_t zeroed;  // leading frames of the block known zero: a hint, advanced by zero_step
+};
+
+// Binary buddy allocator over frame numbers. Free memory is held as aligned power-of-two blocks
+// of up to 2^MAX_ORDER frames, one list per order; a freed block merges with its buddy whenever
+// that buddy is free and whole, so runs freed page by page coalesce back into runs that
+// alloc_contiguous can serve. Every operation is O(MAX_ORDER) list steps.
+//
+// Each order keeps two lists: clean blocks, whose frames are all known zero, and dirty ones.
+// Per-frame zero state is the Frames policy's truth; a block's `zeroed` prefix is only a hint
+// that lets zero_step resume where it stopped. Merges and splits carry the prefix along, and
+// lose it (conservatively) only where it is no longer a prefix.
+//
+// Frames is a small copyable policy that supplies the per-frame storage:
+//   uint8_t order_tag(uint64_t frame)        -- order + 1 while the frame heads a free block, else 0;
+//                                              0 for frames it does not cover
+//   void set_order_tag(uint64_t frame, uint8_t tag)
+//   buddy_link& link(uint64_t frame)          -- the head frame's list storage
+//   bool zeroed(uint64_t frame)               -- the frame is known zero
+// The kernel keys tags on page descriptors and keeps links in the free frames themselves; the
+// host tests back both with arrays. Carries no lock; the owner serializes access. Pure data --
+// host-testable.
+template <typename Frames> class buddy_allocator {
+   public:
+    static constexpr size_t MAX_ORDER = 10;  // 4 MiB blocks of 4 KiB frames
+    static constexpr size_t ORDERS    = MAX_ORDER + 1;
+    static constexpr uint64_t NIL     = ~uint64_t{0};
+
+    explicit buddy_allocator(Frames frames = Frames{}) : m_frames(frames) {
+        for (auto& lists : m_head) { lists[0] = lists[1] = NIL; }
+    }
+    buddy_allocator(const buddy_allocator&)            = delete;
+    buddy_allocator& operator=(const buddy_allocator&) = delete;
+
+    // Return [frame, frame + count) as the largest aligned blocks it holds, merging each with its
+    // free buddies. The frames' zero state is whatever the policy says; the hint starts at none.
+    void release(uint64_t frame, size_t count) {
+        while (count > 0) {
+            size_t order = fitting_order(frame, count);
+            insert(frame, order, 0);
+            frame += uint64_t{1} << order;
+            count -= size_t{1} << order;
+        }
+    }
+
+    // Take a block of exactly 2^order frames: the smallest order that has one, a clean block over
+    // a dirty one within it, split down with the unused halves going back on the lists. Splitting
+    // keeps the low half, so an alloc/free pair leaves the lists as they were.
+    bool take(size_t order, uint64_t& out) {
+        for (size_t from = order; from < ORDERS; ++from) {
+            size_t list = m_head[from][1] != NIL ? 1 : 0;
+            if (m_head[from][list] == NIL) { continue; }
+            uint64_t frame  = m_head[from][list];
+            uint64_t zeroed = m_frames.link(frame).zeroed;
+            unlink(frame, from, list == 1);
+            while (from > order) {
+                --from;
+                uint64_t half = uint64_t{1} << from;
+                // The high half's own buddy is the half being kept, so it cannot merge yet.
+                push(frame + half, from, zeroed > half ? zeroed - half : 0);
+                if (zeroed > half) { zeroed = half; }
+            }
+            out = frame;
+            return true;
+        }
+        return false;
+    }
+
+    // Take `count` frames (at most 2^MAX_ORDER) as one run, returning the tail of the enclosing
+    // block to the lists.
+    bool take_run(size_t count, uint64_t& out) {
+        if (count == 0 || count > (size_t{1} << MAX_ORDER)) { return false; }
+        size_t order = 0;
+        while ((size_t{1} << order) < count) { ++order; }
+        if (!take(order, out)) { return false; }
+        release(out + count, (size_t{1} << order) - count);
+        return true;
+    }
+
+    // One unit of background zeroing: advance the lowest-order dirty block past frames already
+    // zero and call zero(frame) for the next one -- which must make policy.zeroed(frame) true and
+    // may overwrite the whole frame, link included. A block with nothing left to zero moves to its
+    // clean list. False when every free block is clean.
+    template <typename Zero> bool zero_step(Zero&& zero) {
+        for (size_t order = 0; order < ORDERS; ++order) {
+            uint64_t head = m_head[order][0];
+            if (head == NIL) { continue; }
+            uint64_t size    = uint64_t{1} << order;
+            buddy_link saved = m_frames.link(head);
+            while (saved.zeroed < size && m_frames.zeroed(head + saved.zeroed)) { ++saved.zeroed; }
+            if (saved.zeroed < size) {
+                zero(head + saved.zeroed);
+                ++saved.zeroed;
+            }
+            m_frames.link(head) = saved;
+            if (saved.zeroed == size) {
+                unlink(head, order, false);
+                push(head, order, size);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    size_t free_frames() const { return m_free; }
+    size_t blocks(size_t order) const { return m_blocks[order]; }
+    // Frames in the largest free block: the longest run take_run can serve right now.
+    size_t largest_block() const {
+        for (size_t order = ORDERS; order-- > 0;) {
+            if (m_blocks[order] != 0) { return size_t{1} << order; }
+        }
+        return 0;
+    }
+
+   private:
+    // The largest block that starts at `frame` (alignment) and fits in `count`.
+    static size_t fitting_order(uint64_t frame, size_t count) {
+        size_t order = 0;
+        while (order < MAX_ORDER && (frame & (uint64_t{1} << order)) == 0 && (size_t{2} << order) <= count) {
+            ++order;
+        }
+        return order;
+    }
+
+    void insert(uint64_t frame, size_t order, uint64_t zeroed) {
+        while (order < MAX_ORDER) {
+            uint64_t buddy = frame ^ (uint64_t{1} << order);
+            if (m_frames.order_tag(buddy) != order + 1) { break; }
+            uint64_t half         = uint64_t{1} << order;
+            uint64_t buddy_zeroed = m_frames.link(buddy).zeroed;
+            unlink(buddy, order, buddy_zeroed == half);
+            // The merged prefix runs on into the high half only when the low half is all zero.
+            if (buddy < frame) {
+                zeroed = buddy_zeroed == half ? half + zeroed : buddy_zeroed;
+                frame  = buddy;
+            } else if (zeroed == half) {
+                zeroed = half + buddy_zeroed;
+            }
+            ++order;
+        }
+        push(frame, order, zeroed);
+    }
+
+    void push(uint64_t frame, size_t order, uint64_t zeroed) {
+        size_t list          = zeroed == (uint64_t{1} << order) ? 1 : 0;
+        uint64_t& head       = m_head[order][list];
+        m_frames.link(frame) = buddy_link{head, NIL, zeroed};
+        if (head != NIL) { m_frames.link(head).prev = frame; }
+        head = frame;
+        m_frames.set_order_tag(frame, static_cast<uint8_t>(order + 1));
+        m_blocks[order] += 1;
+        m_free += size_t{1} << order;
+    }
+
+    // Clears the link words on the way out, so a clean block's head frame is all zero again.
+    void unlink(uint64_t frame, size_t order, bool clean) {
+        buddy_link& link = m_frames.link(frame);
+        if (link.prev != NIL) {
+            m_frames.link(link.prev).next = link.next;
+        } else {
+            m_head[order][clean ? 1 : 0] = link.next;
+        }
+        if (link.next != NIL) { m_frames.link(link.next).prev = link.prev; }
+        link = buddy_link{0, 0, 0};
+        m_frames.set_order_tag(frame, 0);
+        m_blocks[order] -= 1;
+        m_free -= size_t{1} << order;
+    }
+
+    Frames m_frames;
+    uint64_t m_head[ORDERS][2];  // [order][clean]
+    size_t m_blocks[ORDERS] = {};
+    size_t m_free           = 0;
+};
+
+}  // namespace kernel::mm
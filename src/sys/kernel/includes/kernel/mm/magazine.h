@@ -0,0 +1,239 @@
+#pragma once
+
+#include <kernel/arch.h>
+#include <kernel/config.h>
+#include <kernel/synchronization/execution_context.h>
+#include <kernel/synchronization/guard.h>
+#include <kernel/synchronization/spinlock.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-core object caching in front of a slab layer, after Bonwick's magazines: each core holds two
+// small stacks of free objects ("magazines", loaded and previous), and a shared depot trades full
+// magazines for empty ones. Alloc and free touch only the calling core's own state -- no lock, its
+// cache line local -- and go to the depot once per magazine's worth of objects at worst; the slab
+// layer's lock is taken only when the depot can neither supply nor absorb a magazine, and then for
+// a whole magazine in one hold.
+//
+// Rules the clients (slab_heap, object_arena) rely on:
+// - A core's magazines are touched only by that core, with preemption disabled. Neither client
+//   allocates from interrupt context, so that is all the exclusion they need; other cores read
+//   the counters (relaxed) and never the magazines.
+// - The cache never allocates: magazines come from a fixed pool inside the cache, so the depot is
+//   bounded and a cache costs the same whether or not it is busy.
+// - The owner supplies a refill(void** out, size_t n) -> size_t that takes up to n objects from
+//   its slab layer without fetching pages, and a flush(void** objects, size_t n) that returns
+//   objects to it. Both run with preemption disabled, so neither may block.
+// - The depot lock is a leaf; the owner's slab lock is taken with no cache lock held.
+// - Objects parked in a magazine are free to callers but still allocated to the slab layer, so a
+//   slab with cached objects is not released until drain() flushes them back.
+// - The cache cannot tell a second free of a parked object from a first one. Owners keep a
+//   per-object cached bit in their slab headers, set on free and by refill, cleared on alloc and
+//   flush -- never a mark inside the object, whose bytes are its caller's until the free is checked.
+
+namespace kernel::mm {
+
+struct magazine_stats {
+    uint64_t hits;       // served from the calling core's own two magazines
+    uint64_t misses;     // had to refill from, or flush to, the slab layer
+    uint64_t exchanges;  // traded a magazine with the depot
+    uint64_t allocs;
+    uint64_t frees;
+    size_t cached;  // objects parked in magazines now: free to callers, allocated to the slab layer
+};
+
+class magazine_cache {
+   public:
+    static constexpr size_t ROUNDS          = 14;
+    // Magazines beyond the two per core, circulating through the depot.
+    static constexpr size_t DEPOT_MAGAZINES = 8;
+
+    magazine_cache()                                 = default;
+    magazine_cache(const magazine_cache&)            = delete;
+    magazine_cache& operator=(const magazine_cache&) = delete;
+
+    // A cached object, or a fresh batch from refill; nullptr when the slab layer has nothing on
+    // hand, and the owner takes its slow path (which may fetch a page).
+    template <typename Refill> void* alloc(Refill&& refill) {
+        kernel::synchronization::critical_section critical;
+        core_cache& core = local();
+        bump(core.allocs);
+        void* object = nullptr;
+        if (core.loaded != nullptr && core.loaded->rounds > 0) {
+            bump(core.hits);
+            object = pop(core.loaded);
+        } else if (core.previous != nullptr && core.previous->rounds > 0) {
+            swap(core);
+            bump(core.hits);
+            object = pop(core.loaded);
+        } else if (magazine* full = depot_exchange(m_full, core.previous, m_empty)) {
+            // Both empty: traded the previous magazine to the depot for a full one.
+            core.previous = core.loaded;
+            core.loaded   = full;
+            bump(core.exchanges);
+            object = pop(core.loaded);
+        } else {
+            bump(core.misses);
+            if (core.loaded == nullptr) { core.loaded = depot_exchange(m_empty, nullptr, m_empty); }
+            if (core.loaded == nullptr) { return refill(&object, 1) == 1 ? object : nullptr; }
+            core.loaded->rounds = refill(core.loaded->round, ROUNDS);
+            if (core.loaded->rounds > 0) { object = pop(core.loaded); }
+        }
+        publish(core);
+        return object;
+    }
+
+    // Park `object` on this core. The owner has already validated it and set its cached bit.
+    template <typename Flush> void free(void* object, Flush&& flush) {
+        kernel::synchronization::critical_section critical;
+        core_cache& core = local();
+        catch_up(core, flush);
+        bump(core.frees);
+        if (core.loaded != nullptr && core.loaded->rounds < ROUNDS) {
+            bump(core.hits);
+        } else if (core.previous != nullptr && core.previous->rounds == 0) {
+            swap(core);
+            bump(core.hits);
+        } else if (magazine* empty = depot_exchange(m_empty, core.previous, m_full)) {
+            // Loaded full (or absent) and previous full (or absent): traded previous to the depot
+            // for an empty one. previous is only ever full or empty, so the depot's full list
+            // holds only full magazines.
+            core.previous = core.loaded;
+            core.loaded   = empty;
+            bump(core.exchanges);
+        } else if (core.previous == nullptr) {
+            bump(core.misses);
+            flush(&object, 1);
+            return;
+        } else {
+            // Depot saturated with full magazines: give the previous one's objects back in one batch.
+            bump(core.misses);
+            flush_all(core.previous, flush);
+            swap(core);
+        }
+        push(core.loaded, object);
+        publish(core);
+    }
+
+    // Return cached objects to the slab layer: the calling core's magazines and the depot's now,
+    // every other core's on its next alloc or free. For shape-sensitive accounting (tests) and a
+    // future memory-pressure reaper; concurrent traffic may cache objects again as soon as it
+    // returns.
+    template <typename Flush> void drain(Flush&& flush) {
+        __atomic_fetch_add(&m_generation, 1, __ATOMIC_RELAXED);
+        kernel::synchronization::critical_section critical;
+        catch_up(local(), flush);
+        while (magazine* full = depot_exchange(m_full, nullptr, m_empty)) {
+            flush_all(full, flush);
+            depot_put(m_empty, full);
+        }
+    }
+
+    // Racy against traffic on other cores, as counters are; exact when the cache is quiet.
+    magazine_stats stats() {
+        magazine_stats out{};
+        for (const core_cache& core : m_cores) {
+            out.hits += __atomic_load_n(&core.hits, __ATOMIC_RELAXED);
+            out.misses += __atomic_load_n(&core.misses, __ATOMIC_RELAXED);
+            out.exchanges += __atomic_load_n(&core.exchanges, __ATOMIC_RELAXED);
+            out.allocs += __atomic_load_n(&core.allocs, __ATOMIC_RELAXED);
+            out.frees += __atomic_load_n(&core.frees, __ATOMIC_RELAXED);
+            out.cached += __atomic_load_n(&core.cached, __ATOMIC_RELAXED);
+        }
+        kernel::synchronization::critical_lock_guard guard(m_depot_lock);
+        for (magazine* mag = m_full; mag != nullptr; mag = mag->next) { out.cached += mag->rounds; }
+        return out;
+    }
+
+   private:
+    struct magazine {
+        size_t rounds  = 0;
+        magazine* next = nullptr;
+        void* round[ROUNDS];
+    };
+
+    // Written only by the owning core; counters and `cached` are stored relaxed so stats() on
+    // another core reads whole values.
+    struct alignas(64) core_cache {
+        magazine* loaded    = nullptr;
+        magazine* previous  = nullptr;
+        uint64_t generation = 0;  // the drain generation this core last flushed for
+        uint64_t hits       = 0;
+        uint64_t misses     = 0;
+        uint64_t exchanges  = 0;
+        uint64_t allocs     = 0;
+        uint64_t frees      = 0;
+        size_t cached       = 0;
+    };
+
+    static constexpr size_t POOL = 2 * CONFIG_MAX_CORES + DEPOT_MAGAZINES;
+
+    // Preemption is disabled by the caller, so the index stays ours until the critical section ends.
+    core_cache& local() { return m_cores[kernel::arch::current_core_index()]; }
+
+    static void bump(uint64_t& counter) { __atomic_store_n(&counter, counter + 1, __ATOMIC_RELAXED); }
+    static void publish(core_cache& core) {
+        size_t cached = (core.loaded != nullptr ? core.loaded->rounds : 0) +
+                        (core.previous != nullptr ? core.previous->rounds : 0);
+        __atomic_store_n(&core.cached, cached, __ATOMIC_RELAXED);
+    }
+    static void* pop(magazine* mag) { return mag->round[--mag->rounds]; }
+    static void push(magazine* mag, void* object) { mag->round[mag->rounds++] = object; }
+    static void swap(core_cache& core) {
+        magazine* loaded = core.loaded;
+        core.loaded      = core.previous;
+        core.previous    = loaded;
+    }
+    template <typename Flush> static void flush_all(magazine* mag, Flush& flush) {
+        if (mag == nullptr || mag->rounds == 0) { return; }
+        flush(mag->round, mag->rounds);
+        mag->rounds = 0;
+    }
+
+    // A drain ran since this core last freed: return its own magazines first. Only the free path
+    // checks -- allocation consumes cached objects anyway.
+    template <typename Flush> void catch_up(core_cache& core, Flush& flush) {
+        uint64_t generation = __atomic_load_n(&m_generation, __ATOMIC_RELAXED);
+        if (core.generation == generation) { return; }
+        flush_all(core.loaded, flush);
+        flush_all(core.previous, flush);
+        core.generation = generation;
+        publish(core);
+    }
+
+    // One depot lock hold: take the head of `from` -- the empty list also draws on the never-used
+    // pool -- and, if that succeeded, push `give` (when non-null) onto `to`. With nothing to take,
+    // returns nullptr and the caller keeps `give`.
+    magazine* depot_exchange(magazine*& from, magazine* give, magazine*& to) {
+        kernel::synchronization::critical_lock_guard guard(m_depot_lock);
+        magazine* taken = from;
+        if (taken != nullptr) {
+            from = taken->next;
+        } else if (&from == &m_empty && m_pool_used < POOL) {
+            taken = &m_pool[m_pool_used++];
+        } else {
+            return nullptr;
+        }
+        taken->next = nullptr;
+        if (give != nullptr) {
+            give->next = to;
+            to         = give;
+        }
+        return taken;
+    }
+    void depot_put(magazine*& list, magazine* mag) {
+        kernel::synchronization::critical_lock_guard guard(m_depot_lock);
+        mag->next = list;
+        list      = mag;
+    }
+
+    core_cache m_cores[CONFIG_MAX_CORES];
+    uint64_t m_generation = 0;  // bumped by drain(); see catch_up
+    kernel::synchronization::spinlock m_depot_lock;
+    magazine* m_full      = nullptr;
+    magazine* m_empty     = nullptr;
+    size_t m_pool_used    = 0;  // m_pool[m_pool_used..] have never circulated
+    magazine m_pool[POOL] = {};
+};
+
+}  // namespace kernel::mm
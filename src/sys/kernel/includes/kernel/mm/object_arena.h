@@ -1,5 +1,6 @@
 #pragma once
 
+#include <kernel/mm/magazine.h>
 #include <kernel/synchronization/spinlock.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -17,9 +18,12 @@
 //   leaf, and a free of a pointer the arena does not own -- wrong arena, interior, double, never
 //   allocated -- is a deterministic panic.
 //
+// - Per-core magazines (kernel/mm/magazine.h) in front of the slabs: a freed slot is scrubbed,
+//   then parked on the freeing core, so the common alloc/free pair never takes the arena lock.
+//
 // Arenas register themselves on a global list at construction for introspection (`mem` in the
-// kernel shell). Remaining AUMI phases -- poisoning/redzones, guard-page debug mode, per-CPU
-// magazines -- layer on top of this.
+// kernel shell). Remaining AUMI phases -- poisoning/redzones, guard-page debug mode -- layer on
+// top of this.
 
 namespace kernel::mm {
 
@@ -28,11 +32,15 @@ struct object_arena_stats {
     size_t object_size;
     size_t slot_size;
     size_t slabs;
-    size_t live;
+    size_t live;      // held by callers; excludes slots cached in magazines
     size_t capacity;  // total slots across current slabs
+    size_t cached;
     uint64_t alloc_calls;
     uint64_t free_calls;
     uint64_t failures;
+    uint64_t magazine_hits;
+    uint64_t magazine_misses;
+    uint64_t depot_exchanges;
 };
 
 class object_arena {
@@ -40,8 +48,8 @@ class object_arena {
     // name must be a string literal. object_size must fit a one-page slab after its header;
     // align must be a power of two <= 64 (stricter alignment has no arena client).
     object_arena(const char* name, size_t object_size, size_t align);
-    // Unregisters. Kernel arenas are globals that never die; this exists for test-local arenas,
-    // which would otherwise leave dangling registry entries.
+    // Drains and unregisters. Kernel arenas are globals that never die; this exists for
+    // test-local arenas, which would otherwise leave dangling registry entries.
     ~object_arena();
 
     object_arena(const object_arena&)            = delete;
@@ -51,6 +59,9 @@ class object_arena {
     void* alloc();
     // Scrubs the slot to zero and recycles it. Panics on any pointer this arena does not own.
     void free(void* ptr);
+    // Flush cached slots back to the slabs, as slab_heap::drain does, so empty slabs return
+    // their pages.
+    void drain();
 
     object_arena_stats stats();
 
@@ -62,8 +73,13 @@ class object_arena {
    private:
     struct arena_slab;
 
+    size_t slot_index(arena_slab* slab, void* ptr) const;
+    void* alloc_slab();
     arena_slab* new_slab();
     void* take_slot(arena_slab* slab);
+    size_t take_batch(void** out, size_t count);
+    bool release_slot(void* ptr);
+    void release_batch(void** objects, size_t count);
     void unlink_partial(arena_slab* slab);
 
     const char* m_name;
@@ -75,16 +91,18 @@ class object_arena {
     arena_slab* m_partial  = nullptr;  // slabs with at least one free slot, doubly linked
     size_t m_slab_count    = 0;
     size_t m_live          = 0;
-    uint64_t m_alloc_calls = 0;
-    uint64_t m_free_calls  = 0;
     uint64_t m_failures    = 0;
     object_arena* m_next   = nullptr;
     kernel::synchronization::spinlock m_lock;
+    magazine_cache m_magazines;
 };
 
 // The client arenas. Defined in object_arena.cpp beside the class so the host test runner links
 // the operator new/delete each client type declares, whether or not the client's own translation
 // unit is host-built.
 extern object_arena g_thread_arena;
+// Per-thread FP/SIMD save areas (arch::FPU_AREA_SIZE), taken on a user thread's first FP
+// instruction rather than embedded in every Thread.
+extern object_arena g_fpu_arena;
 
 }  // namespace kernel::mm
@@ -29,6 +29,7 @@ struct page_descriptor {
     uint64_t offset;       // page offset within the owner
     uint32_t share_count;  // CoW sharers; 0 while unowned or exclusively owned
     page_state state;
+    uint8_t free_order;  // buddy order + 1 while this frame heads a free PMM block; 0 otherwise
 };
 static_assert(sizeof(page_descriptor) <= 32, "page descriptors are per-frame; keep them small");
 
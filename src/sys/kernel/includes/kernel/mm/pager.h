@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <ktl/result>
@@ -29,12 +30,22 @@ class pager {
 
     // Cache mode for mappings of this pager's frames.
     virtual vm_cache_mode cache_mode() const { return vm_cache_mode::CACHED; }
+
+    // Produce `count` physically contiguous frames, naturally aligned to the
+    // run's size, backing [page, page + count) -- a large-page fill. Pagers
+    // without one decline, and the pages fill one at a time.
+    virtual ktl::result<vm_paddr_t> fill_run(uint64_t page, size_t count) {
+        (void)page;
+        (void)count;
+        return ktl::err(ktl::errc::invalid_operation);
+    }
 };
 
 // Zero-fill anonymous memory: fill hands out zeroed PMM frames. Stateless.
 class anonymous_pager : public pager {
    public:
     ktl::result<vm_paddr_t> fill(uint64_t page) override;
+    ktl::result<vm_paddr_t> fill_run(uint64_t page, size_t count) override;
     bool owns_frames() const override { return true; }
 };
 
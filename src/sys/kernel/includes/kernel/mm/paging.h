@@ -29,12 +29,19 @@ enum class vm_cache_mode : uint8_t {
     WRITE_COMBINING,
 };
 
+// Large leaf sizes. A 2 MiB leaf stands in for one leaf table, a 1 GiB leaf for
+// a table of those; both are naturally aligned, virtually and physically.
+constexpr size_t LARGE_PAGE_2M = size_t{1} << 21;
+constexpr size_t LARGE_PAGE_1G = size_t{1} << 30;
+
 // Result of a permission-carrying walk: the physical address a virtual address
-// resolves to plus the arch-neutral attributes the mapping was installed with.
+// resolves to plus the arch-neutral attributes the mapping was installed with,
+// and the size of the leaf that maps it (4 KiB or a large page).
 struct vm_translation {
     vm_paddr_t paddr;
     vm_prot_t prot;
     vm_cache_mode cache;
+    size_t size;
 };
 
 }  // namespace kernel::mm
@@ -6,44 +6,76 @@
 #include <ktl/maybe>
 #include <ktl/vector>
 
+#include "kernel/config.h"
+#include "kernel/mm/buddy.h"
 #include "kernel/mm/page.h"
 #include "kernel/synchronization/spinlock.h"
 
 namespace kernel::mm {
 
-// Consistent point-in-time view of the allocator, taken under its lock.
+// Point-in-time view of the allocator. The global pools are read under its lock; the per-core
+// cache figures are summed from relaxed counters, so they are exact only when the caches are quiet.
 struct pmm_stats {
     size_t total_pages;
     size_t free_pages;
     size_t reserved_pages;
-    size_t zeroed_pooled;
+    size_t zeroed_pooled;  // recycled (buddy) pages known zero
     size_t zeroed_region_tail;
+    size_t zeroed_cached;  // per-core cache pages known zero
     size_t dirty;
+    size_t cached;            // free pages parked in per-core caches, zeroed or not
+    size_t largest_free_run;  // pages: the longest run alloc_contiguous could serve now
     uint64_t alloc_count;
     uint64_t free_count;
     uint64_t alloc_failures;
+    uint64_t cache_hits;     // single-page allocs and frees served by the calling core's cache alone
+    uint64_t cache_refills;  // batches a core's cache took from the global pools
+    uint64_t cache_drains;   // batches a core's cache gave back to them
 };
 
+// Free memory lives in two places. Region tails are memory never handed out since boot, carved
+// from the top down and pre-zeroed in place. Everything that has been allocated and freed again
+// goes to a binary buddy allocator (kernel/mm/buddy.h) keyed on the page descriptors, where freed
+// neighbours coalesce back into runs of up to 4 MiB -- so contiguous capacity
+// returns with the memory instead of wearing away. Frames freed before the descriptor table
+// covered them wait on a plain stack until the zeroer moves them into the buddy.
+//
+// Single pages go through a small per-core cache in front of all that: a cold list of zeroed
+// pages and a hot list of pages freed on this core (dirty, but likely still in its cache, so the
+// memset on the way out is cheap). alloc and free touch only the calling core's lists, with
+// interrupts off and no lock, and take the global lock once per batch to refill or drain. Cached
+// pages keep their FREE/ZEROED descriptor state, so double frees are still caught, and the zeroer
+// turns the running core's hot pages cold before it touches the global pools. Runs always go to
+// the global pools; a run request they cannot serve flushes the caches and tries once more.
 class page_frame_allocator {
    public:
     ktl::maybe<vm_paddr_t> alloc();
     void free(vm_paddr_t addr);
-    // Carve a physically contiguous, zeroed run of pages from an untouched
-    // region tail. No free_contiguous: boot-lifetime callers (the page
-    // descriptor array) never free, and the heap's multi-page runs return
-    // through free() page by page, at the documented tail-depletion cost.
-    ktl::maybe<vm_paddr_t> alloc_contiguous(size_t count);
-    // Zero one free page; false when there is nothing left to do. Dirty pages
-    // always drain into the zeroed pool; region tail pages are zeroed in place
-    // (tracked by a per-region count, not pool entries) until all free memory
-    // is zeroed. The zeroer thread's work loop; safe to race with alloc/free.
+    // A physically contiguous, zeroed run of pages: a recycled buddy block when one is large
+    // enough, else carved from an untouched region tail. Either way it goes back through
+    // free_contiguous (or free() page by page) and coalesces. `align` (pages, a power of two)
+    // asks for a naturally aligned run, as a large-page mapping needs; a region tail carved for
+    // one gives the pages above the run to the buddy.
+    ktl::maybe<vm_paddr_t> alloc_contiguous(size_t count, size_t align = 1);
+    void free_contiguous(vm_paddr_t base, size_t count);
+    // Zero one free page; false when there is nothing left to do. The calling core's hot pages
+    // and dirty buddy blocks are always zeroed; region tail pages are zeroed in place (tracked by
+    // a per-region count) until all free memory is zeroed. The zeroer thread's work loop; safe to
+    // race with alloc/free.
     bool zero_one_page();
 
     pmm_stats stats();
 
-    size_t free_pages() const { return m_free_pages; }
-    // Total pages ready to serve without a memset: pooled plus region tails.
-    size_t zeroed_pages() const { return m_zeroed.size() + m_region_zeroed; }
+    // Free pages anywhere, per-core caches included; racy against other cores' traffic.
+    size_t free_pages() const;
+    // Total pages ready to serve without a memset: recycled, region tails and cold cached pages.
+    size_t zeroed_pages() const;
+    // The longest run alloc_contiguous could serve right now, in pages. Flushes the per-core
+    // caches first, as alloc_contiguous does before it gives up.
+    size_t largest_free_run();
+    // Return the calling core's cached pages to the global pools now and every other core's at
+    // its next single-page alloc or free, so the buddy can coalesce them into runs.
+    void flush_caches();
 
     void add_region(const vm_page_region& region) {
         if (!m_regions.push_back(region)) { return; }  // drop region on OOM rather than corrupt page accounting
@@ -56,26 +88,33 @@ class page_frame_allocator {
         m_total_pages += pages;
     }
 
+    // Pages moved per refill or drain, and the most a core's lists hold before spilling back.
+    static constexpr size_t CACHE_BATCH    = 16;
+    static constexpr size_t CACHE_HOT_MAX  = 64;
+    static constexpr size_t CACHE_COLD_MAX = 64;
+
    private:
-    // Guards the pools and counters: the zeroer thread mutates m_dirty/m_zeroed
-    // concurrently with allocating threads.
-    kernel::synchronization::spinlock m_lock;
+    // Guards the global pools and counters: the zeroer thread mutates them concurrently with
+    // allocating threads. The per-core caches are not under it.
+    kernel::synchronization::spinlock m_lock{"pmm"};
 
     size_t m_total_pages      = 0;
-    size_t m_free_pages       = 0;
+    size_t m_free_pages       = 0;  // in the global pools; per-core caches hold the rest
     size_t m_reserved_pages   = 0;
     size_t m_region_zeroed    = 0;  // sum of all regions' zeroed_count
-
-    uint64_t m_alloc_count    = 0;
-    uint64_t m_free_count     = 0;
-    uint64_t m_alloc_failures = 0;
-
-    // The page pools are intrusive: each free frame's first word holds the next frame's address,
-    // written and read through the physmap, so the pools own no storage and pushing can never
-    // fail or allocate. That last property is load-bearing -- the PMM sits below the heap, and a
-    // pool that grew through operator new would re-enter the PMM inside its own lock (the exact
-    // deadlock the slab-heap switchover exposed). pop() re-zeroes the link word on the way out,
-    // which is what keeps the zeroed pool's all-zero guarantee intact.
+    size_t m_buddy_zeroed     = 0;  // buddy pages whose descriptor says ZEROED
+
+    uint64_t m_alloc_count      = 0;  // pages handed out by alloc_contiguous; single allocs count per core
+    uint64_t m_free_count       = 0;  // pages returned through free_contiguous; single frees count per core
+    uint64_t m_alloc_failures   = 0;
+    uint64_t m_flush_generation = 0;  // bumped by flush_caches; see catch_up
+
+    // The page pools are intrusive: each free frame's (or free block's first frame's) leading
+    // words hold the list links, written and read through the physmap, so the pools own no storage
+    // and pushing can never fail or allocate. That last property is load-bearing -- the PMM sits
+    // below the heap, and a pool that grew through operator new would re-enter the PMM inside its
+    // own lock (the exact deadlock the slab-heap switchover exposed). Removal re-zeroes the link
+    // words on the way out, which is what keeps a zeroed page's all-zero guarantee intact.
     class frame_stack {
        public:
         void push(vm_paddr_t addr);
@@ -89,13 +128,48 @@ class page_frame_allocator {
         size_t m_count                  = 0;
     };
 
-    frame_stack m_zeroed;
-    frame_stack m_dirty;
+    // The buddy's per-frame storage: order tags in the page descriptors, links in the free frames.
+    struct descriptor_frames {
+        uint8_t order_tag(uint64_t frame);
+        void set_order_tag(uint64_t frame, uint8_t tag);
+        buddy_link& link(uint64_t frame);
+        bool zeroed(uint64_t frame);
+    };
+
+    // Touched only by its own core with interrupts off; the published sizes and counters are
+    // stored relaxed so stats() on another core reads whole values.
+    struct alignas(64) core_cache {
+        frame_stack cold;  // ZEROED pages
+        frame_stack hot;   // FREE pages freed on this core, zeroed when handed out
+        size_t cold_pages   = 0;
+        size_t hot_pages    = 0;
+        uint64_t allocs     = 0;
+        uint64_t frees      = 0;
+        uint64_t hits       = 0;
+        uint64_t refills    = 0;
+        uint64_t drains     = 0;
+        uint64_t generation = 0;  // the flush_caches generation this core last caught up with
+    };
+
+    buddy_allocator<descriptor_frames> m_buddy;
+    frame_stack m_uncovered;  // dirty frames freed with no page descriptor to key the buddy on
     ktl::vector<vm_page_region> m_regions;
+    core_cache m_cores[CONFIG_MAX_CORES];
 
     // Sets pre_zeroed when the popped page needs no memset (a pre-zeroed
     // region tail page).
     ktl::maybe<vm_paddr_t> pop_free_page(bool& pre_zeroed);
+    // The highest `align`-aligned run of the first region tail long enough, marked ACTIVE;
+    // need_zero counts its low pages that were not pre-zeroed.
+    ktl::maybe<vm_paddr_t> carve_region_tail(size_t count, size_t align, size_t& need_zero);
+    size_t longest_run() const;
+    // Move up to CACHE_BATCH pages from the global pools into the core's lists, zeroed ones
+    // cold; false when the pools are empty. drain_hot hands CACHE_BATCH hot pages back.
+    bool refill(core_cache& core);
+    void drain_hot(core_cache& core);
+    // Hand every cached page back if flush_caches ran since this core last checked.
+    void catch_up(core_cache& core);
+    ktl::maybe<vm_paddr_t> take_run(size_t count, size_t align, uint64_t* dirty, bool& recycled, size_t& need_zero);
     void zero_page(vm_paddr_t addr);
 };
 
@@ -10,6 +10,7 @@
 #include <ktl/ref>
 #include <ktl/result>
 
+#include "kernel/config.h"
 #include "kernel/mm/paging.h"
 
 namespace kernel::mm {
@@ -18,6 +19,12 @@ class vmo;
 class vm_aspace;
 class Region;
 
+// Largest fault-around window a binding may ask for, in pages.
+constexpr size_t FAULT_AROUND_MAX_PAGES = 64;
+static_assert(CONFIG_VM_FAULT_AROUND_PAGES >= 1 && CONFIG_VM_FAULT_AROUND_PAGES <= FAULT_AROUND_MAX_PAGES &&
+                  (CONFIG_VM_FAULT_AROUND_PAGES & (CONFIG_VM_FAULT_AROUND_PAGES - 1)) == 0,
+              "fault-around window must be a power of two within FAULT_AROUND_MAX_PAGES");
+
 // One slot in a region's child tree: either a sub-region or a VMO binding.
 // Slots are heap-allocated, owned by the parent region, and keyed by base;
 // siblings never overlap.
@@ -31,6 +38,7 @@ struct region_child {
     uint64_t vmo_offset = 0;
     vm_prot_t prot      = vm_prot::NONE;  // binding protection
     vm_cache_mode cache = vm_cache_mode::CACHED;
+    size_t fault_around = CONFIG_VM_FAULT_AROUND_PAGES;  // aligned window a fault maps, in pages
 
     bool is_binding() const { return child.get() == nullptr; }
 };
@@ -83,8 +91,13 @@ class Region : public obj::Object {
     // consumer needs partial unmaps.
     ktl::result<void> unmap(uintptr_t base, size_t size);
 
+    // Set the fault-around window of the binding containing vaddr (descending
+    // through sub-regions): a power of two up to FAULT_AROUND_MAX_PAGES, 1 to
+    // map only the faulting page.
+    ktl::result<void> set_fault_around(uintptr_t vaddr, size_t pages);
+
     // Deepest binding slot containing vaddr, descending through sub-regions.
-    // Pointer is valid only under the VMM lock.
+    // Pointer is valid only under the aspace lock.
     region_child* find_binding(uintptr_t vaddr);
 
     static ktl::result<void> register_type(obj::TypeRegistry& registry) {
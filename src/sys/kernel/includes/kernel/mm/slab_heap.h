@@ -1,6 +1,7 @@
 #pragma once
 
 #include <kernel/config.h>
+#include <kernel/mm/magazine.h>
 #include <kernel/synchronization/spinlock.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -17,6 +18,8 @@
 //   mapped region later.
 // - Interrupt context never allocates or frees. Asserted on every call. Drivers preallocate at
 //   bind time; this rule is what keeps the heap free of reserved-pool machinery.
+// - Slab-class traffic goes through per-core magazines (kernel/mm/magazine.h) first, so the heap
+//   lock is taken once per magazine's worth of objects rather than on every call.
 
 namespace kernel::mm {
 
@@ -44,8 +47,12 @@ size_t heap_pages_take_run(uintptr_t base);
 struct slab_class_stats {
     size_t object_size;
     size_t slabs;
-    size_t live_objects;
-    size_t free_slots;
+    size_t live_objects;  // held by callers; excludes objects cached in magazines
+    size_t free_slots;    // includes cached objects, which are free to any caller
+    size_t cached;
+    uint64_t magazine_hits;
+    uint64_t magazine_misses;
+    uint64_t depot_exchanges;
 };
 
 struct slab_heap_stats {
@@ -70,6 +77,11 @@ class slab_heap {
     void* alloc(size_t size, size_t align = sizeof(void*));
     void free(void* ptr);
 
+    // Flush this core's magazines and the depot back to the slabs (other cores follow on their
+    // next free), so empty slabs past the spare return to the page source. Accounting that needs
+    // exact slab shapes calls this first.
+    void drain();
+
     slab_heap_stats stats();
 
    private:
@@ -78,11 +90,16 @@ class slab_heap {
     struct class_state {
         slab_page* partial = nullptr;  // slabs with at least one free slot, doubly linked
         size_t slab_count  = 0;
-        size_t live        = 0;
+        size_t live        = 0;  // slab-layer view: counts objects cached in magazines
+        magazine_cache magazines;
     };
 
+    void* alloc_slab(size_t index);
     void* alloc_large(size_t size);
     void* take_slot(class_state& cls, slab_page* slab, size_t class_size);
+    size_t take_batch(size_t index, void** out, size_t count);
+    uintptr_t release_slot(uintptr_t address);
+    void release_batch(void** objects, size_t count);
     slab_page* new_slab(size_t class_index);
     void unlink_partial(class_state& cls, slab_page* slab);
 
@@ -92,7 +109,7 @@ class slab_heap {
     uint64_t m_alloc_calls = 0;
     uint64_t m_free_calls  = 0;
     uint64_t m_failures    = 0;
-    // ponytail: one lock for the whole heap; split per class when SMP contention is measurable.
+    // One lock for the slab layer; the per-core magazines in front keep it off the common path.
     kernel::synchronization::spinlock m_lock;
 };
 
@@ -14,14 +14,19 @@
 
 namespace kernel::mm {
 
-// The one VMM lock. Guards all mutable VMM state -- region trees, VMO
-// residency, page descriptors, mapping back-refs -- including the fault
-// handler path. Take it with kernel::synchronization::lock_guard (irq-safe).
-// Rule: VMM code never touches faultable memory while holding this lock; all
+// VMM locking is per object, so faults in different address spaces never
+// serialize on each other:
+// - vm_aspace::lock() guards the space's region tree (every Region in it),
+//   its page tables and its fault counters, and is held across the whole fault
+//   path, pager fill included.
+// - Each vmo's own lock guards its residency index, its mapping back-refs and
+//   the owner fields of its frames' page descriptors.
+// Order: aspace lock, then vmo lock, then the allocators (PMM, heap), which
+// are leaves. Never two aspace locks, or two vmo locks, at once. Lockdep
+// learns and checks the order per lock instance. Take both with
+// critical_irq_lock_guard.
+// Rule: VMM code never touches faultable memory while holding either; all
 // VMM structures live in HHDM-mapped PMM frames, which are always resident.
-// Single global lock; split per-aspace/per-VMO when scheduler-era
-// contention is measured.
-extern kernel::synchronization::spinlock g_vmm_lock;
 
 // An address space: one class, completed by each architecture. The portable
 // half (region tree, fault accounting, lifecycle) is implemented in
@@ -50,20 +55,45 @@ class vm_aspace {
     Region& root() { return *m_root; }
     bool has_root() const { return m_root.get() != nullptr; }
 
-    // Fault accounting, bumped by the fault handler.
+    // See the locking notes above.
+    kernel::synchronization::spinlock& lock() { return m_lock; }
+
+    // Fault accounting, bumped by the fault handler under lock(). A fault
+    // avoided is a page fault-around installed ahead of its first access.
     void count_fault() { ++m_faults; }
+    void count_faults_avoided(size_t pages) { m_faults_avoided += pages; }
     uint64_t fault_count() const { return m_faults; }
+    uint64_t faults_avoided() const { return m_faults_avoided; }
 
     // ---- arch-completed half (x86_64/paging.cpp) ----
 
     bool is_valid() const;
     // Install a 4K translation with the given protection and cache mode.
     bool map_page(uintptr_t vaddr, vm_paddr_t paddr, vm_prot_t prot, vm_cache_mode cache = vm_cache_mode::CACHED);
+    // Batched install over consecutive pages from vaddr: paddrs[i] goes to
+    // vaddr + i pages, skipping zero entries and slots already present. One
+    // table walk per leaf table and one remote shootdown for the batch. Stops
+    // at the first table allocation failure; returns the pages installed.
+    size_t map_pages(uintptr_t vaddr, const vm_paddr_t* paddrs, size_t count, vm_prot_t prot, vm_cache_mode cache);
+    // Install one large leaf (LARGE_PAGE_2M, or LARGE_PAGE_1G where the MMU
+    // has it) mapping [vaddr, vaddr + size); both addresses naturally aligned.
+    // Fails if anything, even an empty table, already sits in the span.
+    bool map_large(uintptr_t vaddr, vm_paddr_t paddr, size_t size, vm_prot_t prot,
+                   vm_cache_mode cache = vm_cache_mode::CACHED);
+    // Whether map_large(vaddr, ..., size) would find the span free.
+    bool span_empty(uintptr_t vaddr, size_t size) const;
+    static bool large_page_supported(size_t size);
     // Resolve a virtual address to its physical address (offset preserved).
     ktl::maybe<vm_paddr_t> walk(uintptr_t vaddr) const;
-    // Resolve and report the mapping's protection and cache mode as well.
+    // Resolve and report the mapping's protection, cache mode and leaf size.
     ktl::maybe<vm_translation> walk_ext(uintptr_t vaddr) const;
+    // Remove the leaf at vaddr -- a whole large leaf when vaddr is its base --
+    // and return the physical address it mapped.
     ktl::maybe<vm_paddr_t> unmap_page(uintptr_t vaddr);
+    // Batched removal over count pages from vaddr: every 4K leaf in the span
+    // and every large leaf whose base is in it, with one remote shootdown for
+    // the batch. Returns the leaves removed.
+    size_t unmap_pages(uintptr_t vaddr, size_t count);
 
     // Load this space's page tables into the CPU and record it as the active
     // space. Single-CPU scoped; cross-CPU shootdown is out of scope.
@@ -87,10 +117,17 @@ class vm_aspace {
     bool arch_init();
     bool arch_init_kernel();
     void arch_destroy();
+    // Collapse the kernel-half tables over [base, base + size) into large
+    // leaves wherever a table maps one contiguous, uniformly attributed span.
+    // Runs once at vmm_init on the fresh kernel tables, before they go live
+    // or are shared. Returns the table frames freed.
+    size_t promote_kernel_range(uintptr_t base, size_t size);
 
     arch_aspace m_arch;  // shape differs per architecture
+    kernel::synchronization::spinlock m_lock;
     ktl::ref<Region> m_root;
-    uint64_t m_faults = 0;
+    uint64_t m_faults         = 0;
+    uint64_t m_faults_avoided = 0;
 };
 
 // The global kernel address space, valid after vmm_init(). It owns its page
@@ -13,6 +13,7 @@
 
 #include "kernel/mm/page.h"
 #include "kernel/mm/pager.h"
+#include "kernel/synchronization/spinlock.h"
 
 namespace kernel::mm {
 
@@ -22,6 +23,9 @@ struct region_child;
 // Virtual memory object: a page-granular container of memory whose
 // pages materialize through a pager. Residency truth lives here (chunked
 // frame index) and in the page descriptors -- never in PTE software bits.
+// Residency lookups, fills and back-ref updates take the VMO's own lock;
+// callers may hold their aspace's lock (see vm_aspace.h for the order) but
+// never another VMO's.
 class vmo : public obj::Object {
    public:
     DECLARE_OBJECT_TYPE(vmo, obj::type_ids::VMO)
@@ -37,17 +41,40 @@ class vmo : public obj::Object {
     // Frame backing the given page, if resident.
     ktl::maybe<vm_paddr_t> resident_frame(uint64_t page) const;
 
+    // Fault-around's batched lookup: out[i] gets the frame backing page
+    // first + i, or 0 when absent, all under one lock hold. Translation-only
+    // pagers are filled on the way, since their fill costs no frame;
+    // PMM-owned pages are never filled here. Returns the frames found.
+    size_t gather_frames(uint64_t first, size_t count, vm_paddr_t* out);
+
     // Resolve a page to its backing frame, filling through the pager if
-    // absent. The fault path's core; caller holds the VMM lock.
+    // absent. The fault path's core; the fill runs under this VMO's lock
+    // only, so it stalls no other VMO's faults.
     ktl::result<vm_paddr_t> get_or_fill_page(uint64_t page);
 
+    // Resolve [first, first + count) to one physically contiguous run
+    // aligned to its size, for a large-page mapping. An unpopulated run of a
+    // PMM-backed VMO fills with one aligned allocation; a translation-only
+    // pager fills page by page and qualifies when its window lines up. A
+    // partly populated or scattered run is an error: map it 4K instead.
+    ktl::result<vm_paddr_t> get_or_fill_run(uint64_t first, size_t count);
+
     // Eager population without faulting. Range is [page, page+count).
     ktl::result<void> commit(uint64_t page, size_t count);
 
-    // Mapping back-refs, maintained by Region::map/unmap under the VMM lock.
-    // They record every translation of a page so eviction and writeback can
-    // find them when those land; today only the destructor's no-mappings
-    // assert consumes them. A back-ref that failed to record is a translation
+    // Move the frames of [first, first + count) into a fresh anonymous VMO of
+    // count pages, leaving the range absent here (it reads back zero). The
+    // bulk-transfer path: the new VMO travels as a handle and the receiver
+    // maps the sender's frames, so a payload costs PTE updates, not copies.
+    // The mapping back-refs find every translation of a moved frame to zap;
+    // all of them must live in `aspace`, whose lock this takes ahead of the
+    // VMO's, and a large leaf must lie wholly inside the range. Only
+    // pager-owned frames move.
+    ktl::result<ktl::ref<vmo>> detach_pages(vm_aspace& aspace, uint64_t first, size_t count);
+
+    // Mapping back-refs, maintained by Region::map/unmap under the aspace lock.
+    // They record every translation of a page so detach_pages, and eviction
+    // and writeback when those land, can find them. A back-ref that failed to record is a translation
     // those walks cannot see, so the caller must undo the binding rather than
     // keep an untracked one.
     [[nodiscard]] bool add_mapping(vm_aspace& aspace, region_child& binding);
@@ -70,9 +97,12 @@ class vmo : public obj::Object {
     // touch. The pointer vector itself is heap-backed and sized to the VMO.
     static constexpr size_t CHUNK_ENTRIES = 512;
 
+    // All three expect m_lock held.
     uint64_t* chunk_for(uint64_t page, bool allocate);
     ktl::result<void> fill_page(uint64_t page);
+    ktl::maybe<vm_paddr_t> lookup(uint64_t page) const;
 
+    mutable kernel::synchronization::spinlock m_lock;
     size_t m_pages;
     ktl::ref<pager> m_pager;
     ktl::vector<uint64_t*> m_chunks;
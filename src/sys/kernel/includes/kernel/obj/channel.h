@@ -13,6 +13,7 @@
 namespace kernel::obj {
 
 struct channel_state;
+struct message_handles;
 class Channel;
 
 // Message pages: Allocates from PMM, a message is at most MAX_MESSAGE_BYTES (1 page) via physmap.
@@ -20,82 +21,86 @@ class Channel;
 uintptr_t channel_page_alloc();
 void channel_page_free(uintptr_t page);
 
-// A message. A single physical page containing up to MAX_MESSAGE_BYTES.
-// Move only (Page returns to PMM on destruction). A 0 length message does not contain a page.
-// Can carry handles in transit -- each slot names an entry in the kernel's handle table.
-// A destroyed message can close handles in the kernel table (channel dead, failed send).
+// A message of up to MAX_MESSAGE_BYTES. Storage is sized to the payload: a payload up to
+// MAX_SMALL_BYTES takes a slot from the smallest size-class arena (64/256/1024 B) that fits, and
+// only a larger one takes a physical page. The length picks the class, so it is fixed at create().
+// Move only (storage returns to its arena or the PMM on destruction). A 0 length message holds no
+// storage. Can carry handles in transit -- each slot holds the object reference and rights the
+// sender's table gave up, so no table owns a handle between send and recv. The slots are a block
+// of their own, taken from an arena on the first attach, so a message without handles pays one
+// pointer for them. A destroyed message drops what it carries (channel dead, failed send).
 class MessageBuffer {
    public:
-    static constexpr size_t MAX_HANDLES = static_cast<size_t>(::abi::syscall::CHANNEL_MAX_MESSAGE_HANDLES);
+    static constexpr size_t MAX_HANDLES     = static_cast<size_t>(::abi::syscall::CHANNEL_MAX_MESSAGE_HANDLES);
+    static constexpr size_t MAX_SMALL_BYTES = 1024;
 
     MessageBuffer()                     = default;
     ~MessageBuffer() { reset(); }
 
-    MessageBuffer(MessageBuffer&& other) noexcept : m_page(other.m_page), m_length(other.m_length) {
-        other.m_page   = 0;
-        other.m_length = 0;
-        adopt_handles(other);
+    MessageBuffer(MessageBuffer&& other) noexcept
+        : m_page(other.m_page),
+          m_length(other.m_length),
+          m_handles(other.m_handles),
+          m_handle_count(other.m_handle_count) {
+        other.m_page         = 0;
+        other.m_length       = 0;
+        other.m_handles      = nullptr;
+        other.m_handle_count = 0;
     }
     MessageBuffer& operator=(MessageBuffer&& other) noexcept {
         if (this != &other) {
             reset();
-            m_page         = other.m_page;
-            m_length       = other.m_length;
-            other.m_page   = 0;
-            other.m_length = 0;
-            adopt_handles(other);
+            m_page               = other.m_page;
+            m_length             = other.m_length;
+            m_handles            = other.m_handles;
+            m_handle_count       = other.m_handle_count;
+            other.m_page         = 0;
+            other.m_length       = 0;
+            other.m_handles      = nullptr;
+            other.m_handle_count = 0;
         }
         return *this;
     }
     MessageBuffer(const MessageBuffer&)            = delete;
     MessageBuffer& operator=(const MessageBuffer&) = delete;
 
-    // errc::out_of_range past MAX_MESSAGE_BYTES, errc::oom when the PMM has no page.
+    // errc::out_of_range past MAX_MESSAGE_BYTES, errc::oom when the arena or the PMM is exhausted.
+    // Storage starts zeroed either way. Allocates, so thread context only.
     static ktl::result<MessageBuffer> create(size_t length);
 
     uint8_t* data() { return reinterpret_cast<uint8_t*>(m_page); }
     const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(m_page); }
     size_t size() const { return m_length; }
 
-    // Attach an escrowed kernel-table handle; false once every slot is occupied.
-    bool attach_handle(HandleId id) {
-        if (m_handle_count == MAX_HANDLES) { return false; }
-        m_handles[m_handle_count++] = id;
-        return true;
-    }
+    // Allocate the slot block ahead of the first attach_handle, so a sender can fail on OOM before
+    // it takes anything out of its table. False when the block cannot be allocated.
+    bool reserve_handles();
+    // Attach a handle in transit -- typically what HandleTable::take handed back. False once every
+    // slot is occupied or when the slot block cannot be allocated; `handle` is dropped either way.
+    bool attach_handle(VerifiedHandle handle);
     size_t handle_count() const { return m_handle_count; }
-    // Hand every escrowed handle to the caller, who becomes responsible for moving each out of
-    // the kernel table (or closing it there). Returns the count copied into `out`.
-    size_t detach_handles(HandleId (&out)[MAX_HANDLES]) {
-        size_t count = m_handle_count;
-        for (size_t i = 0; i < count; i++) { out[i] = m_handles[i]; }
-        m_handle_count = 0;
-        return count;
-    }
+    // Move every carried handle to the caller, who becomes responsible for inserting each into a
+    // table (or dropping it). Returns the count moved into `out`.
+    size_t detach_handles(VerifiedHandle (&out)[MAX_HANDLES]);
 
    private:
     friend class Channel;
 
     bool carries_endpoint_from_pair(const Channel& channel) const;
 
-    void adopt_handles(MessageBuffer& other) {
-        m_handle_count = other.m_handle_count;
-        for (size_t i = 0; i < m_handle_count; i++) { m_handles[i] = other.m_handles[i]; }
-        other.m_handle_count = 0;
-    }
-
     void reset() {
-        if (m_page != 0) { channel_page_free(m_page); }
+        if (m_page != 0) { release_storage(); }  // out of line: the size-class arenas live with the channel
         m_page   = 0;
         m_length = 0;
-        release_handles();  // out of line: closing escrow needs the kernel task
+        if (m_handles != nullptr) { release_handles(); }  // out of line: the slot arena lives with the channel
     }
+    void release_storage();
     void release_handles();
 
-    uintptr_t m_page = 0;
-    size_t m_length  = 0;
-    HandleId m_handles[MAX_HANDLES];
-    size_t m_handle_count = 0;
+    uintptr_t m_page           = 0;  // arena slot or physmap page address, by m_length
+    size_t m_length            = 0;
+    message_handles* m_handles = nullptr;  // allocated by the first attach_handle
+    size_t m_handle_count      = 0;
 };
 
 // One endpoint of a bidirectional, point-to-point message channel (docs/Design/IPC Primitives.md).
@@ -110,10 +115,15 @@ class Channel : public Object {
     DECLARE_OBJECT_TYPE(Channel, type_ids::CHANNEL)
 
     static constexpr size_t MAX_MESSAGE_BYTES    = 4096;
-    static constexpr size_t QUEUE_DEPTH          = 8;
-
-    // Kernel managed signals. READABLE if incoming is non-empty, WRITABLE if incoming is not full, PEER_CLOSED if other
-    // end is destroyed.
+    // Queue depth and byte budget are chosen per pair at create(), the same both ways; these are
+    // the default depth and the limits. The default budget is what the depth can hold.
+    static constexpr size_t QUEUE_DEPTH          = static_cast<size_t>(::abi::syscall::CHANNEL_QUEUE_DEPTH);
+    static constexpr size_t MAX_QUEUE_DEPTH      = static_cast<size_t>(::abi::syscall::CHANNEL_MAX_QUEUE_DEPTH);
+    static constexpr size_t MAX_BYTE_BUDGET      = static_cast<size_t>(::abi::syscall::CHANNEL_MAX_BYTE_BUDGET);
+
+    // Kernel managed signals. READABLE if incoming is non-empty, WRITABLE if the peer's incoming has room, PEER_CLOSED if
+    // other end is destroyed. WRITABLE, once cleared by a full queue or a refused write, reasserts only when the peer has
+    // drained to half its depth and half its budget.
     static constexpr uint32_t SIGNAL_READABLE    = static_cast<uint32_t>(::abi::syscall::CHANNEL_SIGNAL_READABLE);
     static constexpr uint32_t SIGNAL_WRITABLE    = static_cast<uint32_t>(::abi::syscall::CHANNEL_SIGNAL_WRITABLE);
     static constexpr uint32_t SIGNAL_PEER_CLOSED = static_cast<uint32_t>(::abi::syscall::CHANNEL_SIGNAL_PEER_CLOSED);
@@ -126,13 +136,17 @@ class Channel : public Object {
         ktl::ref<Channel> first;
         ktl::ref<Channel> second;
     };
-    static ktl::result<Pair> create();
+    // out_of_range for a depth of 0 or past MAX_QUEUE_DEPTH, or a budget past MAX_BYTE_BUDGET; a
+    // budget of 0 means depth * MAX_MESSAGE_BYTES.
+    static ktl::result<Pair> create(size_t depth = QUEUE_DEPTH, size_t byte_budget = 0);
 
     ~Channel() override;
 
     // Queue `message` on the peer's incoming queue. peer_closed if the opposite endpoint is gone,
-    // capacity_exhausted if the peer's queue is full (wait on WRITABLE and retry). The size cap
-    // is enforced where the message is created, so an in-hand MessageBuffer always fits.
+    // capacity_exhausted if the peer's queue is at its depth or the message would take it past
+    // its byte budget (wait on WRITABLE and retry), oom if the queue's ring could not grow. The
+    // size cap is enforced where the message is created, so an in-hand MessageBuffer always fits
+    // an empty queue.
     ktl::result<void> write(MessageBuffer message);
 
     // Dequeue this endpoint's front message. truncated if it exceeds max_bytes or carries more
@@ -141,6 +155,22 @@ class Channel : public Object {
     // is empty and can never refill.
     ktl::result<MessageBuffer> read(size_t max_bytes, size_t max_handles = MessageBuffer::MAX_HANDLES);
 
+    // The blocking forms, for synchronous request/reply (obj/channel_call.cpp). Each parks the
+    // calling thread and so is thread context only. A deadline of 0 waits forever; otherwise
+    // timed_out once kernel time reaches it, or as soon as the calling thread is killed.
+    //
+    // wait_and_read: read, waiting on READABLE while the queue is empty. Errors as read.
+    ktl::result<MessageBuffer> wait_and_read(size_t max_bytes, size_t max_handles, ktime_t deadline);
+    // call: write `request`, then wait for and read the reply. The write hands the CPU straight to
+    // a server blocked reading the other end (sched::handoff_arm). invalid_operation if a message
+    // is already queued here -- it would be taken for the reply. Errors as write, then as
+    // wait_and_read; a failed write leaves nothing sent.
+    ktl::result<MessageBuffer> call(MessageBuffer request, size_t max_bytes, size_t max_handles, ktime_t deadline);
+    // reply_and_wait: the server half -- write `reply` to the caller, handing it the CPU the same
+    // way, then wait for and read the next request.
+    ktl::result<MessageBuffer> reply_and_wait(MessageBuffer reply, size_t max_bytes, size_t max_handles,
+                                              ktime_t deadline);
+
     // DUPLICATE is deliberately outside the valid mask: an endpoint handle is move-only. Two
     // handles to one endpoint would interleave competing reads and make PEER_CLOSED (which fires
     // on the last handle's close) unreadable as a hangup indicator.
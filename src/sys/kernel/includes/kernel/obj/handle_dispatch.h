@@ -10,9 +10,14 @@ namespace kernel::obj {
 // rights it requires, so an operation cannot be reached without its checks and adding one cannot
 // forget them.
 //
+// Type-defined operations (SYS_OBJ_INVOKE) add a stage between verification and the operation:
+// the transaction program attached to the object's type, if any, may reject or complete the
+// operation there, and only what it dispatches continues (docs/Design/Object Transaction
+// Programs.md).
+//
 // Returns the operation's result, or a negative ktl::errc as a uint64. Unknown numbers return
 // invalid_operation. The table is passed in rather than looked up so the pipeline stays free of
 // scheduler dependencies and hosted tests can drive it directly.
-uint64_t dispatch_handle_op(HandleTable& table, uint64_t nr, uint64_t handle, uint64_t arg);
+uint64_t dispatch_handle_op(HandleTable& table, uint64_t nr, uint64_t handle, uint64_t arg, uint64_t arg2 = 0);
 
 }  // namespace kernel::obj
@@ -5,6 +5,7 @@
 #include <kernel/obj/types.h>
 #include <kernel/synchronization/mutex.h>
 
+#include <ktl/atomic>
 #include <ktl/maybe>
 #include <ktl/ref>
 #include <ktl/result>
@@ -59,6 +60,13 @@ class HandleTable {
 
     // Share an already-existing object into this table.
     ktl::result<HandleId> insert(ktl::ref<Object> object, Rights rights);
+    // Two-phase insert, for a caller whose object only exists after a step it cannot undo.
+    // reserve() checks the rights against the type's contract and takes a slot off the free list,
+    // growing the table if it must -- every way an insert can fail. commit() then publishes the
+    // object, of that type, into the slot and cannot fail; cancel() hands an uncommitted slot back.
+    ktl::result<HandleId> reserve(TypeId type_id, Rights rights);
+    void commit(HandleId reserved, ktl::ref<Object> object, Rights rights);
+    void cancel(HandleId reserved);
     // Close every live handle and rebuild the free list.
     void clear();
 
@@ -70,9 +78,10 @@ class HandleTable {
     ktl::result<VerifiedHandle> take(HandleId id);
 
     // The one verification path every handle operation goes through: slot-and-generation lookup,
-    // then type check, then rights check, under a single lock acquisition. Errors come out in that
-    // order (handle_invalid, wrong_type, rights_violation) so a caller learns the first thing wrong
-    // and nothing more. expected_type type_ids::INVALID means any type.
+    // then type check, then rights check, against one consistent view of the entry. Errors come out
+    // in that order (handle_invalid, wrong_type, rights_violation) so a caller learns the first
+    // thing wrong and nothing more. expected_type type_ids::INVALID means any type. Never takes the
+    // table lock; see the read protocol below.
     ktl::result<VerifiedHandle> verify(HandleId id, Rights required_rights, TypeId expected_type = type_ids::INVALID);
 
     template <typename T> ktl::result<ktl::ref<T>> get(HandleId id, Rights required_rights = 0);
@@ -91,25 +100,80 @@ class HandleTable {
 #endif
 
    private:
+    // Lock-free reads. verify() takes no lock, so every mutation publishes an entry's state and
+    // rights under the entry's own sequence count -- odd while a write is in flight -- and a reader
+    // retries until it sees the same even count on both sides of its loads. What the entry points
+    // at is kept alive by a grace period instead: readers announce themselves in the counter of the
+    // current epoch, and a mutation that unpublishes an entry or replaces the chunk directory flips
+    // the epoch and waits out the old counter before it drops the reference or frees the
+    // directory. Mutations stay serialized under m_lock.
     struct HandleEntry {
-        // `object` marks a live entry and is what lookups read; `strong` holds the table's
-        // reference.
-        ktl::unowned_ref<Object> object;
+        ktl::atomic<uint32_t> sequence = 0;
+        // The slot's generation, with ENTRY_LIVE set while it holds a handle. Generations stop
+        // below bit 31, so liveness and the generation check are one comparison (see names()).
+        ktl::atomic<uint32_t> state = 0;
+        ktl::atomic<Rights> rights  = 0;
+        int32_t next_free           = -1;
+        // The table's reference. Written only while the entry is unpublished and every reader that
+        // saw it live has left, so a reader that validated a live entry may copy it unlocked.
         ktl::ref<Object> strong;
-        Rights rights       = 0;
-        uint32_t generation = 0;
-        int32_t next_free   = -1;
+
+        void publish(uint32_t new_state, Rights new_rights);
+    };
+
+    // One consistent read of an entry's published fields.
+    struct EntryView {
+        uint32_t state;
+        Rights rights;
     };
 
-    ktl::vector<HandleEntry> m_entries;
-    size_t m_count      = 0;
-    int32_t m_free_head = -1;
-    kernel::synchronization::mutex m_lock;
+    // Entries live in fixed-size chunks that never move once allocated, found through a directory
+    // of chunk pointers: growth adds one chunk, and only the directory -- one pointer per chunk --
+    // is ever copied, when it doubles.
+    struct HandleChunk;
+
+    // Brackets a lock-free read; the directory and every reference the entries hold stay alive
+    // until the section ends.
+    class ReadSection {
+       public:
+        explicit ReadSection(HandleTable& table);
+        ~ReadSection();
+        ReadSection(const ReadSection&)            = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+       private:
+        HandleTable& m_table;
+        uint32_t m_epoch;
+    };
 
-    static constexpr size_t GROW_BATCH = 32;
+    // The directory is replaced, never resized in place, and the chunk count is published after
+    // the directory holding those chunks, so a reader that sees a count also sees its chunks.
+    ktl::atomic<HandleChunk**> m_directory = nullptr;
+    ktl::atomic<size_t> m_chunk_count      = 0;
+    ktl::atomic<uint32_t> m_epoch          = 0;
+    ktl::atomic<uint32_t> m_readers[2]     = {0, 0};
+    size_t m_directory_size                = 0;
+    size_t m_count                         = 0;
+    int32_t m_free_head                    = -1;
+    kernel::synchronization::mutex m_lock{"handle_table"};
+
+    static constexpr uint32_t ENTRY_LIVE      = 1u << 31;
+    static constexpr size_t CHUNK_ENTRIES     = 32;
+    static constexpr size_t DIRECTORY_INITIAL = 8;
 
     ktl::result<void> grow();
+    // Wait until every read section that began before the call has ended. Called under m_lock.
+    void synchronize();
+    // The entry at `index`, which must be below the published capacity.
+    HandleEntry& entry_at(size_t index) const;
+    size_t capacity() const;
+    static EntryView read_entry(const HandleEntry& entry);
+    // True if an entry in `state` is live and holds the handle `id`.
+    static bool names(uint32_t state, HandleId id);
     HandleEntry* lookup_entry(HandleId id);
+    static ktl::result<void> check_rights(TypeId type_id, Rights rights);
+    ktl::result<int32_t> pop_free_slot();
+    HandleId publish_slot(int32_t slot, ktl::ref<Object> object, Rights rights);
     ktl::result<HandleId> create_handle(ktl::ref<Object> object, Rights rights);
 };
 
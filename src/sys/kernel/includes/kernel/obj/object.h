@@ -5,6 +5,7 @@
 #include <kernel/time.h>
 
 #include <ktl/atomic>
+#include <ktl/span>
 
 #define DECLARE_OBJECT_TYPE(ClassName, TypeIdValue) static constexpr kernel::obj::TypeId TYPE_ID = TypeIdValue;
 
@@ -25,6 +26,11 @@ class Object {
     void signal_set(uint32_t bits);
     void signal_clear(uint32_t bits);
 
+    /// Inline storage: the bytes the kernel holds for this object when its type declared some
+    /// at registration, at least that many. Transaction programs read and write them; the
+    /// dispatch pipeline serializes those accesses. Types without storage return an empty span.
+    virtual ktl::span<uint8_t> inline_storage() { return {}; }
+
     /// Waiters parked on this object's signals.
     kernel::sched::wait_queue& waiters() { return m_waiters; }
 
@@ -44,9 +50,9 @@ class Object {
     const char* m_name = nullptr;
     ktl::atomic<uint32_t> m_signals{0};
     kernel::sched::wait_queue m_waiters;
-    // Port bindings watching this object's signals (obj/port.cpp), guarded by the port
-    // subsystem's lock. Each binding holds a strong reference to this object, so a non-empty
-    // list means the object cannot be mid-destruction.
+    // Port bindings watching this object's signals (obj/port.cpp), guarded by a binding-list
+    // lock striped by object id. Each binding holds a strong reference to this object, so a
+    // non-empty list means the object cannot be mid-destruction.
     struct port_binding* m_bindings = nullptr;
 
     static ObjectId allocate_id();
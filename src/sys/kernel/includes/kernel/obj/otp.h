@@ -0,0 +1,69 @@
+#pragma once
+
+#include <abi/otp.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ktl/ref>
+#include <ktl/result>
+#include <ktl/vector>
+
+// Object Transaction Programs: the in-kernel engine behind <abi/otp.h>. Validation happens once,
+// in Program::create; run() trusts what it is given and checks nothing per instruction beyond
+// the opcode dispatch itself. Where programs run is the handle dispatch pipeline's business
+// (obj/handle_dispatch.cpp) -- this layer knows nothing of handles, locks, or objects.
+namespace kernel::obj::otp {
+
+using insn = ::abi::otp::insn;
+
+// A validated, immutable program. Only create() makes one, so holding a Program means every
+// check has passed. Shared by ktl::ref between the type registry and running invocations:
+// replacing a type's program never pulls one out from under an execution.
+class Program {
+   public:
+    // Check `count` instructions against the attaching type's declared inline storage and copy
+    // them in. All or nothing, with the first failure reported: a revision newer than this kernel
+    // or a structural fault (unknown opcode, bad register or field, jump past the end, a last
+    // instruction that is not a termination) is invalid_operation; a storage access outside
+    // `storage_bytes` or a metadata field past the end is out_of_range; a program over
+    // ABI_OTP_MAX_INSNS or CONFIG_OTP_MAX_COST is capacity_exhausted.
+    static ktl::result<ktl::ref<Program>> create(const insn* code, size_t count, uint32_t version,
+                                                 size_t storage_bytes);
+
+    const insn* code() const { return m_code.data(); }
+    size_t length() const { return m_code.size(); }
+    // Worst-case cost: the sum over every instruction, since no path runs one twice.
+    uint32_t cost() const { return m_cost; }
+    // One past the highest inline-storage byte any instruction reaches; 0 when none does.
+    size_t storage_extent() const { return m_storage_extent; }
+    bool writes_storage() const { return m_writes_storage; }
+
+   private:
+    ktl::vector<insn> m_code;
+    uint32_t m_cost         = 0;
+    size_t m_storage_extent = 0;
+    bool m_writes_storage   = false;
+};
+
+enum class outcome : uint8_t { REJECT, COMPLETE, DISPATCH };
+
+// One execution's inputs and side effects. `storage` covers at least the program's
+// storage_extent() bytes and is written in place; signal changes only accumulate here. Either
+// takes effect only if the caller acts on a COMPLETE.
+struct context {
+    uint64_t meta[::abi::otp::META_COUNT];
+    uint8_t* storage         = nullptr;
+    uint32_t signals_set     = 0;
+    uint32_t signals_cleared = 0;
+};
+
+// The outcome plus its value: the error for REJECT (already negative, ready to return), the
+// completed value for COMPLETE, unused for DISPATCH.
+struct verdict {
+    outcome kind;
+    uint64_t value;
+};
+
+verdict run(const Program& program, context& ctx);
+
+}  // namespace kernel::obj::otp
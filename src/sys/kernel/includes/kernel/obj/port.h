@@ -4,6 +4,7 @@
 #include <kernel/obj/object.h>
 #include <kernel/obj/type_registry.h>
 #include <kernel/obj/types.h>
+#include <kernel/synchronization/spinlock.h>
 
 #include <ktl/ref>
 #include <ktl/result>
@@ -22,12 +23,13 @@ struct port_binding {
     uint64_t key             = 0;
     uint32_t mask            = 0;
     bool pending             = false;  // queued on the port's ready list
+    bool detached            = false;  // unbound; delivery skips it until it leaves the object list
     uint32_t pending_signals = 0;
     ktl::ref<Object> object;
     Port* port               = nullptr;
-    port_binding* obj_next   = nullptr;  // the watched object's binding list (doubly linked)
+    port_binding* obj_next   = nullptr;  // the watched object's binding list (doubly linked, striped lock)
     port_binding* obj_prev   = nullptr;
-    port_binding* port_next  = nullptr;  // the port's list of all its bindings
+    port_binding* port_next  = nullptr;  // the port's list of all its bindings (port lock)
     port_binding* ready_next = nullptr;  // the port's FIFO of pending packets
 };
 
@@ -64,7 +66,11 @@ class Port : public Object {
 
     // Pop the oldest pending packet. false when none are pending; READABLE tracks the queue
     // either way.
-    bool dequeue(Packet& out);
+    bool dequeue(Packet& out) { return dequeue(&out, 1) == 1; }
+
+    // Pop up to `max` pending packets, oldest first, under one acquisition of the port lock;
+    // returns how many were written to `out`.
+    size_t dequeue(Packet* out, size_t max);
 
     size_t binding_count();
 
@@ -75,10 +81,14 @@ class Port : public Object {
    private:
     friend void port_notify(Object* object, uint32_t previous, uint32_t current);
 
-    // Both called with the port subsystem lock held.
+    // enqueue_ready and detach are called with m_lock held, unlink_from_object with the watched
+    // object's binding-list stripe held; retire takes the stripes itself.
     void enqueue_ready(port_binding* binding);
+    void detach(port_binding* binding);
     static void unlink_from_object(port_binding* binding);
+    static size_t retire(port_binding* victims);
 
+    kernel::synchronization::spinlock m_lock{"port"};  // bindings, ready FIFO, and each binding's pending state
     port_binding* m_bindings   = nullptr;
     port_binding* m_ready_head = nullptr;
     port_binding* m_ready_tail = nullptr;
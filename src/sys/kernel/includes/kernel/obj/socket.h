@@ -22,8 +22,11 @@ class Socket : public Object {
    public:
     DECLARE_OBJECT_TYPE(Socket, type_ids::SOCKET)
 
-    // Per-direction buffer: one page, allocated at create and owned by the pair's shared state.
+    // Per-direction buffer: BUFFER_BYTES unless create asks for more, rounded up to whole pages
+    // and capped at MAX_BUFFER_BYTES -- ring memory is wired, so the cap is the same placeholder
+    // quota the IPC buffer has. Allocated at create and owned by the pair's shared state.
     static constexpr size_t BUFFER_BYTES         = 4096;
+    static constexpr size_t MAX_BUFFER_BYTES     = static_cast<size_t>(::abi::syscall::SOCKET_MAX_CAPACITY);
 
     static constexpr uint32_t SIGNAL_READABLE    = static_cast<uint32_t>(::abi::syscall::SOCKET_SIGNAL_READABLE);
     static constexpr uint32_t SIGNAL_WRITABLE    = static_cast<uint32_t>(::abi::syscall::SOCKET_SIGNAL_WRITABLE);
@@ -38,7 +41,14 @@ class Socket : public Object {
         ktl::ref<Socket> first;
         ktl::ref<Socket> second;
     };
-    static ktl::result<Pair> create();
+    // Both directions get `capacity` bytes; out_of_range for zero or over MAX_BUFFER_BYTES.
+    static ktl::result<Pair> create(size_t capacity = BUFFER_BYTES);
+
+    // A scatter/gather element: `length` bytes at `data`, kernel-addressable.
+    struct run {
+        uint8_t* data;
+        size_t length;
+    };
 
     ~Socket() override;
 
@@ -46,11 +56,26 @@ class Socket : public Object {
     // is backpressure, not an error. capacity_exhausted only when nothing fits (wait on WRITABLE
     // and retry); peer_closed once the opposite endpoint is gone.
     ktl::result<size_t> write(const void* data, size_t length);
+    // The same over `count` runs in order under one lock hold, stopping where the buffer fills.
+    ktl::result<size_t> write(const run* runs, size_t count);
 
     // Take up to `capacity` buffered bytes, independent of how they were written. would_block
     // when empty with a live peer; peer_closed when empty for good. Bytes buffered when the peer
     // closed remain readable first.
     ktl::result<size_t> read(void* out, size_t capacity);
+    // The same into `count` runs in order under one lock hold, stopping where the buffer empties.
+    ktl::result<size_t> read(const run* runs, size_t count);
+
+    // Signal thresholds, so waiters wake per batch rather than per byte. READABLE asserts on this
+    // end while at least `read_high` bytes are buffered for it (1..capacity). WRITABLE clears on
+    // this end when the peer's buffer fills, and reasserts only once the peer has drained it down
+    // to `write_low` bytes (0..capacity - 1). A fresh pair has 1 and capacity - 1: the per-byte
+    // behaviour. Bytes stay readable and writable regardless; only the signals wait, and a hangup
+    // asserts READABLE on whatever remains, since the mark can no longer be reached. out_of_range
+    // for a threshold outside its bounds.
+    ktl::result<void> set_watermarks(size_t read_high, size_t write_low);
+
+    size_t capacity() const;
 
     static ktl::result<void> register_type(TypeRegistry& registry) {
         return registry.register_type(TYPE_ID, "socket", DEFAULT_RIGHTS, DEFAULT_RIGHTS);
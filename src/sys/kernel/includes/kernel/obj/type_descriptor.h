@@ -11,6 +11,9 @@ struct TypeDescriptor {
     ktl::string_view name;
     Rights valid_rights;
     Rights default_rights;
+    // Bytes of inline storage every object of the type carries; transaction program accesses
+    // are bounds-checked against it at attachment.
+    uint32_t storage_bytes;
 };
 
 }  // namespace kernel::obj
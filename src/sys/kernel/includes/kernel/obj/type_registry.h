@@ -1,32 +1,62 @@
 #pragma once
 
 #include <kernel/config.h>
+#include <kernel/obj/otp.h>
 #include <kernel/obj/type_descriptor.h>
 #include <kernel/obj/types.h>
 #include <kernel/synchronization/mutex.h>
+#include <kernel/synchronization/rcu.h>
 
 #include <ktl/atomic>
 #include <ktl/maybe>
+#include <ktl/ref>
 #include <ktl/result>
 
 namespace kernel::obj {
 
+// Read-mostly: lookups and program fetches run on every object operation and take no lock.
+// Descriptors are append-only and published by the count; programs are swapped under RCU.
 class TypeRegistry {
    public:
-    ktl::result<void> register_type(TypeId id, ktl::string_view name, Rights valid_rights, Rights default_rights);
+    TypeRegistry() = default;
+    ~TypeRegistry();
+    TypeRegistry(const TypeRegistry&)            = delete;
+    TypeRegistry& operator=(const TypeRegistry&) = delete;
+
+    // storage_bytes declares the inline storage every object of the type carries, at most
+    // CONFIG_OBJECT_MAX_INLINE_STORAGE (out_of_range past it).
+    ktl::result<void> register_type(TypeId id, ktl::string_view name, Rights valid_rights, Rights default_rights,
+                                    uint32_t storage_bytes = 0);
     ktl::maybe<const TypeDescriptor&> lookup(TypeId id) const;
     size_t count() const;
 
+    // Validate a transaction program against the type's declared storage (otp::Program::create
+    // lists the errors) and install it, replacing the type's previous program. Invocations already
+    // running keep the program they started with; the displaced one is released after a grace
+    // period. oom if the new program's slot cannot be allocated.
+    ktl::result<void> attach_program(TypeId id, const otp::insn* code, size_t count, uint32_t version);
+    // The type's current program, or null. Called on every programmable operation, so it costs
+    // one read-side section and a reference count.
+    ktl::ref<otp::Program> program(TypeId id);
+
     void on_object_created(TypeId id);
     void on_object_destroyed(TypeId id);
     uint32_t live_count(TypeId id) const;
 
    private:
+    // A ref is two words, so readers reach a program through a slot published by one pointer.
+    struct program_slot {
+        kernel::synchronization::rcu_head rcu;  // first, so the reclaim callback recovers the slot
+        ktl::ref<otp::Program> program;
+    };
+    static void reclaim_slot(kernel::synchronization::rcu_head* head);
+
     static constexpr size_t MAX_TYPES                  = CONFIG_MAX_OBJECT_TYPES;
     TypeDescriptor m_types[MAX_TYPES]                  = {};
     ktl::atomic<uint32_t> m_instance_counts[MAX_TYPES] = {};
-    size_t m_count                                     = 0;
-    kernel::synchronization::mutex m_lock;
+    program_slot* m_programs[MAX_TYPES]                = {};  // RCU-published, replaced under m_lock
+    ktl::atomic<size_t> m_count                        = 0;   // published after the descriptor it counts
+    kernel::synchronization::mutex m_lock{"type_registry"};
 
     ktl::maybe<size_t> index_for_id(TypeId id) const;
 };
@@ -28,6 +28,9 @@ constexpr Rights RIGHT_DUPLICATE = 1 << 2;
 constexpr Rights RIGHT_TRANSFER  = 1 << 3;
 constexpr Rights RIGHT_SIGNAL    = 1 << 4;
 constexpr Rights RIGHT_WAIT      = 1 << 5;
-constexpr Rights RIGHTS_ALL      = 0x3F;
+// Attach transaction programs to the object's type. Part of the authority over a type, so no
+// kernel-created handle carries it by default.
+constexpr Rights RIGHT_PROGRAM   = 1 << 6;
+constexpr Rights RIGHTS_ALL      = 0x7F;
 
 }  // namespace kernel::obj
@@ -52,6 +52,12 @@ void timer_init();
 /// Called by secondary CPUs only after the scheduler has come online.
 void timer_start_local();
 
+/// Program this CPU's timer for a single interrupt at `deadline_ns` on the ns_since_boot()
+/// timeline, replacing whatever it had armed, periodic or not; a deadline already past fires
+/// promptly. kernel::time::NEVER stops the local timer. Requires kernel::time::high_resolution().
+/// Returns false if this CPU's timer cannot be programmed, leaving it as it was.
+bool timer_set_deadline(int64_t deadline_ns);
+
 /// Signal test-harness exit through the board's debug-exit device (QEMU's
 /// isa-debug-exit on pc, the sifive_test finisher on virt). Returns on
 /// hardware that has no such device, so callers must halt afterwards.
@@ -19,6 +19,10 @@ struct cpu_core {
     size_t index;            // dense bootloader CPU-list position; the subscript into g_cpu_cores
     uint64_t hartid;
     ktl::atomic<bool> initialized;
+    // Lazy FP switching (arch::fpu_set_trap): whether the next return to user opens with FS Off,
+    // and whether the running user thread came in with FS Dirty since its state was last saved.
+    bool fpu_trap_armed;
+    bool fpu_dirty;
 };
 
 namespace riscv {
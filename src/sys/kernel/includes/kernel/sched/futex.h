@@ -0,0 +1,52 @@
+#pragma once
+
+#include <kernel/mm/vmo.h>
+#include <kernel/time.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ktl/ref>
+#include <ktl/result>
+
+// Futexes: wait and wake keyed on a 32-bit word of VMO memory, the kernel half of user mutexes and
+// condition variables whose uncontended paths are one atomic instruction in user space.
+//
+// A futex is named by (VMO, byte offset), never by an address: the syscalls resolve the caller's
+// address through its own region tree and hand the kernel half the binding's VMO and offset, so
+// two tasks mapping the same page at different addresses meet on the same futex, and a mapping
+// that moves or goes away cannot leave a waiter keyed on a stale address. The word itself is read
+// through the physmap, never through the caller's mapping.
+//
+// Waiters hash by key into a fixed table of buckets, each a spinlock over the keyed waiter list
+// and a wait_queue the waiters park on. The value check and the enqueue happen under the bucket
+// lock, and a waker takes the same lock after storing the new value, so a wake can never fall
+// between a waiter's check and its park. Waiters are woken oldest first.
+
+namespace kernel::sched {
+
+// Power of two. Every bucket costs two lockdep identities, so this stays small; a wake scans only
+// its own bucket, and keys that collide merely share a list.
+constexpr size_t FUTEX_BUCKETS = 16;
+
+// A futex_wait deadline that never lapses.
+constexpr ktime_t FUTEX_NO_DEADLINE = UINT64_MAX;
+
+// Park until woken on (object, offset) if the word there still holds `expected`, where offset is
+// 4-byte aligned and inside the VMO. would_block, without parking, when the word differs;
+// timed_out once `deadline` passes unwoken. A killed thread returns early with success, to exit at
+// the syscall boundary. Fills the word's page if it is not resident, which can fail with oom.
+ktl::result<void> futex_wait(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, uint32_t expected,
+                             ktime_t deadline);
+
+// Wake up to `count` waiters on (object, offset), oldest first. Returns how many were woken.
+size_t futex_wake(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, size_t count);
+
+// Wake up to `wake` waiters on (object, offset) and move up to `requeue` of the rest onto
+// (target, target_offset) without waking them -- a condition variable's broadcast hands its
+// waiters to the mutex instead of stampeding it. would_block, touching nothing, when the word at
+// (object, offset) no longer holds `expected`. Returns the number woken plus the number moved.
+ktl::result<size_t> futex_requeue(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, uint32_t expected,
+                                  size_t wake, const ktl::ref<kernel::mm::vmo>& target, uint64_t target_offset,
+                                  size_t requeue);
+
+}  // namespace kernel::sched
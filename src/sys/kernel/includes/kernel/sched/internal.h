@@ -2,49 +2,85 @@
 
 #include <kernel/sched/scheduler.h>
 #include <kernel/sched/thread.h>
+#include <kernel/sched/timer_wheel.h>
+#include <kernel/sched/trace.h>
 #include <kernel/synchronization/spinlock.h>
 #include <kernel/time.h>
 
+#include <ktl/atomic>
 #include <ktl/deque>
 #include <ktl/ref>
 
 // Scheduler-private interfaces shared by the task/ translation units (scheduler, sleep,
-// spawn, reaper, stats). Everything here -- the run queues, sleeper, timed-wait and zombie lists,
-// counters and the trace ring -- is guarded by g_sched_lock; per-core state is touched only by its
-// own core with interrupts off. Nothing outside task/ may include this header.
+// spawn, reaper, stats). The sleeper and timed-wait wheels, the zombie list and the global counters are
+// guarded by g_sched_lock. Each core's run queue, trace ring and switch accounting are guarded by
+// that core's cpu_sched::lock instead, so picking and switching never touch the global lock.
+// Nothing outside task/ may include this header.
 
 namespace kernel::sched {
 
 // Taken with interrupts off and preemption disabled; never held across a context switch. Nests
-// inside nothing and outside a wait queue's lock (kill scan, timed-wait expiry).
+// inside nothing and outside a wait queue's lock (kill scan, timed-wait expiry) and outside every
+// cpu_sched::lock (a wake queues its thread on a core while still holding it).
 extern kernel::synchronization::spinlock g_sched_lock;
 using sched_guard = kernel::synchronization::critical_irq_lock_guard<kernel::synchronization::spinlock>;
 
 struct cpu_sched {
+    // Innermost scheduler lock. At most one core's lock is held at a time -- a steal pops under
+    // the victim's lock alone -- so the per-core locks never order against each other.
+    kernel::synchronization::spinlock lock{"run_queue"};
+    ktl::deque<ktl::ref<Thread>> run_queue;
+    // run_queue.size(), published for siblings choosing a steal victim without taking the lock.
+    ktl::atomic<size_t> queued{0};
+    // Unlocked hints for wake kicks: whether the core has joined scheduling, and whether it is
+    // running its idle thread right now. A stale read costs one spurious or one missed IPI; the
+    // next tick covers the miss.
+    ktl::atomic<bool> online{false};
+    ktl::atomic<bool> idling{false};
     ktl::ref<Thread> current;
     ktl::ref<Thread> idle;
     // Outgoing thread of the in-flight switch; dropped by sched_finish_switch() on the incoming
     // thread's stack so a dead thread's final ref never dies on its own stack.
     ktl::ref<Thread> previous;
+    // The thread whose FP/SIMD state this core last loaded. Only ever compared, never followed:
+    // the thread may be dead, and a new one at the same address has not loaded here
+    // (Thread::fpu_core).
+    const Thread* fpu_owner = nullptr;
     // Anchors per-thread cycle accounting between switch_to and stats_snapshot.
     uint64_t last_switch_ts = 0;
     uint64_t switches       = 0;
+    uint64_t preempts       = 0;
+    uint64_t yields         = 0;
+    uint64_t block_switches = 0;
+    uint64_t sleep_switches = 0;
+    uint64_t exit_switches  = 0;
+    uint64_t steals         = 0;  // threads this core took from a sibling's queue
+    uint64_t handoffs       = 0;  // switches to a thread held by direct handoff, bypassing the queue
+    uint64_t timer_irqs     = 0;  // timer interrupts taken; stays flat while the core idles tickless
+    // Dynticks state, owned by this core with interrupts off. next_tick_ns is when the running
+    // thread's next slice tick is due; armed_ns is what the one-shot timer is programmed for
+    // (NEVER while stopped), read by other cores deciding whether a new timer needs this core to
+    // reprogram.
+    time_ns_t next_tick_ns = 0;
+    ktl::atomic<time_ns_t> armed_ns{kernel::time::NEVER};
+    trace_ring<CONFIG_SCHED_TRACE_EVENTS_PER_CORE> trace;
 };
+using cpu_guard = sched_guard;
 // The calling core's state; interrupts must be disabled so the caller cannot migrate.
 cpu_sched& cur_cpu();
 cpu_sched& cpu_at(size_t index);
 
-// Grow a container that lives under g_sched_lock to `capacity` without allocating while holding
-// it: the lock is taken from interrupt context, so an allocation inside it could deadlock against
-// a core holding the heap lock with interrupts on. A fresh container is reserved outside, the
-// contents move over under the lock (within the reservation, so no allocation), and the old
+// Grow a container that lives under a scheduler spinlock to `capacity` without allocating while
+// holding it: the lock is taken from interrupt context, so an allocation inside it could deadlock
+// against a core holding the heap lock with interrupts on. A fresh container is reserved outside,
+// the contents move over under the lock (within the reservation, so no allocation), and the old
 // storage dies after the unlock.
-template <typename C> bool grow_under_sched_lock(C& live, size_t capacity) {
+template <typename C> bool grow_under_lock(kernel::synchronization::spinlock& lock, C& live, size_t capacity) {
     C fresh;
     if (!fresh.reserve(capacity)) { return false; }
     C old;
     {
-        sched_guard guard(g_sched_lock);
+        sched_guard guard(lock);
         if (live.capacity() >= capacity) { return true; }
         if constexpr (requires { live.pop_front(); }) {
             for (auto item = live.pop_front(); item.has_value(); item = live.pop_front()) {
@@ -58,46 +94,67 @@ template <typename C> bool grow_under_sched_lock(C& live, size_t capacity) {
     }
     return true;
 }
+template <typename C> bool grow_under_sched_lock(C& live, size_t capacity) {
+    return grow_under_lock(g_sched_lock, live, capacity);
+}
 
-// Queue a READY thread; g_sched_lock held. Capacity was reserved by ensure_tick_capacity.
-bool push_runnable_locked(ktl::ref<Thread> thread);
-size_t run_queue_depth_locked();
+// Queue a READY thread on the core it last ran on (its cache is likely still warm there), or on
+// the calling core for a thread that has never run, and kick an idle core to pick it up. Takes the
+// target core's lock; callers may hold g_sched_lock. Capacity was reserved by ensure_tick_capacity.
+bool push_runnable(ktl::ref<Thread> thread);
+// Sum of every core's queue depth; a snapshot, stale as soon as it returns.
+size_t run_queue_depth();
 // make_ready for callers already holding g_sched_lock.
 void make_ready_locked(ktl::ref<Thread> thread);
 
-// The tick path (wake sleepers, requeue the preempted thread) pushes to the run queue and scans
-// the sleeper list from interrupt context, where the heap forbids allocation. Capacity for the
+// The tick path (wake sleepers, requeue the preempted thread) pushes to the run queue and the
+// zombie list from interrupt context, where the heap forbids allocation. Capacity for the
 // worst case -- every live thread runnable or sleeping at once -- is therefore reserved here, in
-// thread context, before a new thread first enters scheduling. spawn calls this once per thread;
-// the reaper gives the slot back. Failure is a clean spawn error, never a tick-time allocation.
+// thread context, before a new thread first enters scheduling. Every core's queue is reserved for
+// the whole worst case, since affinity and stealing can pile any thread onto any core. spawn calls
+// this once per thread; the reaper gives the slot back. Failure is a clean spawn error, never a
+// tick-time allocation.
 ktl::result<void> ensure_tick_capacity();
 void note_thread_reaped();
 
-// Reserve the sleeper list (owned by sleep.cpp) and the zombie list (owned by reaper.cpp) to
-// `capacity` entries; both take interrupts-off internally.
-bool sleepers_reserve(size_t capacity);
+// Reserve the zombie list (owned by reaper.cpp) to `capacity` entries; takes interrupts-off
+// internally. Sleepers and timed waits need no reservation: their timers live in the waiter's frame.
 bool zombies_reserve(size_t capacity);
 
-// Counters and the flight recorder live in stats.cpp; both are written under g_sched_lock.
+// Global counters and the flight recorder live in stats.cpp. g_stats is written under
+// g_sched_lock; trace_push records into the calling core's ring under its lock (interrupts off),
+// and trace_push_locked is the form for a caller already holding that lock.
 extern global_stats g_stats;
 void trace_push(trace_kind kind, switch_reason reason, uint64_t from, uint64_t to);
+void trace_push_locked(cpu_sched& cpu, trace_kind kind, switch_reason reason, uint64_t from, uint64_t to);
 
-// Sleep machinery lives in sleep.cpp. wake_due_sleepers runs from the tick handler; all three are
-// called with g_sched_lock held.
+// Sleep machinery lives in sleep.cpp: sleepers sit on a timer wheel, so the tick handler's
+// wake_due_sleepers only touches timers that are due (or cascading), and the first core to tick
+// does the work while the rest find the wheel already caught up. All three are called with
+// g_sched_lock held.
 void wake_due_sleepers();
 size_t sleeper_count();
-// Pull `thread` out of the sleeper list before its deadline and make it ready; false if it is not
-// sleeping. Task kill's path for waking a killed sleeper early.
+// Disarm `thread`'s sleep timer before its deadline and make it ready; false if it is not
+// sleeping. Task kill's path for waking a killed sleeper early; O(1) through Thread::sleep_timer.
 bool wake_sleeper(Thread* thread);
 
 // Timed waits also live in sleep.cpp: waiters parked on an object's wait queue with a deadline.
-// The registry entry points at the wait node on the waiter's stack; register before parking,
-// unregister after waking (tolerant of the expiry scan having removed the entry first). The
-// expiry scan runs from the tick handler alongside wake_due_sleepers, under g_sched_lock.
+// The registration lives in the waiter's frame beside its wait node; register before parking,
+// unregister after waking (a no-op if expiry already disarmed it). Expiry runs from the tick
+// handler alongside wake_due_sleepers, under g_sched_lock, and wakes through wait_queue::claim.
 struct wait_node;
 class wait_queue;
-void timed_wait_register(wait_queue* queue, wait_node* node, ktime_t wake_at);
-void timed_wait_unregister(wait_node* node);
+struct timed_wait : timer_entry {
+    wait_queue* queue = nullptr;
+    wait_node* node   = nullptr;
+};
+void timed_wait_register(timed_wait& wait, wait_queue* queue, wait_node* node, ktime_t wake_at);
+void timed_wait_unregister(timed_wait& wait);
 void wake_due_timed_waits();
 
+// Earliest point the timer wheels need servicing, on the ns_since_boot() timeline; NEVER when
+// nothing is armed. Published atomically so rearm_timer reads it without g_sched_lock. Wheel
+// deadlines are serviced by the boot core, whose one-shot timer follows this value.
+time_ns_t next_timer_ns();
+
 }  // namespace kernel::sched
@@ -14,7 +14,7 @@ class Thread;
 // Thread reaping. A dead thread cannot free itself -- it is still running on its own stack -- so
 // exit_current() queues it and the reaper thread does the teardown later. The reaper also owns the
 // recycled kernel-stack pool, since its whole purpose is handing reaped threads' stacks back to
-// new spawns (alloc_contiguous has no contiguous free of its own).
+// new spawns; stacks beyond the pool's bound go back to the PMM.
 
 // Spawn the reaper thread. Called by sched::init() once the scheduler is online.
 void reaper_start();
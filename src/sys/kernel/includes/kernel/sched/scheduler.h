@@ -35,14 +35,35 @@ ktl::result<ktl::ref<Thread>> thread_create_in(ktl::ref<Task> task, const char*
 ktl::result<void> thread_enqueue(ktl::ref<Thread> thread);
 void thread_discard(ktl::ref<Thread> thread);
 
+// Direct handoff for synchronous IPC (Channel::call, Channel::reply_and_wait). Once armed, the
+// first thread a wake by the calling thread readies -- never one an interrupt handler readies -- is
+// held for it instead of queued, when it may run on this core and is not still switching out
+// elsewhere. The caller's next switch away, normally its block on the answer, then runs that thread
+// directly: no run queue, no idle-core kick, and the woken thread lands on the caller's warm core.
+// Disarming queues a held thread the caller never switched to.
+void handoff_arm();
+void handoff_disarm();
+
 void yield();
 // Block the current thread until at least `ticks` kernel ticks have elapsed. The idle thread
 // must never sleep.
 void sleep_ticks(uint64_t ticks);
-// Timer-tick hook: slice accounting and preemption. Interrupt context only.
+// Same, for at least `ns` nanoseconds. Once the cycle counter is the clock the wake is driven by
+// a one-shot timer at the deadline itself, not the next tick after it.
+void sleep_ns(uint64_t ns);
+// Timer-interrupt hook: wakes due timers, then slice accounting and preemption on the interrupts
+// that mark a tick. Interrupt context only.
 void on_tick();
+// Reprogram this core's one-shot timer (dynticks): a slice tick while it has a thread to run, plus
+// on the boot core the earliest timer deadline; an idle core with nothing queued stops its timer
+// entirely. A no-op while time is tick-derived and the timer still periodic.
+void rearm_timer();
 // Consume a timer preemption request after the outermost protected/trap context exits.
 void service_pending_preemption();
+// The running user thread's first FP/SIMD instruction since it was switched in, trapped by
+// arch::fpu_set_trap: gives the thread an FPU area if it has none, loads its state, and disarms
+// the trap. False when no area could be allocated. Synchronous-trap context, from user mode.
+bool fpu_first_use();
 [[noreturn]] void exit_current();
 [[noreturn]] void idle_loop();
 
@@ -56,9 +77,14 @@ struct core_stats {
     uint64_t switches    = 0;
     uint64_t idle_cycles = 0;
     uint64_t current_id  = 0;  // thread running there at the snapshot
+    uint64_t steals      = 0;  // threads this core took from a sibling's run queue
+    uint64_t handoffs    = 0;  // switches straight to a thread held by direct handoff
+    uint64_t timer_irqs  = 0;
+    size_t runq_depth    = 0;
 };
 
-// Global scheduler counters plus live queue depths, snapshotted under the scheduler lock.
+// Scheduler counters plus live queue depths. Switch counters are kept per core and summed here;
+// each core is read under its own lock, so the totals are not one atomic cut.
 struct global_stats {
     uint64_t switches       = 0;
     uint64_t preempts       = 0;
@@ -69,6 +95,9 @@ struct global_stats {
     uint64_t wakes          = 0;
     uint64_t spawned        = 0;
     uint64_t reaped         = 0;
+    uint64_t steals         = 0;
+    uint64_t handoffs       = 0;
+    uint64_t timer_irqs     = 0;
     uint64_t boot_ts        = 0;  // timestamp at sched::init
     uint64_t idle_cycles    = 0;  // convenience copy of the idle thread's cpu_cycles
     size_t runq_depth       = 0;
@@ -84,7 +84,7 @@ class Task : public kernel::obj::Object {
    private:
     kernel::obj::HandleTable m_handles;
     ktl::vector<ktl::ref<Thread>> m_threads;
-    kernel::synchronization::mutex m_lock;
+    kernel::synchronization::mutex m_lock{"task"};
     kernel::mm::vm_aspace* m_aspace      = nullptr;
     task_state m_state                   = task_state::NEW;
     kernel::obj::HandleId m_owner_handle = kernel::obj::HandleId::invalid();
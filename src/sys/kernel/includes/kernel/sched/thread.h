@@ -15,6 +15,8 @@
 
 namespace kernel::sched {
 
+struct timer_entry;
+
 using thread_entry_fn = void (*)(void*);
 
 enum class thread_state : uint32_t { READY = 0, RUNNING, BLOCKED, DEAD };
@@ -72,6 +74,9 @@ class Thread : public kernel::obj::Object {
         set_name(name);
     }
 
+    // Returns the FPU area to its arena. Defined beside the arena, like the allocation operators.
+    ~Thread() override;
+
     thread_state state() const { return m_state; }
     void set_state(thread_state s) { m_state = s; }
 
@@ -91,8 +96,7 @@ class Thread : public kernel::obj::Object {
 
     // Where this thread is parked while BLOCKED on a wait queue, recorded under that queue's lock
     // by block_if and cleared when the thread resumes. This is what lets task kill find and claim
-    // a blocked thread without a reverse index; sleepers are found through the sleeper list
-    // instead and have no entry here.
+    // a blocked thread without a reverse index; sleepers have no entry here.
     wait_queue* parked_queue() const { return m_parked_queue; }
     wait_node* parked_node() const { return m_parked_node; }
     void set_parked(wait_queue* queue, wait_node* node) {
@@ -100,6 +104,11 @@ class Thread : public kernel::obj::Object {
         m_parked_node  = node;
     }
 
+    // The armed timer of a thread in sleep_ns, set and cleared under g_sched_lock; task kill
+    // cancels through it instead of searching the sleepers.
+    timer_entry* sleep_timer() const { return m_sleep_timer; }
+    void set_sleep_timer(timer_entry* timer) { m_sleep_timer = timer; }
+
     uintptr_t kstack_phys() const { return m_kstack_phys; }
     uintptr_t kstack_floor() const { return m_kstack_floor; }
     void set_kstack_floor(uintptr_t floor) { m_kstack_floor = floor; }
@@ -111,10 +120,15 @@ class Thread : public kernel::obj::Object {
     uintptr_t* saved_sp_slot() { return &m_saved_sp; }
     void set_saved_sp(uintptr_t sp) { m_saved_sp = sp; }
 
-    // User FP/SIMD register state, saved/restored when the thread is switched out/in. Kernel
-    // threads never execute FP code (the kernel is built without it), so the scheduler skips
-    // their areas entirely.
+    // User FP/SIMD register state, saved when the thread is switched out and loaded on its first
+    // FP instruction after it is switched back in (sched::fpu_first_use). Null until that first
+    // instruction ever happens, so kernel threads and integer-only user threads never have one.
+    // fpu_core is the core that last loaded it, or NO_CORE.
     void* fpu_area() { return m_fpu_area; }
+    // Take a zeroed area from the FPU arena and seed the entry state; false on exhaustion.
+    bool alloc_fpu_area();
+    uint32_t fpu_core() const { return m_fpu_core; }
+    void set_fpu_core(uint32_t core) { m_fpu_core = core; }
 
     void reset_slice() { m_slice = CONFIG_SCHED_TIMESLICE_TICKS; }
     // Returns the remaining slice after the decrement; saturates at zero.
@@ -136,6 +150,24 @@ class Thread : public kernel::obj::Object {
     void set_held_lock_count(size_t count) { m_held_lock_count = count; }
 #endif
 
+    // Direct handoff (sched::handoff_arm): whether a wake this thread makes may be held for it
+    // instead of queued, and the thread held. Touched only by the core running this thread, with
+    // interrupts off; taking the held thread disarms, so one arm hands off at most once.
+    bool handoff_armed() const { return m_handoff_armed; }
+    void set_handoff_armed(bool armed) { m_handoff_armed = armed; }
+    bool holds_handoff() const { return static_cast<bool>(m_handoff); }
+    void hold_handoff(ktl::ref<Thread> target) { m_handoff = ktl::move(target); }
+    ktl::ref<Thread> take_handoff() {
+        m_handoff_armed = false;
+        return ktl::move(m_handoff);
+    }
+
+    // The one core this thread may run on, or NO_CORE for any. Set before the thread is first
+    // queued: it is then only ever queued there and never stolen. Kernel-internal placement for
+    // tests and benchmarks that measure a specific topology; nothing user-visible sets it.
+    uint32_t pinned_core() const { return m_pinned_core; }
+    void set_pinned_core(uint32_t core) { m_pinned_core = core; }
+
     // Timestamp of the last enqueue onto the run queue; 0 when not pending. Set at every
     // enqueue, consumed (and zeroed) when the thread is switched in -- READY latency.
     uint64_t ready_ts() const { return m_ready_ts; }
@@ -153,12 +185,15 @@ class Thread : public kernel::obj::Object {
     }
 
    private:
-    // Mutated under the scheduler lock (block_if additionally holds the wait queue's lock).
+    // Entering and leaving BLOCKED, and DEAD, happen under g_sched_lock (block_if additionally holds
+    // the wait queue's lock) -- the transitions the kill scan reads. READY<->RUNNING happens on the
+    // owning core with interrupts off.
     thread_state m_state       = thread_state::READY;
     ktl::atomic<bool> m_on_cpu = false;
     bool m_killed              = false;
     wait_queue* m_parked_queue = nullptr;
     wait_node* m_parked_node   = nullptr;
+    timer_entry* m_sleep_timer = nullptr;
     uintptr_t m_kstack_phys    = 0;
     uintptr_t m_kstack_floor   = 0;
     uintptr_t m_kstack_top     = 0;
@@ -167,9 +202,13 @@ class Thread : public kernel::obj::Object {
     uint32_t m_slice         = CONFIG_SCHED_TIMESLICE_TICKS;
     uint32_t m_syscall_depth = 0;
     thread_stats m_stats;
-    uint64_t m_ready_ts = 0;
+    uint64_t m_ready_ts    = 0;
+    bool m_handoff_armed   = false;
+    uint32_t m_pinned_core = thread_stats::NO_CORE;
+    ktl::ref<Thread> m_handoff;
     ipc_buffer m_ipc;
-    alignas(kernel::arch::FPU_AREA_ALIGN) uint8_t m_fpu_area[kernel::arch::FPU_AREA_SIZE] = {};
+    void* m_fpu_area    = nullptr;
+    uint32_t m_fpu_core = thread_stats::NO_CORE;
 #ifndef NDEBUG
     kernel::synchronization::held_lock m_held_locks[CONFIG_LOCKDEP_MAX_HELD] = {};
     size_t m_held_lock_count                                                 = 0;
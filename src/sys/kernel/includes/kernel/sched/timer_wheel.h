@@ -0,0 +1,194 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace kernel::sched {
+
+// An intrusive timer: the owner embeds it (usually on the stack of the thread it will wake), so
+// arming allocates nothing and cannot fail. Linked into exactly one wheel slot while armed.
+struct timer_entry {
+    uint64_t deadline  = 0;
+    timer_entry* next  = nullptr;
+    timer_entry* prev  = nullptr;
+    timer_entry** head = nullptr;  // the slot list this entry is on; null when not armed
+
+    bool armed() const { return head != nullptr; }
+};
+
+// Hierarchical timing wheel over an abstract tick counter. Level k holds timers due between
+// 64^k and 64^(k+1) ticks out, bucketed by the matching six bits of the deadline; each time the
+// level below wraps, the next slot up is cascaded down one level. Insert and cancel are O(1), a
+// tick with nothing due visits one slot, and each timer is touched at most once per level over
+// its whole lifetime -- so tick cost follows the timers that fire, not the number armed.
+// Per-level occupancy bitmaps let advance() jump straight over ticks with nothing to do, so a
+// core that slept through a long gap catches up in one step per timer, not one per tick.
+// Deadlines beyond the top level's reach park in its farthest slot and are re-placed when it
+// cascades. Carries no lock; the owner serializes access. Pure data -- host-testable.
+class timer_wheel {
+   public:
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t SLOTS      = size_t{1} << LEVEL_BITS;
+    static constexpr size_t LEVELS     = 6;
+    static constexpr uint64_t NONE     = ~uint64_t{0};
+
+    // Work counters: slots examined and timers moved or fired. The tick cost a benchmark reads.
+    struct counters {
+        uint64_t slots_visited = 0;
+        uint64_t cascaded      = 0;
+        uint64_t fired         = 0;
+    };
+
+    explicit timer_wheel(uint64_t start = 0) : m_next(start) {}
+    timer_wheel(const timer_wheel&)            = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    // Arm `e` to fire at `deadline`. A deadline already passed fires on the next advance.
+    void insert(timer_entry& e, uint64_t deadline) {
+        e.deadline = deadline;
+        place(e);
+        m_armed += 1;
+    }
+
+    // Disarm `e`; false if it was not armed (already fired or never inserted).
+    bool cancel(timer_entry& e) {
+        if (!e.armed()) { return false; }
+        unlink(e);
+        m_armed -= 1;
+        return true;
+    }
+
+    // Process every tick up to and including `now`, calling fire(timer_entry&) for each timer
+    // that comes due, in tick order. The entry is already unlinked when fire runs, so the
+    // callback may re-arm it or let its storage go. Returns the number fired.
+    template <typename Fn> size_t advance(uint64_t now, Fn&& fire) {
+        size_t fired = 0;
+        while (m_next <= now) {
+            // Every tick before the next event is a no-op, so skipping to it is exact.
+            uint64_t event = next_event();
+            if (event > now) {
+                m_next = now + 1;
+                break;
+            }
+            m_next = event;
+            cascade_due();
+            size_t slot = m_next & (SLOTS - 1);
+            m_stats.slots_visited += 1;
+            while (timer_entry* e = m_slots[0][slot]) {
+                unlink(*e);
+                if (e->deadline > m_next) {
+                    // Only a timer clamped to the top level's reach lands early; put it back.
+                    place(*e);
+                    m_stats.cascaded += 1;
+                    continue;
+                }
+                m_armed -= 1;
+                m_stats.fired += 1;
+                fired += 1;
+                fire(*e);
+            }
+            m_next += 1;
+        }
+        return fired;
+    }
+
+    // The earliest tick at which advance() has work: a timer firing, or a slot cascading toward
+    // one. Never later than the earliest armed deadline, so it is a safe time to program a
+    // one-shot interrupt for; NONE when nothing is armed.
+    uint64_t next_event() const {
+        uint64_t best = NONE;
+        for (size_t level = 0; level < LEVELS; ++level) {
+            if (m_occupied[level] == 0) { continue; }
+            // Level-k slots are visited on 64^k boundaries: find the first boundary at or after
+            // m_next, then the first occupied slot counting round from the one it visits.
+            uint64_t span  = uint64_t{1} << (level * LEVEL_BITS);
+            uint64_t base  = (m_next + span - 1) & ~(span - 1);
+            size_t start   = slot_of(base, level);
+            uint64_t ring  = rotate_right(m_occupied[level], start);
+            uint64_t event = base + static_cast<uint64_t>(__builtin_ctzll(ring)) * span;
+            if (event < best) { best = event; }
+        }
+        return best;
+    }
+
+    size_t armed() const { return m_armed; }
+    // The first tick the next advance will process.
+    uint64_t next_tick() const { return m_next; }
+    const counters& stats() const { return m_stats; }
+    void reset_stats() { m_stats = counters{}; }
+
+   private:
+    static size_t slot_of(uint64_t tick, size_t level) {
+        return static_cast<size_t>(tick >> (level * LEVEL_BITS)) & (SLOTS - 1);
+    }
+
+    static uint64_t rotate_right(uint64_t bits, size_t n) {
+        return n == 0 ? bits : (bits >> n) | (bits << (SLOTS - n));
+    }
+
+    void place(timer_entry& e) {
+        constexpr uint64_t MAX_DELTA = (uint64_t{1} << (LEVELS * LEVEL_BITS)) - 1;
+        uint64_t when                = e.deadline < m_next ? m_next : e.deadline;
+        if (when - m_next > MAX_DELTA) { when = m_next + MAX_DELTA; }
+        uint64_t delta = when - m_next;
+        size_t level   = 0;
+        while (level + 1 < LEVELS && delta >= (uint64_t{1} << ((level + 1) * LEVEL_BITS))) { ++level; }
+        size_t slot = slot_of(when, level);
+        link(e, m_slots[level][slot]);
+        m_occupied[level] |= uint64_t{1} << slot;
+    }
+
+    // At each level boundary pull the next slot of the level above down, highest level first
+    // so a timer can fall more than one level in a single tick.
+    void cascade_due() {
+        size_t top = 0;
+        while (top + 1 < LEVELS && slot_of(m_next, top) == 0) { ++top; }
+        for (size_t level = top; level >= 1; --level) {
+            size_t index       = slot_of(m_next, level);
+            timer_entry*& slot = m_slots[level][index];
+            timer_entry* list  = slot;
+            slot               = nullptr;
+            m_occupied[level] &= ~(uint64_t{1} << index);
+            m_stats.slots_visited += 1;
+            while (list) {
+                timer_entry* e = list;
+                list           = e->next;
+                e->head        = nullptr;
+                place(*e);
+                m_stats.cascaded += 1;
+            }
+        }
+    }
+
+    static void link(timer_entry& e, timer_entry*& head) {
+        e.prev = nullptr;
+        e.next = head;
+        if (head) { head->prev = &e; }
+        head   = &e;
+        e.head = &head;  // slot arrays never move, so the back-pointer stays valid while linked
+    }
+
+    void unlink(timer_entry& e) {
+        if (e.prev) {
+            e.prev->next = e.next;
+        } else {
+            *e.head = e.next;
+            if (e.next == nullptr) {
+                // Emptied the slot: the back-pointer's offset in the slot array names it.
+                size_t index = static_cast<size_t>(e.head - &m_slots[0][0]);
+                m_occupied[index / SLOTS] &= ~(uint64_t{1} << (index % SLOTS));
+            }
+        }
+        if (e.next) { e.next->prev = e.prev; }
+        e.next = e.prev = nullptr;
+        e.head          = nullptr;
+    }
+
+    timer_entry* m_slots[LEVELS][SLOTS] = {};
+    uint64_t m_occupied[LEVELS]         = {};  // bit s set while slot s of that level is non-empty
+    uint64_t m_next                     = 0;
+    size_t m_armed                      = 0;
+    counters m_stats;
+};
+
+}  // namespace kernel::sched
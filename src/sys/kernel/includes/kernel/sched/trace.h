@@ -16,22 +16,19 @@ struct trace_record {
     switch_reason reason = switch_reason::NONE;
 };
 
-// Fixed-capacity flight recorder. Carries no lock: the scheduler writes and the shell reads
-// with interrupts disabled on the single scheduling core. Pure data -- host-testable.
+// Fixed-capacity flight recorder. Carries no lock: each core's ring is written and read under that
+// core's scheduler lock. Pure data -- host-testable.
 template <size_t N> class trace_ring {
    public:
     trace_ring() = default;
 
     void push(const trace_record& r) {
-        m_records[m_next] = r;
-        m_next            = (m_next + 1) % N;
+        m_records[m_pushed % N] = r;
+        m_pushed += 1;
         if (m_size < N) { ++m_size; }
     }
 
-    void clear() {
-        m_next = 0;
-        m_size = 0;
-    }
+    void clear() { m_size = 0; }
 
     size_t size() const { return m_size; }
     static constexpr size_t capacity() { return N; }
@@ -39,16 +36,22 @@ template <size_t N> class trace_ring {
     // Copies up to max records into out, newest first. Returns the count copied.
     size_t copy_newest(trace_record* out, size_t max) const {
         size_t n = m_size < max ? m_size : max;
-        for (size_t i = 0; i < n; ++i) {
-            size_t idx = (m_next + N - 1 - i) % N;
-            out[i]     = m_records[idx];
-        }
+        for (size_t i = 0; i < n; ++i) { out[i] = m_records[(m_pushed - 1 - i) % N]; }
         return n;
     }
 
+    // Absolute sequence numbers let a reader merge several rings one record at a time without
+    // holding them all: record `seq` is readable while it lies in [end_seq() - size(), end_seq()).
+    uint64_t end_seq() const { return m_pushed; }
+    bool read_seq(uint64_t seq, trace_record& out) const {
+        if (seq >= m_pushed || m_pushed - seq > m_size) { return false; }
+        out = m_records[seq % N];
+        return true;
+    }
+
    private:
     trace_record m_records[N] = {};
-    size_t m_next             = 0;
+    uint64_t m_pushed         = 0;
     size_t m_size             = 0;
 };
 
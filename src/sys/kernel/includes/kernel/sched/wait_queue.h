@@ -70,7 +70,7 @@ class wait_queue {
     // parking protocol -- unlock, then switch with interrupts off -- leaves a window where another
     // core can wake and queue the thread before its state is saved; Thread::on_cpu keeps any
     // picker from running it until the outgoing switch has finished.
-    kernel::synchronization::spinlock m_lock;
+    kernel::synchronization::spinlock m_lock{"wait_queue"};
     wait_node* m_waiters = nullptr;  // intrusive doubly-linked list of on-stack nodes
 };
 
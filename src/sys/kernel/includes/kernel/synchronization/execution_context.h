@@ -33,6 +33,9 @@ using deferred_preempt_hook = void (*)();
 void init_execution_context(size_t cpu_index);
 execution_context& current_execution_context();
 void set_current_thread_id(uint64_t thread_id);
+// The thread id `cpu` last switched to, read from any core without synchronization: a hint for a
+// spinner deciding whether a lock's owner is still on a core, never a guarantee.
+uint64_t thread_on_core(size_t cpu);
 void set_deferred_preempt_hook(deferred_preempt_hook hook);
 
 void preempt_disable();
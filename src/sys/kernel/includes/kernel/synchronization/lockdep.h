@@ -12,6 +12,41 @@ void acquired(const void* address, uint32_t identity);
 void released(const void* address, uint32_t identity);
 void assert_not_owned(const void* address, uint32_t identity);
 
+// Contention accounting by lock class: the name a lock registered under, so every handle table's
+// mutex counts toward one "handle_table" row however many tables exist. A mutex reports each
+// acquisition that missed its fast path once it finally holds the lock.
+struct class_stats {
+    const char* name     = nullptr;
+    uint64_t contended   = 0;  // acquisitions that missed the uncontended compare-and-swap
+    uint64_t spun        = 0;  // ... of which were won by spinning, never parking
+    uint64_t parks       = 0;  // times a contender parked; one acquisition may park more than once
+    uint64_t spins       = 0;  // spin iterations, won or abandoned
+    uint64_t wait_cycles = 0;  // timestamp cycles from the missed fast path to the acquisition
+};
+
+void contended(uint32_t identity, uint32_t spins, uint32_t parks, uint64_t wait_cycles);
+
+// Per-lock counters a spinlock keeps in its own cache line (CONFIG_SPINLOCK_STATS) and registers
+// here, so a snapshot can walk them by identity.
+struct lock_stats {
+    uint64_t acquires        = 0;
+    uint64_t contended       = 0;  // acquisitions that queued
+    uint64_t max_spin_cycles = 0;  // longest queued wait, in timestamp cycles
+};
+struct lock_row {
+    const char* name    = nullptr;
+    const void* address = nullptr;
+    lock_stats stats;
+};
+
+void attach_stats(uint32_t identity, const lock_stats* stats);
+// Copy up to `capacity` registered locks that carry stats into `out`; returns how many were
+// copied. Always 0 when NDEBUG is defined.
+size_t snapshot_locks(lock_row* out, size_t capacity);
+// Copy up to `capacity` classes into `out`, in registration order; returns how many were copied.
+// Classes that have never been contended are included. Always 0 when NDEBUG is defined.
+size_t snapshot_classes(class_stats* out, size_t capacity);
+
 #if CONFIG_KERNEL_TESTING
 void reset_for_testing();
 size_t edge_count_for_testing();
@@ -10,12 +10,18 @@
 
 namespace kernel::synchronization {
 
+// Adaptive: a contender spins while the owner is running on another core, up to
+// CONFIG_MUTEX_SPIN_LIMIT iterations, and parks only once the owner is off-core or the spin runs
+// out. Unlock takes the wait queue's lock only when a contender may be parked. The name is the
+// lock's lockdep class, under which its contention is counted.
 class mutex {
    public:
 #ifndef NDEBUG
-    mutex() : m_lockdep_id(lockdep::allocate_identity(this, "mutex")) {}
+    mutex() : mutex("mutex") {}
+    explicit mutex(const char* name) : m_lockdep_id(lockdep::allocate_identity(this, name)) {}
 #else
     mutex() = default;
+    explicit mutex(const char* name) { (void)name; }
 #endif
     ~mutex();
     mutex(const mutex&)            = delete;
@@ -24,13 +30,23 @@ class mutex {
     void lock();
     bool try_lock();
     void unlock();
-    bool is_locked() const { return m_state.load(ktl::memory_order::relaxed) != 0; }
+    bool is_locked() const { return (m_state.load(ktl::memory_order::relaxed) & LOCKED) != 0; }
     uint32_t lockdep_id() const { return m_lockdep_id; }
 
    private:
+    static constexpr uint8_t LOCKED  = 1;
+    static constexpr uint8_t WAITERS = 2;  // a contender may be parked, so unlock must wake one
+
     bool try_acquire();
+    void note_owner();
+    bool owner_running() const;
+    void lock_contended();
 
     ktl::atomic<uint8_t> m_state{0};
+    // The holder as a hint for spinners: its thread id (0 while unowned, or not yet recorded) and
+    // the core it acquired on. Never dereferenced, so a stale value only misjudges a spin.
+    ktl::atomic<uint64_t> m_owner{0};
+    ktl::atomic<uint32_t> m_owner_cpu{0};
     kernel::sched::wait_queue m_waiters;
 #ifndef NDEBUG
     uint32_t m_lockdep_id;
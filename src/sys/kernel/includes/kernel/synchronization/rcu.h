@@ -0,0 +1,115 @@
+#pragma once
+
+#include <kernel/config.h>
+#include <kernel/synchronization/execution_context.h>
+#include <kernel/synchronization/spinlock.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ktl/atomic>
+
+namespace kernel::synchronization {
+
+// Read-copy-update for read-mostly structures. A reader brackets its accesses with rcu_read_lock()
+// and rcu_read_unlock(), which only disable and re-enable preemption: no lock, no atomic, no write
+// to a shared cache line. An updater publishes the new version with rcu_assign() and hands the old
+// one to call_rcu(), which reclaims it after a grace period -- once every online core has passed a
+// quiescent state. A context switch, an idle loop iteration, and a tick that interrupted
+// preemptible code are quiescent states, and none can fall inside a read-side section.
+//
+// Read-side sections must not block, and should be as short as a spinlock hold: they hold off
+// preemption the same way.
+
+inline void rcu_read_lock() { preempt_disable(); }
+inline void rcu_read_unlock() { preempt_enable(); }
+
+class rcu_read_guard {
+   public:
+    rcu_read_guard() { rcu_read_lock(); }
+    ~rcu_read_guard() { rcu_read_unlock(); }
+    rcu_read_guard(const rcu_read_guard&)            = delete;
+    rcu_read_guard& operator=(const rcu_read_guard&) = delete;
+};
+
+// Publish `value`, fully initialised, to readers of `slot`.
+template <typename T> void rcu_assign(T*& slot, T* value) { __atomic_store_n(&slot, value, __ATOMIC_RELEASE); }
+// Load a pointer published with rcu_assign; valid until the read-side section closes.
+template <typename T> T* rcu_dereference(T* const& slot) { return __atomic_load_n(&slot, __ATOMIC_ACQUIRE); }
+
+struct rcu_head;
+using rcu_callback = void (*)(rcu_head*);
+
+// Embedded in the object a callback reclaims, so deferring a free never allocates.
+struct rcu_head {
+    rcu_head* next        = nullptr;
+    rcu_callback func     = nullptr;
+    uint64_t grace_period = 0;  // the grace period that must complete before func runs
+};
+
+// Grace-period and callback bookkeeping, free of any scheduler dependency so the host tier can
+// drive it core by core. Grace periods are numbered; each core records the last one it has passed
+// a quiescent state in, and the core whose report completes the set completes the grace period.
+// A callback waits for the grace period after the one running when it was queued, since that one
+// may have begun before the reader the callback protects against.
+class rcu_state {
+   public:
+    rcu_state()                            = default;
+    rcu_state(const rcu_state&)            = delete;
+    rcu_state& operator=(const rcu_state&) = delete;
+
+    // A core takes part in grace periods from the moment it comes online.
+    void set_online(size_t core);
+    // A quiescent state on `core`. Costs two loads once the core has reported for the running
+    // grace period, so the scheduler can call it on every switch.
+    void note_quiescent(size_t core);
+
+    // Queue a callback; true when the queue was empty, so the caller knows to wake its consumer.
+    bool enqueue(rcu_head* head, rcu_callback func);
+    // Open the grace period the queued callbacks wait for, unless one is running or none is owed.
+    bool start();
+    // Detach the callbacks whose grace period has completed, oldest first. Read each next pointer
+    // before running its callback: the callback may free the head.
+    rcu_head* take_ready();
+    bool has_callbacks() const { return m_queued.load(ktl::memory_order::relaxed) != 0; }
+
+    uint64_t started() const { return m_started.load(ktl::memory_order::relaxed); }
+    uint64_t completed() const { return m_completed.load(ktl::memory_order::acquire); }
+    // Online cores yet to report for the running grace period, one bit per core.
+    uint64_t pending_cores() const;
+
+   private:
+    static_assert(CONFIG_MAX_CORES <= 64, "pending_cores reports one bit per core");
+
+    struct alignas(CONFIG_CPU_CACHE_LINE_SIZE) core_state {
+        ktl::atomic<uint64_t> reported{0};
+        ktl::atomic<bool> online{false};
+    };
+
+    core_state m_cores[CONFIG_MAX_CORES];
+    ktl::atomic<uint64_t> m_started{0};
+    ktl::atomic<uint64_t> m_completed{0};
+    // The callback queue, in grace-period order because each takes the next one to start.
+    spinlock m_lock{"rcu"};
+    rcu_head* m_head = nullptr;
+    rcu_head* m_tail = nullptr;
+    ktl::atomic<size_t> m_queued{0};
+};
+
+// Run func(head) once every read-side section open now has closed. Thread context, inside a
+// read-side section or not; wakes the callback thread when its queue was empty. Hosted builds run
+// one thread with no other reader to wait for, so the callback runs at once.
+void call_rcu(rcu_head* head, rcu_callback func);
+// Block until a full grace period has passed. Preemptible thread context only.
+void synchronize_rcu();
+
+// Scheduler hooks. rcu_note_quiescent reports for the calling core, so the caller must be unable
+// to migrate: the context switch calls it with interrupts off, and the idle loop runs on its own
+// core. rcu_tick is called from the timer interrupt, where the tick is quiescent only if it
+// interrupted preemptible code. rcu_core_online registers a core as it joins scheduling, and
+// rcu_start spawns the callback thread once the scheduler is online.
+void rcu_note_quiescent();
+void rcu_tick();
+void rcu_core_online(size_t core);
+void rcu_start();
+
+}  // namespace kernel::synchronization
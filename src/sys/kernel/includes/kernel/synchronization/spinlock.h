@@ -6,14 +6,36 @@
 #include <kernel/synchronization/lockdep.h>
 #include <stdint.h>
 
+// Per-lock statistics need a lockdep identity to be found by, so they go with it.
+#if CONFIG_SPINLOCK_STATS && !defined(NDEBUG)
+#define KERNEL_SPINLOCK_STATS 1
+#else
+#define KERNEL_SPINLOCK_STATS 0
+#endif
+
 namespace kernel::synchronization {
 
+// A queued (MCS-style) spinlock. The uncontended path is one compare-and-swap on the lock word,
+// taken only while no contender is queued. A contender otherwise appends one of its core's queue
+// nodes to the lock's tail and spins on that node alone; only the queue's head spins on the lock
+// word, so a release touches one waiter's cache line and waiters acquire in arrival order.
+//
+// A core needs a node only while waiting, never while holding, and waiting nests only when an
+// interrupt or fault arrives mid-spin, so SPINLOCK_QUEUE_NODES per core cover every context.
 class spinlock {
    public:
+    static constexpr uint32_t SPINLOCK_QUEUE_NODES = 4;
+
 #ifndef NDEBUG
-    spinlock() : m_lockdep_id(lockdep::allocate_identity(this, "spinlock")) {}
+    spinlock() : spinlock("spinlock") {}
+    explicit spinlock(const char* name) : m_lockdep_id(lockdep::allocate_identity(this, name)) {
+#if KERNEL_SPINLOCK_STATS
+        lockdep::attach_stats(m_lockdep_id, &m_stats);
+#endif
+    }
 #else
     spinlock() = default;
+    explicit spinlock(const char* name) { (void)name; }
 #endif
     ~spinlock() {
         lockdep::assert_not_owned(this, m_lockdep_id);
@@ -24,23 +46,56 @@ class spinlock {
 
     void lock() {
         if (!preemption_disabled()) { panic("spinlock: preemption must be disabled before lock"); }
-        while (true) {
-            if (!__atomic_exchange_n(&m_state, locked_state, __ATOMIC_ACQUIRE)) { return; }
-            while (__atomic_load_n(&m_state, __ATOMIC_RELAXED)) {}
+        if (__atomic_load_n(&m_tail, __ATOMIC_RELAXED) == 0 && try_acquire()) {
+            note_acquired(false, 0);
+            return;
         }
+        lock_queued();
     }
     bool try_lock() {
         if (!preemption_disabled()) { panic("spinlock: preemption must be disabled before try_lock"); }
-        return !__atomic_exchange_n(&m_state, locked_state, __ATOMIC_ACQUIRE);
+        if (!try_acquire()) { return false; }
+        note_acquired(false, 0);
+        return true;
     }
-    void unlock() { __atomic_store_n(&m_state, unlocked_state, __ATOMIC_RELEASE); }
-    bool is_locked() const { return __atomic_load_n(&m_state, __ATOMIC_RELAXED) == locked_state; }
+    void unlock() { __atomic_store_n(&m_locked, unlocked_state, __ATOMIC_RELEASE); }
+    bool is_locked() const { return __atomic_load_n(&m_locked, __ATOMIC_RELAXED) == locked_state; }
     uint32_t lockdep_id() const { return m_lockdep_id; }
 
    private:
-    static constexpr uint8_t unlocked_state                      = 0;
-    static constexpr uint8_t locked_state                        = 1;
-    alignas(CONFIG_CPU_CACHE_LINE_SIZE) volatile uint8_t m_state = unlocked_state;
+    static constexpr uint32_t unlocked_state = 0;
+    static constexpr uint32_t locked_state   = 1;
+
+    bool try_acquire() {
+        uint32_t expected = unlocked_state;
+        return __atomic_compare_exchange_n(&m_locked, &expected, locked_state, false, __ATOMIC_ACQUIRE,
+                                           __ATOMIC_RELAXED);
+    }
+    void lock_queued();
+
+    // Counted by the holder only, so plain read-modify-writes suffice; relaxed atomics keep a
+    // concurrent snapshot from reading a torn value.
+    void note_acquired(bool contended, uint64_t spin_cycles) {
+#if KERNEL_SPINLOCK_STATS
+        __atomic_store_n(&m_stats.acquires, m_stats.acquires + 1, __ATOMIC_RELAXED);
+        if (contended) {
+            __atomic_store_n(&m_stats.contended, m_stats.contended + 1, __ATOMIC_RELAXED);
+            if (spin_cycles > m_stats.max_spin_cycles) {
+                __atomic_store_n(&m_stats.max_spin_cycles, spin_cycles, __ATOMIC_RELAXED);
+            }
+        }
+#else
+        (void)contended;
+        (void)spin_cycles;
+#endif
+    }
+
+    // The lock word and the queue tail share the lock's cache line, as the counters do.
+    alignas(CONFIG_CPU_CACHE_LINE_SIZE) uint32_t m_locked = unlocked_state;
+    uint32_t m_tail = 0;  // last queued node as 1 + core * SPINLOCK_QUEUE_NODES + depth; 0 when empty
+#if KERNEL_SPINLOCK_STATS
+    lockdep::lock_stats m_stats;
+#endif
 #ifndef NDEBUG
     uint32_t m_lockdep_id;
 #else
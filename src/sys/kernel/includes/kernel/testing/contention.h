@@ -0,0 +1,71 @@
+#pragma once
+
+#include <kernel/arch.h>
+#include <kernel/platform.h>
+#include <kernel/testing/spawn.h>
+
+#include <ktl/atomic>
+
+namespace kernel::testing {
+
+inline constexpr size_t CONTENTION_MAX_THREADS = 8;
+inline constexpr size_t CONTENTION_CASE_COUNT  = 4;
+
+// The thread counts a lock benchmark sweeps, each with the key its aggregate rate is reported
+// under. Benchmarks reporting more per case keep their own keys in arrays of the same order.
+struct contention_case {
+    size_t threads;
+    const char* rate_key;
+};
+inline constexpr contention_case CONTENTION_CASES[CONTENTION_CASE_COUNT] = {
+    {1, "locks_per_sec_threads_1"},
+    {2, "locks_per_sec_threads_2"},
+    {4, "locks_per_sec_threads_4"},
+    {CONTENTION_MAX_THREADS, "locks_per_sec_threads_8"},
+};
+
+struct contention_result {
+    uint64_t ops_per_sec = 0;  // threads * rounds over the slowest thread's time
+    uint64_t tally       = 0;  // the bodies' counts, summed
+};
+
+// Run `body(tally)` `rounds` times on each of `threads` kernel threads spread round-robin over the
+// online cores, released together once all are spawned. `tally` is a per-thread uint64_t the body
+// may count into (kernel calls made, say). Fails (all zero) if a thread did not spawn or the clock
+// is unusable; checking what the bodies guarded is the caller's job.
+template <typename Body> contention_result contend(const char* name, size_t threads, size_t rounds, Body& body) {
+    if (threads > CONTENTION_MAX_THREADS) { return {}; }
+    uint32_t cores[CONFIG_MAX_CORES];
+    size_t online = online_cores(cores);
+
+    ktl::atomic<bool> go          = false;
+    ktl::atomic<uint64_t> tally   = 0;
+    ktl::atomic<uint64_t> longest = 0;  // cycles of the slowest thread
+    auto contender                = [&] {
+        while (!go.load(ktl::memory_order::acquire)) {}
+        uint64_t counted = 0;
+        uint64_t start   = arch::timestamp();
+        for (size_t i = 0; i < rounds; i++) { body(counted); }
+        uint64_t cycles = arch::timestamp() - start;
+        tally.fetch_add(counted, ktl::memory_order::relaxed);
+        uint64_t seen = longest.load(ktl::memory_order::relaxed);
+        while (seen < cycles && !longest.compare_exchange(seen, cycles, ktl::memory_order::relaxed)) {}
+    };
+
+    ktl::ref<sched::Thread> spawned[CONTENTION_MAX_THREADS];
+    size_t count = 0;
+    for (; count < threads; count++) {
+        auto thread = spawn_fn_on(name, contender, cores[count % online]);
+        if (thread.is_err()) { break; }
+        spawned[count] = thread.unwrap();
+    }
+    go.store(true, ktl::memory_order::release);
+    for (size_t i = 0; i < count; i++) { spawned[i]->wait_signals(sched::Thread::SIGNAL_TERMINATED); }
+
+    uint64_t hz     = platform::timestamp_hz();
+    uint64_t cycles = longest.load();
+    if (count != threads || hz == 0 || cycles == 0) { return {}; }
+    return {threads * rounds * hz / cycles, tally.load()};
+}
+
+}  // namespace kernel::testing
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
-// Minimal cross-tier test-registration ABI: the ktest record, its flags, and the backend hooks (abort
-// plus the assertion sink). This is the contract shared by every test and both backends -- the kernel
+// Minimal cross-tier test-registration ABI: the ktest record, its flags, and the backend hooks (abort,
+// the assertion sink, and the metric sink). This is the contract shared by every test and both backends -- the kernel
 // shell on the QEMU tier and the host fork runner. The host harness depends only on this header, so it
 // is not dragged through the assertion macros or the formatter (which need the kernel <std> include
 // path and cannot compile in the host harness translation unit).
@@ -33,4 +34,8 @@ void abort(unsigned char exit_code = 1);
 void report_assertion(bool passed, bool fatal, const char* file, int line, const char* expr_text, const char* lhs,
                       const char* op, const char* rhs);
 
+// Named measurement from a benchmark case, attached to the running test's result as a test_meta
+// diagnostic. Both backends emit it the same way, so the aggregator sees one shape per tier.
+void report_metric(const char* key, uint64_t value);
+
 }  // namespace kernel::testing
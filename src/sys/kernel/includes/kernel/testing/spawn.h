@@ -1,6 +1,9 @@
 #pragma once
 
+#include <kernel/config.h>
 #include <kernel/sched/scheduler.h>
+#include <kernel/sched/task.h>
+#include <kernel/sched/thread.h>
 
 namespace kernel::testing {
 
@@ -11,4 +14,28 @@ template <typename F> ktl::result<ktl::ref<sched::Thread>> spawn_fn(const char*
     return sched::spawn(name, [](void* arg) { (*static_cast<F*>(arg))(); }, &fn);
 }
 
+// spawn_fn for a thread pinned to `core` (see Thread::set_pinned_core), for tests that measure a
+// specific topology. `core` must be online.
+template <typename F> ktl::result<ktl::ref<sched::Thread>> spawn_fn_on(const char* name, F& fn, uint32_t core) {
+    auto entry   = [](void* arg) { (*static_cast<F*>(arg))(); };
+    auto created = sched::thread_create_in(sched::kernel_task(), name, entry, &fn);
+    if (created.is_err()) { return created; }
+    auto thread = created.unwrap();
+    thread->set_pinned_core(core);
+    auto queued = sched::thread_enqueue(thread);
+    if (queued.is_err()) { return ktl::err(queued.unwrap_err()); }
+    return ktl::result<ktl::ref<sched::Thread>>::ok(ktl::move(thread));
+}
+
+// Fill `cores` with the indices of the online cores, lowest first; returns how many. The usual
+// source of `core` for spawn_fn_on.
+inline size_t online_cores(uint32_t (&cores)[CONFIG_MAX_CORES]) {
+    auto snapshot = sched::stats_snapshot();
+    size_t count  = 0;
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        if (snapshot.cores[i].online) { cores[count++] = i; }
+    }
+    return count;
+}
+
 }  // namespace kernel::testing
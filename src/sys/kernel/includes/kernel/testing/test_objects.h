@@ -14,6 +14,8 @@ constexpr kernel::obj::TypeId TEST_TYPE_A                  = 50;
 constexpr kernel::obj::TypeId TEST_TYPE_B                  = 51;
 constexpr kernel::obj::TypeId TEST_TYPE_RESTRICTED         = 52;
 constexpr kernel::obj::TypeId TEST_TYPE_UNREGISTERED       = 53;
+constexpr kernel::obj::TypeId TEST_TYPE_STORED             = 54;
+constexpr uint32_t TEST_STORED_BYTES                       = 64;
 
 // Rights contract for TestObjRestricted (see register_all_test_types).
 constexpr kernel::obj::Rights TEST_RESTRICTED_VALID_RIGHTS = kernel::obj::RIGHT_READ | kernel::obj::RIGHT_DUPLICATE;
@@ -52,6 +54,17 @@ class TestObjUnregistered : public kernel::obj::Object {
     TestObjUnregistered() : Object(TYPE_ID) {}
 };
 
+// Type declaring inline storage, the target transaction programs run against.
+class TestObjStored : public kernel::obj::Object {
+   public:
+    DECLARE_OBJECT_TYPE(TestObjStored, TEST_TYPE_STORED)
+    TestObjStored() : Object(TYPE_ID) {}
+    ktl::span<uint8_t> inline_storage() override { return m_storage; }
+
+   private:
+    uint8_t m_storage[TEST_STORED_BYTES] = {};
+};
+
 // already_registered is expected here: obj_init() registers Event at boot, and tests
 // re-enter this function freely. Any other registration failure is a real test-environment bug.
 inline void expect_registered(ktl::result<void> result, const char* msg) {
@@ -59,7 +72,7 @@ inline void expect_registered(ktl::result<void> result, const char* msg) {
     result.expect(msg);
 }
 
-// One-shot init that registers TestObjA/TestObjB plus Event.
+// One-shot init that registers the test types plus Event.
 inline void register_all_test_types() {
     static bool done = false;
     if (done) return;
@@ -71,6 +84,9 @@ inline void register_all_test_types() {
     expect_registered(g_type_registry.register_type(TEST_TYPE_RESTRICTED, "test_obj_restricted",
                                                     TEST_RESTRICTED_VALID_RIGHTS, RIGHT_READ),
                       "restricted test type registration failed");
+    expect_registered(g_type_registry.register_type(TEST_TYPE_STORED, "test_obj_stored", RIGHTS_ALL, RIGHTS_ALL,
+                                                    TEST_STORED_BYTES),
+                      "stored test type registration failed");
     expect_registered(Event::register_type(g_type_registry), "Event test registration failed");
     done = true;
 }
@@ -3,7 +3,7 @@
 // Test sources are only ever compiled into builds that want them (the Makefile globs them in per
 // tier), so everything here is unconditional. A future no-tests product build gates the source
 // globs, not this header.
-#include <kernel/testing/registry.h>  // ktest record, flags, abort + report_assertion hooks
+#include <kernel/testing/registry.h>  // ktest record, flags, abort + report_assertion/report_metric hooks
 #include <stddef.h>
 
 // The registry is walked as a packed array between __start__ktests/__stop__ktests, so the entries
@@ -112,6 +112,11 @@
     KTEST_EA_N(__VA_ARGS__, KTEST_EA_8, KTEST_EA_7, KTEST_EA_6, KTEST_EA_5, KTEST_EA_4, KTEST_EA_3, KTEST_EA_2, \
                KTEST_EA_1)(__VA_ARGS__)
 
+// Record a benchmark measurement under `key` (a string literal) for the running test. Benchmarks
+// are reported, not bounded: metrics are never asserted, as QEMU-tier timings are too noisy for a
+// threshold, and a case that wants a bound asserts it separately.
+#define KTEST_METRIC(key, value) kernel::testing::report_metric(key, static_cast<uint64_t>(value))
+
 // Unwrap a ktl::result, requiring is_ok(). Declares `var` with the unwrapped value.
 // Usage: KTEST_UNWRAP(id, table.emplace<ObjA>(RIGHTS_ALL));
 #define KTEST_UNWRAP(var, expr)                   \
@@ -19,12 +19,16 @@ namespace kernel {
 
 class time {
    public:
+    /** Deadline meaning "no deadline": a timer programmed for it never fires. */
+    static constexpr time_ns_t NEVER = static_cast<time_ns_t>(~uint64_t{0} >> 1);
+
     /**
      * @brief Returns the current kernel tick count.
      *
-     * The value monotonically increases each time the scheduler's tick handler
-     * advances the time source. It is expressed in abstract ticks rather than
-     * wall-clock units.
+     * Until use_timestamp_clock() adopts the cycle counter this is a counter the
+     * boot core's periodic tick interrupt advances. Afterwards it is rebuilt from
+     * ns_since_boot() on every read, so it keeps advancing while timer interrupts
+     * are stopped (dynticks) and never depends on which core takes them.
      */
     static ktime_t now();
 
@@ -68,6 +72,22 @@ class time {
      */
     static void use_timestamp_clock();
 
+    /**
+     * @brief True once use_timestamp_clock() has adopted the cycle counter.
+     *
+     * Deadline (one-shot) timer programming depends on it: a deadline is converted
+     * to a counter value, which tick-derived time cannot express below one tick.
+     */
+    static bool high_resolution();
+
+    /**
+     * @brief Converts a point on the ns_since_boot() timeline to a kernel::arch::timestamp() value.
+     *
+     * Rounds up, so a timer armed for the result never fires before `ns`. Only meaningful
+     * once high_resolution() is true; returns 0 before.
+     */
+    static uint64_t ns_to_timestamp(time_ns_t ns);
+
    private:
     /** Current kernel tick count. */
     static ktl::atomic<ktime_t> _now;
@@ -13,10 +13,13 @@ void lapic_eoi();
 
 /// LAPIC timer, fixed divide-by-16. start_counting() begins a masked free run so the caller can
 /// measure counts consumed against an external reference via elapsed(). start_periodic() begins
-/// periodic delivery of `vector` every `initial_count` counts.
+/// periodic delivery of `vector` every `initial_count` counts; start_oneshot() delivers it once
+/// after `count` counts; stop() cancels whatever is pending.
 void lapic_timer_start_counting();
 uint32_t lapic_timer_elapsed();
 void lapic_timer_start_periodic(uint8_t vector, uint32_t initial_count);
+void lapic_timer_start_oneshot(uint8_t vector, uint32_t count);
+void lapic_timer_stop();
 
 /// Deliver a fixed interrupt vector to the LAPIC id named by `destination`.
 void lapic_send_ipi(uint32_t destination, uint8_t vector);
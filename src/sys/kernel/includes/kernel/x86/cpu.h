@@ -24,6 +24,7 @@ struct cpu_local {
     uintptr_t syscall_kernel_rsp;
     uintptr_t syscall_user_rsp;
     size_t index;
+    bool fpu_trap_armed;  // CR0.TS as arch::fpu_set_trap last left it
 };
 
 static_assert(offsetof(cpu_local, kstack_floor) == 0);
@@ -57,6 +58,9 @@ namespace arch {
 
 /// Program the SYSCALL/SYSRET MSRs on the calling core. x86_64-only; called from core_init().
 void syscall_init();
+/// Switch on XSAVE where the CPU has it: CR4.OSXSAVE and XCR0 for x87, SSE and AVX. The boot
+/// processor also picks the save instruction every core then uses. Called from core_init().
+void fpu_cpu_init(bool is_boot_processor);
 
 }  // namespace arch
 
@@ -26,6 +26,68 @@ bool resolve_cow(vm_aspace& aspace, region_child& binding, vmo& obj, uint64_t pa
     (void)aspace.unmap_page(page_vaddr);  // also flushes the stale TLB entry
     return aspace.map_page(page_vaddr, fill.unwrap(), binding.prot, binding.cache);
 }
+
+// Large-page promotion: map the naturally aligned 2 MiB (or, for a device or
+// wired window, 1 GiB) span around the fault with one leaf, when the binding
+// covers the span, the VMO offset lines up with it, nothing in it is mapped
+// yet, and the VMO can back it with one aligned physical run. Anonymous memory
+// is promoted on a write only -- a read still shares the zero page -- and
+// never past 2 MiB, so one touch commits at most one large page.
+bool map_large_around(vm_aspace& aspace, region_child& binding, vmo& obj, uintptr_t vaddr, bool write) {
+    bool anonymous = obj.backing_pager().owns_frames();
+    if (anonymous && !write) { return false; }
+    constexpr size_t SIZES[] = {LARGE_PAGE_1G, LARGE_PAGE_2M};
+    for (size_t size : SIZES) {
+        if (anonymous && size > LARGE_PAGE_2M) { continue; }
+        if (binding.size < size || !vm_aspace::large_page_supported(size)) { continue; }
+        uintptr_t span = vaddr & ~(size - 1);
+        if (span < binding.base || span + size > binding.base + binding.size) { continue; }
+        uint64_t offset = span - binding.base + binding.vmo_offset;
+        if ((offset & (size - 1)) != 0 || !aspace.span_empty(span, size)) { continue; }
+
+        auto run = obj.get_or_fill_run(offset / PAGE_SIZE, size / PAGE_SIZE);
+        if (run.is_err()) { continue; }
+        if (aspace.map_large(span, run.unwrap(), size, binding.prot, binding.cache)) {
+            aspace.count_faults_avoided(size / PAGE_SIZE - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fault-around: after the faulting page is in, install its neighbours in the
+// binding's aligned window in one batch, so a sequential scan traps once per
+// window rather than once per page. Only neighbours that cost no allocation
+// go in: frames already resident (or a translation-only pager's) with the
+// binding's protection, and on a read the shared zero page read-only for
+// unpopulated anonymous pages. A write never commits neighbours it did not
+// touch. Best effort: a neighbour left out simply faults on its own later.
+void fault_around(vm_aspace& aspace, region_child& binding, vmo& obj, uintptr_t page_vaddr, bool write) {
+    size_t window = binding.fault_around;
+    if (window <= 1 || window > FAULT_AROUND_MAX_PAGES) { return; }
+
+    uintptr_t start = page_vaddr & ~(window * PAGE_SIZE - 1);
+    uintptr_t end   = start + window * PAGE_SIZE;
+    if (start < binding.base) { start = binding.base; }
+    if (end > binding.base + binding.size) { end = binding.base + binding.size; }
+    size_t count  = (end - start) / PAGE_SIZE;
+    size_t self   = (page_vaddr - start) / PAGE_SIZE;
+    uint64_t page = (start - binding.base + binding.vmo_offset) / PAGE_SIZE;
+
+    vm_paddr_t frames[FAULT_AROUND_MAX_PAGES];
+    obj.gather_frames(page, count, frames);
+    frames[self]     = 0;  // already mapped by the fault itself
+    size_t installed = aspace.map_pages(start, frames, count, binding.prot, binding.cache);
+
+    if (!write && obj.backing_pager().owns_frames()) {
+        for (size_t i = 0; i < count; ++i) {
+            bool unpopulated = frames[i] == 0 && i != self && page + i < obj.size_pages();
+            frames[i]        = unpopulated ? vmm_zero_page() : 0;
+        }
+        installed += aspace.map_pages(start, frames, count, binding.prot & ~vm_prot::WRITE, binding.cache);
+    }
+    aspace.count_faults_avoided(installed);
+}
 }  // namespace
 
 bool vmm_handle_fault(const vm_fault& fault) {
@@ -35,7 +97,9 @@ bool vmm_handle_fault(const vm_fault& fault) {
     if (active == nullptr || !active->has_root()) { return false; }
     vm_aspace& aspace = *active;
 
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    // The space's own lock: a fault elsewhere, even one filling through a
+    // slow pager, never waits on this one.
+    kernel::synchronization::critical_irq_lock_guard guard(aspace.lock());
     aspace.count_fault();
 
     region_child* binding = aspace.root().find_binding(fault.vaddr);
@@ -68,14 +132,19 @@ bool vmm_handle_fault(const vm_fault& fault) {
 
     // No translation. A read of an unpopulated anonymous page shares the
     // global zero page read-only; the first write lands in resolve_cow.
+    if (map_large_around(aspace, *binding, obj, page_vaddr, fault.write)) { return true; }
+
+    bool mapped = false;
     if (!fault.write && !obj.resident_frame(page).has_value() && obj.backing_pager().owns_frames()) {
-        return aspace.map_page(page_vaddr, vmm_zero_page(), binding->prot & ~vm_prot::WRITE, binding->cache);
+        mapped = aspace.map_page(page_vaddr, vmm_zero_page(), binding->prot & ~vm_prot::WRITE, binding->cache);
+    } else {
+        // Write, or a page the pager already backs: install the real frame.
+        auto fill = obj.get_or_fill_page(page);
+        if (fill.is_err()) { return false; }
+        mapped = aspace.map_page(page_vaddr, fill.unwrap(), binding->prot, binding->cache);
     }
-
-    // Write, or a page the pager already backs: install the real frame.
-    auto fill = obj.get_or_fill_page(page);
-    if (fill.is_err()) { return false; }
-    return aspace.map_page(page_vaddr, fill.unwrap(), binding->prot, binding->cache);
+    if (mapped) { fault_around(aspace, *binding, obj, page_vaddr, fault.write); }
+    return mapped;
 }
 
 }  // namespace kernel::mm
@@ -13,17 +13,18 @@ uintptr_t heap_pages_alloc(size_t pages) {
         auto frame = g_page_frame_allocator.alloc();
         return frame.has_value() ? frame.value() + g_hhdm_offset : 0;
     }
-    // ponytail: multi-page runs carve untouched region tails and are returned below as single
-    // pages, so heavy multi-page alloc/free traffic slowly consumes contiguous capacity; a PMM
-    // that tracks free runs (buddy or equivalent) lifts this ceiling.
     auto frame = g_page_frame_allocator.alloc_contiguous(pages);
     return frame.has_value() ? frame.value() + g_hhdm_offset : 0;
 }
 
+// Single pages go back through the per-core cache they were most likely taken from, so slab and
+// arena churn stays off the PMM lock in both directions.
 void heap_pages_free(uintptr_t base, size_t pages) {
-    for (size_t i = 0; i < pages; ++i) {
-        g_page_frame_allocator.free(base - g_hhdm_offset + i * KERNEL_MINIMUM_PAGE_SIZE);
+    if (pages == 1) {
+        g_page_frame_allocator.free(base - g_hhdm_offset);
+        return;
     }
+    g_page_frame_allocator.free_contiguous(base - g_hhdm_offset, pages);
 }
 
 // Large-run lengths live in the first frame's page descriptor: `owner` stays null for heap frames,
@@ -20,21 +20,36 @@ size_t align_up(size_t value, size_t align) { return (value + align - 1) & ~(ali
 
 }  // namespace
 
-// One page per slab: a header with backref and live bitmap, then the slots. The bitmap is the
-// whole allocation state -- a set bit is a live slot, a clear bit a free one -- and because free
-// slots are zero there is nothing else to maintain.
+// One page per slab: a header with backref, live bitmap and cached bitmap, then the slots. The
+// live bitmap is the whole allocation state -- a set bit is a live slot, a clear bit a free one --
+// and because free slots are zero there is nothing else to maintain. The cached bitmap marks the
+// live slots parked in a magazine: free to callers, so a second free of one is a double free. It
+// sits outside the slot because a slot's bytes are its caller's until the free has been checked.
 struct object_arena::arena_slab {
     uint32_t magic;
     uint32_t live;
     object_arena* owner;
     arena_slab* next;
     arena_slab* prev;
-    // Bitmap words follow the header; slots follow those at the arena's slots offset.
+    // The live bitmap's words follow the header, then as many cached words; slots follow those at
+    // the arena's slots offset.
     uint64_t* bits() { return reinterpret_cast<uint64_t*>(this + 1); }
 
-    bool test_live(size_t slot) { return (bits()[slot >> 6] >> (slot & 63)) & 1; }
-    void mark_live(size_t slot) { bits()[slot >> 6] |= 1ull << (slot & 63); }
-    void clear_live(size_t slot) { bits()[slot >> 6] &= ~(1ull << (slot & 63)); }
+    // Written under the arena lock; free() also reads its caller's bit without it (double-free
+    // check ahead of the magazine), so the words are accessed atomically.
+    bool test_live(size_t slot) { return (__atomic_load_n(&bits()[slot >> 6], __ATOMIC_RELAXED) >> (slot & 63)) & 1; }
+    void mark_live(size_t slot) { __atomic_fetch_or(&bits()[slot >> 6], 1ull << (slot & 63), __ATOMIC_RELAXED); }
+    void clear_live(size_t slot) { __atomic_fetch_and(&bits()[slot >> 6], ~(1ull << (slot & 63)), __ATOMIC_RELAXED); }
+
+    // Set and cleared by whichever core moves the slot into or out of a magazine, lock-free, so
+    // these are atomic read-modify-writes too. mark_cached returns whether the bit was already set.
+    bool mark_cached(size_t words, size_t slot) {
+        uint64_t bit = 1ull << (slot & 63);
+        return (__atomic_fetch_or(&bits()[words + (slot >> 6)], bit, __ATOMIC_RELAXED) & bit) != 0;
+    }
+    void clear_cached(size_t words, size_t slot) {
+        __atomic_fetch_and(&bits()[words + (slot >> 6)], ~(1ull << (slot & 63)), __ATOMIC_RELAXED);
+    }
 };
 
 object_arena* object_arena::first_arena() { return g_arena_list; }
@@ -44,12 +59,12 @@ object_arena::object_arena(const char* name, size_t object_size, size_t align) :
     m_object_size = object_size == 0 ? 1 : object_size;
     m_slot_size   = align_up(m_object_size, align);
 
-    // Solve for the slot count: header, then bitmap words for that many slots, then the slots
-    // themselves, all inside one page. Start from the no-bitmap upper bound and shrink.
+    // Solve for the slot count: header, then both bitmaps' words for that many slots, then the
+    // slots themselves, all inside one page. Start from the no-bitmap upper bound and shrink.
     size_t slots  = (PAGE - sizeof(arena_slab)) / m_slot_size;
     while (slots > 0) {
         size_t words  = (slots + 63) / 64;
-        size_t offset = align_up(sizeof(arena_slab) + words * sizeof(uint64_t), align);
+        size_t offset = align_up(sizeof(arena_slab) + 2 * words * sizeof(uint64_t), align);
         if (offset + slots * m_slot_size <= PAGE) {
             m_bitmap_words = words;
             m_slots_offset = offset;
@@ -65,6 +80,7 @@ object_arena::object_arena(const char* name, size_t object_size, size_t align) :
 }
 
 object_arena::~object_arena() {
+    drain();
     object_arena** link = &g_arena_list;
     while (*link != nullptr && *link != this) { link = &(*link)->m_next; }
     if (*link == this) { *link = m_next; }
@@ -91,6 +107,10 @@ void object_arena::unlink_partial(arena_slab* slab) {
     slab->prev = nullptr;
 }
 
+size_t object_arena::slot_index(arena_slab* slab, void* ptr) const {
+    return (reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(slab) - m_slots_offset) / m_slot_size;
+}
+
 void* object_arena::take_slot(arena_slab* slab) {
     for (size_t word = 0; word < m_bitmap_words; word++) {
         uint64_t bits = slab->bits()[word];
@@ -108,9 +128,20 @@ void* object_arena::take_slot(arena_slab* slab) {
 
 void* object_arena::alloc() {
     check_not_interrupt();
+    void* cached = m_magazines.alloc([this](void** out, size_t count) { return take_batch(out, count); });
+    if (cached != nullptr) {
+        // Cached slots were scrubbed on free, so only the cached bit needs clearing.
+        auto* slab = reinterpret_cast<arena_slab*>(reinterpret_cast<uintptr_t>(cached) & ~(PAGE - 1));
+        slab->clear_cached(m_bitmap_words, slot_index(slab, cached));
+        return cached;
+    }
+    return alloc_slab();
+}
+
+// The slab path: a partial slab's slot, or a fresh slab. The call is already counted.
+void* object_arena::alloc_slab() {
     {
         kernel::synchronization::critical_lock_guard guard(m_lock);
-        m_alloc_calls++;
         if (m_partial != nullptr) { return take_slot(m_partial); }
     }
 
@@ -130,6 +161,19 @@ void* object_arena::alloc() {
     return take_slot(fresh);
 }
 
+// A magazine refill: up to `count` slots from partial slabs in one lock hold, never a new page.
+size_t object_arena::take_batch(void** out, size_t count) {
+    size_t taken = 0;
+    kernel::synchronization::critical_lock_guard guard(m_lock);
+    while (taken < count && m_partial != nullptr) {
+        arena_slab* slab = m_partial;
+        void* slot       = take_slot(slab);
+        slab->mark_cached(m_bitmap_words, slot_index(slab, slot));
+        out[taken++] = slot;
+    }
+    return taken;
+}
+
 void object_arena::free(void* ptr) {
     check_not_interrupt();
     if (ptr == nullptr) { return; }
@@ -144,44 +188,80 @@ void object_arena::free(void* ptr) {
     size_t slot = offset / m_slot_size;
     if (slot >= m_slots_per_slab) { panic("arena: free past slab"); }
 
-    bool release_page = false;
+    // The caller's own live bit cannot change under it, so it is safe to check unlocked; a slot
+    // already parked in a magazine is still live to the slab and has its cached bit set instead.
+    // Setting that bit is the check, so of two racing frees exactly one gets past it.
+    if (!slab->test_live(slot)) { panic("arena: double free"); }
+    if (slab->mark_cached(m_bitmap_words, slot)) { panic("arena: double free of a cached slot"); }
+    // Zero-on-free is the arena's contract: scrub before the slot becomes claimable, on this core
+    // and outside any lock.
+    __builtin_memset(ptr, 0, m_slot_size);
+    m_magazines.free(ptr, [this](void** objects, size_t count) { release_batch(objects, count); });
+}
+
+// Return one slot to its slab under m_lock; true when the slab emptied and its page must go back
+// to the page source once the lock is dropped.
+bool object_arena::release_slot(void* ptr) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    auto* slab        = reinterpret_cast<arena_slab*>(address & ~(PAGE - 1));
+    size_t slot       = slot_index(slab, ptr);
+    if (!slab->test_live(slot)) { panic("arena: double free"); }
+    // Every slot arrives here from a magazine, already scrubbed by the free that cached it.
+    slab->clear_cached(m_bitmap_words, slot);
+    slab->clear_live(slot);
+    slab->live--;
+    m_live--;
+    if (slab->live + 1 == m_slots_per_slab && slab->live != 0) {
+        // Was full: back onto the partial list.
+        slab->next = m_partial;
+        if (m_partial != nullptr) { m_partial->prev = slab; }
+        m_partial = slab;
+    } else if (slab->live == 0) {
+        // Empty: give the page back. Unlink from partial (a one-slot slab can go full ->
+        // empty without ever sitting on the list; unlink_partial's null checks cover that).
+        unlink_partial(slab);
+        m_slab_count--;
+        return true;
+    }
+    return false;
+}
+
+// A magazine flush: every slot back in one lock hold, emptied pages released after it.
+void object_arena::release_batch(void** objects, size_t count) {
+    uintptr_t pages[magazine_cache::ROUNDS];
+    size_t released = 0;
     {
         kernel::synchronization::critical_lock_guard guard(m_lock);
-        m_free_calls++;
-        if (!slab->test_live(slot)) { panic("arena: double free"); }
-        // Zero-on-free is the arena's contract: scrub before the slot becomes claimable.
-        __builtin_memset(ptr, 0, m_slot_size);
-        slab->clear_live(slot);
-        slab->live--;
-        m_live--;
-        if (slab->live + 1 == m_slots_per_slab && slab->live != 0) {
-            // Was full: back onto the partial list.
-            slab->next = m_partial;
-            if (m_partial != nullptr) { m_partial->prev = slab; }
-            m_partial = slab;
-        } else if (slab->live == 0) {
-            // Empty: give the page back. Unlink from partial (a one-slot slab can go full ->
-            // empty without ever sitting on the list; unlink_partial's null checks cover that).
-            unlink_partial(slab);
-            m_slab_count--;
-            release_page = true;
+        for (size_t i = 0; i < count; i++) {
+            if (release_slot(objects[i])) { pages[released++] = reinterpret_cast<uintptr_t>(objects[i]) & ~(PAGE - 1); }
         }
     }
-    if (release_page) { heap_pages_free(reinterpret_cast<uintptr_t>(slab), 1); }
+    for (size_t i = 0; i < released; i++) { heap_pages_free(pages[i], 1); }
+}
+
+void object_arena::drain() {
+    check_not_interrupt();
+    m_magazines.drain([this](void** objects, size_t count) { release_batch(objects, count); });
 }
 
 object_arena_stats object_arena::stats() {
+    // Magazine counters first, so m_lock covers only the slab fields.
+    magazine_stats cached = m_magazines.stats();
     kernel::synchronization::critical_lock_guard guard(m_lock);
     object_arena_stats s;
-    s.name        = m_name;
-    s.object_size = m_object_size;
-    s.slot_size   = m_slot_size;
-    s.slabs       = m_slab_count;
-    s.live        = m_live;
-    s.capacity    = m_slab_count * m_slots_per_slab;
-    s.alloc_calls = m_alloc_calls;
-    s.free_calls  = m_free_calls;
-    s.failures    = m_failures;
+    s.name            = m_name;
+    s.object_size     = m_object_size;
+    s.slot_size       = m_slot_size;
+    s.slabs           = m_slab_count;
+    s.live            = m_live > cached.cached ? m_live - cached.cached : 0;  // read under two locks
+    s.capacity        = m_slab_count * m_slots_per_slab;
+    s.cached          = cached.cached;
+    s.alloc_calls     = cached.allocs;
+    s.free_calls      = cached.frees;
+    s.failures        = m_failures;
+    s.magazine_hits   = cached.hits;
+    s.magazine_misses = cached.misses;
+    s.depot_exchanges = cached.exchanges;
     return s;
 }
 
@@ -190,6 +270,7 @@ object_arena_stats object_arena::stats() {
 // always links the symbols the client headers declare.
 
 object_arena g_thread_arena("thread", sizeof(kernel::sched::Thread), alignof(kernel::sched::Thread));
+object_arena g_fpu_arena("fpu", kernel::arch::FPU_AREA_SIZE, kernel::arch::FPU_AREA_ALIGN);
 
 }  // namespace kernel::mm
 
@@ -200,4 +281,16 @@ void* Thread::operator new(size_t size, const std::nothrow_t&) noexcept {
 }
 void Thread::operator delete(void* ptr) { kernel::mm::g_thread_arena.free(ptr); }
 
+Thread::~Thread() {
+    if (m_fpu_area != nullptr) { kernel::mm::g_fpu_arena.free(m_fpu_area); }
+}
+
+bool Thread::alloc_fpu_area() {
+    void* area = kernel::mm::g_fpu_arena.alloc();
+    if (area == nullptr) { return false; }
+    kernel::arch::fpu_init(area);
+    m_fpu_area = area;
+    return true;
+}
+
 }  // namespace kernel::sched
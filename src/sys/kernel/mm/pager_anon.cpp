@@ -13,4 +13,12 @@ ktl::result<vm_paddr_t> anonymous_pager::fill(uint64_t page) {
     return ktl::result<vm_paddr_t>::ok(frame.value());
 }
 
+// One aligned contiguous run for a large page, zeroed like single frames.
+ktl::result<vm_paddr_t> anonymous_pager::fill_run(uint64_t page, size_t count) {
+    (void)page;
+    auto run = g_page_frame_allocator.alloc_contiguous(count, count);
+    if (!run.has_value()) { return ktl::err(ktl::errc::oom); }
+    return ktl::result<vm_paddr_t>::ok(run.value());
+}
+
 }  // namespace kernel::mm
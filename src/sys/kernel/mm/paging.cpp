@@ -56,10 +56,23 @@ void free_subtree(uint64_t entry, int level) {
     g_page_frame_allocator.free(child);
 }
 
-// Walk down the tree, allocating intermediate tables as needed. Returns a
-// pointer to the leaf-table slot for vaddr, or nullptr on allocation failure
-// or on collision with an existing large-page mapping.
-uint64_t* ensure_leaf_slot(vm_paddr_t root_phys, uintptr_t vaddr, uint64_t leaf_flags) {
+// Bytes one entry at `level` maps: 4 KiB at the deepest level, 2 MiB and
+// 1 GiB above it.
+constexpr uintptr_t level_span(int level) { return uintptr_t{1} << (arch::VA_BITS - 9 * (level + 1)); }
+
+// The level whose entries map `size` bytes, or -1 for a size no level maps.
+constexpr int level_for(size_t size) {
+    for (int level = 0; level < arch::PT_LEVELS; ++level) {
+        if (level_span(level) == size) { return level; }
+    }
+    return -1;
+}
+
+// Walk down the tree to the slot for vaddr at `depth` (the deepest level for
+// a 4K leaf, higher for a large one), allocating intermediate tables as
+// needed. Returns nullptr on allocation failure or on collision with an
+// existing large-page mapping.
+uint64_t* ensure_slot(vm_paddr_t root_phys, uintptr_t vaddr, uint64_t leaf_flags, int depth) {
     uint64_t* table = table_at(root_phys);
 
     // Slots filled in by this walk, so a deeper allocation failure can unwind
@@ -67,7 +80,7 @@ uint64_t* ensure_leaf_slot(vm_paddr_t root_phys, uintptr_t vaddr, uint64_t leaf_
     uint64_t* new_slots[arch::PT_LEVELS - 1];
     int new_count = 0;
 
-    for (int level = 0; level < arch::PT_LEVELS - 1; ++level) {
+    for (int level = 0; level < depth; ++level) {
         uint64_t& slot = table[level_index(vaddr, level)];
         if (!arch::pte_present(slot)) {
             auto child = alloc_table();
@@ -87,21 +100,60 @@ uint64_t* ensure_leaf_slot(vm_paddr_t root_phys, uintptr_t vaddr, uint64_t leaf_
         }
         table = table_at(arch::pte_addr(slot));
     }
-    return &table[level_index(vaddr, arch::PT_LEVELS - 1)];
+    return &table[level_index(vaddr, depth)];
 }
 
-// Walk down the tree without allocating. Returns a pointer to the leaf-table
-// slot, or nullptr if any intermediate is missing or a large-page leaf.
-uint64_t* find_leaf_slot(vm_paddr_t root_phys, uintptr_t vaddr) {
+uint64_t* ensure_leaf_slot(vm_paddr_t root_phys, uintptr_t vaddr, uint64_t leaf_flags) {
+    return ensure_slot(root_phys, vaddr, leaf_flags, arch::PT_LEVELS - 1);
+}
+
+// Walk down the tree without allocating to the slot holding vaddr's terminal
+// entry: a large leaf where the walk meets one, else the deepest-level slot.
+// Returns nullptr if an intermediate is missing; `level` is where it stopped.
+uint64_t* find_terminal_slot(vm_paddr_t root_phys, uintptr_t vaddr, int& level) {
     uint64_t* table = table_at(root_phys);
 
-    for (int level = 0; level < arch::PT_LEVELS - 1; ++level) {
-        uint64_t entry = table[level_index(vaddr, level)];
-        if (!arch::pte_present(entry)) { return nullptr; }
-        if (arch::pte_leaf(entry)) { return nullptr; }
-        table = table_at(arch::pte_addr(entry));
+    for (level = 0; level < arch::PT_LEVELS - 1; ++level) {
+        uint64_t& slot = table[level_index(vaddr, level)];
+        if (!arch::pte_present(slot)) { return nullptr; }
+        if (arch::pte_leaf(slot)) { return &slot; }
+        table = table_at(arch::pte_addr(slot));
     }
-    return &table[level_index(vaddr, arch::PT_LEVELS - 1)];
+    return &table[level_index(vaddr, level)];
+}
+
+// Collapse the table `slot` (an entry at `level`) points to into one large
+// leaf when its 512 entries are leaves mapping one physically contiguous,
+// naturally aligned span with the same attributes. Children go first, so a
+// table of 4K leaves can become a 2M leaf and a table of those a 1G leaf.
+// Only for tables no CPU walks yet: there is no TLB maintenance. Returns the
+// table frames freed.
+size_t collapse_table(uint64_t& slot, int level) {
+    if (!arch::pte_present(slot) || arch::pte_leaf(slot) || level >= arch::PT_LEVELS - 1) { return 0; }
+    uint64_t* table = table_at(arch::pte_addr(slot));
+    int child       = level + 1;
+    bool bottom     = child == arch::PT_LEVELS - 1;
+    size_t freed    = 0;
+    if (!bottom) {
+        for (size_t i = 0; i < 512; ++i) { freed += collapse_table(table[i], child); }
+    }
+    if (!arch::large_page_supported(level_span(level))) { return freed; }
+
+    vm_paddr_t base = arch::pte_addr(table[0]);
+    if ((base & (level_span(level) - 1)) != 0) { return freed; }
+    vm_translation attrs = arch::attrs_from_pte(table[0], base);
+    for (size_t i = 0; i < 512; ++i) {
+        uint64_t entry = table[i];
+        bool leaf      = arch::pte_present(entry) && (bottom ? arch::pte_leaf_bottom(entry) : arch::pte_leaf(entry));
+        if (!leaf || arch::pte_addr(entry) != base + i * level_span(child)) { return freed; }
+        if (bottom && arch::pte_promote(entry) == 0) { return freed; }
+        vm_translation entry_attrs = arch::attrs_from_pte(entry, 0);
+        if (entry_attrs.prot != attrs.prot || entry_attrs.cache != attrs.cache) { return freed; }
+    }
+    vm_paddr_t frame = arch::pte_addr(slot);
+    slot             = bottom ? arch::pte_promote(table[0]) : table[0];
+    g_page_frame_allocator.free(frame);
+    return freed + 1;
 }
 
 // Resolve vaddr to its terminal PTE, transparently handling the large pages
@@ -236,6 +288,96 @@ bool vm_aspace::map_page(uintptr_t vaddr, vm_paddr_t paddr, vm_prot_t prot, vm_c
     return true;
 }
 
+size_t vm_aspace::map_pages(uintptr_t vaddr, const vm_paddr_t* paddrs, size_t count, vm_prot_t prot,
+                            vm_cache_mode cache) {
+    if (m_arch.root_phys == 0 || count == 0) { return 0; }
+    if ((vaddr & 0xFFF) != 0) { return 0; }
+    if (!(prot & vm_prot::READ)) { return 0; }
+    // Both ends canonical and in the same half, so the batch never crosses the hole.
+    uintptr_t last = vaddr + (count - 1) * 0x1000;
+    if (last < vaddr || !is_canonical(vaddr) || !is_canonical(last)) { return 0; }
+    if ((vaddr >> (arch::VA_BITS - 1)) != (last >> (arch::VA_BITS - 1))) { return 0; }
+
+    // A leaf table spans 512 pages; its slot pointer is reused until the batch crosses into the next.
+    constexpr uintptr_t TABLE_SPAN = uintptr_t{512} << 12;
+    uint64_t flags                 = arch::leaf_flags(prot, cache);
+    uint64_t* table                = nullptr;
+    uintptr_t table_base           = 0;
+    uintptr_t low                  = 0;
+    uintptr_t high                 = 0;
+    size_t installed               = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (paddrs[i] == 0 || (paddrs[i] & 0xFFF) != 0) { continue; }
+        uintptr_t page = vaddr + i * 0x1000;
+        if (table == nullptr || (page & ~(TABLE_SPAN - 1)) != table_base) {
+            uint64_t* slot = ensure_leaf_slot(m_arch.root_phys, page, flags);
+            if (slot == nullptr) { break; }
+            table      = slot - level_index(page, arch::PT_LEVELS - 1);
+            table_base = page & ~(TABLE_SPAN - 1);
+        }
+        uint64_t& leaf = table[level_index(page, arch::PT_LEVELS - 1)];
+        if (arch::pte_present(leaf)) { continue; }  // never replaced, as in map_page
+
+        leaf = arch::make_leaf(paddrs[i], flags);
+        arch::flush_new_leaf(m_arch.root_phys, page);
+        if (installed == 0) { low = page; }
+        high = page;
+        ++installed;
+    }
+    if (installed != 0) {
+        if (uint64_t remote = remote_cores_with(this)) { arch::shootdown_tlb_range(remote, low, high - low + 0x1000); }
+    }
+    return installed;
+}
+
+bool vm_aspace::map_large(uintptr_t vaddr, vm_paddr_t paddr, size_t size, vm_prot_t prot, vm_cache_mode cache) {
+    if (m_arch.root_phys == 0) { return false; }
+    if (!large_page_supported(size)) { return false; }
+    if ((vaddr & (size - 1)) != 0 || (paddr & (size - 1)) != 0) { return false; }
+    if (!is_canonical(vaddr) || !is_canonical(vaddr + size - 1)) { return false; }
+    if (!(prot & vm_prot::READ)) { return false; }
+
+    uint64_t flags = arch::leaf_flags(prot, cache);
+    uint64_t* slot = ensure_slot(m_arch.root_phys, vaddr, flags, level_for(size));
+    if (slot == nullptr) { return false; }
+    // Anything already there -- a leaf, or a table even if empty -- keeps the
+    // span; the caller falls back to 4K pages.
+    if (arch::pte_present(*slot)) { return false; }
+
+    *slot = arch::make_large_leaf(paddr, flags);
+    arch::flush_new_leaf(m_arch.root_phys, vaddr);
+    if (uint64_t remote = remote_cores_with(this)) { arch::shootdown_tlb_page(remote, vaddr); }
+    return true;
+}
+
+bool vm_aspace::span_empty(uintptr_t vaddr, size_t size) const {
+    int depth = level_for(size);
+    if (m_arch.root_phys == 0 || depth < 0 || !is_canonical(vaddr)) { return false; }
+    uint64_t* table = table_at(m_arch.root_phys);
+    for (int level = 0; level <= depth; ++level) {
+        uint64_t entry = table[level_index(vaddr, level)];
+        if (!arch::pte_present(entry)) { return true; }
+        if (level == depth || arch::pte_leaf(entry)) { return false; }
+        table = table_at(arch::pte_addr(entry));
+    }
+    return false;
+}
+
+bool vm_aspace::large_page_supported(size_t size) {
+    int level = level_for(size);
+    return level >= 0 && level < arch::PT_LEVELS - 1 && arch::large_page_supported(size);
+}
+
+size_t vm_aspace::promote_kernel_range(uintptr_t base, size_t size) {
+    if (m_arch.root_phys == 0 || size == 0) { return 0; }
+    uint64_t* root = table_at(m_arch.root_phys);
+    size_t first   = level_index(base, 0);
+    size_t last    = level_index(base + size - 1, 0);
+    size_t freed   = 0;
+    for (size_t i = first; i <= last && i < 512; ++i) { freed += collapse_table(root[i], 0); }
+    return freed;
+}
+
 ktl::maybe<vm_paddr_t> vm_aspace::walk(uintptr_t vaddr) const {
     if (m_arch.root_phys == 0) { return ktl::nothing; }
     if (!is_canonical(vaddr)) { return ktl::nothing; }
@@ -250,9 +392,11 @@ ktl::maybe<vm_translation> vm_aspace::walk_ext(uintptr_t vaddr) const {
     if (!is_canonical(vaddr)) { return ktl::nothing; }
     auto term = resolve(m_arch.root_phys, vaddr);
     if (!term.has_value()) { return ktl::nothing; }
-    vm_paddr_t base  = arch::pte_addr(term.value().entry) & ~term.value().offset_mask;
-    vm_paddr_t paddr = base | (vaddr & term.value().offset_mask);
-    return arch::attrs_from_pte(term.value().entry, paddr);
+    vm_paddr_t base       = arch::pte_addr(term.value().entry) & ~term.value().offset_mask;
+    vm_paddr_t paddr      = base | (vaddr & term.value().offset_mask);
+    vm_translation result = arch::attrs_from_pte(term.value().entry, paddr);
+    result.size           = term.value().offset_mask + 1;
+    return result;
 }
 
 ktl::maybe<vm_paddr_t> vm_aspace::unmap_page(uintptr_t vaddr) {
@@ -260,11 +404,12 @@ ktl::maybe<vm_paddr_t> vm_aspace::unmap_page(uintptr_t vaddr) {
     if (!is_canonical(vaddr)) { return ktl::nothing; }
     if ((vaddr & 0xFFF) != 0) { return ktl::nothing; }
 
-    // 4K only: large mappings are bootloader-owned kernel mappings and are
-    // never torn down through this path.
-    uint64_t* leaf = find_leaf_slot(m_arch.root_phys, vaddr);
+    // A large leaf comes down whole, and only from its base address.
+    int level      = 0;
+    uint64_t* leaf = find_terminal_slot(m_arch.root_phys, vaddr, level);
     if (leaf == nullptr) { return ktl::nothing; }
     if (!arch::pte_present(*leaf)) { return ktl::nothing; }
+    if ((vaddr & (level_span(level) - 1)) != 0) { return ktl::nothing; }
 
     vm_paddr_t paddr = arch::pte_addr(*leaf);
     *leaf            = 0;
@@ -273,6 +418,38 @@ ktl::maybe<vm_paddr_t> vm_aspace::unmap_page(uintptr_t vaddr) {
     return paddr;
 }
 
+size_t vm_aspace::unmap_pages(uintptr_t vaddr, size_t count) {
+    if (m_arch.root_phys == 0 || count == 0) { return 0; }
+    if ((vaddr & 0xFFF) != 0) { return 0; }
+    uintptr_t last = vaddr + (count - 1) * 0x1000;
+    if (last < vaddr || !is_canonical(vaddr) || !is_canonical(last)) { return 0; }
+    if ((vaddr >> (arch::VA_BITS - 1)) != (last >> (arch::VA_BITS - 1))) { return 0; }
+
+    uintptr_t low  = 0;
+    uintptr_t high = 0;  // exclusive
+    size_t removed = 0;
+    for (uintptr_t page = vaddr; page <= last;) {
+        int level      = 0;
+        uint64_t* leaf = find_terminal_slot(m_arch.root_phys, page, level);
+        // A missing intermediate or a leaf entered past its base skips the span it covers.
+        uintptr_t span = level_span(level);
+        uintptr_t next = (page & ~(span - 1)) + span;
+        if (leaf != nullptr && arch::pte_present(*leaf) && (page & (span - 1)) == 0) {
+            *leaf = 0;
+            arch::flush_tlb_page(m_arch.root_phys, page);
+            if (removed == 0) { low = page; }
+            high = next;
+            ++removed;
+        }
+        if (next <= page) { break; }  // the top of the half
+        page = next;
+    }
+    if (removed != 0) {
+        if (uint64_t remote = remote_cores_with(this)) { arch::shootdown_tlb_range(remote, low, high - low); }
+    }
+    return removed;
+}
+
 void vm_aspace::activate() {
     arch::set_root(m_arch.root_phys);
     g_active_space[kernel::arch::current_core_index()] = this;
@@ -2,37 +2,131 @@
 
 #include <std/string.h>
 
+#include "kernel/arch.h"
 #include "kernel/config.h"
 #include "kernel/mm/page.h"
 #include "kernel/mm/page_descriptor.h"
+#include "kernel/synchronization/execution_context.h"
 
 extern uintptr_t g_hhdm_offset;
 
 namespace kernel::mm {
 
-namespace { constexpr size_t PAGE_SIZE = KERNEL_MINIMUM_PAGE_SIZE; }  // namespace
+namespace {
+
+constexpr size_t PAGE_SIZE = KERNEL_MINIMUM_PAGE_SIZE;
+
+void bump(uint64_t& counter) { __atomic_store_n(&counter, counter + 1, __ATOMIC_RELAXED); }
+
+}  // namespace
 
 ktl::maybe<vm_paddr_t> page_frame_allocator::alloc() {
-    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
-    // Fetch a zeroed page: from the pool, a pre-zeroed region tail, or by
-    // zeroing a free page inline as the last resort.
-    auto page = m_zeroed.pop()
-                    .or_else([this] {
-                        bool pre_zeroed = false;
-                        return pop_free_page(pre_zeroed).map([&](vm_paddr_t p) {
-                            if (!pre_zeroed) { zero_page(p); }
-                            return p;
-                        });
-                    })
-                    .inspect([this](vm_paddr_t p) {
-                        --m_free_pages;
-                        ++m_alloc_count;
-                        g_page_descriptors.set_state(p, page_state::ACTIVE);
-                    });
-    if (!page.has_value()) { ++m_alloc_failures; }
+    // Interrupts off keeps this core's lists ours -- no preemption, no migration, no interrupt
+    // handler allocating underneath -- without a lock.
+    kernel::synchronization::critical_irq_section local;
+    core_cache& core = m_cores[kernel::arch::current_core_index()];
+    catch_up(core);
+    if (core.cold.size() + core.hot.size() != 0) {
+        bump(core.hits);
+    } else if (!refill(core)) {
+        return ktl::nothing;
+    }
+    // A zeroed page first; a hot one still owes its memset, but its lines are likely in this
+    // core's cache.
+    vm_paddr_t page = 0;
+    if (auto cold = core.cold.pop()) {
+        page = cold.value();
+    } else {
+        page = core.hot.pop().value();
+        zero_page(page);
+    }
+    g_page_descriptors.set_state(page, page_state::ACTIVE);
+    bump(core.allocs);
+    __atomic_store_n(&core.cold_pages, core.cold.size(), __ATOMIC_RELAXED);
+    __atomic_store_n(&core.hot_pages, core.hot.size(), __ATOMIC_RELAXED);
     return page;
 }
 
+bool page_frame_allocator::refill(core_cache& core) {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    // Recycled memory first (a clean block preferred), then a region tail; pre-zeroed pages go
+    // cold and the rest hot, to be zeroed as they are handed out.
+    size_t moved    = 0;
+    bool pre_zeroed = false;
+    while (moved < CACHE_BATCH) {
+        auto page = pop_free_page(pre_zeroed);
+        if (!page.has_value()) { break; }
+        (pre_zeroed ? core.cold : core.hot).push(page.value());
+        ++moved;
+    }
+    if (moved == 0) {
+        ++m_alloc_failures;
+        return false;
+    }
+    m_free_pages -= moved;
+    bump(core.refills);
+    return true;
+}
+
+void page_frame_allocator::drain_hot(core_cache& core) {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    for (size_t i = 0; i < CACHE_BATCH; ++i) {
+        auto page = core.hot.pop();
+        if (!page.has_value()) { break; }
+        m_buddy.release(page.value() / PAGE_SIZE, 1);
+        ++m_free_pages;
+    }
+    bump(core.drains);
+}
+
+// A flush ran since this core last touched its lists: hand all of them back. Interrupts are off.
+void page_frame_allocator::catch_up(core_cache& core) {
+    uint64_t generation = __atomic_load_n(&m_flush_generation, __ATOMIC_RELAXED);
+    if (core.generation == generation) { return; }
+    core.generation = generation;
+    if (core.cold.size() + core.hot.size() == 0) { return; }
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    while (auto page = core.cold.pop()) {
+        ++m_buddy_zeroed;
+        m_buddy.release(page.value() / PAGE_SIZE, 1);
+        ++m_free_pages;
+    }
+    while (auto page = core.hot.pop()) {
+        m_buddy.release(page.value() / PAGE_SIZE, 1);
+        ++m_free_pages;
+    }
+    bump(core.drains);
+    __atomic_store_n(&core.cold_pages, size_t{0}, __ATOMIC_RELAXED);
+    __atomic_store_n(&core.hot_pages, size_t{0}, __ATOMIC_RELAXED);
+}
+
+// The caches are lock-free because only their own core touches them, so this cannot reach into
+// another core's lists. It empties the calling core's now; every other core empties its own at its
+// next single-page alloc or free, as the magazine layer's drain works.
+void page_frame_allocator::flush_caches() {
+    __atomic_fetch_add(&m_flush_generation, 1, __ATOMIC_RELAXED);
+    kernel::synchronization::critical_irq_section local;
+    catch_up(m_cores[kernel::arch::current_core_index()]);
+}
+
+uint8_t page_frame_allocator::descriptor_frames::order_tag(uint64_t frame) {
+    const page_descriptor* descriptor = g_page_descriptors.lookup(frame * PAGE_SIZE);
+    return descriptor != nullptr ? descriptor->free_order : 0;
+}
+
+void page_frame_allocator::descriptor_frames::set_order_tag(uint64_t frame, uint8_t tag) {
+    if (page_descriptor* descriptor = g_page_descriptors.lookup(frame * PAGE_SIZE)) { descriptor->free_order = tag; }
+}
+
+buddy_link& page_frame_allocator::descriptor_frames::link(uint64_t frame) {
+    return *reinterpret_cast<buddy_link*>(frame * PAGE_SIZE + g_hhdm_offset);
+}
+
+bool page_frame_allocator::descriptor_frames::zeroed(uint64_t frame) {
+    const page_descriptor* descriptor = g_page_descriptors.lookup(frame * PAGE_SIZE);
+    return descriptor != nullptr && descriptor->state == page_state::ZEROED;
+}
+
 void page_frame_allocator::frame_stack::push(vm_paddr_t addr) {
     *reinterpret_cast<vm_paddr_t*>(addr + g_hhdm_offset) = m_head;
     m_head                                               = addr;
@@ -50,63 +144,161 @@ ktl::maybe<vm_paddr_t> page_frame_allocator::frame_stack::pop() {
 }
 
 void page_frame_allocator::free(vm_paddr_t addr) {
+    // Frames without a descriptor cannot carry the FREE state the double-free check and the
+    // buddy key on; they take the global path to the uncovered stack.
+    const page_descriptor* descriptor = g_page_descriptors.lookup(addr);
+    if (descriptor == nullptr) {
+        free_contiguous(addr, 1);
+        return;
+    }
+    kernel::synchronization::critical_irq_section local;
+    if (descriptor->state == page_state::FREE || descriptor->state == page_state::ZEROED) {
+        panic("pmm: double free of a frame");
+    }
+    g_page_descriptors.set_state(addr, page_state::FREE);
+    core_cache& core = m_cores[kernel::arch::current_core_index()];
+    catch_up(core);
+    core.hot.push(addr);
+    bump(core.frees);
+    if (core.hot.size() > CACHE_HOT_MAX) {
+        drain_hot(core);
+    } else {
+        bump(core.hits);
+    }
+    __atomic_store_n(&core.hot_pages, core.hot.size(), __ATOMIC_RELAXED);
+}
+
+void page_frame_allocator::free_contiguous(vm_paddr_t base, size_t count) {
     kernel::synchronization::critical_irq_lock_guard guard(m_lock);
-    // A frame already back in a pool would be threaded onto the intrusive stack twice, aliasing
-    // two future allocations forever -- with descriptor coverage a double free is detectable, so
-    // detect it. Uncovered frames (pre-VMM boot) stay tolerated, matching set_state's contract.
-    if (const auto* descriptor = g_page_descriptors.lookup(addr)) {
-        if (descriptor->state == page_state::FREE || descriptor->state == page_state::ZEROED) {
-            panic("pmm: double free of a frame");
+    // A frame already free would be linked into the pools twice, aliasing two future allocations
+    // forever -- with descriptor coverage a double free is detectable, so detect it. Uncovered
+    // frames (pre-VMM boot) stay tolerated, matching set_state's contract.
+    bool covered = true;
+    for (size_t p = 0; p < count; ++p) {
+        vm_paddr_t addr = base + p * PAGE_SIZE;
+        if (const auto* descriptor = g_page_descriptors.lookup(addr)) {
+            if (descriptor->state == page_state::FREE || descriptor->state == page_state::ZEROED) {
+                panic("pmm: double free of a frame");
+            }
+        } else {
+            covered = false;
         }
+        g_page_descriptors.set_state(addr, page_state::FREE);
     }
-    m_dirty.push(addr);
-    ++m_free_pages;
-    ++m_free_count;
-    g_page_descriptors.set_state(addr, page_state::FREE);
+    if (covered) {
+        m_buddy.release(base / PAGE_SIZE, count);
+    } else {
+        for (size_t p = 0; p < count; ++p) { m_uncovered.push(base + p * PAGE_SIZE); }
+    }
+    m_free_pages += count;
+    m_free_count += count;
 }
 
-ktl::maybe<vm_paddr_t> page_frame_allocator::alloc_contiguous(size_t count) {
+ktl::maybe<vm_paddr_t> page_frame_allocator::alloc_contiguous(size_t count, size_t align) {
     // A zero-page run would "succeed" at the first region's tail with a base above its free
     // space -- an address the allocator does not own. There is nothing coherent to return.
-    if (count == 0) { return ktl::nothing; }
+    if (count == 0 || align == 0 || (align & (align - 1)) != 0) { return ktl::nothing; }
 
-    vm_paddr_t base  = 0;
-    size_t need_zero = 0;
-    bool carved      = false;
-    {
+    constexpr size_t MAX_RECYCLED     = size_t{1} << buddy_allocator<descriptor_frames>::MAX_ORDER;
+    uint64_t dirty[MAX_RECYCLED / 64] = {};  // recycled pages still owing a memset
+    bool recycled                     = false;
+    size_t need_zero                  = 0;
+    auto run                          = take_run(count, align, dirty, recycled, need_zero);
+    if (!run.has_value()) {
+        // Single pages parked in the per-core caches are invisible to the buddy, and one of them
+        // may be all a run is missing to coalesce. Give them back and look once more.
+        flush_caches();
+        run = take_run(count, align, dirty, recycled, need_zero);
+    }
+    if (!run.has_value()) {
         kernel::synchronization::critical_irq_lock_guard guard(m_lock);
-        for (size_t i = m_regions.size(); i-- > 0;) {
-            auto& region = m_regions[i];
-            if (region.count < count) { continue; }
-            region.count -= count;
-            base       = region.start + region.count * PAGE_SIZE;
-            // The carved run's high end may overlap the pre-zeroed tail; only the
-            // low pages still need a memset.
-            size_t pre = region.zeroed_count < count ? region.zeroed_count : count;
-            region.zeroed_count -= pre;
-            m_region_zeroed -= pre;
-            need_zero = count - pre;
-            for (size_t p = 0; p < count; ++p) {
-                g_page_descriptors.set_state(base + p * PAGE_SIZE, page_state::ACTIVE);
-            }
-            m_free_pages -= count;
-            carved = true;
-            break;
-        }
-        if (!carved) { ++m_alloc_failures; }
+        ++m_alloc_failures;
+        return ktl::nothing;
     }
-    if (!carved) { return ktl::nothing; }
 
     // Zero outside the lock: an unbounded memset under the IRQ-off spinlock would stall the whole
-    // core for the run's length. The pages are already carved and marked ACTIVE, so this thread
+    // core for the run's length. The pages are already taken and marked ACTIVE, so this thread
     // is their sole owner and nothing else can hand them out or scan them mid-zero.
-    for (size_t p = 0; p < need_zero; ++p) { zero_page(base + p * PAGE_SIZE); }
+    vm_paddr_t base = run.value();
+    for (size_t p = 0; p < count; ++p) {
+        bool owed = recycled ? ((dirty[p / 64] >> (p % 64)) & 1) != 0 : p < need_zero;
+        if (owed) { zero_page(base + p * PAGE_SIZE); }
+    }
     return base;
 }
 
+// One attempt at a run under the lock: a recycled buddy block, else a region tail carve. A recycled
+// run's pages still owing a memset are flagged in `dirty`; a carved run's are its low `need_zero`.
+ktl::maybe<vm_paddr_t> page_frame_allocator::take_run(size_t count, size_t align, uint64_t* dirty, bool& recycled,
+                                                      size_t& need_zero) {
+    // Buddy blocks are aligned to their own size, so a run is aligned to the power of two
+    // that covers it.
+    size_t block = 1;
+    while (block < count) { block <<= 1; }
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    ktl::maybe<vm_paddr_t> run;
+    uint64_t frame = 0;
+    if (align <= block && m_buddy.take_run(count, frame)) {
+        recycled = true;
+        run      = frame * PAGE_SIZE;
+        for (size_t p = 0; p < count; ++p) {
+            if (descriptor_frames{}.zeroed(frame + p)) {
+                --m_buddy_zeroed;
+            } else {
+                dirty[p / 64] |= uint64_t{1} << (p % 64);
+            }
+            g_page_descriptors.set_state((frame + p) * PAGE_SIZE, page_state::ACTIVE);
+        }
+        m_free_pages -= count;
+    } else {
+        run = carve_region_tail(count, align, need_zero);
+    }
+    if (run.has_value()) { m_alloc_count += count; }
+    return run;
+}
+
+ktl::maybe<vm_paddr_t> page_frame_allocator::carve_region_tail(size_t count, size_t align, size_t& need_zero) {
+    for (size_t i = m_regions.size(); i-- > 0;) {
+        auto& region = m_regions[i];
+        if (region.count < count) { continue; }
+        vm_paddr_t top  = region.start + region.count * PAGE_SIZE;
+        vm_paddr_t base = (top - count * PAGE_SIZE) & ~(align * PAGE_SIZE - 1);
+        if (base < region.start) { continue; }
+        // Pages above an aligned run join the buddy, which needs descriptors to key on.
+        size_t slack = (top - base) / PAGE_SIZE - count;
+        if (slack != 0 && g_page_descriptors.lookup(base) == nullptr) { continue; }
+        region.count = (base - region.start) / PAGE_SIZE;
+
+        // The pre-zeroed tail covers the slack first, then the carved run's high end; only the
+        // run's low pages still need a memset.
+        size_t slack_pre = region.zeroed_count < slack ? region.zeroed_count : slack;
+        region.zeroed_count -= slack_pre;
+        size_t pre = region.zeroed_count < count ? region.zeroed_count : count;
+        region.zeroed_count -= pre;
+        m_region_zeroed -= slack_pre + pre;
+        need_zero = count - pre;
+        if (slack != 0) {
+            m_buddy_zeroed += slack_pre;
+            m_buddy.release(base / PAGE_SIZE + count, slack);
+        }
+        for (size_t p = 0; p < count; ++p) { g_page_descriptors.set_state(base + p * PAGE_SIZE, page_state::ACTIVE); }
+        m_free_pages -= count;
+        return base;
+    }
+    return ktl::nothing;
+}
+
 ktl::maybe<vm_paddr_t> page_frame_allocator::pop_free_page(bool& pre_zeroed) {
-    pre_zeroed = false;
-    if (auto addr = m_dirty.pop()) { return addr; }
+    pre_zeroed     = false;
+    uint64_t frame = 0;
+    if (m_buddy.take(0, frame)) {
+        if (descriptor_frames{}.zeroed(frame)) {
+            pre_zeroed = true;
+            --m_buddy_zeroed;
+        }
+        return frame * PAGE_SIZE;
+    }
+    if (auto addr = m_uncovered.pop()) { return addr; }
 
     while (!m_regions.empty()) {
         auto& region = m_regions[m_regions.size() - 1];
@@ -129,22 +321,51 @@ void page_frame_allocator::zero_page(vm_paddr_t addr) {
 }
 
 bool page_frame_allocator::zero_one_page() {
+    // The running core's hot pages first: they are the next ones it hands out, and no other core
+    // can reach them.
+    {
+        kernel::synchronization::critical_irq_section local;
+        core_cache& core = m_cores[kernel::arch::current_core_index()];
+        if (core.hot.size() != 0 && core.cold.size() < CACHE_COLD_MAX) {
+            vm_paddr_t page = core.hot.pop().value();
+            zero_page(page);
+            g_page_descriptors.set_state(page, page_state::ZEROED);
+            core.cold.push(page);
+            __atomic_store_n(&core.cold_pages, core.cold.size(), __ATOMIC_RELAXED);
+            __atomic_store_n(&core.hot_pages, core.hot.size(), __ATOMIC_RELAXED);
+            return true;
+        }
+    }
+
     kernel::synchronization::critical_irq_lock_guard guard(m_lock);
     // Zeroing under the lock keeps every page in exactly one place at all
     // times, so allocators never observe an in-flight frame.
 
-    // Dirty pages always drain into the pool: they are pages already
-    // circulating, so the pool never grows past what free() handed back.
-    if (auto page = m_dirty.pop()) {
-        zero_page(page.value());
-        m_zeroed.push(page.value());
-        g_page_descriptors.set_state(page.value(), page_state::ZEROED);
-        return true;
+    // Dirty recycled blocks are always zeroed: they are pages already
+    // circulating, so this never does more than free() handed back.
+    bool stepped = m_buddy.zero_step([this](uint64_t frame) {
+        zero_page(frame * PAGE_SIZE);
+        g_page_descriptors.set_state(frame * PAGE_SIZE, page_state::ZEROED);
+        ++m_buddy_zeroed;
+    });
+    if (stepped) { return true; }
+
+    // Frames freed before the descriptor table existed join the buddy once
+    // it covers them.
+    if (auto page = m_uncovered.pop()) {
+        if (g_page_descriptors.lookup(page.value()) != nullptr) {
+            zero_page(page.value());
+            g_page_descriptors.set_state(page.value(), page_state::ZEROED);
+            ++m_buddy_zeroed;
+            m_buddy.release(page.value() / PAGE_SIZE, 1);
+            return true;
+        }
+        m_uncovered.push(page.value());
     }
 
     // Pre-zero untouched region tails in place -- a counter per region, no
-    // pool entries -- until all free memory is zeroed.
-    if (zeroed_pages() >= m_free_pages) { return false; }
+    // pool entries -- until all free memory in the global pools is zeroed.
+    if (m_buddy_zeroed + m_region_zeroed >= m_free_pages) { return false; }
     for (size_t i = m_regions.size(); i-- > 0;) {
         auto& region = m_regions[i];
         if (region.zeroed_count == region.count) { continue; }
@@ -158,18 +379,67 @@ bool page_frame_allocator::zero_one_page() {
     return false;
 }
 
+size_t page_frame_allocator::longest_run() const {
+    size_t longest = m_buddy.largest_block();
+    for (const auto& region : m_regions) {
+        if (region.count > longest) { longest = region.count; }
+    }
+    return longest;
+}
+
+size_t page_frame_allocator::largest_free_run() {
+    flush_caches();  // cached single pages may complete a run once back in the buddy
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    return longest_run();
+}
+
+size_t page_frame_allocator::free_pages() const {
+    size_t pages = __atomic_load_n(&m_free_pages, __ATOMIC_RELAXED);
+    for (const core_cache& core : m_cores) {
+        pages += __atomic_load_n(&core.cold_pages, __ATOMIC_RELAXED);
+        pages += __atomic_load_n(&core.hot_pages, __ATOMIC_RELAXED);
+    }
+    return pages;
+}
+
+size_t page_frame_allocator::zeroed_pages() const {
+    size_t pages = __atomic_load_n(&m_buddy_zeroed, __ATOMIC_RELAXED);
+    pages += __atomic_load_n(&m_region_zeroed, __ATOMIC_RELAXED);
+    for (const core_cache& core : m_cores) { pages += __atomic_load_n(&core.cold_pages, __ATOMIC_RELAXED); }
+    return pages;
+}
+
 pmm_stats page_frame_allocator::stats() {
+    pmm_stats cores{};
+    for (const core_cache& core : m_cores) {
+        size_t cold = __atomic_load_n(&core.cold_pages, __ATOMIC_RELAXED);
+        size_t hot  = __atomic_load_n(&core.hot_pages, __ATOMIC_RELAXED);
+        cores.zeroed_cached += cold;
+        cores.cached += cold + hot;
+        cores.alloc_count += __atomic_load_n(&core.allocs, __ATOMIC_RELAXED);
+        cores.free_count += __atomic_load_n(&core.frees, __ATOMIC_RELAXED);
+        cores.cache_hits += __atomic_load_n(&core.hits, __ATOMIC_RELAXED);
+        cores.cache_refills += __atomic_load_n(&core.refills, __ATOMIC_RELAXED);
+        cores.cache_drains += __atomic_load_n(&core.drains, __ATOMIC_RELAXED);
+    }
     kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    size_t global_dirty = m_buddy.free_frames() - m_buddy_zeroed + m_uncovered.size();
     return pmm_stats{
         .total_pages        = m_total_pages,
-        .free_pages         = m_free_pages,
+        .free_pages         = m_free_pages + cores.cached,
         .reserved_pages     = m_reserved_pages,
-        .zeroed_pooled      = m_zeroed.size(),
+        .zeroed_pooled      = m_buddy_zeroed,
         .zeroed_region_tail = m_region_zeroed,
-        .dirty              = m_dirty.size(),
-        .alloc_count        = m_alloc_count,
-        .free_count         = m_free_count,
+        .zeroed_cached      = cores.zeroed_cached,
+        .dirty              = global_dirty + cores.cached - cores.zeroed_cached,
+        .cached             = cores.cached,
+        .largest_free_run   = longest_run(),
+        .alloc_count        = cores.alloc_count + m_alloc_count,
+        .free_count         = cores.free_count + m_free_count,
         .alloc_failures     = m_alloc_failures,
+        .cache_hits         = cores.cache_hits,
+        .cache_refills      = cores.cache_refills,
+        .cache_drains       = cores.cache_drains,
     };
 }
 
@@ -68,13 +68,18 @@ void Region::remove_slot(region_child& slot) {
 }
 
 void Region::zap_range(uintptr_t base, size_t size) {
-    for (uintptr_t vaddr = base; vaddr < base + size; vaddr += PAGE_SIZE) {
+    // A large leaf lies wholly inside its binding and comes down from its base in one step.
+    uintptr_t vaddr = base;
+    while (vaddr < base + size) {
+        auto mapped = m_aspace.walk_ext(vaddr);
+        size_t step = mapped.has_value() ? mapped.value().size : PAGE_SIZE;
         (void)m_aspace.unmap_page(vaddr);  // absent pages are fine
+        vaddr += step;
     }
 }
 
 ktl::result<ktl::ref<Region>> Region::create_child(uintptr_t base, size_t size, vm_prot_t max_prot) {
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
     auto slot = insert_slot(base, size, max_prot);
     if (slot.is_err()) { return ktl::err(slot.unwrap_err()); }
 
@@ -89,13 +94,13 @@ ktl::result<ktl::ref<Region>> Region::create_child(uintptr_t base, size_t size,
 
 ktl::result<void> Region::map(uintptr_t vaddr, size_t size, ktl::ref<vmo> vmo_ref, uint64_t vmo_offset, vm_prot_t prot,
                               vm_cache_mode cache) {
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
     return map_locked(vaddr, size, ktl::move(vmo_ref), vmo_offset, prot, cache);
 }
 
 ktl::result<uintptr_t> Region::map_anywhere(uintptr_t floor, size_t size, ktl::ref<vmo> vmo_ref, uint64_t vmo_offset,
                                             vm_prot_t prot, vm_cache_mode cache) {
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
     if (size == 0 || !page_aligned(size) || !page_aligned(floor)) { return ktl::err(ktl::errc::invalid_operation); }
 
     // Children are visited in address order, so `cursor` is always past every
@@ -116,7 +121,7 @@ ktl::result<uintptr_t> Region::map_anywhere(uintptr_t floor, size_t size, ktl::r
 }
 
 ktl::result<void> Region::unmap_binding(uintptr_t vaddr) {
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
     auto it = m_children.find_le(vaddr);
     if (it == m_children.end() || vaddr >= it->base + it->size || !it->is_binding()) {
         return ktl::err(ktl::errc::out_of_range);
@@ -152,7 +157,7 @@ ktl::result<void> Region::map_locked(uintptr_t vaddr, size_t size, ktl::ref<vmo>
 }
 
 ktl::result<void> Region::unmap(uintptr_t base, size_t size) {
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
     uintptr_t end = base + size;
     if (end < base || base < m_base || end > m_base + m_size) { return ktl::err(ktl::errc::out_of_range); }
 
@@ -174,6 +179,17 @@ ktl::result<void> Region::unmap(uintptr_t base, size_t size) {
     return ktl::result<void>::ok();
 }
 
+ktl::result<void> Region::set_fault_around(uintptr_t vaddr, size_t pages) {
+    if (pages == 0 || pages > FAULT_AROUND_MAX_PAGES || (pages & (pages - 1)) != 0) {
+        return ktl::err(ktl::errc::invalid_operation);
+    }
+    kernel::synchronization::critical_irq_lock_guard guard(m_aspace.lock());
+    region_child* binding = find_binding(vaddr);
+    if (binding == nullptr) { return ktl::err(ktl::errc::out_of_range); }
+    binding->fault_around = pages;
+    return ktl::result<void>::ok();
+}
+
 region_child* Region::find_binding(uintptr_t vaddr) {
     auto it = m_children.find_le(vaddr);
     if (it == m_children.end() || vaddr >= it->base + it->size) { return nullptr; }
@@ -11,11 +11,11 @@ slab_heap g_slab_heap;
 namespace {
 
 constexpr size_t PAGE                                = KERNEL_MINIMUM_PAGE_SIZE;
-// Slab pages begin with a 64-byte tagged header; slots start at 64 and are never page-aligned.
+// Slab pages begin with a 128-byte tagged header; slots start at 128 and are never page-aligned.
 // Large runs carry no header at all -- their length lives in the first frame's page descriptor
 // (heap_pages_note_run/take_run) -- so a page-aligned pointer always means a large run and free()
-// classifies by alignment alone. 64 keeps the first slot aligned for every class.
-constexpr size_t HEADER_BYTES                        = 64;
+// classifies by alignment alone. 128 keeps the first slot aligned for every class.
+constexpr size_t HEADER_BYTES                        = 128;
 constexpr uint32_t SLAB_MAGIC                        = 0x42414c53;  // "SLAB"
 
 constexpr size_t CLASS_SIZES[slab_heap::CLASS_COUNT] = {16, 32, 64, 128, 256, 512, 1024};
@@ -27,6 +27,9 @@ size_t class_for(size_t bytes) {
     __builtin_unreachable();
 }
 
+// Index of the slot at a validated slab address.
+size_t slot_of(uintptr_t address, size_t class_size) { return ((address & (PAGE - 1)) - HEADER_BYTES) / class_size; }
+
 }  // namespace
 
 void check_not_interrupt() {
@@ -36,10 +39,12 @@ void check_not_interrupt() {
 }
 
 // Slot freeing threads a uint16 next-offset through the free slots themselves; never-used slots
-// are tracked by a bump offset so a fresh slab initializes nothing but this header. The bitmap
-// carries one bit per possible slot (at most (4096-64)/16 == 252) recording which are live, which
-// is what makes double frees and frees of never-carved slots deterministic panics instead of
-// freelist corruption.
+// are tracked by a bump offset so a fresh slab initializes nothing but this header. The live
+// bitmap carries one bit per possible slot (at most (4096-128)/16 == 248) recording which are
+// live, which is what makes double frees and frees of never-carved slots deterministic panics
+// instead of freelist corruption. The cached bitmap marks the live slots parked in a magazine,
+// catching a second free of one; it lives here rather than in the slot, whose bytes are still the
+// caller's when free() checks it.
 struct slab_heap::slab_page {
     uint32_t magic;
     uint16_t class_index;
@@ -49,12 +54,29 @@ struct slab_heap::slab_page {
     slab_page* next;
     slab_page* prev;
     uint64_t live_bits[4];
+    uint64_t cached_bits[4];
 
     bool full() const { return free_head == 0 && next_uninit == 0; }
 
-    bool test_live(size_t slot) const { return (live_bits[slot >> 6] >> (slot & 63)) & 1; }
-    void mark_live(size_t slot) { live_bits[slot >> 6] |= 1ull << (slot & 63); }
-    void clear_live(size_t slot) { live_bits[slot >> 6] &= ~(1ull << (slot & 63)); }
+    // Written under the heap lock, but free() reads a caller's own bit without it to reject a
+    // double free before the slot reaches a magazine; atomic words keep that read clean.
+    bool test_live(size_t slot) const {
+        return (__atomic_load_n(&live_bits[slot >> 6], __ATOMIC_RELAXED) >> (slot & 63)) & 1;
+    }
+    void mark_live(size_t slot) { __atomic_fetch_or(&live_bits[slot >> 6], 1ull << (slot & 63), __ATOMIC_RELAXED); }
+    void clear_live(size_t slot) {
+        __atomic_fetch_and(&live_bits[slot >> 6], ~(1ull << (slot & 63)), __ATOMIC_RELAXED);
+    }
+
+    // Flipped lock-free by whichever core moves the slot into or out of a magazine. mark_cached
+    // returns whether the bit was already set.
+    bool mark_cached(size_t slot) {
+        uint64_t bit = 1ull << (slot & 63);
+        return (__atomic_fetch_or(&cached_bits[slot >> 6], bit, __ATOMIC_RELAXED) & bit) != 0;
+    }
+    void clear_cached(size_t slot) {
+        __atomic_fetch_and(&cached_bits[slot >> 6], ~(1ull << (slot & 63)), __ATOMIC_RELAXED);
+    }
 };
 
 slab_heap::slab_page* slab_heap::new_slab(size_t class_index) {
@@ -62,7 +84,7 @@ slab_heap::slab_page* slab_heap::new_slab(size_t class_index) {
     uintptr_t base = heap_pages_alloc(1);
     if (base == 0) { return nullptr; }
     // Placement-new starts the header's lifetime in the raw page (plain member writes through a
-    // cast pointer would be lifetime UB); value-init zeroes the bitmap.
+    // cast pointer would be lifetime UB); value-init zeroes the bitmaps.
     auto* slab        = new (reinterpret_cast<void*>(base)) slab_page{};
     slab->magic       = SLAB_MAGIC;
     slab->class_index = static_cast<uint16_t>(class_index);
@@ -106,12 +128,24 @@ void* slab_heap::alloc(size_t size, size_t align) {
     size_t need = size > align ? size : align;
     if (need > MAX_CLASS_BYTES || align > MAX_SLAB_ALIGN) { return alloc_large(size); }
 
-    size_t index      = class_for(need);
+    size_t index = class_for(need);
+    void* cached = m_classes[index].magazines.alloc(
+        [this, index](void** out, size_t count) { return take_batch(index, out, count); });
+    if (cached != nullptr) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(cached);
+        reinterpret_cast<slab_page*>(address & ~(PAGE - 1))->clear_cached(slot_of(address, CLASS_SIZES[index]));
+        return cached;
+    }
+    return alloc_slab(index);
+}
+
+// Every slab was full when the magazine layer asked: take the slow path, which may fetch a page.
+// The call was already counted by the magazine.
+void* slab_heap::alloc_slab(size_t index) {
     size_t class_size = CLASS_SIZES[index];
     class_state& cls  = m_classes[index];
     {
         kernel::synchronization::critical_lock_guard guard(m_lock);
-        m_alloc_calls++;
         if (cls.partial != nullptr) { return take_slot(cls, cls.partial, class_size); }
     }
 
@@ -131,6 +165,22 @@ void* slab_heap::alloc(size_t size, size_t align) {
     return take_slot(cls, fresh, class_size);
 }
 
+// A magazine refill: up to `count` slots from partial slabs in one lock hold, never a new page.
+// Each is marked as cached, as if it had been freed into the magazine.
+size_t slab_heap::take_batch(size_t index, void** out, size_t count) {
+    size_t class_size = CLASS_SIZES[index];
+    class_state& cls  = m_classes[index];
+    size_t taken      = 0;
+    kernel::synchronization::critical_lock_guard guard(m_lock);
+    while (taken < count && cls.partial != nullptr) {
+        slab_page* slab = cls.partial;
+        void* slot      = take_slot(cls, slab, class_size);
+        slab->mark_cached(slot_of(reinterpret_cast<uintptr_t>(slot), class_size));
+        out[taken++] = slot;
+    }
+    return taken;
+}
+
 void* slab_heap::alloc_large(size_t size) {
     // A size whose page rounding wraps, or whose page count exceeds what the descriptor's 32-bit
     // run field can record, is an impossible request: fail it as exhaustion rather than letting
@@ -181,68 +231,113 @@ void slab_heap::free(void* ptr) {
         return;
     }
 
-    uintptr_t page         = address & ~(PAGE - 1);
-    uintptr_t release_base = 0;
-    size_t release_pages   = 0;
+    // Validate against the slab header without the lock: a pointer the caller legitimately holds
+    // keeps its slab alive, and its own live bit cannot change under it.
+    uintptr_t page = address & ~(PAGE - 1);
+    auto* slab     = reinterpret_cast<slab_page*>(page);
+    if (slab->magic != SLAB_MAGIC) { panic("heap: free of a pointer the heap never produced"); }
+    if (slab->class_index >= CLASS_COUNT) { panic("heap: slab header corrupted"); }
+
+    // A slab pointer must sit exactly on a slot boundary with the whole slot inside the page;
+    // anything else is a corrupted or interior pointer that would poison the freelist if
+    // threaded onto it. The page tail has stride-aligned offsets that were never carved
+    // (e.g. 3200 in the 1024 class), which the upper bound rejects.
+    size_t class_size = CLASS_SIZES[slab->class_index];
+    size_t offset     = address - page;
+    if (offset < HEADER_BYTES || offset > PAGE - class_size || (offset - HEADER_BYTES) % class_size != 0) {
+        panic("heap: slab free not on a slot boundary");
+    }
+    size_t slot = (offset - HEADER_BYTES) / class_size;
+    if (!slab->test_live(slot)) { panic("heap: double free, or free of a slot never allocated"); }
+    // Setting the cached bit is the check, so of two racing frees exactly one gets past it.
+    if (slab->mark_cached(slot)) { panic("heap: double free of a cached slot"); }
+    m_classes[slab->class_index].magazines.free(
+        ptr, [this](void** objects, size_t count) { release_batch(objects, count); });
+}
+
+// Return one validated slot to its slab under m_lock. Returns the slab's page when the slab
+// emptied and should go back to the page source -- after the lock is dropped -- or 0.
+uintptr_t slab_heap::release_slot(uintptr_t address) {
+    uintptr_t page    = address & ~(PAGE - 1);
+    auto* slab        = reinterpret_cast<slab_page*>(page);
+    class_state& cls  = m_classes[slab->class_index];
+    bool was_full     = slab->full();
+    size_t class_size = CLASS_SIZES[slab->class_index];
+    size_t offset     = address - page;
+    size_t slot       = (offset - HEADER_BYTES) / class_size;
+    if (!slab->test_live(slot)) { panic("heap: double free, or free of a slot never allocated"); }
+    slab->clear_cached(slot);
+    slab->clear_live(slot);
+
+    *reinterpret_cast<uint16_t*>(address) = slab->free_head;
+    slab->free_head                       = static_cast<uint16_t>(offset);
+    slab->live--;
+    cls.live--;
+
+    if (was_full) {
+        slab->next = cls.partial;
+        slab->prev = nullptr;
+        if (cls.partial != nullptr) { cls.partial->prev = slab; }
+        cls.partial = slab;
+    }
+
+    // ponytail: keep the last partial slab as a hot spare, release any other fully-free
+    // slab; a per-class spare count is the knob if churn at a class boundary ever shows.
+    if (slab->live == 0 && !(cls.partial == slab && slab->next == nullptr)) {
+        unlink_partial(cls, slab);
+        cls.slab_count--;
+        return page;
+    }
+    return 0;
+}
+
+// A magazine flush: every slot back in one lock hold, emptied pages released after it.
+void slab_heap::release_batch(void** objects, size_t count) {
+    uintptr_t pages[magazine_cache::ROUNDS];
+    size_t released = 0;
     {
         kernel::synchronization::critical_lock_guard guard(m_lock);
-        m_free_calls++;
-
-        auto* slab = reinterpret_cast<slab_page*>(page);
-        if (slab->magic != SLAB_MAGIC) { panic("heap: free of a pointer the heap never produced"); }
-        if (slab->class_index >= CLASS_COUNT) { panic("heap: slab header corrupted"); }
-        class_state& cls  = m_classes[slab->class_index];
-        bool was_full     = slab->full();
-
-        // A slab pointer must sit exactly on a slot boundary with the whole slot inside the page;
-        // anything else is a corrupted or interior pointer that would poison the freelist if
-        // threaded onto it. The page tail has stride-aligned offsets that were never carved
-        // (e.g. 3136 in the 1024 class), which the upper bound rejects.
-        size_t class_size = CLASS_SIZES[slab->class_index];
-        size_t offset     = address - page;
-        if (offset < HEADER_BYTES || offset > PAGE - class_size || (offset - HEADER_BYTES) % class_size != 0) {
-            panic("heap: slab free not on a slot boundary");
-        }
-        size_t slot = (offset - HEADER_BYTES) / class_size;
-        if (!slab->test_live(slot)) { panic("heap: double free, or free of a slot never allocated"); }
-        slab->clear_live(slot);
-
-        *reinterpret_cast<uint16_t*>(address) = slab->free_head;
-        slab->free_head                       = static_cast<uint16_t>(offset);
-        slab->live--;
-        cls.live--;
-
-        if (was_full) {
-            slab->next = cls.partial;
-            slab->prev = nullptr;
-            if (cls.partial != nullptr) { cls.partial->prev = slab; }
-            cls.partial = slab;
+        for (size_t i = 0; i < count; i++) {
+            uintptr_t page = release_slot(reinterpret_cast<uintptr_t>(objects[i]));
+            if (page != 0) { pages[released++] = page; }
         }
+    }
+    for (size_t i = 0; i < released; i++) { heap_pages_free(pages[i], 1); }
+}
 
-        // ponytail: keep the last partial slab as a hot spare, release any other fully-free
-        // slab; a per-class spare count is the knob if churn at a class boundary ever shows.
-        if (slab->live == 0 && !(cls.partial == slab && slab->next == nullptr)) {
-            unlink_partial(cls, slab);
-            cls.slab_count--;
-            release_base  = page;
-            release_pages = 1;
-        }
+void slab_heap::drain() {
+    check_not_interrupt();
+    for (auto& cls : m_classes) {
+        cls.magazines.drain([this](void** objects, size_t count) { release_batch(objects, count); });
     }
-    if (release_pages != 0) { heap_pages_free(release_base, release_pages); }
 }
 
 slab_heap_stats slab_heap::stats() {
+    // Magazine counters first, so m_lock covers only the slab fields.
+    magazine_stats cached[CLASS_COUNT];
+    for (size_t i = 0; i < CLASS_COUNT; ++i) { cached[i] = m_classes[i].magazines.stats(); }
+
     kernel::synchronization::critical_lock_guard guard(m_lock);
     slab_heap_stats out{};
+    out.alloc_calls = m_alloc_calls;
+    out.free_calls  = m_free_calls;
     for (size_t i = 0; i < CLASS_COUNT; ++i) {
         size_t per_slab = (PAGE - HEADER_BYTES) / CLASS_SIZES[i];
-        out.classes[i]  = {CLASS_SIZES[i], m_classes[i].slab_count, m_classes[i].live,
-                           m_classes[i].slab_count * per_slab - m_classes[i].live};
+        // The two halves are read under different locks; clamp a transient skew.
+        size_t live     = m_classes[i].live > cached[i].cached ? m_classes[i].live - cached[i].cached : 0;
+        out.classes[i]  = {CLASS_SIZES[i],
+                           m_classes[i].slab_count,
+                           live,
+                           m_classes[i].slab_count * per_slab - live,
+                           cached[i].cached,
+                           cached[i].hits,
+                           cached[i].misses,
+                           cached[i].exchanges};
+        out.alloc_calls += cached[i].allocs;
+        out.free_calls += cached[i].frees;
     }
     out.large_allocs = m_large_allocs;
     out.large_pages  = m_large_pages;
-    out.alloc_calls  = m_alloc_calls;
-    out.free_calls   = m_free_calls;
     out.failures     = m_failures;
     return out;
 }
@@ -2,15 +2,16 @@
 
 #include <kernel/obj/type_registry.h>
 
+#include "kernel/config.h"
 #include "kernel/log.h"
 #include "kernel/mm/page_descriptor.h"
 #include "kernel/mm/pmm.h"
 #include "kernel/mm/vmo.h"
 #include "kernel/panic.h"
 
-namespace kernel::mm {
+extern uintptr_t g_hhdm_offset;
 
-kernel::synchronization::spinlock g_vmm_lock;
+namespace kernel::mm {
 
 namespace {
 vm_aspace g_kernel_aspace;
@@ -59,6 +60,18 @@ void vmm_init(const vm_page_region* usable, size_t usable_count, const vm_page_r
     // half) and switches onto them -- the bootloader's tables sit in
     // reclaimable memory the PMM hands out, so running on them is unsafe.
     if (!g_kernel_aspace.arch_init_kernel()) { panic("vmm: kernel page table clone failed"); }
+    // The physmap covers RAM with whatever page sizes the bootloader chose;
+    // collapse it to the largest leaves the MMU takes before going live.
+    vm_paddr_t phys_end = 0;
+    for (size_t i = 0; i < usable_count; ++i) {
+        vm_paddr_t end = usable[i].start + usable[i].count * KERNEL_MINIMUM_PAGE_SIZE;
+        if (end > phys_end) { phys_end = end; }
+    }
+    for (size_t i = 0; i < wired_count; ++i) {
+        vm_paddr_t end = wired[i].start + wired[i].count * KERNEL_MINIMUM_PAGE_SIZE;
+        if (end > phys_end) { phys_end = end; }
+    }
+    size_t collapsed = g_kernel_aspace.promote_kernel_range(g_hhdm_offset, phys_end);
     g_kernel_aspace.activate();
     g_kernel_aspace.m_root = make_root(g_kernel_aspace);
     if (g_kernel_aspace.m_root.get() == nullptr) { panic("vmm: kernel root region allocation failed"); }
@@ -70,7 +83,8 @@ void vmm_init(const vm_page_region* usable, size_t usable_count, const vm_page_r
         desc->state       = page_state::WIRED;
         desc->share_count = 1;
     }
-    g_log.info("vmm: kernel running on its own page tables");
+    g_log.info("vmm: kernel running on its own page tables ({0} physmap tables collapsed into large pages)",
+               collapsed);
 }
 
 }  // namespace kernel::mm
@@ -1,6 +1,7 @@
 #include "kernel/mm/vmo.h"
 
 #include "kernel/assert.h"
+#include "kernel/config.h"
 #include "kernel/mm/page_descriptor.h"
 #include "kernel/mm/pmm.h"
 #include "kernel/mm/region.h"
@@ -49,6 +50,11 @@ uint64_t* vmo::chunk_for(uint64_t page, bool allocate) {
 }
 
 ktl::maybe<vm_paddr_t> vmo::resident_frame(uint64_t page) const {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    return lookup(page);
+}
+
+ktl::maybe<vm_paddr_t> vmo::lookup(uint64_t page) const {
     if (page >= m_pages) { return ktl::nothing; }
     size_t index = page / CHUNK_ENTRIES;
     if (index >= m_chunks.size() || m_chunks[index] == nullptr) { return ktl::nothing; }
@@ -78,14 +84,78 @@ ktl::result<void> vmo::fill_page(uint64_t page) {
 
 ktl::result<vm_paddr_t> vmo::get_or_fill_page(uint64_t page) {
     if (page >= m_pages) { return ktl::err(ktl::errc::out_of_range); }
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
     auto res = fill_page(page);
     if (res.is_err()) { return ktl::err(res.unwrap_err()); }
-    return ktl::result<vm_paddr_t>::ok(resident_frame(page).value());
+    return ktl::result<vm_paddr_t>::ok(lookup(page).value());
+}
+
+ktl::result<vm_paddr_t> vmo::get_or_fill_run(uint64_t first, size_t count) {
+    if (count == 0 || first + count < first || first + count > m_pages) { return ktl::err(ktl::errc::out_of_range); }
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    constexpr size_t PAGE_SIZE = KERNEL_MINIMUM_PAGE_SIZE;
+
+    size_t resident = 0;
+    for (uint64_t p = first; p < first + count; ++p) {
+        if (lookup(p).has_value()) { ++resident; }
+    }
+    if (resident == 0 && m_pager->owns_frames()) {
+        // Index chunks first, so a run never lands half recorded.
+        for (uint64_t p = first; p < first + count; p += CHUNK_ENTRIES) {
+            if (chunk_for(p, /*allocate=*/true) == nullptr) { return ktl::err(ktl::errc::oom); }
+        }
+        auto run = m_pager->fill_run(first, count);
+        if (run.is_err()) { return ktl::err(run.unwrap_err()); }
+        vm_paddr_t base = run.unwrap();
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t& entry = chunk_for(first + i, /*allocate=*/false)[(first + i) % CHUNK_ENTRIES];
+            entry           = base + i * PAGE_SIZE;
+            if (page_descriptor* desc = g_page_descriptors.lookup(entry)) {
+                desc->owner  = this;
+                desc->offset = first + i;
+            }
+        }
+        m_resident += count;
+        m_fills += count;
+        return ktl::result<vm_paddr_t>::ok(base);
+    }
+
+    if (!m_pager->owns_frames()) {
+        for (uint64_t p = first; p < first + count; ++p) {
+            auto res = fill_page(p);
+            if (res.is_err()) { return ktl::err(res.unwrap_err()); }
+        }
+    }
+    auto base = lookup(first);
+    if (!base.has_value() || (base.value() & (count * PAGE_SIZE - 1)) != 0) {
+        return ktl::err(ktl::errc::invalid_operation);
+    }
+    for (size_t i = 1; i < count; ++i) {
+        auto frame = lookup(first + i);
+        if (!frame.has_value() || frame.value() != base.value() + i * PAGE_SIZE) {
+            return ktl::err(ktl::errc::invalid_operation);
+        }
+    }
+    return ktl::result<vm_paddr_t>::ok(base.value());
+}
+
+size_t vmo::gather_frames(uint64_t first, size_t count, vm_paddr_t* out) {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+    bool cheap_fill = !m_pager->owns_frames();
+    size_t found    = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t page = first + i;
+        if (cheap_fill && page < m_pages) { (void)fill_page(page); }  // a failed fill just leaves the page absent
+        auto frame = lookup(page);
+        out[i]     = frame.has_value() ? frame.value() : 0;
+        if (frame.has_value()) { ++found; }
+    }
+    return found;
 }
 
 ktl::result<void> vmo::commit(uint64_t page, size_t count) {
     if (page + count < page || page + count > m_pages) { return ktl::err(ktl::errc::out_of_range); }
-    kernel::synchronization::critical_irq_lock_guard guard(g_vmm_lock);
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
     for (uint64_t p = page; p < page + count; ++p) {
         auto res = fill_page(p);
         if (res.is_err()) { return res; }
@@ -94,10 +164,12 @@ ktl::result<void> vmo::commit(uint64_t page, size_t count) {
 }
 
 bool vmo::add_mapping(vm_aspace& aspace, region_child& binding) {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
     return m_mappings.push_back({.aspace = &aspace, .binding = &binding});
 }
 
 void vmo::remove_mapping(region_child& binding) {
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
     for (size_t i = 0; i < m_mappings.size(); ++i) {
         if (m_mappings[i].binding == &binding) {
             m_mappings.swap_remove(i);
@@ -106,6 +178,90 @@ void vmo::remove_mapping(region_child& binding) {
     }
 }
 
+namespace {
+
+// The vaddrs at which `binding` maps VMO pages [first, first + count): empty
+// (start == end) when its window misses the range.
+struct vaddr_span {
+    uintptr_t start;
+    uintptr_t end;
+};
+
+vaddr_span window_of(const region_child& binding, uint64_t first, size_t count) {
+    constexpr size_t PAGE_SIZE = KERNEL_MINIMUM_PAGE_SIZE;
+    uint64_t lo = first * PAGE_SIZE > binding.vmo_offset ? first * PAGE_SIZE : binding.vmo_offset;
+    uint64_t hi = (first + count) * PAGE_SIZE;
+    if (binding.vmo_offset + binding.size < hi) { hi = binding.vmo_offset + binding.size; }
+    if (lo >= hi) { return {0, 0}; }
+    return {binding.base + (lo - binding.vmo_offset), binding.base + (hi - binding.vmo_offset)};
+}
+
+}  // namespace
+
+ktl::result<ktl::ref<vmo>> vmo::detach_pages(vm_aspace& aspace, uint64_t first, size_t count) {
+    if (count == 0 || first + count < first || first + count > m_pages) { return ktl::err(ktl::errc::out_of_range); }
+    if (!m_pager->owns_frames()) { return ktl::err(ktl::errc::invalid_operation); }
+    constexpr size_t PAGE_SIZE = KERNEL_MINIMUM_PAGE_SIZE;
+
+    // The receiver's index is built before any lock is taken, so the move
+    // itself cannot fail halfway. Nothing else can see it yet: no lock.
+    auto moved = create_anonymous_vmo(count);
+    if (moved.get() == nullptr || moved->m_chunks.size() != (count + CHUNK_ENTRIES - 1) / CHUNK_ENTRIES) {
+        return ktl::err(ktl::errc::oom);
+    }
+    for (uint64_t p = 0; p < count; p += CHUNK_ENTRIES) {
+        if (moved->chunk_for(p, /*allocate=*/true) == nullptr) { return ktl::err(ktl::errc::oom); }
+    }
+
+    // The aspace lock holds off faults that would re-map a frame mid-move and
+    // bindings coming or going; the VMO lock, fills and other detaches.
+    kernel::synchronization::critical_irq_lock_guard aspace_guard(aspace.lock());
+    kernel::synchronization::critical_irq_lock_guard guard(m_lock);
+
+    // Refuse before anything moves: a translation elsewhere is one this
+    // cannot zap, and a large leaf straddling the range one it cannot split.
+    for (size_t i = 0; i < m_mappings.size(); ++i) {
+        if (m_mappings[i].aspace != &aspace) { return ktl::err(ktl::errc::invalid_operation); }
+        vaddr_span span = window_of(*m_mappings[i].binding, first, count);
+        for (uintptr_t vaddr = span.start; vaddr < span.end;) {
+            auto mapped = aspace.walk_ext(vaddr);
+            if (!mapped.has_value() || mapped.value().size == PAGE_SIZE) {
+                vaddr += PAGE_SIZE;
+                continue;
+            }
+            uintptr_t leaf = vaddr & ~(mapped.value().size - 1);
+            if (leaf < span.start || leaf + mapped.value().size > span.end) {
+                return ktl::err(ktl::errc::invalid_operation);
+            }
+            vaddr = leaf + mapped.value().size;
+        }
+    }
+
+    // Hand each resident frame over: the descriptor follows it, and a fault
+    // here from now on fills a fresh zero page instead.
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t* chunk = chunk_for(first + i, /*allocate=*/false);
+        if (chunk == nullptr || chunk[(first + i) % CHUNK_ENTRIES] == 0) { continue; }
+        uint64_t& entry = chunk[(first + i) % CHUNK_ENTRIES];
+        moved->chunk_for(i, /*allocate=*/false)[i % CHUNK_ENTRIES] = entry;
+        if (page_descriptor* desc = g_page_descriptors.lookup(entry)) {
+            desc->owner  = moved.get();
+            desc->offset = i;
+        }
+        entry = 0;
+        --m_resident;
+        ++moved->m_resident;
+    }
+
+    // Then zap the old translations, one remote shootdown per binding, so no
+    // core writes a moved frame once this returns.
+    for (size_t i = 0; i < m_mappings.size(); ++i) {
+        vaddr_span span = window_of(*m_mappings[i].binding, first, count);
+        if (span.start != span.end) { (void)aspace.unmap_pages(span.start, (span.end - span.start) / PAGE_SIZE); }
+    }
+    return ktl::result<ktl::ref<vmo>>::ok(ktl::move(moved));
+}
+
 // All anonymous VMOs share one stateless zero-fill pager. Global-scope so the
 // initializer runs from the global-ctor pass (no __cxa_guard in the kernel).
 namespace { ktl::ref<pager> g_anonymous_pager = ktl::make_ref<anonymous_pager>(); }  // namespace
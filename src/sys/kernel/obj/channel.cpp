@@ -1,6 +1,5 @@
 #include <kernel/mm/object_arena.h>
 #include <kernel/obj/channel.h>
-#include <kernel/sched/task.h>
 #include <kernel/synchronization/guard.h>
 #include <kernel/synchronization/mutex.h>
 #include <std/new.h>
@@ -8,9 +7,9 @@
 namespace kernel::obj {
 
 // The pair's shared half: one lock covering both directions, raw back-pointers to the endpoints
-// (nulled as each dies, so a live pointer here is always safe to signal), and the two message
-// queues indexed by the side that reads them. Refcounted separately from the endpoints so neither
-// endpoint keeps the other alive -- only this state outlives the first close.
+// (nulled as each dies, so a live pointer here is always safe to signal), the pair's queue limits,
+// and the two message queues indexed by the side that reads them. Refcounted separately from the
+// endpoints so neither endpoint keeps the other alive -- only this state outlives the first close.
 struct channel_state {
     // Channel state allocates from its AUMI arena: exact-size zeroed slots instead of the
     // general heap's next power-of-two class. Operators defined below the arena, which needs
@@ -18,15 +17,53 @@ struct channel_state {
     static void* operator new(size_t size, const std::nothrow_t&) noexcept;
     static void operator delete(void* ptr);
 
-    kernel::synchronization::mutex lock;
+    kernel::synchronization::mutex lock{"channel"};
     Channel* ends[2] = {nullptr, nullptr};
+    size_t depth     = Channel::QUEUE_DEPTH;
+    size_t budget    = Channel::QUEUE_DEPTH * Channel::MAX_MESSAGE_BYTES;
 
+    // A ring that starts in the inline slots and doubles onto the heap as the queue backs up, up
+    // to the pair's depth, so a deep channel that never fills costs what a default one does.
+    // `stalled` is the writer's side of WRITABLE's hysteresis: set when the bit was cleared,
+    // cleared when a drain to the low-water mark reasserts it.
     struct message_queue {
-        MessageBuffer slots[Channel::QUEUE_DEPTH];
-        size_t head  = 0;
-        size_t count = 0;
+        MessageBuffer inline_slots[Channel::QUEUE_DEPTH];
+        MessageBuffer* slots = inline_slots;
+        size_t capacity      = Channel::QUEUE_DEPTH;
+        size_t head          = 0;
+        size_t count         = 0;
+        size_t bytes         = 0;
+        bool stalled         = false;
+
+        message_queue()                                = default;
+        message_queue(const message_queue&)            = delete;
+        message_queue& operator=(const message_queue&) = delete;
+        ~message_queue() {
+            if (slots != inline_slots) { delete[] slots; }
+        }
+
+        // Double the ring, capped at `depth`, keeping the queued messages in order. False when
+        // the larger ring cannot be allocated.
+        bool grow(size_t depth) {
+            size_t larger = capacity * 2 < depth ? capacity * 2 : depth;
+            auto* fresh   = new (std::nothrow) MessageBuffer[larger];
+            if (fresh == nullptr) { return false; }
+            for (size_t i = 0; i < count; i++) { fresh[i] = ktl::move(slots[(head + i) % capacity]); }
+            if (slots != inline_slots) { delete[] slots; }
+            slots    = fresh;
+            capacity = larger;
+            head     = 0;
+            return true;
+        }
     };
     message_queue inbound[2];
+
+    // Whether `queue` takes one more message of `length` bytes. An empty queue takes any message.
+    bool admits(const message_queue& queue, size_t length) const {
+        return queue.count == 0 || (queue.count < depth && queue.bytes + length <= budget);
+    }
+    // WRITABLE's low-water mark: half the depth and half the budget.
+    bool drained(const message_queue& queue) const { return queue.count <= depth / 2 && queue.bytes <= budget / 2; }
 };
 
 kernel::mm::object_arena g_channel_state_arena("channel-state", sizeof(channel_state), alignof(channel_state));
@@ -36,37 +73,99 @@ void* channel_state::operator new(size_t size, const std::nothrow_t&) noexcept {
 }
 void channel_state::operator delete(void* ptr) { g_channel_state_arena.free(ptr); }
 
+namespace {
+
+// Message payload classes. Most traffic is small RPCs, which a whole zeroed PMM frame per send
+// would make pay for the PMM's IRQ-off lock and descriptor churn; an arena slot is a bitmap
+// operation and is already zero. The arena's scrub-on-free keeps one message's bytes from reaching
+// the next, as a fresh page would.
+kernel::mm::object_arena g_message_64_arena("channel-msg-64", 64, 16);
+kernel::mm::object_arena g_message_256_arena("channel-msg-256", 256, 16);
+kernel::mm::object_arena g_message_1024_arena("channel-msg-1024", MessageBuffer::MAX_SMALL_BYTES, 16);
+
+// The arena serving a payload of `length` bytes, or null when it takes a page.
+kernel::mm::object_arena* message_arena(size_t length) {
+    if (length <= 64) { return &g_message_64_arena; }
+    if (length <= 256) { return &g_message_256_arena; }
+    if (length <= MessageBuffer::MAX_SMALL_BYTES) { return &g_message_1024_arena; }
+    return nullptr;
+}
+
+}  // namespace
+
 ktl::result<MessageBuffer> MessageBuffer::create(size_t length) {
     if (length > Channel::MAX_MESSAGE_BYTES) { return ktl::err(ktl::errc::out_of_range); }
     MessageBuffer buffer;
     if (length != 0) {
-        buffer.m_page = channel_page_alloc();
+        auto* arena   = message_arena(length);
+        buffer.m_page = arena ? reinterpret_cast<uintptr_t>(arena->alloc()) : channel_page_alloc();
         if (buffer.m_page == 0) { return ktl::err(ktl::errc::oom); }
     }
     buffer.m_length = length;
     return ktl::result<MessageBuffer>::ok(ktl::move(buffer));
 }
 
-// Close handles still escrowed when the message dies -- the "channel destroyed with handles in
-// flight" path, where the kernel closes them like any other handle. Runs after the channel state
-// lock is released (the state's reference drops in ~Channel's member destruction), so a close that
-// destroys another channel endpoint cannot deadlock here. Channel::write rejects handles to either
-// endpoint of its own pair, preventing a queue -> endpoint -> queue ownership cycle.
+// A message's carried handles. A block of its own rather than inline slots, which would multiply
+// the size of every queue slot for the minority of messages that carry handles.
+struct message_handles {
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept;
+    static void operator delete(void* ptr);
+
+    VerifiedHandle slots[MessageBuffer::MAX_HANDLES];
+};
+
+kernel::mm::object_arena g_message_handles_arena("channel-handles", sizeof(message_handles), alignof(message_handles));
+
+void* message_handles::operator new(size_t size, const std::nothrow_t&) noexcept {
+    return size <= sizeof(message_handles) ? g_message_handles_arena.alloc() : nullptr;
+}
+void message_handles::operator delete(void* ptr) { g_message_handles_arena.free(ptr); }
+
+bool MessageBuffer::reserve_handles() {
+    if (m_handles == nullptr) { m_handles = new (std::nothrow) message_handles; }
+    return m_handles != nullptr;
+}
+
+bool MessageBuffer::attach_handle(VerifiedHandle handle) {
+    if (m_handle_count == MAX_HANDLES) { return false; }
+    if (!reserve_handles()) { return false; }
+    m_handles->slots[m_handle_count++] = ktl::move(handle);
+    return true;
+}
+
+size_t MessageBuffer::detach_handles(VerifiedHandle (&out)[MAX_HANDLES]) {
+    size_t count = m_handle_count;
+    for (size_t i = 0; i < count; i++) { out[i] = ktl::move(m_handles->slots[i]); }
+    delete m_handles;
+    m_handles      = nullptr;
+    m_handle_count = 0;
+    return count;
+}
+
+// Dropping a carried reference can destroy its object -- another channel endpoint included -- so
+// a message must never die under a channel state lock (see Channel::read).
 void MessageBuffer::release_handles() {
-    auto& escrow = kernel::sched::kernel_task()->handles();
-    for (size_t i = 0; i < m_handle_count; i++) { (void)escrow.close(m_handles[i]); }
+    delete m_handles;
+    m_handles      = nullptr;
     m_handle_count = 0;
 }
 
+void MessageBuffer::release_storage() {
+    if (auto* arena = message_arena(m_length)) {
+        arena->free(reinterpret_cast<void*>(m_page));
+    } else {
+        channel_page_free(m_page);
+    }
+}
+
+// A carried endpoint is a plain reference, so this is a pointer comparison per handle. Rejecting
+// both ends of the pair prevents a queue -> endpoint -> queue ownership cycle, which nothing would
+// ever break: a message only releases its handles when it is read or its queue dies.
 bool MessageBuffer::carries_endpoint_from_pair(const Channel& channel) const {
-    auto& escrow = kernel::sched::kernel_task()->handles();
     for (size_t i = 0; i < m_handle_count; i++) {
-        auto handle = escrow.verify(m_handles[i], 0);
-        if (handle.is_err()) { continue; }
-        auto verified = handle.unwrap();
-        if (verified.object->type_id() != Channel::TYPE_ID) { continue; }
-        auto endpoint = ktl::static_ref_cast<Channel>(verified.object);
-        if (endpoint->m_state.get() == channel.m_state.get()) { return true; }
+        const auto& object = m_handles->slots[i].object;
+        if (!object || object->type_id() != Channel::TYPE_ID) { continue; }
+        if (static_cast<const Channel*>(object.get())->m_state.get() == channel.m_state.get()) { return true; }
     }
     return false;
 }
@@ -74,9 +173,14 @@ bool MessageBuffer::carries_endpoint_from_pair(const Channel& channel) const {
 Channel::Channel(ktl::ref<channel_state> state, uint32_t side)
     : Object(TYPE_ID), m_state(ktl::move(state)), m_side(side) {}
 
-ktl::result<Channel::Pair> Channel::create() {
+ktl::result<Channel::Pair> Channel::create(size_t depth, size_t byte_budget) {
+    if (depth == 0 || depth > MAX_QUEUE_DEPTH || byte_budget > MAX_BYTE_BUDGET) {
+        return ktl::err(ktl::errc::out_of_range);
+    }
     auto state = ktl::make_ref<channel_state>();
     if (!state) { return ktl::err(ktl::errc::oom); }
+    state->depth  = depth;
+    state->budget = byte_budget != 0 ? byte_budget : depth * MAX_MESSAGE_BYTES;
     auto first  = ktl::make_ref<Channel>(state, 0u);
     auto second = ktl::make_ref<Channel>(state, 1u);
     if (!first || !second) { return ktl::err(ktl::errc::oom); }
@@ -100,7 +204,7 @@ Channel::~Channel() {
 
 ktl::result<void> Channel::write(MessageBuffer message) {
     // Queuing either endpoint of this pair would make the queue own an endpoint that owns the
-    // queue. Reject it before taking the state lock; dropping the message then closes its escrow.
+    // queue. Reject it before taking the state lock; dropping the message then drops its handles.
     if (message.carries_endpoint_from_pair(*this)) { return ktl::err(ktl::errc::invalid_operation); }
 
     kernel::synchronization::lock_guard guard(m_state->lock);
@@ -108,18 +212,29 @@ ktl::result<void> Channel::write(MessageBuffer message) {
     if (!peer) { return ktl::err(ktl::errc::peer_closed); }
 
     auto& queue = m_state->inbound[m_side ^ 1];
-    if (queue.count == QUEUE_DEPTH) { return ktl::err(ktl::errc::capacity_exhausted); }
-    queue.slots[(queue.head + queue.count) % QUEUE_DEPTH] = ktl::move(message);
+    if (!m_state->admits(queue, message.size())) {
+        // Refused by the budget with WRITABLE still up, a sender waiting on it would spin; the
+        // refusal stalls the writer exactly as filling the queue does.
+        queue.stalled = true;
+        signal_clear(SIGNAL_WRITABLE);
+        return ktl::err(ktl::errc::capacity_exhausted);
+    }
+    if (queue.count == queue.capacity && !queue.grow(m_state->depth)) { return ktl::err(ktl::errc::oom); }
+    queue.bytes += message.size();
+    queue.slots[(queue.head + queue.count) % queue.capacity] = ktl::move(message);
     queue.count++;
 
     peer->signal_set(SIGNAL_READABLE);
-    if (queue.count == QUEUE_DEPTH) { signal_clear(SIGNAL_WRITABLE); }
+    if (queue.count == m_state->depth || queue.bytes >= m_state->budget) {
+        queue.stalled = true;
+        signal_clear(SIGNAL_WRITABLE);
+    }
     return ktl::result<void>::ok();
 }
 
 ktl::result<MessageBuffer> Channel::read(size_t max_bytes, size_t max_handles) {
-    // Declared before the guard: a discarded message's destructor closes escrowed handles, which
-    // can destroy another endpoint -- of this very pair in the worst case -- so it must run after
+    // Declared before the guard: a discarded message's destructor drops its handles, which can
+    // destroy another endpoint -- of this very pair in the worst case -- so it must run after
     // the state lock is released.
     MessageBuffer discarded;
     kernel::synchronization::lock_guard guard(m_state->lock);
@@ -134,13 +249,14 @@ ktl::result<MessageBuffer> Channel::read(size_t max_bytes, size_t max_handles) {
     // endpoint (and every message behind it) forever.
     bool oversized = queue.slots[queue.head].size() > max_bytes || queue.slots[queue.head].handle_count() > max_handles;
 
-    bool was_full  = queue.count == QUEUE_DEPTH;
     MessageBuffer message = ktl::move(queue.slots[queue.head]);
-    queue.head            = (queue.head + 1) % QUEUE_DEPTH;
+    queue.head            = (queue.head + 1) % queue.capacity;
     queue.count--;
+    queue.bytes -= message.size();
 
     if (queue.count == 0) { signal_clear(SIGNAL_READABLE); }
-    if (was_full) {
+    if (queue.stalled && m_state->drained(queue)) {
+        queue.stalled = false;
         if (Channel* peer = m_state->ends[m_side ^ 1]) { peer->signal_set(SIGNAL_WRITABLE); }
     }
     if (oversized) {
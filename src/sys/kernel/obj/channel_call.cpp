@@ -0,0 +1,55 @@
+#include <kernel/obj/channel.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/sched/thread.h>
+#include <kernel/time.h>
+
+// The blocking channel operations live apart from channel.cpp: they park threads, and the hosted
+// test runner links channel.cpp without the scheduler.
+
+namespace kernel::obj {
+
+namespace {
+
+constexpr uint32_t ANSWER_SIGNALS = Channel::SIGNAL_READABLE | Channel::SIGNAL_PEER_CLOSED;
+
+// Send with direct handoff armed, so the wake of a reader parked on the other end is held for this
+// thread and its next block runs that reader at once. Disarming queues the reader normally if this
+// thread never blocked after all -- the answer was already there, or it was killed.
+ktl::result<MessageBuffer> send_then_read(Channel& channel, MessageBuffer message, size_t max_bytes,
+                                          size_t max_handles, ktime_t deadline) {
+    kernel::sched::handoff_arm();
+    auto sent = channel.write(ktl::move(message));
+    if (sent.is_err()) {
+        kernel::sched::handoff_disarm();
+        return ktl::err(sent.unwrap_err());
+    }
+    auto answer = channel.wait_and_read(max_bytes, max_handles, deadline);
+    kernel::sched::handoff_disarm();
+    return answer;
+}
+
+}  // namespace
+
+ktl::result<MessageBuffer> Channel::wait_and_read(size_t max_bytes, size_t max_handles, ktime_t deadline) {
+    for (;;) {
+        auto received = read(max_bytes, max_handles);
+        if (received.is_ok() || received.unwrap_err() != ktl::errc::would_block) { return received; }
+        // READABLE can be seen set on a queue another reader of this endpoint has just drained, so
+        // an empty read after a wake waits again with the same deadline.
+        uint32_t got = deadline == 0 ? wait_signals(ANSWER_SIGNALS) : wait_signals_deadline(ANSWER_SIGNALS, deadline);
+        if ((got & ANSWER_SIGNALS) == 0) { return ktl::err(ktl::errc::timed_out); }
+    }
+}
+
+ktl::result<MessageBuffer> Channel::call(MessageBuffer request, size_t max_bytes, size_t max_handles,
+                                         ktime_t deadline) {
+    if ((signals() & SIGNAL_READABLE) != 0) { return ktl::err(ktl::errc::invalid_operation); }
+    return send_then_read(*this, ktl::move(request), max_bytes, max_handles, deadline);
+}
+
+ktl::result<MessageBuffer> Channel::reply_and_wait(MessageBuffer reply, size_t max_bytes, size_t max_handles,
+                                                   ktime_t deadline) {
+    return send_then_read(*this, ktl::move(reply), max_bytes, max_handles, deadline);
+}
+
+}  // namespace kernel::obj
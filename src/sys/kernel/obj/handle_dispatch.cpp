@@ -1,6 +1,12 @@
 #include <abi/syscall.h>
+#include <kernel/config.h>
 #include <kernel/obj/handle_dispatch.h>
+#include <kernel/obj/otp.h>
+#include <kernel/obj/type_registry.h>
 #include <kernel/sched/user_task.h>
+#include <kernel/synchronization/spinlock.h>
+
+#include <ktl/maybe>
 
 namespace kernel::obj {
 
@@ -15,6 +21,7 @@ struct op_context {
     HandleId id;
     VerifiedHandle verified;
     uint64_t arg;
+    uint64_t arg2;
 };
 
 uint64_t errc_of(ktl::errc error) { return static_cast<uint64_t>(error); }
@@ -55,32 +62,97 @@ uint64_t op_task_status(op_context& ctx) {
     return task->exit_code();
 }
 
+// The dispatch stage of a type-defined operation: reached when no program is attached or the
+// program dispatched. It forwards to the type's server over IPC, and no type has a server behind
+// it yet, so the operation has nowhere to go.
+uint64_t op_invoke(op_context& ctx) {
+    (void)ctx;
+    return errc_of(ktl::errc::invalid_operation);
+}
+
 // One row per handle syscall: the operation cannot run without passing the pipeline with exactly
 // these requirements. expected_type INVALID means any type -- every operation so far is generic,
-// but the column is what a task- or thread-specific operation will fill in.
+// but the column is what a task- or thread-specific operation will fill in. `programmable` rows
+// run the type's transaction program between verification and the handler; kernel-defined
+// operations keep fixed semantics and never do.
 struct op_spec {
     uint64_t nr;
     TypeId expected_type;
     Rights required_rights;
+    bool programmable;
     uint64_t (*handler)(op_context&);
 };
 
 constexpr op_spec OPS[] = {
-    {sys::SYS_HANDLE_CLOSE, type_ids::INVALID, 0, op_close},
-    {sys::SYS_HANDLE_DUPLICATE, type_ids::INVALID, RIGHT_DUPLICATE, op_duplicate},
-    {sys::SYS_OBJ_INFO, type_ids::INVALID, 0, op_info},
-    {sys::SYS_TASK_KILL, type_ids::TASK, RIGHT_WRITE, op_task_kill},
-    {sys::SYS_TASK_STATUS, type_ids::TASK, RIGHT_READ, op_task_status},
+    {sys::SYS_HANDLE_CLOSE, type_ids::INVALID, 0, false, op_close},
+    {sys::SYS_HANDLE_DUPLICATE, type_ids::INVALID, RIGHT_DUPLICATE, false, op_duplicate},
+    {sys::SYS_OBJ_INFO, type_ids::INVALID, 0, false, op_info},
+    {sys::SYS_TASK_KILL, type_ids::TASK, RIGHT_WRITE, false, op_task_kill},
+    {sys::SYS_TASK_STATUS, type_ids::TASK, RIGHT_READ, false, op_task_status},
+    {sys::SYS_OBJ_INVOKE, type_ids::INVALID, 0, true, op_invoke},
 };
 
+// Programs that touch inline storage run under one of these, picked by object id. A lock per
+// object would cost every object a lockdep identity; striping bounds that to a handful, and an
+// execution is short and bounded by its program's length.
+constexpr size_t STORAGE_LOCK_STRIPES = 16;
+kernel::synchronization::spinlock g_storage_locks[STORAGE_LOCK_STRIPES];
+
+// The program stage of three-path dispatch. Returns the operation's result when the program
+// rejected or completed it, nothing when there is no program or it dispatched. Stores run against
+// a snapshot that is written back only on completion, and signal changes apply only then, so a
+// rejected or dispatched operation leaves no trace on the object.
+ktl::maybe<uint64_t> run_program(op_context& ctx) {
+    Object* object = ctx.verified.object.get();
+    auto program   = g_type_registry.program(object->type_id());
+    if (!program) { return {}; }
+
+    otp::context run{{ctx.verified.rights, ctx.arg, ctx.arg2, object->signals()}};
+    otp::verdict verdict{otp::outcome::DISPATCH, 0};
+    size_t extent = program->storage_extent();
+    if (extent == 0) {
+        verdict = otp::run(*program, run);
+    } else {
+        // Attachment bounded every access by the type's declaration, which the object honors.
+        ktl::span<uint8_t> storage = object->inline_storage();
+        if (storage.size() < extent) { return errc_of(ktl::errc::invalid_operation); }
+        uint8_t snapshot[CONFIG_OBJECT_MAX_INLINE_STORAGE];
+        kernel::synchronization::critical_lock_guard guard(g_storage_locks[object->id() % STORAGE_LOCK_STRIPES]);
+        if (program->writes_storage()) {
+            __builtin_memcpy(snapshot, storage.data(), extent);
+            run.storage = snapshot;
+        } else {
+            run.storage = storage.data();
+        }
+        verdict = otp::run(*program, run);
+        if (verdict.kind == otp::outcome::COMPLETE && program->writes_storage()) {
+            __builtin_memcpy(storage.data(), snapshot, extent);
+        }
+    }
+
+    switch (verdict.kind) {
+        case otp::outcome::REJECT: return verdict.value;
+        case otp::outcome::COMPLETE:
+            if (run.signals_cleared != 0) { object->signal_clear(run.signals_cleared); }
+            if (run.signals_set != 0) { object->signal_set(run.signals_set); }
+            return verdict.value;
+        case otp::outcome::DISPATCH: break;
+    }
+    return {};
+}
+
 }  // namespace
 
-uint64_t dispatch_handle_op(HandleTable& table, uint64_t nr, uint64_t handle, uint64_t arg) {
+uint64_t dispatch_handle_op(HandleTable& table, uint64_t nr, uint64_t handle, uint64_t arg, uint64_t arg2) {
     for (const op_spec& op : OPS) {
         if (op.nr != nr) { continue; }
         auto verified = table.verify(unpack_handle(handle), op.required_rights, op.expected_type);
         if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
-        op_context ctx{table, unpack_handle(handle), verified.unwrap(), arg};
+        op_context ctx{table, unpack_handle(handle), verified.unwrap(), arg, arg2};
+        if (op.programmable) {
+            auto ran = run_program(ctx);
+            if (ran.has_value()) { return ran.value(); }
+        }
         return op.handler(ctx);
     }
     return errc_of(ktl::errc::invalid_operation);
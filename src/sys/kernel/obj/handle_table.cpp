@@ -1,5 +1,8 @@
+#include <kernel/mm/object_arena.h>
 #include <kernel/obj/handle_table.h>
 #include <kernel/obj/type_registry.h>
+#include <kernel/panic.h>
+#include <std/new.h>
 
 namespace kernel::obj {
 
@@ -8,62 +11,225 @@ namespace kernel::obj {
 // classify a syscall return as handle-vs-error with a plain sign test (see abi/syscall.h).
 constexpr uint32_t MAX_GENERATION = 0x7FFFFFFF;
 
-HandleTable::~HandleTable()       = default;
+// Slot indices travel as int32_t on the free list.
+constexpr size_t MAX_ENTRIES = 0x7FFFFFFF;
 
+// next_free of a slot taken by reserve() and not yet committed: off the free list, not live.
+constexpr int32_t RESERVED_SLOT = -2;
+
+struct HandleTable::HandleChunk {
+    HandleEntry entries[CHUNK_ENTRIES];
+
+    // Every table's chunks share one arena, so a table's growth is a bitmap operation on a slab
+    // page rather than a heap allocation, and a destroyed table's chunks go back to the pool whole.
+    static kernel::mm::object_arena arena;
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept;
+    static void operator delete(void* ptr);
+
+    static_assert((MAX_GENERATION & ENTRY_LIVE) == 0, "the live bit sits above every generation");
+    static_assert((CHUNK_ENTRIES & (CHUNK_ENTRIES - 1)) == 0, "chunk index is a shift");
+};
+
+kernel::mm::object_arena HandleTable::HandleChunk::arena("handle-chunk", sizeof(HandleChunk), alignof(HandleChunk));
+
+void* HandleTable::HandleChunk::operator new(size_t size, const std::nothrow_t&) noexcept {
+    return size <= sizeof(HandleChunk) ? arena.alloc() : nullptr;
+}
+void HandleTable::HandleChunk::operator delete(void* ptr) { arena.free(ptr); }
+
+HandleTable::~HandleTable() {
+    HandleChunk** directory = m_directory.load(ktl::memory_order::relaxed);
+    for (size_t i = 0; i < m_chunk_count.load(ktl::memory_order::relaxed); i++) { delete directory[i]; }
+    delete[] directory;
+}
+
+// The odd count goes out first and the fields follow as release stores, so a reader whose acquire
+// load sees any new field also sees the count move when it re-reads it.
+void HandleTable::HandleEntry::publish(uint32_t new_state, Rights new_rights) {
+    uint32_t count = sequence.load(ktl::memory_order::relaxed);
+    sequence.store(count + 1, ktl::memory_order::relaxed);
+    state.store(new_state, ktl::memory_order::release);
+    rights.store(new_rights, ktl::memory_order::release);
+    sequence.store(count + 2, ktl::memory_order::release);
+}
+
+HandleTable::EntryView HandleTable::read_entry(const HandleEntry& entry) {
+    for (;;) {
+        uint32_t before = entry.sequence.load(ktl::memory_order::acquire);
+        if ((before & 1) != 0) { continue; }
+        EntryView view{entry.state.load(ktl::memory_order::acquire), entry.rights.load(ktl::memory_order::acquire)};
+        if (entry.sequence.load(ktl::memory_order::relaxed) == before) { return view; }
+    }
+}
+
+// A reader counts itself into the current epoch, then checks the epoch did not move underneath it;
+// if it did, a writer may already have looked at that counter and found it empty, so the reader
+// backs out and joins the new epoch instead. Every step is sequentially consistent: a writer that
+// saw the old counter at zero flipped the epoch before the reader's re-check could load it.
+HandleTable::ReadSection::ReadSection(HandleTable& table) : m_table(table) {
+#if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
+    // A section is a handful of loads; with preemption off, a writer's wait is bounded by that
+    // rather than by how long the reader stays descheduled.
+    kernel::synchronization::preempt_disable();
+#endif
+    for (;;) {
+        m_epoch = table.m_epoch.load() & 1;
+        table.m_readers[m_epoch].fetch_add(1);
+        if ((table.m_epoch.load() & 1) == m_epoch) { return; }
+        table.m_readers[m_epoch].fetch_sub(1, ktl::memory_order::release);
+    }
+}
+
+HandleTable::ReadSection::~ReadSection() {
+    m_table.m_readers[m_epoch].fetch_sub(1, ktl::memory_order::release);
+#if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
+    kernel::synchronization::preempt_enable();
+#endif
+}
+
+// Writers are serialized, so two counters suffice: sections that start after the flip count into
+// the other one, and the old one only drains.
+void HandleTable::synchronize() {
+    uint32_t old = m_epoch.fetch_add(1) & 1;
+    while (m_readers[old].load(ktl::memory_order::acquire) != 0) {}
+}
+
+// An id whose generation carries the live bit was never issued; it must not match the entry whose
+// generation is the rest of it.
+bool HandleTable::names(uint32_t state, HandleId id) {
+    return (id.generation & ENTRY_LIVE) == 0 && state == (id.generation | ENTRY_LIVE);
+}
+
+size_t HandleTable::capacity() const { return m_chunk_count.load(ktl::memory_order::acquire) * CHUNK_ENTRIES; }
+
+HandleTable::HandleEntry& HandleTable::entry_at(size_t index) const {
+    HandleChunk* chunk = m_directory.load(ktl::memory_order::acquire)[index / CHUNK_ENTRIES];
+    return chunk->entries[index % CHUNK_ENTRIES];
+}
+
+// One more chunk; nothing already in the table moves, so growth costs the same at any size. The
+// directory doubles when full -- a copy of chunk pointers, published before the count that uses
+// the new slot, with the old directory freed once no reader can still be walking it. Any failure
+// leaves the table as it was.
 ktl::result<void> HandleTable::grow() {
-    size_t old_size = m_entries.size();
-    for (size_t i = 0; i < GROW_BATCH; i++) {
-        HandleEntry entry;
-        if (!m_entries.push_back(ktl::move(entry))) { return ktl::err(ktl::errc::oom); }
+    size_t chunks = m_chunk_count.load(ktl::memory_order::relaxed);
+    if ((chunks + 1) * CHUNK_ENTRIES > MAX_ENTRIES) { return ktl::err(ktl::errc::capacity_exhausted); }
+    auto* chunk = new (std::nothrow) HandleChunk;
+    if (chunk == nullptr) { return ktl::err(ktl::errc::oom); }
+
+    HandleChunk** directory = m_directory.load(ktl::memory_order::relaxed);
+    HandleChunk** stale     = nullptr;
+    if (chunks == m_directory_size) {
+        size_t size    = m_directory_size == 0 ? DIRECTORY_INITIAL : m_directory_size * 2;
+        auto* replaced = new (std::nothrow) HandleChunk*[size];
+        if (replaced == nullptr) {
+            delete chunk;
+            return ktl::err(ktl::errc::oom);
+        }
+        for (size_t i = 0; i < chunks; i++) { replaced[i] = directory[i]; }
+        stale            = directory;
+        directory        = replaced;
+        m_directory_size = size;
     }
+    directory[chunks] = chunk;
+
     // Chain the new slots so allocation walks them in ascending index order. The order is
     // load-bearing for a fresh table: the ABI promises the initial thread's bootstrap channel
     // endpoint occupies slot 0 (abi::syscall::BOOTSTRAP_HANDLE).
-    for (size_t i = old_size + GROW_BATCH; i-- > old_size;) {
-        m_entries[i].next_free = m_free_head;
-        m_free_head            = static_cast<int32_t>(i);
+    for (size_t i = CHUNK_ENTRIES; i-- > 0;) {
+        chunk->entries[i].next_free = m_free_head;
+        m_free_head                 = static_cast<int32_t>(chunks * CHUNK_ENTRIES + i);
+    }
+
+    m_directory.store(directory, ktl::memory_order::release);
+    m_chunk_count.store(chunks + 1, ktl::memory_order::release);
+    if (stale != nullptr) {
+        synchronize();
+        delete[] stale;
     }
     return ktl::result<void>::ok();
 }
 
 HandleTable::HandleEntry* HandleTable::lookup_entry(HandleId id) {
-    if (id.index >= m_entries.size()) { return nullptr; }
-    auto& entry = m_entries[id.index];
-    if (entry.generation != id.generation) { return nullptr; }
-    if (!entry.object) { return nullptr; }
+    if (id.index >= capacity()) { return nullptr; }
+    auto& entry = entry_at(id.index);
+    if (!names(entry.state.load(ktl::memory_order::relaxed), id)) { return nullptr; }
     return &entry;
 }
 
-ktl::result<HandleId> HandleTable::create_handle(ktl::ref<Object> object, Rights rights) {
-    if (!object) { return ktl::err(ktl::errc::null_argument); }
-
-    // Requested rights must stay within the contract registered for this object's type.
-    // Out-of-contract bits are rejected outright rather than silently clamped.
-    auto descriptor = g_type_registry.lookup(object->type_id());
+// Requested rights must stay within the contract registered for the object's type. Out-of-contract
+// bits are rejected outright rather than silently clamped.
+ktl::result<void> HandleTable::check_rights(TypeId type_id, Rights rights) {
+    auto descriptor = g_type_registry.lookup(type_id);
     if (!descriptor.has_value()) { return ktl::err(ktl::errc::wrong_type); }
     if ((rights & ~descriptor.value().valid_rights) != 0) { return ktl::err(ktl::errc::rights_violation); }
+    return ktl::result<void>::ok();
+}
 
-    kernel::synchronization::lock_guard guard(m_lock);
-
+// Off the free list, growing the table when it is empty. Called under m_lock.
+ktl::result<int32_t> HandleTable::pop_free_slot() {
     if (m_free_head == -1) {
         auto grown = grow();
         if (grown.is_err()) { return ktl::err(grown.unwrap_err()); }
     }
+    int32_t slot = m_free_head;
+    m_free_head  = entry_at(static_cast<size_t>(slot)).next_free;
+    return ktl::result<int32_t>::ok(slot);
+}
 
-    int32_t slot    = m_free_head;
-    auto& entry     = m_entries[static_cast<size_t>(slot)];
-    m_free_head     = entry.next_free;
-
-    entry.object    = ktl::unowned_ref<Object>(object);
-    entry.strong    = ktl::move(object);
-    entry.rights    = rights;
-    entry.next_free = -1;
+// Publish into a slot already off the free list. Called under m_lock.
+HandleId HandleTable::publish_slot(int32_t slot, ktl::ref<Object> object, Rights rights) {
+    auto& entry         = entry_at(static_cast<size_t>(slot));
+    entry.strong        = ktl::move(object);
+    entry.next_free     = -1;
+    uint32_t generation = entry.state.load(ktl::memory_order::relaxed);
+    entry.publish(generation | ENTRY_LIVE, rights);
     m_count++;
+    return HandleId{static_cast<uint32_t>(slot), generation};
+}
 
-    HandleId id{static_cast<uint32_t>(slot), entry.generation};
+ktl::result<HandleId> HandleTable::create_handle(ktl::ref<Object> object, Rights rights) {
+    if (!object) { return ktl::err(ktl::errc::null_argument); }
+    auto allowed = check_rights(object->type_id(), rights);
+    if (allowed.is_err()) { return ktl::err(allowed.unwrap_err()); }
+
+    kernel::synchronization::lock_guard guard(m_lock);
+    auto slot = pop_free_slot();
+    if (slot.is_err()) { return ktl::err(slot.unwrap_err()); }
+    return ktl::result<HandleId>::ok(publish_slot(slot.unwrap(), ktl::move(object), rights));
+}
+
+ktl::result<HandleId> HandleTable::reserve(TypeId type_id, Rights rights) {
+    auto allowed = check_rights(type_id, rights);
+    if (allowed.is_err()) { return ktl::err(allowed.unwrap_err()); }
+
+    kernel::synchronization::lock_guard guard(m_lock);
+    auto slot = pop_free_slot();
+    if (slot.is_err()) { return ktl::err(slot.unwrap_err()); }
+    auto& entry     = entry_at(static_cast<size_t>(slot.unwrap()));
+    entry.next_free = RESERVED_SLOT;
+    HandleId id{static_cast<uint32_t>(slot.unwrap()), entry.state.load(ktl::memory_order::relaxed)};
     return ktl::result<HandleId>::ok(id);
 }
 
+// The generation is fixed while the slot is reserved, so it is what the returned id carries.
+void HandleTable::commit(HandleId reserved, ktl::ref<Object> object, Rights rights) {
+    kernel::synchronization::lock_guard guard(m_lock);
+    if (reserved.index >= capacity() || entry_at(reserved.index).next_free != RESERVED_SLOT || !object) {
+        panic("handle_table: commit of a slot that was not reserved");
+    }
+    (void)publish_slot(static_cast<int32_t>(reserved.index), ktl::move(object), rights);
+}
+
+void HandleTable::cancel(HandleId reserved) {
+    kernel::synchronization::lock_guard guard(m_lock);
+    if (reserved.index >= capacity() || entry_at(reserved.index).next_free != RESERVED_SLOT) {
+        panic("handle_table: cancel of a slot that was not reserved");
+    }
+    entry_at(reserved.index).next_free = m_free_head;
+    m_free_head                        = static_cast<int32_t>(reserved.index);
+}
+
 ktl::result<HandleId> HandleTable::insert(ktl::ref<Object> object, Rights rights) {
     return create_handle(ktl::move(object), rights);
 }
@@ -75,23 +241,28 @@ void HandleTable::clear() {
     for (;;) {
         ktl::ref<Object> victim;  // declared before the guard so it drops after the unlock
         kernel::synchronization::lock_guard guard(m_lock);
-        while (index < m_entries.size() && !m_entries[index].object) { index++; }
-        if (index >= m_entries.size()) { break; }
-        auto& entry = m_entries[index];
-        victim      = ktl::move(entry.strong);
-        entry.object.reset();
-        entry.rights = 0;
+        size_t limit = capacity();
+        while (index < limit && (entry_at(index).state.load(ktl::memory_order::relaxed) & ENTRY_LIVE) == 0) {
+            index++;
+        }
+        if (index >= limit) { break; }
+        auto& entry         = entry_at(index);
+        uint32_t generation = entry.state.load(ktl::memory_order::relaxed) & ~ENTRY_LIVE;
+        entry.publish(generation == MAX_GENERATION ? generation : generation + 1, 0);
+        synchronize();
+        victim = ktl::move(entry.strong);
         m_count--;
-        if (entry.generation != MAX_GENERATION) { entry.generation++; }
     }
 
     // Rebuild the free list over the dead slots in ascending index order -- fresh-table slot
     // order is ABI (see grow()). Retired slots stay off the list.
     kernel::synchronization::lock_guard guard(m_lock);
     m_free_head = -1;
-    for (size_t i = m_entries.size(); i-- > 0;) {
-        auto& entry = m_entries[i];
-        if (entry.object || entry.generation == MAX_GENERATION) {
+    for (size_t i = capacity(); i-- > 0;) {
+        auto& entry    = entry_at(i);
+        uint32_t state = entry.state.load(ktl::memory_order::relaxed);
+        if (entry.next_free == RESERVED_SLOT) { continue; }  // its reserver still owns it
+        if ((state & ENTRY_LIVE) != 0 || state == MAX_GENERATION) {
             entry.next_free = -1;
             continue;
         }
@@ -110,9 +281,10 @@ ktl::result<HandleId> HandleTable::duplicate(HandleId source, Rights rights_mask
         if (!src) { return ktl::err(ktl::errc::handle_invalid); }
         // Duplication is itself a capability: a source handle without the right is refused no
         // matter which kernel path asks.
-        if ((src->rights & RIGHT_DUPLICATE) == 0) { return ktl::err(ktl::errc::rights_violation); }
-        new_rights = src->rights & rights_mask;
-        obj_copy   = src->object.promote();
+        Rights rights = src->rights.load(ktl::memory_order::relaxed);
+        if ((rights & RIGHT_DUPLICATE) == 0) { return ktl::err(ktl::errc::rights_violation); }
+        new_rights = rights & rights_mask;
+        obj_copy   = src->strong;
     }
 
     return create_handle(ktl::move(obj_copy), new_rights);
@@ -132,19 +304,20 @@ ktl::result<VerifiedHandle> HandleTable::take(HandleId id) {
     HandleEntry* entry = lookup_entry(id);
     if (!entry) { return ktl::err(ktl::errc::handle_invalid); }
 
-    ktl::ref<Object> moved = ktl::move(entry->strong);
-    Rights rights          = entry->rights;
-    entry->object.reset();
-    entry->rights = 0;
-    m_count--;
-
     // If the generation counter is saturated, incrementing would wrap to 0 and let a stale
     // (index, generation) HandleId revalidate against a recycled slot. Retire the slot permanently
     // instead of returning it to the free list.
-    if (entry->generation == MAX_GENERATION) {
+    Rights rights = entry->rights.load(ktl::memory_order::relaxed);
+    bool retire   = id.generation == MAX_GENERATION;
+    entry->publish(retire ? id.generation : id.generation + 1, 0);
+    // Readers that saw the entry live may still be copying its reference out.
+    synchronize();
+    ktl::ref<Object> moved = ktl::move(entry->strong);
+    m_count--;
+
+    if (retire) {
         entry->next_free = -1;
     } else {
-        entry->generation++;
         entry->next_free = m_free_head;
         m_free_head      = static_cast<int32_t>(id.index);
     }
@@ -153,14 +326,18 @@ ktl::result<VerifiedHandle> HandleTable::take(HandleId id) {
 }
 
 ktl::result<VerifiedHandle> HandleTable::verify(HandleId id, Rights required_rights, TypeId expected_type) {
-    kernel::synchronization::lock_guard guard(m_lock);
-    HandleEntry* entry = lookup_entry(id);
-    if (!entry) { return ktl::err(ktl::errc::handle_invalid); }
-    if (expected_type != type_ids::INVALID && entry->object->type_id() != expected_type) {
+    ReadSection section(*this);
+    if (id.index >= capacity()) { return ktl::err(ktl::errc::handle_invalid); }
+    const HandleEntry& entry = entry_at(id.index);
+    EntryView view           = read_entry(entry);
+    if (!names(view.state, id)) { return ktl::err(ktl::errc::handle_invalid); }
+    // The entry was live at this generation inside the section, so its reference is the one that
+    // generation published and cannot be dropped before the section ends.
+    if (expected_type != type_ids::INVALID && entry.strong->type_id() != expected_type) {
         return ktl::err(ktl::errc::wrong_type);
     }
-    if ((entry->rights & required_rights) != required_rights) { return ktl::err(ktl::errc::rights_violation); }
-    return ktl::result<VerifiedHandle>::ok(VerifiedHandle{entry->object.promote(), entry->rights});
+    if ((view.rights & required_rights) != required_rights) { return ktl::err(ktl::errc::rights_violation); }
+    return ktl::result<VerifiedHandle>::ok(VerifiedHandle{entry.strong, view.rights});
 }
 
 size_t HandleTable::count() {
@@ -171,14 +348,15 @@ size_t HandleTable::count() {
 bool HandleTable::snapshot(ktl::vector<HandleInfo>& out) {
     kernel::synchronization::lock_guard guard(m_lock);
     if (!out.reserve(out.size() + m_count)) { return false; }
-    for (size_t i = 0; i < m_entries.size(); i++) {
-        auto& entry = m_entries[i];
-        if (!entry.object) { continue; }
+    for (size_t i = 0; i < capacity(); i++) {
+        auto& entry    = entry_at(i);
+        uint32_t state = entry.state.load(ktl::memory_order::relaxed);
+        if ((state & ENTRY_LIVE) == 0) { continue; }
         HandleInfo info;
-        info.id        = HandleId{static_cast<uint32_t>(i), entry.generation};
-        info.rights    = entry.rights;
-        info.type_id   = entry.object->type_id();
-        info.object_id = entry.object->id();
+        info.id        = HandleId{static_cast<uint32_t>(i), state & ~ENTRY_LIVE};
+        info.rights    = entry.rights.load(ktl::memory_order::relaxed);
+        info.type_id   = entry.strong->type_id();
+        info.object_id = entry.strong->id();
         if (!out.push_back(info)) { return false; }
     }
     return true;
@@ -194,7 +372,7 @@ ktl::maybe<HandleId> HandleTable::testing_set_generation(HandleId id, uint32_t g
     kernel::synchronization::lock_guard guard(m_lock);
     HandleEntry* entry = lookup_entry(id);
     if (!entry) { return ktl::nothing; }
-    entry->generation = generation;
+    entry->publish(generation | ENTRY_LIVE, entry->rights.load(ktl::memory_order::relaxed));
     return HandleId{id.index, generation};
 }
 #endif
@@ -0,0 +1,194 @@
+#include <kernel/config.h>
+#include <kernel/obj/otp.h>
+
+namespace kernel::obj::otp {
+
+namespace {
+
+namespace isa = ::abi::otp;
+
+// The error band a REJECT may return (see SYS_HANDLE_CLOSE in <abi/syscall.h>).
+constexpr int64_t ERROR_BAND_FLOOR = -64;
+
+bool is_register(uint8_t r) { return r < isa::REGISTERS; }
+bool is_operand(uint8_t src) { return src == isa::SRC_IMM || is_register(src); }
+bool is_width(uint8_t width) { return width == 1 || width == 2 || width == 4 || width == 8; }
+bool is_termination(uint8_t op) { return op <= isa::OP_DISPATCH; }
+
+// Cost units against CONFIG_OTP_MAX_COST. Register work is 1; touching storage is 2 for the
+// cache line it may miss on; a signal change is 4, since completing one wakes waiters and
+// notifies port bindings. Unknown opcodes never get this far.
+uint32_t cost_of(uint8_t op) {
+    switch (op) {
+        case isa::OP_LDS:
+        case isa::OP_STS: return 2;
+        case isa::OP_SIGNAL_SET:
+        case isa::OP_SIGNAL_CLEAR: return 4;
+        default: return 1;
+    }
+}
+
+// One instruction's checks, in the order the errors are documented at Program::create. `storage`
+// is the declared size accesses are bounded by; a passing access widens `extent`.
+ktl::result<void> check(const insn& in, size_t pc, size_t count, size_t storage, size_t& extent) {
+    switch (in.op) {
+        case isa::OP_REJECT: {
+            auto error = static_cast<int64_t>(in.imm);
+            if (error >= 0 || error < ERROR_BAND_FLOOR) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        }
+        case isa::OP_COMPLETE:
+            if (!is_register(in.src)) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_DISPATCH: break;
+        case isa::OP_LDI:
+            if (!is_register(in.dst)) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_MOV:
+            if (!is_register(in.dst) || !is_register(in.src)) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_LDM:
+            if (!is_register(in.dst)) { return ktl::err(ktl::errc::invalid_operation); }
+            if (in.off >= isa::META_COUNT) { return ktl::err(ktl::errc::out_of_range); }
+            break;
+        case isa::OP_LDS:
+        case isa::OP_STS: {
+            uint8_t value = in.op == isa::OP_LDS ? in.dst : in.src;
+            if (!is_register(value) || !is_width(in.width)) { return ktl::err(ktl::errc::invalid_operation); }
+            // 64-bit arithmetic: a 32-bit offset plus a width cannot wrap it.
+            uint64_t end = static_cast<uint64_t>(in.off) + in.width;
+            if (end > storage) { return ktl::err(ktl::errc::out_of_range); }
+            if (end > extent) { extent = static_cast<size_t>(end); }
+            break;
+        }
+        case isa::OP_ADD:
+        case isa::OP_SUB:
+        case isa::OP_MUL:
+        case isa::OP_AND:
+        case isa::OP_OR:
+        case isa::OP_XOR:
+        case isa::OP_CMP_EQ:
+        case isa::OP_CMP_NE:
+        case isa::OP_CMP_LT:
+        case isa::OP_CMP_GE:
+        case isa::OP_TEST:
+            if (!is_register(in.dst) || !is_operand(in.src)) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_SHL:
+        case isa::OP_SHR:
+            if (!is_register(in.dst) || in.imm >= 64) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_JMP:
+        case isa::OP_JT:
+        case isa::OP_JF:
+            // Forward-only by construction: off is unsigned. In bounds means the target exists.
+            if (static_cast<uint64_t>(pc) + 1 + in.off >= count) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        case isa::OP_SIGNAL_SET:
+        case isa::OP_SIGNAL_CLEAR:
+            if ((in.imm >> 32) != 0) { return ktl::err(ktl::errc::invalid_operation); }
+            break;
+        default: return ktl::err(ktl::errc::invalid_operation);
+    }
+    return ktl::result<void>::ok();
+}
+
+}  // namespace
+
+ktl::result<ktl::ref<Program>> Program::create(const insn* code, size_t count, uint32_t version,
+                                               size_t storage_bytes) {
+    if (version == 0 || version > isa::VERSION) { return ktl::err(ktl::errc::invalid_operation); }
+    if (code == nullptr || count == 0) { return ktl::err(ktl::errc::invalid_operation); }
+    if (count > isa::MAX_INSNS) { return ktl::err(ktl::errc::capacity_exhausted); }
+
+    // Structure: with every jump forward and in bounds, the only way off the end is to run past
+    // the last instruction, so every path terminates exactly when the last one is a termination.
+    if (!is_termination(code[count - 1].op)) { return ktl::err(ktl::errc::invalid_operation); }
+
+    size_t extent = 0;
+    bool writes   = false;
+    uint32_t cost = 0;
+    for (size_t pc = 0; pc < count; pc++) {
+        auto checked = check(code[pc], pc, count, storage_bytes, extent);
+        if (checked.is_err()) { return ktl::err(checked.unwrap_err()); }
+        writes = writes || code[pc].op == isa::OP_STS;
+        cost   = cost + cost_of(code[pc].op);
+    }
+    if (cost > CONFIG_OTP_MAX_COST) { return ktl::err(ktl::errc::capacity_exhausted); }
+
+    auto program = ktl::make_ref<Program>();
+    if (!program || !program->m_code.reserve(count)) { return ktl::err(ktl::errc::oom); }
+    for (size_t pc = 0; pc < count; pc++) { program->m_code.push_back(code[pc]); }
+    program->m_cost           = cost;
+    program->m_storage_extent = extent;
+    program->m_writes_storage = writes;
+    return ktl::result<ktl::ref<Program>>::ok(ktl::move(program));
+}
+
+verdict run(const Program& program, context& ctx) {
+    uint64_t regs[isa::REGISTERS] = {};
+    bool flag                     = false;
+    const insn* code              = program.code();
+    size_t length                 = program.length();
+    size_t pc                     = 0;
+    while (pc < length) {
+        const insn& in = code[pc];
+        auto operand   = [&]() { return in.src == isa::SRC_IMM ? in.imm : regs[in.src]; };
+        size_t next    = pc + 1;
+        switch (in.op) {
+            case isa::OP_REJECT: return {outcome::REJECT, in.imm};
+            case isa::OP_COMPLETE: return {outcome::COMPLETE, regs[in.src]};
+            case isa::OP_DISPATCH: return {outcome::DISPATCH, 0};
+            case isa::OP_LDI: regs[in.dst] = in.imm; break;
+            case isa::OP_MOV: regs[in.dst] = regs[in.src]; break;
+            case isa::OP_LDM: regs[in.dst] = ctx.meta[in.off]; break;
+            case isa::OP_LDS: {
+                // Both targets are little-endian, so a narrow copy into a zeroed word zero-extends.
+                uint64_t value = 0;
+                __builtin_memcpy(&value, ctx.storage + in.off, in.width);
+                regs[in.dst] = value;
+                break;
+            }
+            case isa::OP_STS: __builtin_memcpy(ctx.storage + in.off, &regs[in.src], in.width); break;
+            case isa::OP_ADD: regs[in.dst] = regs[in.dst] + operand(); break;
+            case isa::OP_SUB: regs[in.dst] = regs[in.dst] - operand(); break;
+            case isa::OP_MUL: regs[in.dst] = regs[in.dst] * operand(); break;
+            case isa::OP_AND: regs[in.dst] = regs[in.dst] & operand(); break;
+            case isa::OP_OR: regs[in.dst] = regs[in.dst] | operand(); break;
+            case isa::OP_XOR: regs[in.dst] = regs[in.dst] ^ operand(); break;
+            case isa::OP_SHL: regs[in.dst] = regs[in.dst] << in.imm; break;
+            case isa::OP_SHR: regs[in.dst] = regs[in.dst] >> in.imm; break;
+            case isa::OP_CMP_EQ: flag = regs[in.dst] == operand(); break;
+            case isa::OP_CMP_NE: flag = regs[in.dst] != operand(); break;
+            case isa::OP_CMP_LT: flag = regs[in.dst] < operand(); break;
+            case isa::OP_CMP_GE: flag = regs[in.dst] >= operand(); break;
+            case isa::OP_TEST: flag = (regs[in.dst] & operand()) != 0; break;
+            case isa::OP_JMP: next = pc + 1 + in.off; break;
+            case isa::OP_JT:
+                if (flag) { next = pc + 1 + in.off; }
+                break;
+            case isa::OP_JF:
+                if (!flag) { next = pc + 1 + in.off; }
+                break;
+            case isa::OP_SIGNAL_SET: {
+                auto bits           = static_cast<uint32_t>(in.imm);
+                ctx.signals_set     = ctx.signals_set | bits;
+                ctx.signals_cleared = ctx.signals_cleared & ~bits;
+                break;
+            }
+            case isa::OP_SIGNAL_CLEAR: {
+                auto bits           = static_cast<uint32_t>(in.imm);
+                ctx.signals_cleared = ctx.signals_cleared | bits;
+                ctx.signals_set     = ctx.signals_set & ~bits;
+                break;
+            }
+            default: break;  // unreachable: create() refuses unknown opcodes
+        }
+        pc = next;
+    }
+    // Unreachable for a created program, whose last instruction terminates. Dispatch is the
+    // outcome that can never be wrong.
+    return {outcome::DISPATCH, 0};
+}
+
+}  // namespace kernel::obj::otp
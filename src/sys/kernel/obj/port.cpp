@@ -8,11 +8,19 @@ namespace kernel::obj {
 
 namespace {
 
-// ponytail: one lock for the whole port subsystem -- every binding list, every port's ready
-// queue -- and a plain (non-IRQ) guard, because nothing signals objects from interrupt context
-// yet. Both are ceilings: split the lock if contention shows, switch to the IRQ guard when
-// interrupt objects start signaling from handlers.
-kernel::synchronization::spinlock g_port_lock;
+// Two lock domains, taken in this order when nested. A watched object's binding list is guarded
+// by one of these stripes, picked by object id: a lock per object would cost every object a
+// lockdep identity, and the list is only walked for the object's own transitions. Everything a
+// binding's port owns -- its binding list, its ready FIFO, a binding's pending state -- is under
+// that port's m_lock, so producers feeding different ports never meet. Both use the plain
+// (non-IRQ) guard, because nothing signals objects from interrupt context yet; switch to the IRQ
+// guard when interrupt objects start signaling from handlers.
+constexpr size_t BINDING_LOCK_STRIPES = 16;
+kernel::synchronization::spinlock g_binding_locks[BINDING_LOCK_STRIPES];
+
+kernel::synchronization::spinlock& binding_lock_of(const Object* object) {
+    return g_binding_locks[object->id() % BINDING_LOCK_STRIPES];
+}
 
 kernel::mm::object_arena g_binding_arena("port-binding", sizeof(port_binding), alignof(port_binding));
 
@@ -23,7 +31,25 @@ void destroy_binding(port_binding* binding) {
 
 }  // namespace
 
-// Unlink from the watched object's doubly-linked list. Caller holds g_port_lock.
+// Take detached bindings off their objects' lists, then free them. Runs with no lock held: each
+// unlink takes its object's stripe, and the dropped object reference may run an arbitrary
+// destructor. Returns how many were freed.
+size_t Port::retire(port_binding* victims) {
+    size_t count = 0;
+    while (victims != nullptr) {
+        port_binding* next = victims->port_next;
+        {
+            kernel::synchronization::critical_lock_guard guard(binding_lock_of(victims->object.get()));
+            unlink_from_object(victims);
+        }
+        destroy_binding(victims);
+        victims = next;
+        count++;
+    }
+    return count;
+}
+
+// Unlink from the watched object's doubly-linked list. Caller holds the object's stripe.
 void Port::unlink_from_object(port_binding* binding) {
     Object* watched = binding->object.get();
     if (binding->obj_prev != nullptr) { binding->obj_prev->obj_next = binding->obj_next; }
@@ -33,7 +59,7 @@ void Port::unlink_from_object(port_binding* binding) {
     binding->obj_prev = nullptr;
 }
 
-// Caller holds g_port_lock.
+// Caller holds m_lock.
 void Port::enqueue_ready(port_binding* binding) {
     binding->ready_next = nullptr;
     if (m_ready_tail != nullptr) {
@@ -44,6 +70,23 @@ void Port::enqueue_ready(port_binding* binding) {
     m_ready_tail = binding;
 }
 
+// Caller holds m_lock.
+void Port::detach(port_binding* binding) {
+    binding->detached = true;
+    if (!binding->pending) { return; }
+    // Drop the pending packet: walk the singly-linked ready FIFO to excise it.
+    port_binding** ready = &m_ready_head;
+    while (*ready != binding) { ready = &(*ready)->ready_next; }
+    *ready = binding->ready_next;
+    if (m_ready_tail == binding) {
+        m_ready_tail = m_ready_head;
+        while (m_ready_tail != nullptr && m_ready_tail->ready_next != nullptr) {
+            m_ready_tail = m_ready_tail->ready_next;
+        }
+    }
+    binding->pending = false;
+}
+
 ktl::result<void> Port::bind(ktl::ref<Object> object, uint64_t key, uint32_t mask) {
     if (!object) { return ktl::err(ktl::errc::null_argument); }
     if (mask == 0) { return ktl::err(ktl::errc::invalid_operation); }
@@ -58,8 +101,9 @@ ktl::result<void> Port::bind(ktl::ref<Object> object, uint64_t key, uint32_t mas
 
     bool pended     = false;
     {
-        kernel::synchronization::critical_lock_guard guard(g_port_lock);
-        Object* watched   = binding->object.get();
+        Object* watched = binding->object.get();
+        kernel::synchronization::critical_lock_guard object_guard(binding_lock_of(watched));
+        kernel::synchronization::critical_lock_guard port_guard(m_lock);
         binding->obj_next = watched->m_bindings;
         if (watched->m_bindings != nullptr) { watched->m_bindings->obj_prev = binding; }
         watched->m_bindings = binding;
@@ -81,11 +125,11 @@ ktl::result<void> Port::bind(ktl::ref<Object> object, uint64_t key, uint32_t mas
 }
 
 size_t Port::unbind(uint64_t key) {
-    // Unlink matches under the lock, destroy them after: the dropped object reference may run an
-    // arbitrary destructor, which must not execute inside the port lock.
+    // Detach matches under the port lock, so delivery skips them from here on; they leave their
+    // objects' lists and are destroyed after, outside it.
     port_binding* victims = nullptr;
     {
-        kernel::synchronization::critical_lock_guard guard(g_port_lock);
+        kernel::synchronization::critical_lock_guard guard(m_lock);
         port_binding** link = &m_bindings;
         while (*link != nullptr) {
             port_binding* binding = *link;
@@ -94,98 +138,82 @@ size_t Port::unbind(uint64_t key) {
                 continue;
             }
             *link = binding->port_next;
-            unlink_from_object(binding);
-            if (binding->pending) {
-                // Drop the pending packet: walk the singly-linked ready FIFO to excise it.
-                port_binding** ready = &m_ready_head;
-                while (*ready != binding) { ready = &(*ready)->ready_next; }
-                *ready = binding->ready_next;
-                if (m_ready_tail == binding) {
-                    m_ready_tail = m_ready_head;
-                    while (m_ready_tail != nullptr && m_ready_tail->ready_next != nullptr) {
-                        m_ready_tail = m_ready_tail->ready_next;
-                    }
-                }
-            }
+            detach(binding);
             binding->port_next = victims;
             victims            = binding;
         }
         if (m_ready_head == nullptr) { signal_clear(SIGNAL_READABLE); }
     }
-
-    size_t count = 0;
-    while (victims != nullptr) {
-        port_binding* next = victims->port_next;
-        destroy_binding(victims);
-        victims = next;
-        count++;
-    }
-    return count;
+    return retire(victims);
 }
 
 Port::~Port() {
     // No new bindings can arrive (no handles remain) and every binding holds only objects, never
     // the port, so tearing the lists down here cannot race a bind. Signal delivery can still find
-    // bindings until they leave the object lists under the lock.
+    // bindings until they leave the object lists, which retire waits out stripe by stripe
+    // before m_lock goes away with the port.
     port_binding* victims = nullptr;
     {
-        kernel::synchronization::critical_lock_guard guard(g_port_lock);
+        kernel::synchronization::critical_lock_guard guard(m_lock);
         while (m_bindings != nullptr) {
             port_binding* binding = m_bindings;
             m_bindings            = binding->port_next;
-            unlink_from_object(binding);
-            binding->port_next = victims;
-            victims            = binding;
+            binding->detached     = true;
+            binding->pending      = false;
+            binding->port_next    = victims;
+            victims               = binding;
         }
         m_ready_head = nullptr;
         m_ready_tail = nullptr;
     }
-    while (victims != nullptr) {
-        port_binding* next = victims->port_next;
-        destroy_binding(victims);
-        victims = next;
-    }
+    (void)retire(victims);
 }
 
-bool Port::dequeue(Packet& out) {
-    kernel::synchronization::critical_lock_guard guard(g_port_lock);
-    port_binding* binding = m_ready_head;
-    if (binding == nullptr) {
-        // Cleared under the lock so a producer's enqueue cannot interleave; the producer's
-        // signal_set lands after its unlock, so READABLE can flicker high on an empty queue but
-        // never sit low on a full one.
+size_t Port::dequeue(Packet* out, size_t max) {
+    kernel::synchronization::critical_lock_guard guard(m_lock);
+    size_t count = 0;
+    while (count < max && m_ready_head != nullptr) {
+        port_binding* binding    = m_ready_head;
+        m_ready_head             = binding->ready_next;
+        binding->ready_next      = nullptr;
+        out[count].key           = binding->key;
+        out[count].signals       = binding->pending_signals;
+        binding->pending         = false;
+        binding->pending_signals = 0;
+        count++;
+    }
+    // Cleared under the lock so a producer's enqueue cannot interleave; the producer's signal_set
+    // lands after its unlock, so READABLE can flicker high on an empty queue but never sit low on
+    // a full one.
+    if (m_ready_head == nullptr) {
+        m_ready_tail = nullptr;
         signal_clear(SIGNAL_READABLE);
-        return false;
     }
-    m_ready_head = binding->ready_next;
-    if (m_ready_head == nullptr) { m_ready_tail = nullptr; }
-    binding->ready_next      = nullptr;
-    out.key                  = binding->key;
-    out.signals              = binding->pending_signals;
-    binding->pending         = false;
-    binding->pending_signals = 0;
-    if (m_ready_head == nullptr) { signal_clear(SIGNAL_READABLE); }
-    return true;
+    return count;
 }
 
 size_t Port::binding_count() {
-    kernel::synchronization::critical_lock_guard guard(g_port_lock);
+    kernel::synchronization::critical_lock_guard guard(m_lock);
     size_t count = 0;
     for (port_binding* b = m_bindings; b != nullptr; b = b->port_next) { count++; }
     return count;
 }
 
 void port_notify(Object* object, uint32_t previous, uint32_t current) {
-    // The restart dance keeps the port lock out of signal_set's way: asserting READABLE on the
-    // port re-enters this function for the port's own bindings, so it must happen unlocked. Each
-    // restart finds strictly more bindings already pending, so the scan converges.
+    // The restart dance keeps both locks out of signal_set's way: asserting READABLE on the port
+    // re-enters this function for the port's own bindings, so it must happen unlocked. Each
+    // restart finds strictly more bindings already pending, so the scan converges. The stripe
+    // keeps every binding on the list -- and so its port -- alive while the scan holds it.
     for (;;) {
         Port* to_signal = nullptr;
         {
-            kernel::synchronization::critical_lock_guard guard(g_port_lock);
+            kernel::synchronization::critical_lock_guard guard(binding_lock_of(object));
             for (port_binding* binding = object->m_bindings; binding != nullptr; binding = binding->obj_next) {
                 uint32_t hits = current & binding->mask;
                 if (hits == 0) { continue; }
+                Port* port = binding->port;
+                kernel::synchronization::critical_lock_guard port_guard(port->m_lock);
+                if (binding->detached) { continue; }  // unbound, waiting to leave this list
                 if (binding->pending) {
                     binding->pending_signals |= hits;  // coalesce into the queued packet
                     continue;
@@ -193,8 +221,8 @@ void port_notify(Object* object, uint32_t previous, uint32_t current) {
                 if ((previous & binding->mask) != 0) { continue; }  // no edge: was already matched
                 binding->pending         = true;
                 binding->pending_signals = hits;
-                binding->port->enqueue_ready(binding);
-                to_signal = binding->port;
+                port->enqueue_ready(binding);
+                to_signal = port;
                 break;
             }
         }
@@ -7,26 +7,61 @@
 
 namespace kernel::obj {
 
+namespace {
+
+constexpr size_t PAGE_BYTES = 4096;
+constexpr size_t MAX_PAGES  = Socket::MAX_BUFFER_BYTES / PAGE_BYTES;
+
+static_assert(Socket::BUFFER_BYTES % PAGE_BYTES == 0 && Socket::MAX_BUFFER_BYTES % PAGE_BYTES == 0,
+              "rings are whole pages");
+
+}  // namespace
+
 // The pair's shared half, mirroring channel_state: one lock covering both directions, raw
 // back-pointers nulled as each endpoint dies, and one byte ring per direction indexed by the
-// side that reads it. Ring pages come from the same one-page PMM helper the channels use.
+// side that reads it. A ring's pages come one at a time from the same PMM helper the channels
+// use, so a large ring needs no contiguous run; like the IPC buffer, the ring keeps its frames'
+// addresses and walks a range page by page.
 struct socket_state {
     static void* operator new(size_t size, const std::nothrow_t&) noexcept;
     static void operator delete(void* ptr);
 
-    kernel::synchronization::mutex lock;
+    kernel::synchronization::mutex lock{"socket"};
     Socket* ends[2] = {nullptr, nullptr};
+    size_t capacity = 0;  // bytes per direction
 
     struct byte_ring {
-        uintptr_t page = 0;
-        size_t head    = 0;
-        size_t count   = 0;
+        uintptr_t pages[MAX_PAGES] = {};
+        size_t head                = 0;
+        size_t count               = 0;
+        size_t read_high           = 1;      // READABLE on the reader at this many bytes
+        size_t write_low           = 0;      // WRITABLE back on the writer at this many bytes
+        bool writer_stalled        = false;  // the writer's WRITABLE is down until write_low
+
+        // Copy `length` bytes between `at` (a ring position) and `bytes`, wrapping at `capacity`.
+        template <bool IN> void copy(size_t at, uint8_t* bytes, size_t length, size_t capacity) {
+            while (length != 0) {
+                size_t in_page = at % PAGE_BYTES;
+                size_t run     = length < PAGE_BYTES - in_page ? length : PAGE_BYTES - in_page;
+                auto* page     = reinterpret_cast<uint8_t*>(pages[at / PAGE_BYTES]) + in_page;
+                if constexpr (IN) {
+                    __builtin_memcpy(page, bytes, run);
+                } else {
+                    __builtin_memcpy(bytes, page, run);
+                }
+                at      = (at + run) % capacity;
+                bytes  += run;
+                length -= run;
+            }
+        }
     };
     byte_ring inbound[2];
 
     ~socket_state() {
         for (auto& ring : inbound) {
-            if (ring.page != 0) { channel_page_free(ring.page); }
+            for (uintptr_t page : ring.pages) {
+                if (page != 0) { channel_page_free(page); }
+            }
         }
     }
 };
@@ -38,17 +73,22 @@ void* socket_state::operator new(size_t size, const std::nothrow_t&) noexcept {
 }
 void socket_state::operator delete(void* ptr) { g_socket_state_arena.free(ptr); }
 
-static_assert(Socket::BUFFER_BYTES <= 4096, "one ring per direction fits its one page");
-
 Socket::Socket(ktl::ref<socket_state> state, uint32_t side)
     : Object(TYPE_ID), m_state(ktl::move(state)), m_side(side) {}
 
-ktl::result<Socket::Pair> Socket::create() {
+ktl::result<Socket::Pair> Socket::create(size_t capacity) {
+    if (capacity == 0 || capacity > MAX_BUFFER_BYTES) { return ktl::err(ktl::errc::out_of_range); }
+    size_t pages = (capacity + PAGE_BYTES - 1) / PAGE_BYTES;
+
     auto state = ktl::make_ref<socket_state>();
     if (!state) { return ktl::err(ktl::errc::oom); }
+    state->capacity = pages * PAGE_BYTES;
     for (auto& ring : state->inbound) {
-        ring.page = channel_page_alloc();
-        if (ring.page == 0) { return ktl::err(ktl::errc::oom); }  // ~socket_state frees the other
+        for (size_t i = 0; i < pages; i++) {
+            ring.pages[i] = channel_page_alloc();
+            if (ring.pages[i] == 0) { return ktl::err(ktl::errc::oom); }  // ~socket_state frees the rest
+        }
+        ring.write_low = state->capacity - 1;
     }
     auto first  = ktl::make_ref<Socket>(state, 0u);
     auto second = ktl::make_ref<Socket>(state, 1u);
@@ -65,60 +105,106 @@ ktl::result<Socket::Pair> Socket::create() {
 Socket::~Socket() {
     kernel::synchronization::lock_guard guard(m_state->lock);
     m_state->ends[m_side] = nullptr;
-    // Buffered bytes stay readable on the peer, so its READABLE is left alone.
+    // Buffered bytes stay readable on the peer, and no more are coming, so whatever is left is
+    // READABLE even short of the peer's mark.
     if (Socket* peer = m_state->ends[m_side ^ 1]) {
         peer->signal_clear(SIGNAL_WRITABLE);
+        if (m_state->inbound[m_side ^ 1].count != 0) { peer->signal_set(SIGNAL_READABLE); }
         peer->signal_set(SIGNAL_PEER_CLOSED);
     }
 }
 
+size_t Socket::capacity() const { return m_state->capacity; }
+
 ktl::result<size_t> Socket::write(const void* data, size_t length) {
+    const run single{static_cast<uint8_t*>(const_cast<void*>(data)), length};
+    return write(&single, 1);
+}
+
+ktl::result<size_t> Socket::read(void* out, size_t capacity) {
+    const run single{static_cast<uint8_t*>(out), capacity};
+    return read(&single, 1);
+}
+
+ktl::result<size_t> Socket::write(const run* runs, size_t count) {
     kernel::synchronization::lock_guard guard(m_state->lock);
     Socket* peer = m_state->ends[m_side ^ 1];
     if (!peer) { return ktl::err(ktl::errc::peer_closed); }
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) { length += runs[i].length; }
     if (length == 0) { return ktl::result<size_t>::ok(0); }
 
-    auto& ring   = m_state->inbound[m_side ^ 1];
-    size_t space = BUFFER_BYTES - ring.count;
-    if (space == 0) { return ktl::err(ktl::errc::capacity_exhausted); }
-
-    // At most two runs: tail-to-edge, then wrap to the front.
-    size_t take        = length < space ? length : space;
-    const uint8_t* src = static_cast<const uint8_t*>(data);
-    size_t tail        = (ring.head + ring.count) % BUFFER_BYTES;
-    size_t first_run   = take < BUFFER_BYTES - tail ? take : BUFFER_BYTES - tail;
-    __builtin_memcpy(reinterpret_cast<uint8_t*>(ring.page) + tail, src, first_run);
-    __builtin_memcpy(reinterpret_cast<uint8_t*>(ring.page), src + first_run, take - first_run);
-    ring.count += take;
-
-    peer->signal_set(SIGNAL_READABLE);
-    if (ring.count == BUFFER_BYTES) { signal_clear(SIGNAL_WRITABLE); }
-    return ktl::result<size_t>::ok(take);
+    auto& ring      = m_state->inbound[m_side ^ 1];
+    size_t capacity = m_state->capacity;
+    if (ring.count == capacity) { return ktl::err(ktl::errc::capacity_exhausted); }
+
+    size_t done = 0;
+    for (size_t i = 0; i < count && ring.count < capacity; i++) {
+        size_t space = capacity - ring.count;
+        size_t take  = runs[i].length < space ? runs[i].length : space;
+        ring.copy<true>((ring.head + ring.count) % capacity, runs[i].data, take, capacity);
+        ring.count += take;
+        done       += take;
+    }
+
+    if (ring.count >= ring.read_high) { peer->signal_set(SIGNAL_READABLE); }
+    if (ring.count == capacity) {
+        ring.writer_stalled = true;
+        signal_clear(SIGNAL_WRITABLE);
+    }
+    return ktl::result<size_t>::ok(done);
 }
 
-ktl::result<size_t> Socket::read(void* out, size_t capacity) {
+ktl::result<size_t> Socket::read(const run* runs, size_t count) {
     kernel::synchronization::lock_guard guard(m_state->lock);
     auto& ring = m_state->inbound[m_side];
     if (ring.count == 0) {
         bool peer_alive = m_state->ends[m_side ^ 1] != nullptr;
         return ktl::err(peer_alive ? ktl::errc::would_block : ktl::errc::peer_closed);
     }
-    if (capacity == 0) { return ktl::result<size_t>::ok(0); }
-
-    size_t take      = capacity < ring.count ? capacity : ring.count;
-    uint8_t* dst     = static_cast<uint8_t*>(out);
-    size_t first_run = take < BUFFER_BYTES - ring.head ? take : BUFFER_BYTES - ring.head;
-    __builtin_memcpy(dst, reinterpret_cast<const uint8_t*>(ring.page) + ring.head, first_run);
-    __builtin_memcpy(dst + first_run, reinterpret_cast<const uint8_t*>(ring.page), take - first_run);
-    bool was_full = ring.count == BUFFER_BYTES;
-    ring.head     = (ring.head + take) % BUFFER_BYTES;
-    ring.count -= take;
-
-    if (ring.count == 0) { signal_clear(SIGNAL_READABLE); }
-    if (was_full) {
-        if (Socket* peer = m_state->ends[m_side ^ 1]) { peer->signal_set(SIGNAL_WRITABLE); }
+
+    size_t capacity = m_state->capacity;
+    size_t done     = 0;
+    for (size_t i = 0; i < count && ring.count != 0; i++) {
+        size_t take = runs[i].length < ring.count ? runs[i].length : ring.count;
+        ring.copy<false>(ring.head, runs[i].data, take, capacity);
+        ring.head   = (ring.head + take) % capacity;
+        ring.count -= take;
+        done       += take;
+    }
+
+    // A hung-up peer leaves the remainder READABLE down to the last byte (see ~Socket).
+    Socket* peer = m_state->ends[m_side ^ 1];
+    if (ring.count == 0 || (peer && ring.count < ring.read_high)) { signal_clear(SIGNAL_READABLE); }
+    if (ring.writer_stalled && ring.count <= ring.write_low) {
+        ring.writer_stalled = false;
+        if (peer) { peer->signal_set(SIGNAL_WRITABLE); }
+    }
+    return ktl::result<size_t>::ok(done);
+}
+
+ktl::result<void> Socket::set_watermarks(size_t read_high, size_t write_low) {
+    kernel::synchronization::lock_guard guard(m_state->lock);
+    size_t capacity = m_state->capacity;
+    if (read_high == 0 || read_high > capacity || write_low >= capacity) { return ktl::err(ktl::errc::out_of_range); }
+
+    // Apply the new marks to the signals as they stand, as if the last transfer had just run.
+    auto& inbound     = m_state->inbound[m_side];
+    Socket* peer      = m_state->ends[m_side ^ 1];
+    inbound.read_high = read_high;
+    if (inbound.count != 0 && (inbound.count >= read_high || !peer)) {
+        signal_set(SIGNAL_READABLE);
+    } else {
+        signal_clear(SIGNAL_READABLE);
+    }
+
+    auto& outbound     = m_state->inbound[m_side ^ 1];
+    outbound.write_low = write_low;
+    if (peer && outbound.writer_stalled && outbound.count <= write_low) {
+        outbound.writer_stalled = false;
+        signal_set(SIGNAL_WRITABLE);
     }
-    return ktl::result<size_t>::ok(take);
+    return ktl::result<void>::ok();
 }
 
 }  // namespace kernel::obj
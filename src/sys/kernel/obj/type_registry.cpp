@@ -1,4 +1,5 @@
 #include <kernel/obj/type_registry.h>
+#include <std/new.h>
 
 #include <ktl/algorithm>
 #include <ktl/string_view>
@@ -7,26 +8,70 @@ namespace kernel::obj {
 
 TypeRegistry g_type_registry;
 
+// Nothing can still be reading a registry that is being destroyed.
+TypeRegistry::~TypeRegistry() {
+    for (auto* slot : m_programs) { delete slot; }
+}
+
 ktl::result<void> TypeRegistry::register_type(TypeId id, ktl::string_view name, Rights valid_rights,
-                                              Rights default_rights) {
+                                              Rights default_rights, uint32_t storage_bytes) {
     kernel::synchronization::lock_guard guard(m_lock);
 
-    if (m_count >= MAX_TYPES) { return ktl::err(ktl::errc::registry_full); }
+    size_t count = m_count.load(ktl::memory_order::relaxed);
+    if (count >= MAX_TYPES) { return ktl::err(ktl::errc::registry_full); }
+    if (storage_bytes > CONFIG_OBJECT_MAX_INLINE_STORAGE) { return ktl::err(ktl::errc::out_of_range); }
 
     auto duplicate =
-        ktl::find_if(m_types, m_types + m_count, [&](const TypeDescriptor& t) { return t.id == id || t.name == name; });
+        ktl::find_if(m_types, m_types + count, [&](const TypeDescriptor& t) { return t.id == id || t.name == name; });
     if (duplicate.has_value()) { return ktl::err(ktl::errc::already_registered); }
 
-    m_types[m_count] = {id, name, valid_rights, default_rights};
-    m_count++;
+    // Lookups scan without the lock, so the descriptor is complete before the count covers it.
+    m_types[count] = {id, name, valid_rights, default_rights, storage_bytes};
+    m_count.store(count + 1, ktl::memory_order::release);
 
     return ktl::result<void>::ok();
 }
 
-size_t TypeRegistry::count() const { return m_count; }
+size_t TypeRegistry::count() const { return m_count.load(ktl::memory_order::acquire); }
 
 ktl::maybe<const TypeDescriptor&> TypeRegistry::lookup(TypeId id) const {
-    return ktl::find_if(m_types, m_types + m_count, [&](const TypeDescriptor& t) { return t.id == id; });
+    return ktl::find_if(m_types, m_types + count(), [&](const TypeDescriptor& t) { return t.id == id; });
+}
+
+ktl::result<void> TypeRegistry::attach_program(TypeId id, const otp::insn* code, size_t count, uint32_t version) {
+    // Descriptors never change once registered, so validation runs outside every lock.
+    auto index = index_for_id(id);
+    if (!index.has_value()) { return ktl::err(ktl::errc::wrong_type); }
+    auto created = otp::Program::create(code, count, version, m_types[index.value()].storage_bytes);
+    if (created.is_err()) { return ktl::err(created.unwrap_err()); }
+
+    auto* slot = new (std::nothrow) program_slot;
+    if (slot == nullptr) { return ktl::err(ktl::errc::oom); }
+    slot->program = created.unwrap();
+
+    // A reader may have loaded the displaced slot and not yet taken its reference, so the slot
+    // outlives a grace period; its reference then drops, and the program with it unless an
+    // invocation still holds one.
+    program_slot* displaced;
+    {
+        kernel::synchronization::lock_guard guard(m_lock);
+        displaced = m_programs[index.value()];
+        kernel::synchronization::rcu_assign(m_programs[index.value()], slot);
+    }
+    if (displaced != nullptr) { kernel::synchronization::call_rcu(&displaced->rcu, reclaim_slot); }
+    return ktl::result<void>::ok();
+}
+
+void TypeRegistry::reclaim_slot(kernel::synchronization::rcu_head* head) {
+    delete reinterpret_cast<program_slot*>(head);
+}
+
+ktl::ref<otp::Program> TypeRegistry::program(TypeId id) {
+    auto index = index_for_id(id);
+    if (!index.has_value()) { return {}; }
+    kernel::synchronization::rcu_read_guard guard;
+    auto* slot = kernel::synchronization::rcu_dereference(m_programs[index.value()]);
+    return slot != nullptr ? slot->program : ktl::ref<otp::Program>();
 }
 
 void TypeRegistry::on_object_created(TypeId id) {
@@ -43,7 +88,7 @@ uint32_t TypeRegistry::live_count(TypeId id) const {
 }
 
 ktl::maybe<size_t> TypeRegistry::index_for_id(TypeId id) const {
-    return ktl::find_index_if(m_types, m_types + m_count, [&](const TypeDescriptor& t) { return t.id == id; });
+    return ktl::find_index_if(m_types, m_types + count(), [&](const TypeDescriptor& t) { return t.id == id; });
 }
 
 }  // namespace kernel::obj
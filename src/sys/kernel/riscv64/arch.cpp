@@ -24,6 +24,9 @@ void set_kernel_stack(uintptr_t) {}
     riscv::current_core().kstack_top = kstack_top;
     constexpr uint64_t SSTATUS_SPP   = 1ull << 8;
     constexpr uint64_t SSTATUS_SPIE  = 1ull << 5;
+    // FS Off: a fresh thread has no FP state loaded anywhere, so its first FP instruction traps
+    // and loads it (sched::fpu_first_use) rather than reading the last thread's registers.
+    constexpr uint64_t SSTATUS_FS = 3ull << 13;
     // a0/a1 carry the IPC buffer, matching the argument registers so startup code reads them as
     // ordinary function arguments. Everything outside that ABI is zeroed so no kernel value stays
     // readable in a register; the zeroing follows the last use of every operand, and the operands
@@ -69,7 +72,7 @@ void set_kernel_stack(uintptr_t) {}
         "li a7, 0\n"
         "sret\n"
         : "+r"(entry), "+r"(user_sp), "+r"(ipc_base), "+r"(ipc_size)
-        : "i"(SSTATUS_SPP), "i"(SSTATUS_SPIE)
+        : "i"(SSTATUS_SPP | SSTATUS_FS), "i"(SSTATUS_SPIE)
         : "ra", "gp", "tp", "t0", "t1", "t2", "t3", "t4", "t5", "t6", "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
           "s8", "s9", "s10", "s11", "a0", "a1", "memory");
     __builtin_unreachable();
@@ -116,6 +119,9 @@ uintptr_t active_translation_root() {
 
 void wait_for_interrupt() { asm volatile("wfi"); }
 
+// Zihintpause's pause, spelled as the FENCE hint it is so the rv64imac assembler accepts it.
+void cpu_relax() { asm volatile(".insn i 0x0F, 0, x0, x0, 0x010"); }
+
 extern "C" void thread_entry_trampoline();
 
 uintptr_t prepare_thread_stack(uintptr_t stack_top, void (*entry)(void*), void* arg) {
@@ -138,14 +144,17 @@ uint64_t timestamp() {
 // The save area holds f0-f31 at bytes 0..255 and fcsr at 256. All-zero is the entry state --
 // cleared registers, round-to-nearest, no accrued flags -- and the area arrives zeroed, so there
 // is nothing to seed. The kernel builds -march=rv64imac, so the FP instructions are scoped to the
-// two functions below with .option arch; they rely on sstatus.FS being switched on per hart
-// (trap_init).
+// two functions below with .option arch. Each first switches sstatus.FS on for itself: the kernel
+// runs with whatever FS the interrupted user frame had, which is Off while the trap is armed.
+// Only the live CSR changes; the return to user restores the frame's own FS.
 void fpu_init(void*) {}
 
 void fpu_save(void* area) {
     asm volatile(
         ".option push\n"
         ".option arch, +d\n"
+        "li t0, 0x2000\n"
+        "csrs sstatus, t0\n"
         ".irp idx, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31\n"
         "fsd f\\idx, (8*\\idx)(%0)\n"
         ".endr\n"
@@ -161,6 +170,8 @@ void fpu_restore(void* area) {
     asm volatile(
         ".option push\n"
         ".option arch, +d\n"
+        "li t0, 0x2000\n"
+        "csrs sstatus, t0\n"
         "lw t0, 256(%0)\n"
         "csrw fcsr, t0\n"
         ".irp idx, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31\n"
@@ -172,4 +183,15 @@ void fpu_restore(void* area) {
         : "t0", "memory");
 }
 
+// The trap itself is sstatus.FS Off in the user frame, which only the trap return path can write
+// (riscv_trap_return); this records what it should write.
+void fpu_set_trap(bool armed) { riscv::current_core().fpu_trap_armed = armed; }
+
+bool fpu_take_dirty() {
+    auto& core     = riscv::current_core();
+    bool dirty     = core.fpu_dirty;
+    core.fpu_dirty = false;
+    return dirty;
+}
+
 }  // namespace kernel::arch
@@ -58,6 +58,11 @@ uint64_t make_table_ptr(vm_paddr_t child, uint64_t) { return pte::ppn_encode(chi
 void widen_table_ptr(uint64_t&, uint64_t) {}
 
 uint64_t make_leaf(vm_paddr_t paddr, uint64_t flags) { return pte::ppn_encode(paddr) | flags | pte::VALID; }
+// Sv39 leaves look the same at every level; the level they sit at sets the size.
+uint64_t make_large_leaf(vm_paddr_t paddr, uint64_t flags) { return make_leaf(paddr, flags); }
+uint64_t pte_promote(uint64_t entry) { return entry; }
+// Megapages and gigapages are part of Sv39 itself.
+bool large_page_supported(size_t size) { return size == LARGE_PAGE_2M || size == LARGE_PAGE_1G; }
 
 // Translate arch-neutral leaf attributes into Sv39 PTE permission bits.
 // A/D are pre-set so implementations that trap on hardware A/D update
@@ -82,7 +87,7 @@ vm_translation attrs_from_pte(uint64_t entry, vm_paddr_t paddr) {
     if (entry & pte::EXECUTE) { prot |= vm_prot::EXECUTE; }
     if (entry & pte::USER) { prot |= vm_prot::USER; }
     auto cache = static_cast<vm_cache_mode>((entry & pte::RSW_MASK) >> pte::RSW_SHIFT);
-    return {paddr, prot, cache};
+    return {paddr, prot, cache, 0};  // the walk knows the leaf size
 }
 
 vm_paddr_t current_root() {
@@ -110,7 +115,9 @@ void flush_new_leaf(vm_paddr_t root, uintptr_t vaddr) { flush_tlb_page(root, vad
 
 // SBI RFENCE runs the sfence.vma on the named harts and returns once they have executed it, so
 // the caller's unmap is complete everywhere on return.
-void shootdown_tlb_page(uint64_t core_mask, uintptr_t vaddr) {
+void shootdown_tlb_page(uint64_t core_mask, uintptr_t vaddr) { shootdown_tlb_range(core_mask, vaddr, 4096); }
+
+void shootdown_tlb_range(uint64_t core_mask, uintptr_t vaddr, size_t size) {
     uint64_t hart_mask = 0;
     for (size_t core = 0; core_mask != 0; core++, core_mask >>= 1) {
         if (!(core_mask & 1)) { continue; }
@@ -118,7 +125,7 @@ void shootdown_tlb_page(uint64_t core_mask, uintptr_t vaddr) {
         if (hartid >= 64) { panic("sbi: hartid does not fit a hart mask"); }
         hart_mask |= 1ull << hartid;
     }
-    if (kernel::riscv::sbi::remote_sfence_vma(hart_mask, vaddr, 4096).error != 0) {
+    if (kernel::riscv::sbi::remote_sfence_vma(hart_mask, vaddr, size).error != 0) {
         panic("tlb: SBI RFENCE remote_sfence_vma failed");
     }
 }
@@ -4,6 +4,8 @@
 #include <kernel/platform.h>
 #include <kernel/time.h>
 
+#include <ktl/atomic>
+
 namespace kernel::platform {
 
 namespace {
@@ -31,11 +33,15 @@ class sbi_timer : public kernel::hal::IInterruptHandler {
    public:
     void init();
     void start_local();
+    bool set_deadline(time_ns_t deadline_ns);
     time_ns_t resolution_ns();
     bool handle_interrupt(register_frame_t* regs);
 
    private:
     uint64_t m_ticks_per_interval = 0;
+    // Set once the scheduler first programs a deadline; from then on every hart's interrupt is
+    // one-shot and the handler stops re-arming the periodic interval.
+    ktl::atomic<bool> m_oneshot{false};
 };
 
 // Interrupt-handler object, so its constructor must have run (global ctors)
@@ -45,6 +51,7 @@ sbi_timer g_timer;
 
 void timer_init() { g_timer.init(); }
 void timer_start_local() { g_timer.start_local(); }
+bool timer_set_deadline(int64_t deadline_ns) { return g_timer.set_deadline(deadline_ns); }
 
 void sbi_timer::init() {
     m_ticks_per_interval = timestamp_hz() / TICK_HZ;
@@ -62,11 +69,25 @@ void sbi_timer::start_local() {
     asm volatile("csrs sie, %0" ::"r"(SIE_STIE));
 }
 
+// The SBI deadline is already absolute and one-shot; an all-ones deadline is the spec's way to
+// cancel a pending timer.
+bool sbi_timer::set_deadline(time_ns_t deadline_ns) {
+    m_oneshot.store(true, ktl::memory_order::relaxed);
+    uint64_t stamp = deadline_ns == kernel::time::NEVER ? ~uint64_t{0} : kernel::time::ns_to_timestamp(deadline_ns);
+    return sbi_set_timer(stamp) == 0;
+}
+
 time_ns_t sbi_timer::resolution_ns() { return static_cast<time_ns_t>(1'000'000'000ULL / TICK_HZ); }
 
 bool sbi_timer::handle_interrupt(register_frame_t*) {
-    // Re-arm first: tick() may preempt into another thread and not return for a full timeslice.
-    sbi_set_timer(kernel::arch::timestamp() + m_ticks_per_interval);
+    // Periodic mode re-arms first: tick() may preempt into another thread and not return for a
+    // full timeslice. In one-shot mode tick() programs the next deadline itself; until it does,
+    // the spent deadline would re-raise the interrupt, so push it out of the way.
+    if (m_oneshot.load(ktl::memory_order::relaxed)) {
+        sbi_set_timer(~uint64_t{0});
+    } else {
+        sbi_set_timer(kernel::arch::timestamp() + m_ticks_per_interval);
+    }
     kernel::time::tick();
     return true;
 }
@@ -4,6 +4,8 @@
 #include <kernel/panic.h>
 #include <kernel/platform.h>
 #include <kernel/registers.h>
+#include <kernel/riscv/cpu.h>
+#include <kernel/sched/scheduler.h>
 #include <kernel/sched/user_task.h>
 #include <kernel/synchronization/execution_context.h>
 #include <kernel/syscall.h>
@@ -15,8 +17,12 @@ extern "C" void riscv_trap_entry();
 namespace {
 
 constexpr uint64_t SCAUSE_INTERRUPT             = 1ull << 63;
-constexpr uint64_t SSTATUS_SPP                  = 1ull << 8;  // previous privilege: 0 = user, 1 = supervisor
+constexpr uint64_t SSTATUS_SPP                  = 1ull << 8;   // previous privilege: 0 = user, 1 = supervisor
+constexpr uint64_t SSTATUS_FS                   = 3ull << 13;  // FP unit: Off, Initial, Clean, Dirty
+constexpr uint64_t SSTATUS_FS_CLEAN             = 2ull << 13;
+constexpr uint64_t SSTATUS_FS_DIRTY             = 3ull << 13;
 
+constexpr uint64_t CAUSE_ILLEGAL_INSTRUCTION    = 2;
 constexpr uint64_t CAUSE_INSTRUCTION_PAGE_FAULT = 12;
 constexpr uint64_t CAUSE_LOAD_PAGE_FAULT        = 13;
 constexpr uint64_t CAUSE_STORE_PAGE_FAULT       = 15;
@@ -40,6 +46,15 @@ bool try_resolve_page_fault(register_frame_t* regs) {
     return kernel::mm::vmm_handle_fault(fault);
 }
 
+// A trap from user mode with FS Dirty: the thread wrote its FP state since it last came in, and
+// the next switch away must save it. Recorded for the core and downgraded to Clean here, so the
+// next trap sees only later writes.
+void note_user_fp_state(register_frame_t* regs) {
+    if ((regs->sstatus & SSTATUS_FS) != SSTATUS_FS_DIRTY) { return; }
+    kernel::riscv::current_core().fpu_dirty = true;
+    regs->sstatus                           = (regs->sstatus & ~SSTATUS_FS) | SSTATUS_FS_CLEAN;
+}
+
 }  // namespace
 
 namespace kernel::riscv {
@@ -49,12 +64,11 @@ void trap_init() {
     asm volatile("csrw stvec, %0" ::"r"(&riscv_trap_entry));
     asm volatile("csrw sscratch, zero");
 
-    // Allow FP execution: sstatus.FS resets to Off, where any FP touch -- user code or the
-    // scheduler's own state switching -- traps as an illegal instruction. Setting Initial (0b01)
-    // once per hart is enough: hardware only ever promotes FS toward Dirty, every other sstatus
-    // write in the kernel is bit-scoped or round-trips a live value, and the trap return path
-    // restores the frame's saved sstatus, so no path can turn FS back Off. It lives here so every
-    // hart inherits FP enablement along with its trap vector.
+    // sstatus.FS resets to Off, where any FP touch traps as an illegal instruction. Boot code
+    // runs with Initial (0b01); from the first user thread on, FS follows the trap frames, where
+    // the lazy FP switch keeps it (riscv_trap_return), and the scheduler's own save and restore
+    // switch it on for themselves. It lives here so every hart starts from the same state along
+    // with its trap vector.
     constexpr uint64_t SSTATUS_FS_INITIAL = 1ull << 13;
     asm volatile("csrs sstatus, %0" ::"r"(SSTATUS_FS_INITIAL));
 }
@@ -67,6 +81,7 @@ extern "C" [[noreturn]] void riscv_trap_stack_overflow(uintptr_t sepc, uintptr_t
 }
 
 extern "C" void riscv_trap_handler(register_frame_t* regs) {
+    if ((regs->sstatus & SSTATUS_SPP) == 0) { note_user_fp_state(regs); }
     if (regs->scause & SCAUSE_INTERRUPT) {
         kernel::synchronization::interrupt_enter();
         const auto cause = static_cast<unsigned int>(regs->scause & ~SCAUSE_INTERRUPT);
@@ -90,6 +105,16 @@ extern "C" void riscv_trap_handler(register_frame_t* regs) {
         }
     }
 
+    // An FP instruction with FS Off in user mode: the thread's first since it was switched in
+    // (arch::fpu_set_trap). Its state is loaded now, the return path reopens FS, and the sret
+    // retries the instruction. An instruction that was illegal anyway traps again with FS on and
+    // ends up below.
+    if (regs->scause == CAUSE_ILLEGAL_INSTRUCTION && (regs->sstatus & (SSTATUS_SPP | SSTATUS_FS)) == 0 &&
+        kernel::sched::fpu_first_use()) {
+        kernel::synchronization::fault_exit();
+        return;
+    }
+
     constexpr uint64_t CAUSE_ECALL_U = 8;
     if (regs->scause == CAUSE_ECALL_U) {
         kernel::synchronization::fault_exit();
@@ -107,3 +132,17 @@ extern "C" void riscv_trap_handler(register_frame_t* regs) {
 
     kernel::crash::dispatch(kernel::crash::trigger_kind::exception, regs);
 }
+
+// Called by the trap entry with interrupts off from here to the sret, after the handler and any
+// switch it made: whether the core holds the returning user thread's FP state is settled only
+// now. Armed, FS goes Off; otherwise an Off left from an earlier armed return reopens as Clean.
+extern "C" void riscv_trap_return(register_frame_t* regs) {
+    if ((regs->sstatus & SSTATUS_SPP) != 0) { return; }
+    uint64_t fs = regs->sstatus & SSTATUS_FS;
+    if (kernel::riscv::current_core().fpu_trap_armed) {
+        fs = 0;
+    } else if (fs == 0) {
+        fs = SSTATUS_FS_CLEAN;
+    }
+    regs->sstatus = (regs->sstatus & ~SSTATUS_FS) | fs;
+}
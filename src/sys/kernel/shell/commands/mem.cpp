@@ -56,8 +56,11 @@ void mem_handler(int, const ktl::string_view[], ShellOutput& output) {
                  human_pages(free, sizeof(free), pmm.free_pages), human_pages(total, sizeof(total), pmm.total_pages),
                  human_pages(used, sizeof(used), used_pages),
                  human_pages(reserved, sizeof(reserved), pmm.reserved_pages));
-    output.print("pmm: {0} zeroed, {1} dirty, {2} allocations, {3} frees, {4} failures\n", pmm.zeroed_pooled, pmm.dirty,
-                 pmm.alloc_count, pmm.free_count, pmm.alloc_failures);
+    output.print("pmm: {0} zeroed, {1} dirty, {2} allocations, {3} frees, {4} failures, largest run {5} pages\n",
+                 pmm.zeroed_pooled, pmm.dirty, pmm.alloc_count, pmm.free_count, pmm.alloc_failures,
+                 pmm.largest_free_run);
+    output.print("pmm cache: {0} pages ({1} zeroed), {2} hits, {3} refills, {4} drains\n", pmm.cached,
+                 pmm.zeroed_cached, pmm.cache_hits, pmm.cache_refills, pmm.cache_drains);
 
     if (g_page_descriptors.initialized()) {
         output.print("pages: wired {0}, active {1}, free {2}, zeroed {3}, mmio {4}\n",
@@ -78,21 +81,26 @@ void mem_handler(int, const ktl::string_view[], ShellOutput& output) {
                      slab.alloc_calls, slab.free_calls, slab.failures, slab.large_allocs, slab.large_pages);
         for (const auto& cls : slab.classes) {
             if (cls.slabs == 0) { continue; }
-            output.print("  {0}B: {1} slabs, {2} live, {3} free slots\n", cls.object_size, cls.slabs, cls.live_objects,
-                         cls.free_slots);
+            output.print("  {0}B: {1} slabs, {2} live, {3} cached, {4} free slots; magazines {5} hits, {6} misses, "
+                         "{7} exchanges\n",
+                         cls.object_size, cls.slabs, cls.live_objects, cls.cached, cls.free_slots, cls.magazine_hits,
+                         cls.magazine_misses, cls.depot_exchanges);
         }
     }
 
     for (auto* arena = object_arena::first_arena(); arena != nullptr; arena = arena->next_arena()) {
         auto a = arena->stats();
-        output.print("arena {0}: {1}B slots, {2} slabs, {3}/{4} live, {5} allocs, {6} frees, {7} failures\n", a.name,
-                     a.slot_size, a.slabs, a.live, a.capacity, a.alloc_calls, a.free_calls, a.failures);
+        output.print("arena {0}: {1}B slots, {2} slabs, {3}/{4} live, {5} cached, {6} allocs, {7} frees, {8} failures; "
+                     "magazines {9} hits, {10} misses, {11} exchanges\n",
+                     a.name, a.slot_size, a.slabs, a.live, a.capacity, a.cached, a.alloc_calls, a.free_calls, a.failures,
+                     a.magazine_hits, a.magazine_misses, a.depot_exchanges);
     }
 
     vm_aspace& aspace = kernel_aspace();
     if (aspace.has_root()) {
-        output.print("kernel aspace: [0x{0:p}, 0x{1:p}), {2} faults\n", aspace.root().base(),
-                     aspace.root().base() + aspace.root().size(), aspace.fault_count());
+        output.print("kernel aspace: [0x{0:p}, 0x{1:p}), {2} faults, {3} avoided by fault-around\n",
+                     aspace.root().base(), aspace.root().base() + aspace.root().size(), aspace.fault_count(),
+                     aspace.faults_avoided());
     } else {
         output.print("kernel aspace: not initialized\n");
     }
@@ -20,8 +20,11 @@ void obj_handler(int argc, const ktl::string_view argv[], kernel::shell::ShellOu
         for (size_t i = 0; i < CONFIG_MAX_OBJECT_TYPES; ++i) {
             kernel::obj::g_type_registry.lookup(static_cast<kernel::obj::TypeId>(i))
                 .inspect([&](const kernel::obj::TypeDescriptor& d) {
-                    output.print("  [{0}] {1} (live: {2})\n", d.id, d.name,
+                    output.print("  [{0}] {1} (live: {2})", d.id, d.name,
                                  kernel::obj::g_type_registry.live_count(d.id));
+                    auto program = kernel::obj::g_type_registry.program(d.id);
+                    if (program) { output.print(" program: {0} insns, cost {1}", program->length(), program->cost()); }
+                    output.print("\n");
                 });
         }
     } else {
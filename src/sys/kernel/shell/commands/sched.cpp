@@ -11,6 +11,7 @@
 #include <kernel/sched/trace.h>
 #include <kernel/shell/output.h>
 #include <kernel/shell/render.h>
+#include <kernel/synchronization/lockdep.h>
 
 #include <ktl/fmt>
 #include <ktl/ref>
@@ -105,8 +106,10 @@ void cmd_stats(kernel::shell::ShellOutput& output) {
     }
     output.print("\nswitches: {0} (preempt {1}, yield {2}, block {3}, sleep {4}, exit {5})\n", s.switches, s.preempts,
                  s.yields, s.block_switches, s.sleep_switches, s.exit_switches);
-    output.print("wakes: {0}  spawned: {1}  reaped: {2}\n", s.wakes, s.spawned, s.reaped);
-    output.print("runq: {0}  sleepers: {1}  zombies: {2}\n", s.runq_depth, s.sleepers, s.zombies);
+    output.print("wakes: {0}  spawned: {1}  reaped: {2}  timer irqs: {3}\n", s.wakes, s.spawned, s.reaped,
+                 s.timer_irqs);
+    output.print("runq: {0}  sleepers: {1}  zombies: {2}  steals: {3}  handoffs: {4}\n", s.runq_depth, s.sleepers,
+                 s.zombies, s.steals, s.handoffs);
 
     ktl::vector<ktl::ref<Thread>> threads;
     snapshot_all_threads(threads);
@@ -116,7 +119,42 @@ void cmd_stats(kernel::shell::ShellOutput& output) {
         const char* running = name_of(threads, core.current_id);
         output.print("cpu{0} (hw {1}): running {2}", i, kernel::boot::cpu_hw_id(i), core.current_id);
         if (running != nullptr) { output.print("'{0}'", running); }
-        output.print("  idle {0}%  switches {1}\n", total > 0 ? core.idle_cycles * 100 / total : 0, core.switches);
+        output.print("  idle {0}%  switches {1}  runq {2}  steals {3}  handoffs {4}  irqs {5}\n",
+                     total > 0 ? core.idle_cycles * 100 / total : 0, core.switches, core.runq_depth, core.steals,
+                     core.handoffs, core.timer_irqs);
+    }
+}
+
+// Mutex contention by lock class, then every spinlock that has queued, from lockdep; empty in
+// NDEBUG builds, which keep neither.
+void cmd_locks(kernel::shell::ShellOutput& output) {
+    namespace lockdep = kernel::synchronization::lockdep;
+    static lockdep::class_stats classes[CONFIG_LOCKDEP_MAX_CLASSES];
+    static lockdep::lock_row locks[CONFIG_LOCKDEP_MAX_LOCKS];
+    size_t class_count = lockdep::snapshot_classes(classes, CONFIG_LOCKDEP_MAX_CLASSES);
+    size_t lock_count  = lockdep::snapshot_locks(locks, CONFIG_LOCKDEP_MAX_LOCKS);
+    uint64_t hz        = kernel::platform::timestamp_hz();
+    if (class_count == 0) {
+        output.print("no lock classes (lockdep compiled out)\n");
+        return;
+    }
+    output.print("mutexes:\n");
+    for (size_t i = 0; i < class_count; ++i) {
+        const auto& c = classes[i];
+        if (c.contended == 0) { continue; }
+        output.print("  {0}: contended {1}  spun {2}  parks {3}  spins {4}  waited ", c.name, c.contended, c.spun,
+                     c.parks, c.spins);
+        print_human(output, c.wait_cycles, hz);
+        output.print("\n");
+    }
+    output.print("spinlocks ({0} with stats):\n", lock_count);
+    for (size_t i = 0; i < lock_count; ++i) {
+        const auto& l = locks[i];
+        if (l.stats.contended == 0) { continue; }
+        output.print("  {0} at 0x{1:p}: acquires {2}  contended {3}  max wait ", l.name, (uintptr_t)l.address,
+                     l.stats.acquires, l.stats.contended);
+        print_human(output, l.stats.max_spin_cycles, hz);
+        output.print("\n");
     }
 }
 
@@ -147,7 +185,7 @@ void cmd_trace_dump(kernel::shell::ShellOutput& output, size_t n) {
 
 void sched_handler(int argc, const ktl::string_view argv[], kernel::shell::ShellOutput& output) {
     if (argc < 2) {
-        output.print("usage: sched threads|top|stats|trace dump [n]|trace clear|log on|off|verbose\n");
+        output.print("usage: sched threads|top|stats|locks|trace dump [n]|trace clear|log on|off|verbose\n");
         return;
     }
     if (argv[1] == "threads") {
@@ -156,6 +194,8 @@ void sched_handler(int argc, const ktl::string_view argv[], kernel::shell::Shell
         cmd_threads(output, /*top=*/true);
     } else if (argv[1] == "stats") {
         cmd_stats(output);
+    } else if (argv[1] == "locks") {
+        cmd_locks(output);
     } else if (argv[1] == "trace") {
         if (argc >= 3 && argv[2] == "clear") {
             trace_clear();
@@ -197,6 +237,6 @@ void sched_handler(int argc, const ktl::string_view argv[], kernel::shell::Shell
 
 }  // namespace
 
-KSHELL_COMMAND(sched, "sched", "Scheduler inspection: threads, stats, trace, lifecycle log", sched_handler);
+KSHELL_COMMAND(sched, "sched", "Scheduler inspection: threads, stats, locks, trace, lifecycle log", sched_handler);
 
 #endif  // CONFIG_KERNEL_SHELL
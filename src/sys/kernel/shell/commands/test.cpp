@@ -183,4 +183,12 @@ void kernel::testing::report_assertion(bool passed, bool fatal, const char* file
     handle_assertion_failure(reason.c_str(), fatal);
 }
 
+// Metric backend: same test_meta shape the host runner emits, so benchmark numbers from either tier
+// land in the result's diagnostics.
+void kernel::testing::report_metric(const char* key, uint64_t value) {
+    const char* name = g_current_test ? g_current_test->name : "?";
+    kernel::shell::shell_output().event("{{\"event\":\"test_meta\",\"name\":\"{0}\",\"{1}\":{2}}}", name, key,
+                                        value);
+}
+
 #endif  // CONFIG_KERNEL_SHELL && CONFIG_KERNEL_TESTING
@@ -13,17 +13,64 @@
 
 namespace kernel::syscalls {
 
+namespace {
+
+// The shared body of SYS_CHANNEL_CALL and SYS_CHANNEL_REPLY_WAIT: the outgoing message is staged
+// from the IPC buffer before blocking and the incoming one written over it after, so one buffer
+// region serves both directions. No handles either way (see <abi/syscall.h>).
+uint64_t channel_round_trip(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity,
+                            uint64_t timeout_ns, bool call) {
+    using namespace kernel::obj;
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    bool sends         = call || length != ::abi::syscall::CHANNEL_NO_REPLY;
+    const auto& buffer = self->ipc();
+    if (!buffer.valid() || !buffer.contains(offset, capacity)) { return errc_of(ktl::errc::out_of_range); }
+    if (sends && (length > Channel::MAX_MESSAGE_BYTES || !buffer.contains(offset, length))) {
+        return errc_of(ktl::errc::out_of_range);
+    }
+
+    auto task     = calling_task(self);
+    auto verified = task->handles().verify(unpack_handle(handle), RIGHT_READ | RIGHT_WRITE | RIGHT_WAIT,
+                                           type_ids::CHANNEL);
+    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
+    auto channel     = ktl::static_ref_cast<Channel>(verified.unwrap().object);
+    ktime_t deadline = deadline_after(timeout_ns);
+
+    auto exchange = [&]() -> ktl::result<MessageBuffer> {
+        if (!sends) { return channel->wait_and_read(capacity, 0, deadline); }
+        auto created = MessageBuffer::create(length);
+        if (created.is_err()) { return ktl::err(created.unwrap_err()); }
+        auto outgoing = created.unwrap();
+        if (length != 0) { buffer_read(buffer, offset, outgoing.data(), length); }
+        if (call) { return channel->call(ktl::move(outgoing), capacity, 0, deadline); }
+        return channel->reply_and_wait(ktl::move(outgoing), capacity, 0, deadline);
+    };
+    auto received = exchange();
+    if (received.is_err()) { return errc_of(received.unwrap_err()); }
+    auto message = received.unwrap();
+    if (message.size() != 0) { buffer_write(buffer, offset, message.data(), message.size()); }
+    return message.size();
+}
+
+}  // namespace
+
 // Channel syscalls take up to five arguments, more than the declarative handle-op table carries,
 // and need the calling thread's IPC buffer, which that pipeline is kept free of. They run the
 // same HandleTable::verify checks; only the dispatch is hand-rolled.
 
-uint64_t sys_channel_create(uint64_t offset) {
+uint64_t sys_channel_create(uint64_t offset, uint64_t depth, uint64_t byte_budget) {
     auto self = kernel::sched::current();
     if (!self) { return errc_of(ktl::errc::invalid_operation); }
     const auto& buffer = self->ipc();
     if (!buffer.valid() || !buffer.contains(offset, 2 * sizeof(uint64_t))) { return errc_of(ktl::errc::out_of_range); }
 
-    auto created = kernel::obj::Channel::create();
+    // Limits are checked at full width, before anything narrows.
+    using kernel::obj::Channel;
+    if (depth > Channel::MAX_QUEUE_DEPTH || byte_budget > Channel::MAX_BYTE_BUDGET) {
+        return errc_of(ktl::errc::out_of_range);
+    }
+    auto created = Channel::create(depth != 0 ? depth : Channel::QUEUE_DEPTH, byte_budget);
     if (created.is_err()) { return errc_of(created.unwrap_err()); }
     auto pair  = created.unwrap();
 
@@ -61,8 +108,8 @@ uint64_t sys_channel_send(uint64_t handle, uint64_t offset, uint64_t length, uin
     if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
     auto channel = ktl::static_ref_cast<Channel>(verified.unwrap().object);
 
-    // Once escrow begins, the handles belong to the message: any later failure closes them (see
-    // <abi/syscall.h>). So fail the ordinary flow-control cases -- full queue, dead peer -- before
+    // Once taken from this table, the handles belong to the message: any later failure closes them
+    // (see <abi/syscall.h>). So fail the ordinary flow-control cases -- full queue, dead peer -- before
     // consuming anything, by the same signals a waiting sender uses. A racing writer on this same
     // endpoint can still fill the queue between this check and the write; that residual race is
     // what the close-on-failure rule is for.
@@ -72,21 +119,23 @@ uint64_t sys_channel_send(uint64_t handle, uint64_t offset, uint64_t length, uin
         if ((signals & Channel::SIGNAL_WRITABLE) == 0) { return errc_of(ktl::errc::capacity_exhausted); }
     }
 
-    // The message page is contiguous, so staging is one memcpy per source page run.
+    // Message storage is contiguous, so staging is one memcpy per source page run.
     auto created = MessageBuffer::create(length);
     if (created.is_err()) { return errc_of(created.unwrap_err()); }
     auto message = created.unwrap();
     if (length != 0) { buffer_read(buffer, offset, message.data(), length); }
 
+    // The slot block comes first: an OOM here leaves every handle still in the sender's table, and
+    // with the block in place attaching a taken handle cannot fail.
     uint64_t handle_values[MessageBuffer::MAX_HANDLES];
-    if (handle_count != 0) { buffer_read(buffer, handles_offset, handle_values, handle_count * sizeof(uint64_t)); }
+    if (handle_count != 0) {
+        if (!message.reserve_handles()) { return errc_of(ktl::errc::oom); }
+        buffer_read(buffer, handles_offset, handle_values, handle_count * sizeof(uint64_t));
+    }
     for (uint64_t i = 0; i < handle_count; i++) {
         auto taken = task->handles().take(unpack_handle(handle_values[i]));
         if (taken.is_err()) { return errc_of(taken.unwrap_err()); }
-        auto moved    = taken.unwrap();
-        auto escrowed = kernel::sched::kernel_task()->handles().insert(ktl::move(moved.object), moved.rights);
-        if (escrowed.is_err()) { return errc_of(escrowed.unwrap_err()); }
-        message.attach_handle(escrowed.unwrap());
+        if (!message.attach_handle(taken.unwrap())) { return errc_of(ktl::errc::oom); }
     }
 
     auto sent = channel->write(ktl::move(message));
@@ -115,18 +164,15 @@ uint64_t sys_channel_recv(uint64_t handle, uint64_t offset, uint64_t capacity, u
     auto message = received.unwrap();
     if (message.size() != 0) { buffer_write(buffer, offset, message.data(), message.size()); }
 
-    // Move each handle out of escrow into the caller's table. An insert the receiver's table
-    // cannot make (OOM) closes that handle -- the message is already dequeued, so the returned
-    // count is how the caller learns what actually arrived.
-    HandleId escrowed[MessageBuffer::MAX_HANDLES];
-    size_t count = message.detach_handles(escrowed);
+    // Move each carried handle into the caller's table. An insert the receiver's table cannot
+    // make (OOM) closes that handle -- the message is already dequeued, so the returned count is
+    // how the caller learns what actually arrived.
+    VerifiedHandle carried[MessageBuffer::MAX_HANDLES];
+    size_t count = message.detach_handles(carried);
     uint64_t handle_values[MessageBuffer::MAX_HANDLES];
     uint64_t delivered = 0;
     for (size_t i = 0; i < count; i++) {
-        auto taken = kernel::sched::kernel_task()->handles().take(escrowed[i]);
-        if (taken.is_err()) { continue; }
-        auto moved    = taken.unwrap();
-        auto inserted = task->handles().insert(ktl::move(moved.object), moved.rights);
+        auto inserted = task->handles().insert(ktl::move(carried[i].object), carried[i].rights);
         if (inserted.is_err()) { continue; }
         handle_values[delivered++] = pack_handle(inserted.unwrap());
     }
@@ -134,4 +180,13 @@ uint64_t sys_channel_recv(uint64_t handle, uint64_t offset, uint64_t capacity, u
     return (delivered << 32) | message.size();
 }
 
+uint64_t sys_channel_call(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity, uint64_t timeout_ns) {
+    return channel_round_trip(handle, offset, length, capacity, timeout_ns, true);
+}
+
+uint64_t sys_channel_reply_wait(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity,
+                                uint64_t timeout_ns) {
+    return channel_round_trip(handle, offset, length, capacity, timeout_ns, false);
+}
+
 }  // namespace kernel::syscalls
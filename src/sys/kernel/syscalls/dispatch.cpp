@@ -30,16 +30,24 @@ extern "C" uint64_t syscall_dispatch(uint64_t nr, uint64_t a0, uint64_t a1, uint
             break;
         }
         case kernel::syscall::SYS_YIELD: kernel::sched::yield(); break;
-        case kernel::syscall::SYS_SLEEP: kernel::sched::sleep_ticks(a0); break;
+        case kernel::syscall::SYS_SLEEP: kernel::sched::sleep_ns(a0); break;
         case kernel::syscall::SYS_WRITE: ret = kernel::syscalls::sys_write(a0, a1); break;
         case kernel::syscall::SYS_HANDLE_CLOSE:
         case kernel::syscall::SYS_HANDLE_DUPLICATE:
         case kernel::syscall::SYS_OBJ_INFO:
         case kernel::syscall::SYS_TASK_KILL:
-        case kernel::syscall::SYS_TASK_STATUS: ret = kernel::syscalls::handle_syscall(nr, a0, a1); break;
-        case kernel::syscall::SYS_CHANNEL_CREATE: ret = kernel::syscalls::sys_channel_create(a0); break;
+        case kernel::syscall::SYS_TASK_STATUS:
+        case kernel::syscall::SYS_OBJ_INVOKE: ret = kernel::syscalls::handle_syscall(nr, a0, a1, a2); break;
+        case kernel::syscall::SYS_TYPE_ATTACH_PROGRAM:
+            ret = kernel::syscalls::sys_type_attach_program(a0, a1, a2, a3);
+            break;
+        case kernel::syscall::SYS_CHANNEL_CREATE: ret = kernel::syscalls::sys_channel_create(a0, a1, a2); break;
         case kernel::syscall::SYS_CHANNEL_SEND: ret = kernel::syscalls::sys_channel_send(a0, a1, a2, a3, a4); break;
         case kernel::syscall::SYS_CHANNEL_RECV: ret = kernel::syscalls::sys_channel_recv(a0, a1, a2, a3, a4); break;
+        case kernel::syscall::SYS_CHANNEL_CALL: ret = kernel::syscalls::sys_channel_call(a0, a1, a2, a3, a4); break;
+        case kernel::syscall::SYS_CHANNEL_REPLY_WAIT:
+            ret = kernel::syscalls::sys_channel_reply_wait(a0, a1, a2, a3, a4);
+            break;
         case kernel::syscall::SYS_OBJECT_WAIT: ret = kernel::syscalls::sys_object_wait(a0, a1, a2); break;
         case kernel::syscall::SYS_PORT_CREATE: ret = kernel::syscalls::sys_port_create(); break;
         case kernel::syscall::SYS_PORT_BIND: ret = kernel::syscalls::sys_port_bind(a0, a1, a2, a3); break;
@@ -49,9 +57,20 @@ extern "C" uint64_t syscall_dispatch(uint64_t nr, uint64_t a0, uint64_t a1, uint
         case kernel::syscall::SYS_VMO_CREATE: ret = kernel::syscalls::sys_vmo_create(a0); break;
         case kernel::syscall::SYS_VMO_MAP: ret = kernel::syscalls::sys_vmo_map(a0, a1, a2, a3, a4); break;
         case kernel::syscall::SYS_VMO_UNMAP: ret = kernel::syscalls::sys_vmo_unmap(a0); break;
-        case kernel::syscall::SYS_SOCKET_CREATE: ret = kernel::syscalls::sys_socket_create(a0); break;
+        case kernel::syscall::SYS_VMO_DETACH: ret = kernel::syscalls::sys_vmo_detach(a0, a1, a2); break;
+        case kernel::syscall::SYS_SOCKET_CREATE: ret = kernel::syscalls::sys_socket_create(a0, a1); break;
         case kernel::syscall::SYS_SOCKET_WRITE: ret = kernel::syscalls::sys_socket_write(a0, a1, a2); break;
         case kernel::syscall::SYS_SOCKET_READ: ret = kernel::syscalls::sys_socket_read(a0, a1, a2); break;
+        case kernel::syscall::SYS_SUBMIT: ret = kernel::syscalls::sys_submit(a0, a1, a2); break;
+        case kernel::syscall::SYS_PORT_WAIT_MANY: ret = kernel::syscalls::sys_port_wait_many(a0, a1, a2, a3); break;
+        case kernel::syscall::SYS_SOCKET_SET_WATERMARKS:
+            ret = kernel::syscalls::sys_socket_set_watermarks(a0, a1, a2);
+            break;
+        case kernel::syscall::SYS_SOCKET_WRITEV: ret = kernel::syscalls::sys_socket_writev(a0, a1, a2); break;
+        case kernel::syscall::SYS_SOCKET_READV: ret = kernel::syscalls::sys_socket_readv(a0, a1, a2); break;
+        case kernel::syscall::SYS_FUTEX_WAIT: ret = kernel::syscalls::sys_futex_wait(a0, a1, a2); break;
+        case kernel::syscall::SYS_FUTEX_WAKE: ret = kernel::syscalls::sys_futex_wake(a0, a1); break;
+        case kernel::syscall::SYS_FUTEX_REQUEUE: ret = kernel::syscalls::sys_futex_requeue(a0, a1, a2, a3, a4); break;
         // Unknown numbers fall through to the kill boundary like every other exit path -- an
         // early return here would let a killed thread slip back to user code.
         default: ret = static_cast<uint64_t>(-1); break;
@@ -0,0 +1,81 @@
+#include <kernel/mm/region.h>
+#include <kernel/mm/vm_aspace.h>
+#include <kernel/mm/vmo.h>
+#include <kernel/sched/futex.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/time.h>
+
+#include "internal.h"
+
+namespace kernel::syscalls {
+
+// Futexes (<abi/syscall.h>). The one place a syscall takes a user address, and it is only ever a
+// name: it resolves through the caller's region tree to the VMO and offset behind it, and the word
+// is read through the physmap by kernel/sched/futex.h. Nothing is dereferenced through the
+// caller's page tables, so an address that is unmapped or moves fails or misses cleanly.
+
+namespace {
+
+struct futex_word {
+    ktl::ref<kernel::mm::vmo> object;
+    uint64_t offset = 0;
+};
+
+// The binding must be a readable user mapping of cached memory: a device window's frames are not
+// ordinary RAM the physmap may read.
+ktl::result<futex_word> resolve(ktl::ref<kernel::sched::Thread>& self, uint64_t vaddr) {
+    if ((vaddr % sizeof(uint32_t)) != 0) { return ktl::err(ktl::errc::invalid_operation); }
+    auto task    = calling_task(self);
+    auto* aspace = task->aspace();
+    if (aspace == nullptr) { return ktl::err(ktl::errc::invalid_operation); }
+
+    constexpr kernel::mm::vm_prot_t NEEDED = kernel::mm::vm_prot::READ | kernel::mm::vm_prot::USER;
+    kernel::synchronization::critical_irq_lock_guard guard(aspace->lock());
+    auto* binding = aspace->root().find_binding(vaddr);
+    if (binding == nullptr || (binding->prot & NEEDED) != NEEDED ||
+        binding->cache != kernel::mm::vm_cache_mode::CACHED) {
+        return ktl::err(ktl::errc::out_of_range);
+    }
+    return ktl::result<futex_word>::ok(futex_word{binding->vmo_ref, binding->vmo_offset + (vaddr - binding->base)});
+}
+
+}  // namespace
+
+uint64_t sys_futex_wait(uint64_t vaddr, uint64_t expected, uint64_t timeout_ns) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    if ((expected >> 32) != 0) { return errc_of(ktl::errc::out_of_range); }
+    auto word = resolve(self, vaddr);
+    if (word.is_err()) { return errc_of(word.unwrap_err()); }
+
+    ktime_t deadline = timeout_ns == 0 ? kernel::sched::FUTEX_NO_DEADLINE : deadline_after(timeout_ns);
+    auto waited = kernel::sched::futex_wait(word.unwrap().object, word.unwrap().offset,
+                                            static_cast<uint32_t>(expected), deadline);
+    return waited.is_ok() ? 0 : errc_of(waited.unwrap_err());
+}
+
+uint64_t sys_futex_wake(uint64_t vaddr, uint64_t count) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    auto word = resolve(self, vaddr);
+    if (word.is_err()) { return errc_of(word.unwrap_err()); }
+    return kernel::sched::futex_wake(word.unwrap().object, word.unwrap().offset, count);
+}
+
+uint64_t sys_futex_requeue(uint64_t vaddr, uint64_t expected, uint64_t wake, uint64_t target_vaddr,
+                           uint64_t requeue) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    if ((expected >> 32) != 0) { return errc_of(ktl::errc::out_of_range); }
+    auto word = resolve(self, vaddr);
+    if (word.is_err()) { return errc_of(word.unwrap_err()); }
+    auto target = resolve(self, target_vaddr);
+    if (target.is_err()) { return errc_of(target.unwrap_err()); }
+
+    auto moved = kernel::sched::futex_requeue(word.unwrap().object, word.unwrap().offset,
+                                              static_cast<uint32_t>(expected), wake, target.unwrap().object,
+                                              target.unwrap().offset, requeue);
+    return moved.is_ok() ? moved.unwrap() : errc_of(moved.unwrap_err());
+}
+
+}  // namespace kernel::syscalls
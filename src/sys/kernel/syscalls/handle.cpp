@@ -22,15 +22,22 @@ ktl::ref<kernel::sched::Task> calling_task(ktl::ref<kernel::sched::Thread>& self
     return task;
 }
 
-uint64_t handle_syscall(uint64_t nr, uint64_t a0, uint64_t a1) {
+uint64_t handle_syscall(uint64_t nr, uint64_t a0, uint64_t a1, uint64_t a2) {
     auto self = kernel::sched::current();
     if (!self) { return static_cast<uint64_t>(ktl::errc::invalid_operation); }
     auto task = calling_task(self);
-    return kernel::obj::dispatch_handle_op(task->handles(), nr, a0, a1);
+    return kernel::obj::dispatch_handle_op(task->handles(), nr, a0, a1, a2);
 }
 
 uint64_t errc_of(ktl::errc error) { return static_cast<uint64_t>(error); }
 
+ktime_t deadline_after(uint64_t timeout_ns) {
+    if (timeout_ns == 0) { return 0; }
+    ktime_t now   = kernel::time::now();
+    ktime_t ticks = kernel::time::ns_to_ticks_ceil(timeout_ns);
+    return (now + ticks < now) ? UINT64_MAX : now + ticks;
+}
+
 // The installed error codes in <abi/syscall.h> are spelled as literals there; pin each to its
 // kernel-internal value so the two cannot drift.
 static_assert(static_cast<int64_t>(ktl::errc::truncated) == ::abi::syscall::ERR_TRUNCATED);
@@ -3,32 +3,55 @@
 #include <kernel/sched/ipc_buffer.h>
 #include <kernel/sched/task.h>
 #include <kernel/sched/thread.h>
+#include <kernel/time.h>
 
 namespace kernel::syscalls {
 
 ktl::ref<sched::Task> calling_task(ktl::ref<sched::Thread>& self);
 uint64_t errc_of(ktl::errc error);
+// The deadline a syscall's `timeout_ns` names: rounded up to ticks and saturating, so a huge value
+// waits forever rather than wrapping into the past. 0 stays 0, which callers treat as no timeout.
+ktime_t deadline_after(uint64_t timeout_ns);
 void buffer_write(const sched::ipc_buffer& buffer, uint64_t offset, const void* src, size_t length);
 void buffer_read(const sched::ipc_buffer& buffer, uint64_t offset, void* dst, size_t length);
 
 uint64_t sys_write(uint64_t offset, uint64_t length);
-uint64_t handle_syscall(uint64_t nr, uint64_t a0, uint64_t a1);
-uint64_t sys_channel_create(uint64_t offset);
+uint64_t handle_syscall(uint64_t nr, uint64_t a0, uint64_t a1, uint64_t a2);
+uint64_t sys_channel_create(uint64_t offset, uint64_t depth, uint64_t byte_budget);
 uint64_t sys_channel_send(uint64_t handle, uint64_t offset, uint64_t length, uint64_t handles_offset,
                           uint64_t handle_count);
 uint64_t sys_channel_recv(uint64_t handle, uint64_t offset, uint64_t capacity, uint64_t handles_offset,
                           uint64_t handle_capacity);
+uint64_t sys_channel_call(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity, uint64_t timeout_ns);
+uint64_t sys_channel_reply_wait(uint64_t handle, uint64_t offset, uint64_t length, uint64_t capacity,
+                                uint64_t timeout_ns);
 uint64_t sys_object_wait(uint64_t handle, uint64_t mask, uint64_t timeout_ns);
+uint64_t sys_type_attach_program(uint64_t handle, uint64_t offset, uint64_t count, uint64_t version);
 uint64_t sys_port_create();
 uint64_t sys_port_bind(uint64_t port_handle, uint64_t object_handle, uint64_t key, uint64_t mask);
 uint64_t sys_port_unbind(uint64_t port_handle, uint64_t key);
 uint64_t sys_port_wait(uint64_t port_handle, uint64_t offset, uint64_t timeout_ns);
+uint64_t sys_port_wait_many(uint64_t port_handle, uint64_t offset, uint64_t capacity, uint64_t timeout_ns);
+// SYS_PORT_WAIT's and SYS_PORT_WAIT_MANY's bodies; without may_block an empty port is would_block
+// instead of a wait.
+uint64_t port_dequeue(uint64_t port_handle, uint64_t offset, uint64_t timeout_ns, bool may_block);
+uint64_t port_dequeue_many(uint64_t port_handle, uint64_t offset, uint64_t capacity, uint64_t timeout_ns,
+                           bool may_block);
+uint64_t sys_submit(uint64_t offset, uint64_t count, uint64_t completions);
 uint64_t sys_task_spawn(uint64_t handle, uint64_t offset);
-uint64_t sys_socket_create(uint64_t offset);
+uint64_t sys_socket_create(uint64_t offset, uint64_t capacity);
 uint64_t sys_socket_write(uint64_t handle, uint64_t offset, uint64_t length);
 uint64_t sys_socket_read(uint64_t handle, uint64_t offset, uint64_t capacity);
+uint64_t sys_socket_writev(uint64_t handle, uint64_t offset, uint64_t count);
+uint64_t sys_socket_readv(uint64_t handle, uint64_t offset, uint64_t count);
+uint64_t sys_socket_set_watermarks(uint64_t handle, uint64_t read_high, uint64_t write_low);
 uint64_t sys_vmo_create(uint64_t size);
 uint64_t sys_vmo_map(uint64_t handle, uint64_t vaddr, uint64_t vmo_offset, uint64_t length, uint64_t prot);
 uint64_t sys_vmo_unmap(uint64_t vaddr);
+uint64_t sys_vmo_detach(uint64_t handle, uint64_t offset, uint64_t length);
+uint64_t sys_futex_wait(uint64_t vaddr, uint64_t expected, uint64_t timeout_ns);
+uint64_t sys_futex_wake(uint64_t vaddr, uint64_t count);
+uint64_t sys_futex_requeue(uint64_t vaddr, uint64_t expected, uint64_t wake, uint64_t target_vaddr,
+                           uint64_t requeue);
 
 }  // namespace kernel::syscalls
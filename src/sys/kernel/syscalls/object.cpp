@@ -5,10 +5,13 @@
 #include <kernel/obj/handle_dispatch.h>
 #include <kernel/obj/port.h>
 #include <kernel/obj/socket.h>
+#include <kernel/obj/type_registry.h>
 #include <kernel/sched/scheduler.h>
 #include <kernel/sched/user_task.h>
 #include <kernel/time.h>
 
+#include <ktl/vector>
+
 #include "internal.h"
 
 namespace kernel::syscalls {
@@ -30,14 +33,40 @@ uint64_t sys_object_wait(uint64_t handle, uint64_t mask, uint64_t timeout_ns) {
     if (mask == 0) { return object->signals(); }
     if (timeout_ns == 0) { return object->wait_signals(static_cast<uint32_t>(mask)); }
 
-    // The timeout rounds up to ticks and the deadline saturates: a huge value waits forever
-    // rather than wrapping to a deadline already in the past.
-    ktime_t now      = kernel::time::now();
-    ktime_t ticks    = kernel::time::ns_to_ticks_ceil(timeout_ns);
-    ktime_t deadline = (now + ticks < now) ? UINT64_MAX : now + ticks;
-    uint32_t got     = object->wait_signals_deadline(static_cast<uint32_t>(mask), deadline);
+    uint32_t got = object->wait_signals_deadline(static_cast<uint32_t>(mask), deadline_after(timeout_ns));
     if ((got & mask) == 0) { return errc_of(ktl::errc::timed_out); }
     return got;
 }
 
+// Attach a transaction program to the type of the object `handle` names; see <abi/syscall.h>.
+// The instructions are copied out of the IPC buffer before validation, so nothing the caller
+// does to the buffer afterwards can reach the attached program.
+uint64_t sys_type_attach_program(uint64_t handle, uint64_t offset, uint64_t count, uint64_t version) {
+    using namespace kernel::obj;
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    if (count == 0) { return errc_of(ktl::errc::invalid_operation); }
+    if (count > ::abi::otp::MAX_INSNS) { return errc_of(ktl::errc::capacity_exhausted); }
+    const auto& buffer = self->ipc();
+    if (!buffer.valid() || !buffer.contains(offset, count * sizeof(otp::insn))) {
+        return errc_of(ktl::errc::out_of_range);
+    }
+    if ((version >> 32) != 0) { return errc_of(ktl::errc::invalid_operation); }
+
+    auto task     = calling_task(self);
+    auto verified = task->handles().verify(unpack_handle(handle), RIGHT_PROGRAM);
+    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
+
+    ktl::vector<otp::insn> code;
+    if (!code.reserve(count)) { return errc_of(ktl::errc::oom); }
+    for (uint64_t i = 0; i < count; i++) {
+        otp::insn in{};
+        buffer_read(buffer, offset + i * sizeof(otp::insn), &in, sizeof(in));
+        code.push_back(in);
+    }
+    auto attached = g_type_registry.attach_program(verified.unwrap().object->type_id(), code.data(), code.size(),
+                                                   static_cast<uint32_t>(version));
+    return attached.is_ok() ? 0 : errc_of(attached.unwrap_err());
+}
+
 }  // namespace kernel::syscalls
@@ -52,30 +52,47 @@ uint64_t sys_port_unbind(uint64_t port_handle, uint64_t key) {
 }
 
 uint64_t sys_port_wait(uint64_t port_handle, uint64_t offset, uint64_t timeout_ns) {
+    return port_dequeue(port_handle, offset, timeout_ns, true);
+}
+
+uint64_t sys_port_wait_many(uint64_t port_handle, uint64_t offset, uint64_t capacity, uint64_t timeout_ns) {
+    return port_dequeue_many(port_handle, offset, capacity, timeout_ns, true);
+}
+
+// SYS_PORT_WAIT is the one-packet batch, returning 0 for its packet.
+uint64_t port_dequeue(uint64_t port_handle, uint64_t offset, uint64_t timeout_ns, bool may_block) {
+    uint64_t got = port_dequeue_many(port_handle, offset, 1, timeout_ns, may_block);
+    return got == 1 ? 0 : got;
+}
+
+uint64_t port_dequeue_many(uint64_t port_handle, uint64_t offset, uint64_t capacity, uint64_t timeout_ns,
+                           bool may_block) {
     using namespace kernel::obj;
-    auto self = kernel::sched::current();
+    constexpr size_t PACKET_BYTES = 2 * sizeof(uint64_t);
+    auto self                     = kernel::sched::current();
     if (!self) { return errc_of(ktl::errc::invalid_operation); }
     const auto& buffer = self->ipc();
-    if (!buffer.valid() || !buffer.contains(offset, 2 * sizeof(uint64_t))) { return errc_of(ktl::errc::out_of_range); }
+    if (capacity == 0 || capacity > ABI_PORT_WAIT_MAX_PACKETS) { return errc_of(ktl::errc::out_of_range); }
+    if (!buffer.valid() || !buffer.contains(offset, capacity * PACKET_BYTES)) {
+        return errc_of(ktl::errc::out_of_range);
+    }
 
     auto task    = calling_task(self);
     auto claimed = task->handles().get<Port>(unpack_handle(port_handle), RIGHT_READ | RIGHT_WAIT);
     if (claimed.is_err()) { return errc_of(claimed.unwrap_err()); }
-    auto port        = claimed.unwrap();
+    auto port    = claimed.unwrap();
 
-    ktime_t deadline = 0;
-    if (timeout_ns != 0) {
-        ktime_t now   = kernel::time::now();
-        ktime_t ticks = kernel::time::ns_to_ticks_ceil(timeout_ns);
-        deadline      = (now + ticks < now) ? UINT64_MAX : now + ticks;
-    }
+    ktime_t deadline = deadline_after(timeout_ns);
 
     // Dequeue-then-wait loop: READABLE can flicker high on a drained queue (see Port::dequeue),
     // so an empty dequeue after a wake just waits again with the same deadline. A killed thread
     // must leave the loop -- its waits return immediately without the signal, and the dispatcher's
-    // boundary check exits it as soon as this returns.
-    Port::Packet packet;
-    while (!port->dequeue(packet)) {
+    // boundary check exits it as soon as this returns. Whatever is pending when one arrives is
+    // taken in the same pass, so a burst of packets costs one lock round and one return.
+    Port::Packet packets[ABI_PORT_WAIT_MAX_PACKETS];
+    size_t count = 0;
+    while ((count = port->dequeue(packets, capacity)) == 0) {
+        if (!may_block) { return errc_of(ktl::errc::would_block); }
         if (self->killed()) { return errc_of(ktl::errc::timed_out); }
         if (timeout_ns == 0) {
             (void)port->wait_signals(Port::SIGNAL_READABLE);
@@ -84,9 +101,11 @@ uint64_t sys_port_wait(uint64_t port_handle, uint64_t offset, uint64_t timeout_n
         uint32_t got = port->wait_signals_deadline(Port::SIGNAL_READABLE, deadline);
         if ((got & Port::SIGNAL_READABLE) == 0) { return errc_of(ktl::errc::timed_out); }
     }
-    uint64_t out[2] = {packet.key, packet.signals};
-    buffer_write(buffer, offset, out, sizeof(out));
-    return 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t out[2] = {packets[i].key, packets[i].signals};
+        buffer_write(buffer, offset + i * PACKET_BYTES, out, sizeof(out));
+    }
+    return count;
 }
 
 }  // namespace kernel::syscalls
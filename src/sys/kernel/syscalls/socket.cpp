@@ -16,20 +16,107 @@ namespace kernel::syscalls {
 // Socket syscalls use hand-rolled dispatch, the same verify pipeline as handle operations, and
 // the IPC buffer as the only memory crossing the boundary. Bytes move ring-to-buffer in page
 // runs, so a partial result mid-walk is returned as the count, never rewound.
-uint64_t sys_socket_create(uint64_t offset) {
+namespace {
+
+using kernel::obj::Socket;
+
+// Page runs handed to the socket per lock hold. A range spans at most IPC_BUFFER_MAX_PAGES + 1
+// runs, so a plain write or read is one hold; a long vector takes a few.
+constexpr size_t RUN_BATCH = 32;
+
+struct io_range {
+    uint64_t offset;
+    uint64_t length;
+};
+
+// Move `count` IPC-buffer ranges through the socket's vectored write or read, in order, gathering
+// their page runs RUN_BATCH at a time. A batch moved short is backpressure (or a drained buffer)
+// and ends the walk, reported as the count; so is an error with bytes already moved, since those
+// bytes are delivered. Ranges are already checked against the buffer.
+uint64_t stream_ranges(const kernel::sched::ipc_buffer& buffer, Socket& socket, bool write, const io_range* ranges,
+                       size_t count) {
+    Socket::run runs[RUN_BATCH];
+    size_t pending   = 0;
+    uint64_t batched = 0;
+    uint64_t done    = 0;
+    uint64_t failure = 0;
+    // Hand the gathered runs over; false once the walk should end.
+    auto flush = [&] {
+        auto moved = write ? socket.write(runs, pending) : socket.read(runs, pending);
+        if (moved.is_err()) {
+            failure = errc_of(moved.unwrap_err());
+            return false;
+        }
+        done      += moved.unwrap();
+        bool whole = moved.unwrap() == batched;
+        pending    = 0;
+        batched    = 0;
+        return whole;
+    };
+
+    bool going = true;
+    for (size_t i = 0; going && i < count; i++) {
+        for (uint64_t at = 0; going && at < ranges[i].length;) {
+            size_t run      = 0;
+            auto* data      = reinterpret_cast<uint8_t*>(buffer.kernel_at(ranges[i].offset + at, run));
+            size_t take     = run < ranges[i].length - at ? run : ranges[i].length - at;
+            runs[pending++] = {data, take};
+            batched        += take;
+            at             += take;
+            if (pending == RUN_BATCH) { going = flush(); }
+        }
+    }
+    if (going && pending != 0) { (void)flush(); }
+    return done == 0 && failure != 0 ? failure : done;
+}
+
+// Verify `handle` as a socket with the direction's right and stream `count` ranges through it.
+uint64_t socket_io(uint64_t handle, bool write, const io_range* ranges, size_t count) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    const auto& buffer = self->ipc();
+    if (!buffer.valid()) { return errc_of(ktl::errc::out_of_range); }
+    for (size_t i = 0; i < count; i++) {
+        if (!buffer.contains(ranges[i].offset, ranges[i].length)) { return errc_of(ktl::errc::out_of_range); }
+    }
+
+    using namespace kernel::obj;
+    auto task     = calling_task(self);
+    auto verified = task->handles().verify(unpack_handle(handle), write ? RIGHT_WRITE : RIGHT_READ, type_ids::SOCKET);
+    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
+    auto socket = ktl::static_ref_cast<Socket>(verified.unwrap().object);
+    return stream_ranges(buffer, *socket, write, ranges, count);
+}
+
+// The vectored forms' range list, copied out of the IPC buffer and bounded first.
+uint64_t socket_iov(uint64_t handle, bool write, uint64_t offset, uint64_t count) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    const auto& buffer = self->ipc();
+    if (count > ABI_SOCKET_MAX_IOVECS || !buffer.valid() || !buffer.contains(offset, count * sizeof(io_range))) {
+        return errc_of(ktl::errc::out_of_range);
+    }
+    io_range ranges[ABI_SOCKET_MAX_IOVECS];
+    buffer_read(buffer, offset, ranges, count * sizeof(io_range));
+    return socket_io(handle, write, ranges, count);
+}
+
+}  // namespace
+
+uint64_t sys_socket_create(uint64_t offset, uint64_t capacity) {
     auto self = kernel::sched::current();
     if (!self) { return errc_of(ktl::errc::invalid_operation); }
     const auto& buffer = self->ipc();
     if (!buffer.valid() || !buffer.contains(offset, 2 * sizeof(uint64_t))) { return errc_of(ktl::errc::out_of_range); }
 
-    auto created = kernel::obj::Socket::create();
+    auto created = Socket::create(capacity != 0 ? capacity : Socket::BUFFER_BYTES);
     if (created.is_err()) { return errc_of(created.unwrap_err()); }
     auto pair  = created.unwrap();
 
     auto task  = calling_task(self);
-    auto first = task->handles().insert(pair.first, kernel::obj::Socket::DEFAULT_RIGHTS);
+    auto first = task->handles().insert(pair.first, Socket::DEFAULT_RIGHTS);
     if (first.is_err()) { return errc_of(first.unwrap_err()); }
-    auto second = task->handles().insert(pair.second, kernel::obj::Socket::DEFAULT_RIGHTS);
+    auto second = task->handles().insert(pair.second, Socket::DEFAULT_RIGHTS);
     if (second.is_err()) {
         (void)task->handles().close(first.unwrap());
         return errc_of(second.unwrap_err());
@@ -41,55 +128,32 @@ uint64_t sys_socket_create(uint64_t offset) {
 }
 
 uint64_t sys_socket_write(uint64_t handle, uint64_t offset, uint64_t length) {
-    using namespace kernel::obj;
-    auto self = kernel::sched::current();
-    if (!self) { return errc_of(ktl::errc::invalid_operation); }
-    const auto& buffer = self->ipc();
-    if (!buffer.valid() || !buffer.contains(offset, length)) { return errc_of(ktl::errc::out_of_range); }
-
-    auto task     = calling_task(self);
-    auto verified = task->handles().verify(unpack_handle(handle), RIGHT_WRITE, type_ids::SOCKET);
-    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
-    auto socket   = ktl::static_ref_cast<Socket>(verified.unwrap().object);
-
-    // Page run by page run; a short acceptance mid-walk is backpressure, reported as the count.
-    // An error with bytes already accepted is likewise the count -- those bytes are delivered.
-    uint64_t done = 0;
-    while (done < length) {
-        size_t run       = 0;
-        const void* from = reinterpret_cast<const void*>(buffer.kernel_at(offset + done, run));
-        size_t attempt   = run < length - done ? run : length - done;
-        auto wrote       = socket->write(from, attempt);
-        if (wrote.is_err()) { return done != 0 ? done : errc_of(wrote.unwrap_err()); }
-        done += wrote.unwrap();
-        if (wrote.unwrap() < attempt) { break; }
-    }
-    return done;
+    const io_range range{offset, length};
+    return socket_io(handle, true, &range, 1);
 }
 
 uint64_t sys_socket_read(uint64_t handle, uint64_t offset, uint64_t capacity) {
+    const io_range range{offset, capacity};
+    return socket_io(handle, false, &range, 1);
+}
+
+uint64_t sys_socket_writev(uint64_t handle, uint64_t offset, uint64_t count) {
+    return socket_iov(handle, true, offset, count);
+}
+
+uint64_t sys_socket_readv(uint64_t handle, uint64_t offset, uint64_t count) {
+    return socket_iov(handle, false, offset, count);
+}
+
+uint64_t sys_socket_set_watermarks(uint64_t handle, uint64_t read_high, uint64_t write_low) {
     using namespace kernel::obj;
     auto self = kernel::sched::current();
     if (!self) { return errc_of(ktl::errc::invalid_operation); }
-    const auto& buffer = self->ipc();
-    if (!buffer.valid() || !buffer.contains(offset, capacity)) { return errc_of(ktl::errc::out_of_range); }
-
-    auto task     = calling_task(self);
-    auto verified = task->handles().verify(unpack_handle(handle), RIGHT_READ, type_ids::SOCKET);
-    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
-    auto socket   = ktl::static_ref_cast<Socket>(verified.unwrap().object);
-
-    uint64_t done = 0;
-    while (done < capacity) {
-        size_t run   = 0;
-        void* to     = reinterpret_cast<void*>(buffer.kernel_at(offset + done, run));
-        size_t space = run < capacity - done ? run : capacity - done;
-        auto got     = socket->read(to, space);
-        if (got.is_err()) { return done != 0 ? done : errc_of(got.unwrap_err()); }
-        done += got.unwrap();
-        if (got.unwrap() < space) { break; }
-    }
-    return done;
+    auto task   = calling_task(self);
+    auto socket = task->handles().get<Socket>(unpack_handle(handle), RIGHT_WAIT);
+    if (socket.is_err()) { return errc_of(socket.unwrap_err()); }
+    auto set = socket.unwrap()->set_watermarks(read_high, write_low);
+    return set.is_ok() ? 0 : errc_of(set.unwrap_err());
 }
 
 }  // namespace kernel::syscalls
@@ -0,0 +1,58 @@
+#include <abi/submit.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/syscall.h>
+
+#include "internal.h"
+
+namespace kernel::syscalls {
+
+namespace {
+
+// One entry, run as the syscall it names would run, minus the trap. Only operations that never
+// block are here (see <abi/submit.h>); the port dequeues are the non-blocking forms of their syscalls.
+uint64_t run_entry(const abi_submit_entry& entry) {
+    const uint64_t* a = entry.args;
+    switch (entry.op) {
+        case kernel::syscall::SYS_CHANNEL_SEND: return sys_channel_send(a[0], a[1], a[2], a[3], a[4]);
+        case kernel::syscall::SYS_CHANNEL_RECV: return sys_channel_recv(a[0], a[1], a[2], a[3], a[4]);
+        case kernel::syscall::SYS_SOCKET_WRITE: return sys_socket_write(a[0], a[1], a[2]);
+        case kernel::syscall::SYS_SOCKET_READ: return sys_socket_read(a[0], a[1], a[2]);
+        case kernel::syscall::SYS_SOCKET_WRITEV: return sys_socket_writev(a[0], a[1], a[2]);
+        case kernel::syscall::SYS_SOCKET_READV: return sys_socket_readv(a[0], a[1], a[2]);
+        case kernel::syscall::SYS_HANDLE_CLOSE: return handle_syscall(entry.op, a[0], a[1], a[2]);
+        case kernel::syscall::SYS_FUTEX_WAKE: return sys_futex_wake(a[0], a[1]);
+        case kernel::syscall::SYS_PORT_WAIT: return port_dequeue(a[0], a[1], a[2], false);
+        case kernel::syscall::SYS_PORT_WAIT_MANY: return port_dequeue_many(a[0], a[1], a[2], a[3], false);
+        default: return errc_of(ktl::errc::invalid_operation);
+    }
+}
+
+}  // namespace
+
+// The batch is the IPC buffer's to describe, so each entry is copied out before it runs and its
+// completion copied back after: an entry whose own operation writes over the entry array (a recv
+// landing on it) changes what later entries say, never the one already running.
+uint64_t sys_submit(uint64_t offset, uint64_t count, uint64_t completions) {
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    const auto& buffer = self->ipc();
+    if (count > ABI_SUBMIT_MAX_ENTRIES) { return errc_of(ktl::errc::out_of_range); }
+    if (!buffer.valid() || !buffer.contains(offset, count * sizeof(abi_submit_entry)) ||
+        !buffer.contains(completions, count * sizeof(abi_submit_completion))) {
+        return errc_of(ktl::errc::out_of_range);
+    }
+
+    uint64_t run = 0;
+    for (; run < count; run++) {
+        // The kill boundary is the dispatcher's, once the whole batch returns; stopping here just
+        // keeps a killed thread from running the rest of it first.
+        if (self->killed()) { break; }
+        abi_submit_entry entry;
+        buffer_read(buffer, offset + run * sizeof(entry), &entry, sizeof(entry));
+        abi_submit_completion done = {entry.user_data, run_entry(entry)};
+        buffer_write(buffer, completions + run * sizeof(done), &done, sizeof(done));
+    }
+    return run;
+}
+
+}  // namespace kernel::syscalls
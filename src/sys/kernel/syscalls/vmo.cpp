@@ -82,4 +82,33 @@ uint64_t sys_vmo_unmap(uint64_t vaddr) {
     return removed.is_ok() ? 0 : errc_of(removed.unwrap_err());
 }
 
+uint64_t sys_vmo_detach(uint64_t handle, uint64_t offset, uint64_t length) {
+    using namespace kernel::obj;
+    auto self = kernel::sched::current();
+    if (!self) { return errc_of(ktl::errc::invalid_operation); }
+    if (length == 0 || (offset % KERNEL_MINIMUM_PAGE_SIZE) != 0 || (length % KERNEL_MINIMUM_PAGE_SIZE) != 0) {
+        return errc_of(ktl::errc::invalid_operation);
+    }
+
+    auto task    = calling_task(self);
+    auto* aspace = task->aspace();
+    if (aspace == nullptr) { return errc_of(ktl::errc::invalid_operation); }
+    auto verified = task->handles().verify(unpack_handle(handle), RIGHT_READ | RIGHT_WRITE, type_ids::VMO);
+    if (verified.is_err()) { return errc_of(verified.unwrap_err()); }
+    auto object = ktl::static_ref_cast<kernel::mm::vmo>(verified.unwrap().object);
+
+    // The move cannot be undone -- the frames leave the source and their translations are zapped --
+    // so the handle slot is taken first, and publishing into it afterwards cannot fail.
+    Rights rights = RIGHT_READ | RIGHT_WRITE;
+    auto reserved = task->handles().reserve(type_ids::VMO, rights);
+    if (reserved.is_err()) { return errc_of(reserved.unwrap_err()); }
+    auto moved = object->detach_pages(*aspace, offset / KERNEL_MINIMUM_PAGE_SIZE, length / KERNEL_MINIMUM_PAGE_SIZE);
+    if (moved.is_err()) {
+        task->handles().cancel(reserved.unwrap());
+        return errc_of(moved.unwrap_err());
+    }
+    task->handles().commit(reserved.unwrap(), moved.unwrap(), rights);
+    return pack_handle(reserved.unwrap());
+}
+
 }  // namespace kernel::syscalls
@@ -0,0 +1,245 @@
+// src/sys/kernel/task/futex.cpp
+#include <kernel/sched/futex.h>
+#include <kernel/sched/internal.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/sched/thread.h>
+#include <kernel/sched/wait_queue.h>
+#include <kernel/synchronization/spinlock.h>
+
+#include <ktl/atomic>
+
+extern uintptr_t g_hhdm_offset;
+
+namespace kernel::sched {
+
+namespace {
+
+static_assert((FUTEX_BUCKETS & (FUTEX_BUCKETS - 1)) == 0, "FUTEX_BUCKETS must be a power of two");
+
+using bucket_guard = kernel::synchronization::critical_irq_lock_guard<kernel::synchronization::spinlock>;
+
+// Nonzero, so block_if refuses to park a thread already killed; nothing ever calls wake_matching on
+// a bucket's queue, so the bit itself means nothing.
+constexpr uint32_t FUTEX_WAIT_MASK = 1;
+
+struct futex_bucket;
+
+// One waiter, in futex_wait's frame. It parks on its home bucket's queue for the whole wait, but
+// sits on the list of whichever bucket its key hashes to -- the same one until a requeue moves it.
+// The frame cannot unwind while a waker is using it: a waker holds the listing bucket's lock from
+// finding the waiter through its claim, and the waiter takes that lock to leave.
+struct futex_waiter {
+    ktl::ref<kernel::mm::vmo> object;  // the key's VMO, pinned so its address cannot name another
+    uint64_t offset  = 0;
+    wait_queue* home = nullptr;
+    wait_node node;
+    ktime_t deadline = FUTEX_NO_DEADLINE;
+    // Both change only under the listing bucket's lock; read by the parking predicate under the
+    // home queue's lock, and by the waiter's exit to find which lock to take.
+    ktl::atomic<futex_bucket*> bucket{nullptr};
+    ktl::atomic<bool> woken{false};
+    bool listed        = false;
+    futex_waiter* next = nullptr;
+    futex_waiter* prev = nullptr;
+};
+
+struct futex_bucket {
+    kernel::synchronization::spinlock lock{"futex_bucket"};
+    wait_queue queue;
+    futex_waiter* head = nullptr;  // oldest first
+    futex_waiter* tail = nullptr;
+
+    void append(futex_waiter* waiter) {
+        waiter->prev = tail;
+        waiter->next = nullptr;
+        if (tail != nullptr) {
+            tail->next = waiter;
+        } else {
+            head = waiter;
+        }
+        tail           = waiter;
+        waiter->listed = true;
+        waiter->bucket.store(this, ktl::memory_order::release);
+    }
+
+    void remove(futex_waiter* waiter) {
+        if (waiter->prev != nullptr) {
+            waiter->prev->next = waiter->next;
+        } else {
+            head = waiter->next;
+        }
+        if (waiter->next != nullptr) {
+            waiter->next->prev = waiter->prev;
+        } else {
+            tail = waiter->prev;
+        }
+        waiter->next   = nullptr;
+        waiter->prev   = nullptr;
+        waiter->listed = false;
+    }
+};
+
+futex_bucket g_buckets[FUTEX_BUCKETS];
+
+futex_bucket& bucket_of(const kernel::mm::vmo* object, uint64_t offset) {
+    uint64_t hash = (reinterpret_cast<uintptr_t>(object) >> 4) ^ (offset >> 2);
+    hash *= 0x9E3779B97F4A7C15ull;
+    return g_buckets[(hash >> 32) & (FUTEX_BUCKETS - 1)];
+}
+
+// The physmap address of the word at `offset`, filling its page if absent. The frame is resolved
+// before any bucket lock is taken, since a fill may allocate.
+ktl::result<const uint32_t*> word_of(kernel::mm::vmo& object, uint64_t offset) {
+    if ((offset % sizeof(uint32_t)) != 0) { return ktl::err(ktl::errc::invalid_operation); }
+    if (offset >= object.size_pages() * KERNEL_MINIMUM_PAGE_SIZE) { return ktl::err(ktl::errc::out_of_range); }
+    auto frame = object.get_or_fill_page(offset / KERNEL_MINIMUM_PAGE_SIZE);
+    if (frame.is_err()) { return ktl::err(frame.unwrap_err()); }
+    uintptr_t word = frame.unwrap() + g_hhdm_offset + offset % KERNEL_MINIMUM_PAGE_SIZE;
+    return ktl::result<const uint32_t*>::ok(reinterpret_cast<const uint32_t*>(word));
+}
+
+bool still_holds(const uint32_t* word, uint32_t expected) {
+    return __atomic_load_n(word, __ATOMIC_SEQ_CST) == expected;
+}
+
+bool keyed(const futex_waiter* waiter, const kernel::mm::vmo* object, uint64_t offset) {
+    return waiter->object.get() == object && waiter->offset == offset;
+}
+
+// Unlist `waiter` as woken and wake its thread. The caller holds `bucket`'s lock, which keeps the
+// waiter's frame alive through the claim. The claim comes up empty when the waiter has not parked
+// yet -- its predicate then sees `woken` and stays off the queue -- or when a timeout or kill got
+// there first; either way the wake is consumed, and futex_wait reports it. make_ready under the
+// bucket lock is in order: no path takes a bucket lock inside the scheduler's.
+void wake_waiter(futex_bucket& bucket, futex_waiter* waiter) {
+    bucket.remove(waiter);
+    waiter->woken.store(true, ktl::memory_order::release);
+    ktl::ref<Thread> thread = waiter->home->claim(&waiter->node);
+    if (thread) { make_ready(ktl::move(thread)); }
+}
+
+// Take `waiter` off whichever list holds it and report whether a waker got to it. A requeue can
+// move it between reading the bucket and locking it, so the read is checked again under the lock.
+bool leave(futex_waiter& waiter) {
+    while (true) {
+        futex_bucket* bucket = waiter.bucket.load(ktl::memory_order::acquire);
+        bucket_guard guard(bucket->lock);
+        if (waiter.bucket.load(ktl::memory_order::relaxed) != bucket) { continue; }
+        if (waiter.listed) { bucket->remove(&waiter); }
+        return waiter.woken.load(ktl::memory_order::relaxed);
+    }
+}
+
+// Requeue's body, with both buckets' locks held (one lock when they are the same bucket). The
+// retagged waiters keep parking on their home queues, so only the lists change.
+ktl::result<size_t> requeue_locked(futex_bucket& from, const uint32_t* word, uint32_t expected,
+                                   const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, size_t wake,
+                                   futex_bucket& to, const ktl::ref<kernel::mm::vmo>& target, uint64_t target_offset,
+                                   size_t requeue) {
+    if (!still_holds(word, expected)) { return ktl::err(ktl::errc::would_block); }
+    size_t woken = 0;
+    size_t moved = 0;
+    for (futex_waiter* waiter = from.head; waiter != nullptr && (woken < wake || moved < requeue);) {
+        futex_waiter* next = waiter->next;
+        if (!keyed(waiter, object.get(), offset)) {
+            waiter = next;
+            continue;
+        }
+        if (woken < wake) {
+            wake_waiter(from, waiter);
+            woken++;
+        } else {
+            // The caller's refs keep both VMOs alive, so swapping the pin never frees one here.
+            waiter->object = target;
+            waiter->offset = target_offset;
+            if (&from != &to) {
+                from.remove(waiter);
+                to.append(waiter);
+            }
+            moved++;
+        }
+        waiter = next;
+    }
+    return ktl::result<size_t>::ok(woken + moved);
+}
+
+}  // namespace
+
+ktl::result<void> futex_wait(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, uint32_t expected,
+                             ktime_t deadline) {
+    auto word = word_of(*object, offset);
+    if (word.is_err()) { return ktl::err(word.unwrap_err()); }
+    futex_bucket& bucket = bucket_of(object.get(), offset);
+
+    futex_waiter waiter;
+    waiter.object   = object;
+    waiter.offset   = offset;
+    waiter.home     = &bucket.queue;
+    waiter.deadline = deadline;
+    {
+        // A waker stores the new value before taking this lock, so either the load sees it or the
+        // waker finds this waiter listed.
+        bucket_guard guard(bucket.lock);
+        if (!still_holds(word.unwrap(), expected)) { return ktl::err(ktl::errc::would_block); }
+        bucket.append(&waiter);
+    }
+
+    // Parks once: every way off the queue -- a wake, the timeout, a kill -- ends the wait, and the
+    // predicate keeps a waiter woken (or timed out) before it parked from parking at all.
+    auto should_block = [](void* p) {
+        auto* w = static_cast<futex_waiter*>(p);
+        if (w->woken.load(ktl::memory_order::acquire)) { return false; }
+        return w->deadline == FUTEX_NO_DEADLINE || kernel::time::now() < w->deadline;
+    };
+    if (deadline == FUTEX_NO_DEADLINE) {
+        bucket.queue.block_if(waiter.node, FUTEX_WAIT_MASK, should_block, &waiter);
+    } else {
+        timed_wait wait;
+        timed_wait_register(wait, &bucket.queue, &waiter.node, deadline);
+        bucket.queue.block_if(waiter.node, FUTEX_WAIT_MASK, should_block, &waiter);
+        timed_wait_unregister(wait);
+    }
+
+    if (leave(waiter)) { return ktl::result<void>::ok(); }
+    if (deadline != FUTEX_NO_DEADLINE && kernel::time::now() >= deadline) { return ktl::err(ktl::errc::timed_out); }
+    return ktl::result<void>::ok();
+}
+
+size_t futex_wake(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, size_t count) {
+    futex_bucket& bucket = bucket_of(object.get(), offset);
+    size_t woken         = 0;
+    bucket_guard guard(bucket.lock);
+    for (futex_waiter* waiter = bucket.head; waiter != nullptr && woken < count;) {
+        futex_waiter* next = waiter->next;
+        if (keyed(waiter, object.get(), offset)) {
+            wake_waiter(bucket, waiter);
+            woken++;
+        }
+        waiter = next;
+    }
+    return woken;
+}
+
+ktl::result<size_t> futex_requeue(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset, uint32_t expected,
+                                  size_t wake, const ktl::ref<kernel::mm::vmo>& target, uint64_t target_offset,
+                                  size_t requeue) {
+    auto word = word_of(*object, offset);
+    if (word.is_err()) { return ktl::err(word.unwrap_err()); }
+    if ((target_offset % sizeof(uint32_t)) != 0) { return ktl::err(ktl::errc::invalid_operation); }
+    if (target_offset >= target->size_pages() * KERNEL_MINIMUM_PAGE_SIZE) { return ktl::err(ktl::errc::out_of_range); }
+
+    futex_bucket& from = bucket_of(object.get(), offset);
+    futex_bucket& to   = bucket_of(target.get(), target_offset);
+    if (&from == &to) {
+        bucket_guard guard(from.lock);
+        return requeue_locked(from, word.unwrap(), expected, object, offset, wake, to, target, target_offset, requeue);
+    }
+    // Two buckets lock in table order, so concurrent requeues in opposite directions cannot deadlock.
+    futex_bucket& first  = &from < &to ? from : to;
+    futex_bucket& second = &from < &to ? to : from;
+    bucket_guard outer(first.lock);
+    kernel::synchronization::lock_guard inner(second.lock);
+    return requeue_locked(from, word.unwrap(), expected, object, offset, wake, to, target, target_offset, requeue);
+}
+
+}  // namespace kernel::sched
@@ -1,7 +1,9 @@
 // src/sys/kernel/task/reaper.cpp
 #include <kernel/arch.h>
 #include <kernel/assert.h>
+#include <kernel/config.h>
 #include <kernel/log.h>
+#include <kernel/mm/pmm.h>
 #include <kernel/sched/internal.h>
 #include <kernel/sched/reaper.h>
 #include <kernel/sched/scheduler.h>
@@ -17,9 +19,11 @@ namespace kernel::sched {
 
 namespace {
 
-// Dead threads awaiting the reaper, and recycled stacks. Stacks come from alloc_contiguous, which
-// has no contiguous free -- the pool recycles them among threads instead; it is bounded by the peak
-// live thread count. All under g_sched_lock.
+// Dead threads awaiting the reaper, and recycled stacks. A few stacks are kept to spare new spawns
+// the contiguous allocation; past that they go back to the PMM, where the run coalesces again.
+// All under g_sched_lock.
+constexpr size_t STACK_CACHE_MAX = 16;
+constexpr size_t STACK_PAGES     = CONFIG_KERNEL_STACK_SIZE / KERNEL_MINIMUM_PAGE_SIZE;
 ktl::deque<ktl::ref<Thread>> g_zombies;
 ktl::deque<kernel::mm::vm_paddr_t> g_stack_cache;
 wait_queue g_reaper_wq;
@@ -91,12 +95,12 @@ ktl::maybe<kernel::mm::vm_paddr_t> stack_pool_acquire() {
 }
 
 void stack_pool_release(kernel::mm::vm_paddr_t phys) {
-    bool ok;
+    bool cached;
     {
         sched_guard guard(g_sched_lock);
-        ok = g_stack_cache.push_back(phys);
+        cached = g_stack_cache.size() < STACK_CACHE_MAX && g_stack_cache.push_back(phys);
     }
-    if (!ok) { g_log.warn("sched: stack cache full; leaking a thread stack"); }
+    if (!cached) { kernel::mm::g_page_frame_allocator.free_contiguous(phys, STACK_PAGES); }
 }
 
 }  // namespace kernel::sched
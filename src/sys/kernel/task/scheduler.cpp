@@ -6,17 +6,19 @@
 #include <kernel/log.h>
 #include <kernel/mm/vm_aspace.h>
 #include <kernel/panic.h>
+#include <kernel/platform.h>
 #include <kernel/sched/internal.h>
 #include <kernel/sched/reaper.h>
 #include <kernel/sched/scheduler.h>
 #include <kernel/sched/task.h>
 #include <kernel/synchronization/execution_context.h>
+#include <kernel/synchronization/rcu.h>
 
 #include <ktl/atomic>
 
 namespace kernel::sched {
 
-kernel::synchronization::spinlock g_sched_lock;
+kernel::synchronization::spinlock g_sched_lock{"sched"};
 cpu_sched g_cpus[CONFIG_MAX_CORES];
 
 cpu_sched& cur_cpu() { return g_cpus[kernel::arch::current_core_index()]; }
@@ -29,43 +31,115 @@ namespace {
 
 ktl::atomic<bool> g_started{false};
 
-// One FIFO under g_sched_lock; any core picks from it.
-// ponytail: one shared queue, per-core queues if the lock shows up in profiles.
-ktl::deque<ktl::ref<Thread>> g_run_queue;
-
-// Pop the first thread whose previous core has finished switching it out; one still on-cpu rotates
-// to the back so no core ever waits on another inside the lock.
-ktl::maybe<ktl::ref<Thread>> pop_locked(ktl::deque<ktl::ref<Thread>>& queue) {
+// Pop, for core `self`, the first thread whose previous core has finished switching it out; one still
+// on-cpu rotates to the back so no core ever waits on another inside the lock. A thread pinned to
+// another core rotates the same way, so stealing passes it over. c.lock held.
+ktl::maybe<ktl::ref<Thread>> pop_locked(cpu_sched& c, size_t self) {
+    auto& queue = c.run_queue;
     for (size_t n = queue.size(); n > 0; --n) {
-        auto thread = queue.pop_front();
-        if (!(*thread)->on_cpu()) { return thread; }
+        auto thread  = queue.pop_front();
+        uint32_t pin = (*thread)->pinned_core();
+        if (!(*thread)->on_cpu() && (pin == thread_stats::NO_CORE || pin == self)) {
+            c.queued.store(queue.size(), ktl::memory_order::relaxed);
+            return thread;
+        }
         bool ok = queue.push_back(ktl::move(*thread));
         ensure(ok, "pick: run queue push failed despite reservation");
     }
     return ktl::maybe<ktl::ref<Thread>>();
 }
 
-ktl::maybe<ktl::ref<Thread>> pick_next_locked() { return pop_locked(g_run_queue); }
+// Idle-time balancing: a core with nothing of its own takes one thread from the sibling with the
+// deepest queue. Depths are read unlocked, so the victim choice is a heuristic; the pop itself
+// holds only the victim's lock.
+ktl::maybe<ktl::ref<Thread>> steal(size_t self) {
+    size_t victim = CONFIG_MAX_CORES;
+    size_t depth  = 0;
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        size_t queued = g_cpus[i].queued.load(ktl::memory_order::relaxed);
+        if (i != self && queued > depth) {
+            victim = i;
+            depth  = queued;
+        }
+    }
+    if (victim == CONFIG_MAX_CORES) { return ktl::maybe<ktl::ref<Thread>>(); }
+    ktl::maybe<ktl::ref<Thread>> stolen;
+    {
+        cpu_guard guard(g_cpus[victim].lock);
+        stolen = pop_locked(g_cpus[victim], self);
+    }
+    if (stolen.has_value()) {
+        cpu_guard guard(g_cpus[self].lock);
+        g_cpus[self].steals += 1;
+    }
+    return stolen;
+}
+
+// Local queue first. Only a core about to go idle -- its current thread is blocking, or is the idle
+// thread -- steals; a busy thread yielding or being preempted keeps to its own queue, so a loaded
+// core does not pull work away from siblings that are already running it warm.
+ktl::maybe<ktl::ref<Thread>> pick_next(bool may_steal) {
+    size_t self = kernel::arch::current_core_index();
+    {
+        cpu_guard guard(g_cpus[self].lock);
+        auto local = pop_locked(g_cpus[self], self);
+        if (local.has_value()) { return local; }
+    }
+    if (!may_steal) { return ktl::maybe<ktl::ref<Thread>>(); }
+    return steal(self);
+}
+
+// A thread held by direct handoff runs next, ahead of the queue: it is why the current thread is
+// switching away at all. Interrupts off.
+ktl::maybe<ktl::ref<Thread>> pick_next_or_handoff(bool may_steal) {
+    auto& c = cur_cpu();
+    if (c.current && c.current->holds_handoff()) {
+        {
+            cpu_guard guard(c.lock);
+            c.handoffs += 1;
+        }
+        return ktl::maybe<ktl::ref<Thread>>(c.current->take_handoff());
+    }
+    return pick_next(may_steal);
+}
 
-bool has_runnable_locked() { return g_run_queue.size() != 0; }
+bool has_local_runnable() { return cur_cpu().queued.load(ktl::memory_order::relaxed) != 0; }
 
 // A core parked in wait_for_interrupt() would otherwise notice new work only at its next tick. An
-// idle pusher (the tick waking a sleeper) picks the thread up itself at interrupt exit, so it
-// kicks nobody.
-void kick_idle_core_locked() {
+// idle target is kicked directly. Work queued on a busy core waits out that core's slice unless an
+// idle sibling steals it first, so one idle sibling is kicked instead. An idle pusher (the tick
+// waking a sleeper) picks its own queue up at interrupt exit, so it kicks nobody for that.
+void kick_for(size_t target) {
     size_t self = kernel::arch::current_core_index();
-    if (g_cpus[self].current.get() == g_cpus[self].idle.get()) { return; }
+    if (target == self) {
+        if (g_cpus[self].idling.load(ktl::memory_order::relaxed)) { return; }
+    } else if (g_cpus[target].idling.load(ktl::memory_order::relaxed)) {
+        kernel::arch::send_reschedule_ipi(target);
+        return;
+    }
     for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
         auto& c = g_cpus[i];
-        if (i == self || !c.current || c.current.get() != c.idle.get()) { continue; }
+        if (i == self || i == target || !c.online.load(ktl::memory_order::relaxed)) { continue; }
+        if (!c.idling.load(ktl::memory_order::relaxed)) { continue; }
         kernel::arch::send_reschedule_ipi(i);
         return;
     }
 }
 
+// Cache-affine placement: a pinned thread's own core, else back onto the core that last ran the
+// thread while that core is online, else the caller's own.
+size_t home_core(const Thread& thread) {
+    if (thread.pinned_core() < CONFIG_MAX_CORES) { return thread.pinned_core(); }
+    uint32_t last = thread.stats().last_core;
+    if (last < CONFIG_MAX_CORES && g_cpus[last].online.load(ktl::memory_order::relaxed)) { return last; }
+    return kernel::arch::current_core_index();
+}
+
 // Interrupts must be disabled and no lock held. Returns when this thread is next switched in.
 void switch_to(ktl::ref<Thread> next, switch_reason reason) {
     assert(!kernel::synchronization::preemption_disabled(), "switch_to: preemption disabled");
+    // Preemption is enabled, so the outgoing thread is outside any read-side section.
+    kernel::synchronization::rcu_note_quiescent();
     auto& c          = cur_cpu();
     Thread* outgoing = c.current.get();
     auto& execution  = kernel::synchronization::current_execution_context();
@@ -75,7 +149,9 @@ void switch_to(ktl::ref<Thread> next, switch_reason reason) {
     for (size_t i = 0; i < execution.held_count; ++i) { outgoing->held_locks()[i] = execution.held[i]; }
 #endif
     {
-        sched_guard guard(g_sched_lock);
+        // The incoming thread is exclusively ours (just popped, or the idle thread); the outgoing
+        // thread's accounting and the core's fields are shared only with stats_snapshot.
+        cpu_guard guard(c.lock);
         uint64_t now = kernel::arch::timestamp();
         c.current->stats().cpu_cycles += now - c.last_switch_ts;
         c.last_switch_ts = now;
@@ -93,18 +169,17 @@ void switch_to(ktl::ref<Thread> next, switch_reason reason) {
             next->set_ready_ts(0);
         }
 
-        g_stats.switches += 1;
         c.switches += 1;
         switch (reason) {
-            case switch_reason::PREEMPT: g_stats.preempts += 1; break;
-            case switch_reason::YIELD: g_stats.yields += 1; break;
-            case switch_reason::BLOCK: g_stats.block_switches += 1; break;
-            case switch_reason::SLEEP: g_stats.sleep_switches += 1; break;
-            case switch_reason::EXIT: g_stats.exit_switches += 1; break;
+            case switch_reason::PREEMPT: c.preempts += 1; break;
+            case switch_reason::YIELD: c.yields += 1; break;
+            case switch_reason::BLOCK: c.block_switches += 1; break;
+            case switch_reason::SLEEP: c.sleep_switches += 1; break;
+            case switch_reason::EXIT: c.exit_switches += 1; break;
             case switch_reason::NONE:
             default: break;
         }
-        trace_push(trace_kind::SWITCH, reason, c.current->id(), next->id());
+        trace_push_locked(c, trace_kind::SWITCH, reason, c.current->id(), next->id());
 
         // Callers park or re-queue the outgoing thread before switching; only the idle handoff
         // paths leave it RUNNING (idle is never re-queued), so demote it here to keep reported
@@ -113,6 +188,7 @@ void switch_to(ktl::ref<Thread> next, switch_reason reason) {
         next->set_state(thread_state::RUNNING);
         next->reset_slice();
         next->set_on_cpu(true);
+        c.idling.store(next.get() == c.idle.get(), ktl::memory_order::relaxed);
         assert(c.previous.get() == nullptr, "switch_to: unfinished previous switch");
         c.previous = ktl::move(c.current);
         c.current  = ktl::move(next);
@@ -133,13 +209,22 @@ void switch_to(ktl::ref<Thread> next, switch_reason reason) {
         next_task != nullptr && next_task->aspace() != nullptr ? next_task->aspace() : &kernel::mm::kernel_aspace();
     if (kernel::mm::vm_aspace::active() != want) { want->activate(); }
     if (c.current->kstack_top() != 0) { kernel::arch::set_kernel_stack(c.current->kstack_top()); }
-    // User FP/SIMD state changes hands only here, and only user threads (task with an address
-    // space) have any: kernel code never touches those registers, so whatever user mode left in
-    // them survives every kernel entry -- and every kernel-thread stretch -- until the next user
-    // thread is restored.
+    // Tickless idle may have stopped this core's timer; the incoming thread needs its slice tick.
+    if (outgoing == c.idle.get()) { rearm_timer(); }
+    // User FP/SIMD state is saved here, when the outgoing thread may have changed what it loaded,
+    // and loaded lazily on first use (fpu_first_use). Only user threads (task with an address
+    // space) have any: kernel code never touches those registers, so a user thread that comes
+    // back to the core that last loaded its state, with only kernel threads in between, finds it
+    // still there and runs with the trap disarmed.
     auto* prev_task = static_cast<Task*>(outgoing->owner().get());
-    if (prev_task != nullptr && prev_task->aspace() != nullptr) { kernel::arch::fpu_save(outgoing->fpu_area()); }
-    if (next_task != nullptr && next_task->aspace() != nullptr) { kernel::arch::fpu_restore(c.current->fpu_area()); }
+    if (prev_task != nullptr && prev_task->aspace() != nullptr && outgoing->fpu_area() != nullptr &&
+        kernel::arch::fpu_take_dirty()) {
+        kernel::arch::fpu_save(outgoing->fpu_area());
+    }
+    if (next_task != nullptr && next_task->aspace() != nullptr) {
+        uint32_t core = (uint32_t)kernel::arch::current_core_index();
+        kernel::arch::fpu_set_trap(c.fpu_owner != c.current.get() || c.current->fpu_core() != core);
+    }
     arch_context_switch(outgoing->saved_sp_slot(), c.current->saved_sp());
     sched_finish_switch();
 }
@@ -175,6 +260,9 @@ void adopt_idle() {
     c.current = c.idle;
     kernel::synchronization::set_current_thread_id(c.current->id());
     c.last_switch_ts = kernel::arch::timestamp();
+    c.idling.store(true, ktl::memory_order::relaxed);
+    c.online.store(true, ktl::memory_order::release);
+    kernel::synchronization::rcu_core_online(kernel::arch::current_core_index());
     kernel::arch::restore_interrupts(flags);
 }
 
@@ -198,8 +286,8 @@ bool current_is_idle() {
 }
 
 namespace {
-// Live threads known to scheduling; the high-water mark of this count is what the run queue and
-// sleeper list stay reserved for, so tick-context pushes never grow them.
+// Live threads known to scheduling; the high-water mark of this count is what every core's run
+// queue and the zombie list stay reserved for, so tick-context pushes never grow them.
 ktl::atomic<size_t> g_live_threads{0};
 }  // namespace
 
@@ -211,8 +299,11 @@ ktl::result<void> ensure_tick_capacity() {
     // spawn and a reap race the counter. The reservations only need to be >= the worst case.
     size_t target = live + 2;
 
-    bool ok       = grow_under_sched_lock(g_run_queue, target);
-    if (ok) { ok = sleepers_reserve(target); }
+    bool ok = true;
+    for (size_t i = 0; ok && i < CONFIG_MAX_CORES; i++) {
+        // Idle threads exist exactly for the cores init() brought up; no other queue is ever used.
+        if (g_cpus[i].idle) { ok = grow_under_lock(g_cpus[i].lock, g_cpus[i].run_queue, target); }
+    }
     if (ok) { ok = zombies_reserve(target); }
     if (!ok) {
         g_live_threads.fetch_sub(1, ktl::memory_order::relaxed);
@@ -223,13 +314,41 @@ ktl::result<void> ensure_tick_capacity() {
 
 void note_thread_reaped() { g_live_threads.fetch_sub(1, ktl::memory_order::relaxed); }
 
-bool push_runnable_locked(ktl::ref<Thread> thread) {
-    if (!g_run_queue.push_back(ktl::move(thread))) { return false; }
-    kick_idle_core_locked();
+bool push_runnable(ktl::ref<Thread> thread) {
+    size_t target = home_core(*thread);
+    auto& c       = g_cpus[target];
+    {
+        cpu_guard guard(c.lock);
+        if (!c.run_queue.push_back(ktl::move(thread))) { return false; }
+        c.queued.store(c.run_queue.size(), ktl::memory_order::relaxed);
+    }
+    kick_for(target);
     return true;
 }
 
-size_t run_queue_depth_locked() { return g_run_queue.size(); }
+size_t run_queue_depth() {
+    size_t depth = 0;
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) { depth += g_cpus[i].queued.load(ktl::memory_order::relaxed); }
+    return depth;
+}
+
+namespace {
+
+// Direct handoff capture (see handoff_arm): hold `thread` for the current thread rather than queue
+// it. Never from an interrupt handler -- that wake is not the current thread's doing -- and never a
+// thread that may not run here or that another core is still switching out; those queue as usual.
+bool hold_for_handoff(cpu_sched& c, ktl::ref<Thread>& thread) {
+    if (!c.current || c.current.get() == c.idle.get()) { return false; }
+    if (!c.current->handoff_armed() || c.current->holds_handoff()) { return false; }
+    if (kernel::synchronization::current_execution_context().interrupt_depth != 0) { return false; }
+    uint32_t pin = thread->pinned_core();
+    if (pin != thread_stats::NO_CORE && pin != kernel::arch::current_core_index()) { return false; }
+    if (thread->on_cpu()) { return false; }
+    c.current->hold_handoff(ktl::move(thread));
+    return true;
+}
+
+}  // namespace
 
 void make_ready_locked(ktl::ref<Thread> thread) {
     assert(thread->state() == thread_state::BLOCKED, "make_ready: thread is not blocked");
@@ -239,7 +358,8 @@ void make_ready_locked(ktl::ref<Thread> thread) {
     g_stats.wakes += 1;
     auto& c = cur_cpu();
     trace_push(trace_kind::WAKE, switch_reason::NONE, c.current ? c.current->id() : 0, thread->id());
-    bool ok = push_runnable_locked(ktl::move(thread));
+    if (hold_for_handoff(c, thread)) { return; }
+    bool ok = push_runnable(ktl::move(thread));
     ensure(ok, "make_ready: run queue push failed despite reservation");
 }
 
@@ -248,15 +368,27 @@ void make_ready(ktl::ref<Thread> thread) {
     make_ready_locked(ktl::move(thread));
 }
 
+void handoff_arm() {
+    uint64_t flags = kernel::arch::save_and_disable_interrupts();
+    cur_cpu().current->set_handoff_armed(true);
+    kernel::arch::restore_interrupts(flags);
+}
+
+void handoff_disarm() {
+    uint64_t flags = kernel::arch::save_and_disable_interrupts();
+    auto held      = cur_cpu().current->take_handoff();
+    if (held) {
+        bool ok = push_runnable(ktl::move(held));
+        ensure(ok, "handoff_disarm: run queue push failed despite reservation");
+    }
+    kernel::arch::restore_interrupts(flags);
+}
+
 void schedule_out(switch_reason reason) {
     kernel::synchronization::assert_blocking_allowed("schedule_out: scheduling is forbidden in this context");
     kernel::synchronization::assert_no_locks_held("schedule_out: scheduling while holding a lock");
-    ktl::ref<Thread> next;
-    {
-        sched_guard guard(g_sched_lock);
-        auto picked = pick_next_locked();
-        next        = picked.has_value() ? ktl::move(*picked) : cur_cpu().idle;
-    }
+    auto picked           = pick_next_or_handoff(true);
+    ktl::ref<Thread> next = picked.has_value() ? ktl::move(*picked) : cur_cpu().idle;
     switch_to(ktl::move(next), reason);
 }
 
@@ -265,22 +397,20 @@ void yield() {
     kernel::synchronization::assert_no_locks_held("yield: scheduling while holding a lock");
     uint64_t flags = kernel::arch::save_and_disable_interrupts();
     ktl::ref<Thread> next;
-    {
-        sched_guard guard(g_sched_lock);
-        auto& c = cur_cpu();
-        if (c.current.get() != c.idle.get()) { c.current->stats().yields += 1; }
-        // Nothing else runnable: keep going. Bouncing through idle would requeue this thread, kick
-        // another core for it, and switch twice to land back here.
-        auto picked = pick_next_locked();
-        if (picked.has_value()) {
-            if (c.current.get() != c.idle.get()) {
-                c.current->set_state(thread_state::READY);
-                c.current->set_ready_ts(kernel::arch::timestamp());
-                bool ok = push_runnable_locked(c.current);
-                ensure(ok, "yield: run queue push failed despite reservation");
-            }
-            next = ktl::move(*picked);
+    auto& c        = cur_cpu();
+    bool idle      = c.current.get() == c.idle.get();
+    if (!idle) { c.current->stats().yields += 1; }
+    // Nothing else runnable: keep going. Bouncing through idle would requeue this thread, kick
+    // another core for it, and switch twice to land back here.
+    auto picked = pick_next_or_handoff(idle);
+    if (picked.has_value()) {
+        if (!idle) {
+            c.current->set_state(thread_state::READY);
+            c.current->set_ready_ts(kernel::arch::timestamp());
+            bool ok = push_runnable(c.current);
+            ensure(ok, "yield: run queue push failed despite reservation");
         }
+        next = ktl::move(*picked);
     }
     if (next) { switch_to(ktl::move(next), switch_reason::YIELD); }
     kernel::arch::restore_interrupts(flags);
@@ -288,10 +418,24 @@ void yield() {
 
 void on_tick() {
     if (!g_started.load(ktl::memory_order::acquire)) { return; }
+    kernel::synchronization::rcu_tick();
     sched_guard guard(g_sched_lock);
     auto& c = cur_cpu();
+    // With a one-shot timer an interrupt may be for a timer deadline rather than a slice tick;
+    // only the latter charges the running thread's slice. Periodic interrupts are all ticks.
+    bool slice_tick = true;
+    if (kernel::time::high_resolution()) {
+        time_ns_t now = kernel::time::ns_since_boot();
+        slice_tick    = now >= c.next_tick_ns;
+        if (slice_tick) { c.next_tick_ns = now + kernel::time::ktime_to_ns(1); }
+    }
+    {
+        cpu_guard cguard(c.lock);
+        c.timer_irqs += 1;
+    }
     // Wake due sleepers and expired timed waits first so a woken thread can be this tick's
-    // switch target. Every core's tick runs the scans; the lists are shared.
+    // switch target. Every core's tick advances the shared wheels; after the first, the rest
+    // find nothing left to process for this tick.
     wake_due_sleepers();
     wake_due_timed_waits();
     bool idle_running = (c.current.get() == c.idle.get());
@@ -302,11 +446,57 @@ void on_tick() {
         kernel::synchronization::request_preemption();
         return;
     }
-    if (!has_runnable_locked()) { return; }
-    if (!idle_running && c.current->decrement_slice() > 0) { return; }
+    if (!has_local_runnable()) { return; }
+    if (!idle_running && (!slice_tick || c.current->decrement_slice() > 0)) { return; }
     kernel::synchronization::request_preemption();
 }
 
+void rearm_timer() {
+    if (!g_started.load(ktl::memory_order::acquire) || !kernel::time::high_resolution()) { return; }
+    uint64_t flags = kernel::arch::save_and_disable_interrupts();
+    auto& c        = cur_cpu();
+    if (c.online.load(ktl::memory_order::relaxed)) {
+        time_ns_t tick = kernel::time::NEVER;
+        if (c.current.get() != c.idle.get() || has_local_runnable()) {
+            // Coming out of tickless idle the old tick is long past; the slice clock restarts now.
+            time_ns_t now = kernel::time::ns_since_boot();
+            if (c.next_tick_ns <= now) { c.next_tick_ns = now + kernel::time::ktime_to_ns(1); }
+            tick = c.next_tick_ns;
+        }
+        time_ns_t want = tick;
+        if (on_boot_core()) {
+            // A timer armed on another core publishes its deadline and then reads armed_ns to
+            // decide whether to kick us; re-reading after the store means one of the two sides
+            // always sees the other, so an earlier deadline is never left unprogrammed.
+            do {
+                time_ns_t due = next_timer_ns();
+                want          = due < tick ? due : tick;
+                if (!kernel::platform::timer_set_deadline(want)) { break; }
+                c.armed_ns.store(want);
+            } while (next_timer_ns() < want);
+        } else if (kernel::platform::timer_set_deadline(want)) {
+            c.armed_ns.store(want);
+        }
+    }
+    kernel::arch::restore_interrupts(flags);
+}
+
+bool fpu_first_use() {
+    ktl::ref<Thread> self = current();
+    // Before the interrupts-off section: the arena takes its own lock and may go to the page
+    // allocator for a fresh slab.
+    if (self->fpu_area() == nullptr && !self->alloc_fpu_area()) { return false; }
+    uint64_t flags = kernel::arch::save_and_disable_interrupts();
+    auto& c        = cur_cpu();
+    // Disarm first: on x86_64 the restore is itself an FP instruction, and would trap.
+    kernel::arch::fpu_set_trap(false);
+    kernel::arch::fpu_restore(self->fpu_area());
+    c.fpu_owner = self.get();
+    self->set_fpu_core((uint32_t)kernel::arch::current_core_index());
+    kernel::arch::restore_interrupts(flags);
+    return true;
+}
+
 void service_pending_preemption() {
     if (!g_started.load(ktl::memory_order::acquire)) { return; }
     // switch_to must run with interrupts masked (see yield/schedule_out). This hook is reached from
@@ -315,33 +505,36 @@ void service_pending_preemption() {
     // masked interrupt_exit/fault_exit callers.
     uint64_t flags = kernel::arch::save_and_disable_interrupts();
     ktl::ref<Thread> next;
-    bool exit_now = false;
-    {
-        sched_guard guard(g_sched_lock);
-        auto& c  = cur_cpu();
-        // A killed thread that never syscalls would otherwise run user code forever between ticks.
-        // Only when no syscall is in flight: mid-syscall the thread may hold kernel locks it must
-        // release on its way out, and the dispatcher's own boundary check exits it lock-free. With
-        // syscall depth zero and this hook eligible to run, the interrupted context is user code,
-        // which holds nothing.
-        exit_now = c.current->killed() && c.current.get() != c.idle.get() &&
-                   kernel::synchronization::current_execution_context().syscall_depth == 0;
-        if (!exit_now) {
-            auto picked = pick_next_locked();
-            if (picked.has_value()) {
-                if (c.current.get() != c.idle.get()) {
-                    c.current->stats().preemptions += 1;
-                    c.current->set_state(thread_state::READY);
-                    c.current->set_ready_ts(kernel::arch::timestamp());
-                    bool ok = push_runnable_locked(c.current);
-                    ensure(ok, "service_pending_preemption: run queue push failed despite reservation");
-                }
-                next = ktl::move(*picked);
+    auto& c   = cur_cpu();
+    bool idle = c.current.get() == c.idle.get();
+    // A killed thread that never syscalls would otherwise run user code forever between ticks.
+    // Only when no syscall is in flight: mid-syscall the thread may hold kernel locks it must
+    // release on its way out, and the dispatcher's own boundary check exits it lock-free. With
+    // syscall depth zero and this hook eligible to run, the interrupted context is user code,
+    // which holds nothing.
+    bool exit_now =
+        !idle && c.current->killed() && kernel::synchronization::current_execution_context().syscall_depth == 0;
+    if (!exit_now) {
+        auto picked = pick_next_or_handoff(idle);
+        if (picked.has_value()) {
+            if (!idle) {
+                c.current->stats().preemptions += 1;
+                c.current->set_state(thread_state::READY);
+                c.current->set_ready_ts(kernel::arch::timestamp());
+                bool ok = push_runnable(c.current);
+                ensure(ok, "service_pending_preemption: run queue push failed despite reservation");
             }
+            next = ktl::move(*picked);
         }
     }
     if (exit_now) { exit_current(); }
-    if (next) { switch_to(ktl::move(next), switch_reason::PREEMPT); }
+    if (next) {
+        switch_to(ktl::move(next), switch_reason::PREEMPT);
+    } else {
+        // Nothing to switch to: the request may have been a kick to reprogram this core's timer
+        // for a deadline armed elsewhere.
+        rearm_timer();
+    }
     kernel::arch::restore_interrupts(flags);
 }
 
@@ -379,6 +572,7 @@ void init(uint32_t boot_core_index) {
     g_stats.boot_ts = kernel::arch::timestamp();
     g_started.store(true, ktl::memory_order::release);
     reaper_start();
+    kernel::synchronization::rcu_start();
     g_log.info("sched: online (core {0})", boot_core_index);
 }
 
@@ -392,9 +586,13 @@ void join_secondary(uint32_t core_index) {
     // Tick preemption (on_tick) switches threads in and out automatically, but idle itself is
     // never preempted into -- it has to cooperatively yield to hand the CPU to a newly-ready
     // thread. yield() is a fast no-op when the run queue is empty, so this still spends most of
-    // its time halted in-between.
+    // its time halted in-between. Before halting, rearm_timer stops the tick (dynticks): new work
+    // arrives with a reschedule IPI, and the boot core keeps only the next timer deadline. Each
+    // pass is an RCU quiescent state; a grace period waiting on a halted core sends it an IPI.
     while (true) {
         yield();
+        rearm_timer();
+        kernel::synchronization::rcu_note_quiescent();
         kernel::arch::wait_for_interrupt();
     }
 }
@@ -1,130 +1,174 @@
 // src/sys/kernel/task/sleep.cpp
 #include <kernel/arch.h>
 #include <kernel/assert.h>
+#include <kernel/boot.h>
 #include <kernel/log.h>
 #include <kernel/sched/internal.h>
 #include <kernel/sched/scheduler.h>
+#include <kernel/sched/timer_wheel.h>
 #include <kernel/sched/wait_queue.h>
 #include <kernel/synchronization/execution_context.h>
 #include <kernel/time.h>
 
-#include <ktl/vector>
-
 namespace kernel::sched {
 
 namespace {
 
-struct sleeper {
-    ktime_t wake_at = 0;
+// A sleeping thread's timer, living in sleep_ticks' frame for exactly as long as the thread is
+// parked -- the same self-sufficiency rule wait_node follows, so sleeping never allocates. The ref
+// pins the thread; whoever disarms the timer (expiry or task kill) moves it out to wake it.
+struct sleeper : timer_entry {
     ktl::ref<Thread> thread;
 };
-ktl::vector<sleeper> g_sleepers;
-
-// Waiters parked on some object's wait queue with a deadline. Unlike sleepers, an entry does not
-// own the thread -- the wait node on the waiter's stack does. The entry only records where to look:
-// on expiry the scan asks the queue to claim() the node, which resolves the race against signal
-// wakers under that queue's own lock. Entries leave the list on successful claim or when the
-// waiter unregisters after waking; an entry whose claim fails stays until the waiter removes it,
-// so the node pointer is valid for exactly as long as the entry exists.
-struct timed_wait {
-    ktime_t wake_at   = 0;
-    wait_queue* queue = nullptr;
-    wait_node* node   = nullptr;
-};
-ktl::vector<timed_wait> g_timed_waits;
+timer_wheel g_sleepers;
+
+// Timed waits get their own wheel: their entries do not own the thread (the wait node does), and
+// expiry has to go through the queue's claim() rather than a direct wake.
+timer_wheel g_timed_waits;
+
+// Both wheels count microseconds on the ns_since_boot() timeline rather than kernel ticks, so a
+// one-shot timer can wake a sleeper at its deadline instead of on the tick after it. A 64-slot
+// level-0 still spans 64us, and six levels reach ~19 hours before the clamp.
+constexpr uint64_t TIMER_UNIT_NS = 1000;
+
+uint64_t wheel_now() {
+    time_ns_t ns = kernel::time::ns_since_boot();
+    return ns > 0 ? static_cast<uint64_t>(ns) / TIMER_UNIT_NS : 0;
+}
+
+// Rounds up: a timer never fires before its nanosecond deadline.
+uint64_t wheel_deadline(time_ns_t ns) {
+    if (ns <= 0) { return 0; }
+    return static_cast<uint64_t>(ns) / TIMER_UNIT_NS + (static_cast<uint64_t>(ns) % TIMER_UNIT_NS != 0 ? 1 : 0);
+}
+
+// Earliest wheel event in nanoseconds, republished under g_sched_lock after every change so
+// rearm_timer can read it locklessly.
+ktl::atomic<time_ns_t> g_next_timer_ns{kernel::time::NEVER};
+
+void publish_next_timer() {
+    uint64_t event = g_sleepers.next_event();
+    uint64_t waits = g_timed_waits.next_event();
+    if (waits < event) { event = waits; }
+    time_ns_t ns = kernel::time::NEVER;
+    if (event != timer_wheel::NONE && event < static_cast<uint64_t>(kernel::time::NEVER) / TIMER_UNIT_NS) {
+        ns = static_cast<time_ns_t>(event * TIMER_UNIT_NS);
+    }
+    g_next_timer_ns.store(ns);
+}
+
+// A new timer may be due before whatever the boot core's one-shot is armed for. Its own core
+// reprograms directly; any other core kicks it with a reschedule IPI, whose exit path rearms.
+// Called after publish_next_timer, outside g_sched_lock.
+void notify_timer_core(time_ns_t deadline_ns) {
+    if (!kernel::time::high_resolution()) { return; }
+    if (on_boot_core()) {
+        rearm_timer();
+        return;
+    }
+    size_t boot = kernel::boot::collect().boot_cpu_index;
+    if (deadline_ns < cpu_at(boot).armed_ns.load()) { kernel::arch::send_reschedule_ipi(boot); }
+}
 
 }  // namespace
 
+time_ns_t next_timer_ns() { return g_next_timer_ns.load(); }
+
 void sleep_ticks(uint64_t ticks) {
-    kernel::synchronization::assert_blocking_allowed("sleep_ticks: scheduling is forbidden in this context");
-    kernel::synchronization::assert_no_locks_held("sleep_ticks: scheduling while holding a lock");
-    if (ticks == 0) {
+    uint64_t per = static_cast<uint64_t>(kernel::time::ktime_to_ns(1));
+    // Saturate rather than wrap: an absurd tick count sleeps (effectively) forever, not briefly.
+    sleep_ns(per != 0 && ticks > ~uint64_t{0} / per ? ~uint64_t{0} : ticks * per);
+}
+
+void sleep_ns(uint64_t ns) {
+    kernel::synchronization::assert_blocking_allowed("sleep_ns: scheduling is forbidden in this context");
+    kernel::synchronization::assert_no_locks_held("sleep_ns: scheduling while holding a lock");
+    if (ns == 0) {
         yield();
         return;
     }
-    if (lifecycle_log_verbose_enabled()) { g_log.debug("sched: sleep id={0} ticks={1}", current()->id(), ticks); }
+    if (lifecycle_log_verbose_enabled()) { g_log.debug("sched: sleep id={0} ns={1}", current()->id(), ns); }
+    time_ns_t now      = kernel::time::ns_since_boot();
+    time_ns_t deadline = ns >= static_cast<uint64_t>(kernel::time::NEVER - now) ? kernel::time::NEVER
+                                                                                 : now + static_cast<time_ns_t>(ns);
+    sleeper self;
+    bool parked    = false;
     uint64_t flags = kernel::arch::save_and_disable_interrupts();
     {
         sched_guard guard(g_sched_lock);
         auto& c = cur_cpu();
-        assert(c.current.get() != c.idle.get(), "sleep_ticks: idle thread cannot sleep");
-        // A killed thread must not enter the sleeper list: its deadline could be arbitrarily far
-        // out, and the kill scan that wakes sleepers early has already run. Checked under the lock
-        // so a kill cannot slip between the check and the park; the thread exits at the syscall
+        assert(c.current.get() != c.idle.get(), "sleep_ns: idle thread cannot sleep");
+        // A killed thread must not arm a sleep timer: its deadline could be arbitrarily far out,
+        // and the kill scan that wakes sleepers early has already run. Checked under the lock so
+        // a kill cannot slip between the check and the park; the thread exits at the syscall
         // boundary.
-        if (c.current->killed()) { return; }
-        c.current->stats().sleeps += 1;
-        c.current->set_state(thread_state::BLOCKED);
-        bool ok = g_sleepers.push_back(sleeper{kernel::time::now() + ticks, c.current});
-        ensure(ok, "sleep_ticks: sleeper push failed despite reservation");
+        if (!c.current->killed()) {
+            c.current->stats().sleeps += 1;
+            c.current->set_state(thread_state::BLOCKED);
+            self.thread = c.current;
+            c.current->set_sleep_timer(&self);
+            g_sleepers.insert(self, wheel_deadline(deadline));
+            publish_next_timer();
+            parked = true;
+        }
+    }
+    if (parked) {
+        notify_timer_core(deadline);
+        schedule_out(switch_reason::SLEEP);
     }
-    schedule_out(switch_reason::SLEEP);
     kernel::arch::restore_interrupts(flags);
 }
 
 void wake_due_sleepers() {
-    for (size_t i = 0; i < g_sleepers.size();) {
-        if (g_sleepers[i].wake_at <= kernel::time::now()) {
-            ktl::ref<Thread> t = ktl::move(g_sleepers[i].thread);
-            g_sleepers.swap_remove(i);
-            make_ready_locked(ktl::move(t));
-        } else {
-            ++i;
-        }
-    }
+    g_sleepers.advance(wheel_now(), [](timer_entry& e) {
+        auto& s = static_cast<sleeper&>(e);
+        s.thread->set_sleep_timer(nullptr);
+        // The frame holding `s` unwinds once the woken thread runs; nothing touches it after this.
+        make_ready_locked(ktl::move(s.thread));
+    });
+    publish_next_timer();
 }
 
-size_t sleeper_count() { return g_sleepers.size(); }
+size_t sleeper_count() { return g_sleepers.armed(); }
 
 bool wake_sleeper(Thread* thread) {
-    for (size_t i = 0; i < g_sleepers.size(); i++) {
-        if (g_sleepers[i].thread.get() != thread) { continue; }
-        ktl::ref<Thread> woken = ktl::move(g_sleepers[i].thread);
-        g_sleepers.swap_remove(i);
-        make_ready_locked(ktl::move(woken));
-        return true;
-    }
-    return false;
-}
-
-bool sleepers_reserve(size_t capacity) {
-    return grow_under_sched_lock(g_sleepers, capacity) && grow_under_sched_lock(g_timed_waits, capacity);
+    timer_entry* timer = thread->sleep_timer();
+    if (timer == nullptr || !g_sleepers.cancel(*timer)) { return false; }
+    thread->set_sleep_timer(nullptr);
+    make_ready_locked(ktl::move(static_cast<sleeper*>(timer)->thread));
+    publish_next_timer();
+    return true;
 }
 
-void timed_wait_register(wait_queue* queue, wait_node* node, ktime_t wake_at) {
-    sched_guard guard(g_sched_lock);
-    bool ok = g_timed_waits.push_back(timed_wait{wake_at, queue, node});
-    ensure(ok, "timed_wait_register: push failed despite reservation");
+void timed_wait_register(timed_wait& wait, wait_queue* queue, wait_node* node, ktime_t wake_at) {
+    wait.queue            = queue;
+    wait.node             = node;
+    time_ns_t deadline_ns = kernel::time::ktime_to_ns(wake_at);
+    {
+        sched_guard guard(g_sched_lock);
+        g_timed_waits.insert(wait, wheel_deadline(deadline_ns));
+        publish_next_timer();
+    }
+    notify_timer_core(deadline_ns);
 }
 
-void timed_wait_unregister(wait_node* node) {
+void timed_wait_unregister(timed_wait& wait) {
     sched_guard guard(g_sched_lock);
-    for (size_t i = 0; i < g_timed_waits.size(); i++) {
-        if (g_timed_waits[i].node == node) {
-            g_timed_waits.swap_remove(i);
-            break;
-        }
-    }
-    // Absent is normal: the expiry scan already removed the entry when it claimed the thread.
+    // Not armed is normal: expiry already disarmed it, whether or not its claim found the thread.
+    if (g_timed_waits.cancel(wait)) { publish_next_timer(); }
 }
 
 void wake_due_timed_waits() {
-    for (size_t i = 0; i < g_timed_waits.size();) {
-        if (g_timed_waits[i].wake_at > kernel::time::now()) {
-            ++i;
-            continue;
-        }
+    g_timed_waits.advance(wheel_now(), [](timer_entry& e) {
+        auto& wait = static_cast<timed_wait&>(e);
         // claim() resolves the race against signal wakers under the queue's lock. A failed claim
-        // means the waiter is not parked (not yet, or already woken); leave the entry -- the
-        // waiter's unregister removes it, and its deadline predicate keeps it from re-parking.
-        ktl::ref<Thread> woken = g_timed_waits[i].queue->claim(g_timed_waits[i].node);
-        if (!woken) {
-            ++i;
-            continue;
-        }
-        g_timed_waits.swap_remove(i);
-        make_ready_locked(ktl::move(woken));
-    }
+        // means the waiter is not parked (not yet, or already woken); the timer is spent either
+        // way -- the waiter's deadline predicate keeps it from parking on an expired wait, and its
+        // unregister finds nothing left to cancel.
+        ktl::ref<Thread> woken = wait.queue->claim(wait.node);
+        if (woken) { make_ready_locked(ktl::move(woken)); }
+    });
+    publish_next_timer();
 }
 
 }  // namespace kernel::sched
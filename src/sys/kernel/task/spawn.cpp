@@ -28,10 +28,6 @@ ktl::result<ktl::ref<Thread>> thread_create_in(ktl::ref<Task> task, const char*
         return ktl::err(ktl::errc::oom);
     }
     thread->set_saved_sp(kernel::arch::prepare_thread_stack(virt_base + CONFIG_KERNEL_STACK_SIZE, entry, arg));
-    // A fresh user thread is switched in -- and its FP state restored -- before it ever saves, so
-    // the area must hold the entry-state image now: the zero-initialized area plus the arch's
-    // nonzero entry fields. Kernel threads' areas are never touched, so seeding them is harmless.
-    kernel::arch::fpu_init(thread->fpu_area());
 
     // A thread gets an IPC buffer exactly when its task has an address space to map one into.
     // Kernel threads have neither, and make no syscalls.
@@ -87,7 +83,7 @@ ktl::result<void> thread_enqueue(ktl::ref<Thread> thread) {
         g_stats.spawned += 1;
         auto& c = cur_cpu();
         trace_push(trace_kind::SPAWN, switch_reason::NONE, c.current ? c.current->id() : 0, thread->id());
-        ok = push_runnable_locked(thread);
+        ok = push_runnable(thread);
     }
     if (!ok) {
         thread_discard(thread);
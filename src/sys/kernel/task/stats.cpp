@@ -9,7 +9,6 @@ namespace kernel::sched {
 
 namespace {
 
-trace_ring<CONFIG_SCHED_TRACE_EVENTS> g_trace;
 bool g_lifecycle_log         = true;
 // Per-scheduling-event messages (sleep/block/woke) flood the log; opt in via `sched log verbose`.
 bool g_lifecycle_log_verbose = false;
@@ -18,35 +17,58 @@ bool g_lifecycle_log_verbose = false;
 
 global_stats g_stats;
 
-void trace_push(trace_kind kind, switch_reason reason, uint64_t from, uint64_t to) {
+void trace_push_locked(cpu_sched& cpu, trace_kind kind, switch_reason reason, uint64_t from, uint64_t to) {
     trace_record r;
     r.timestamp = kernel::arch::timestamp();
     r.kind      = kind;
     r.reason    = reason;
     r.from_id   = from;
     r.to_id     = to;
-    g_trace.push(r);
+    cpu.trace.push(r);
+}
+
+void trace_push(trace_kind kind, switch_reason reason, uint64_t from, uint64_t to) {
+    auto& c = cur_cpu();
+    cpu_guard guard(c.lock);
+    trace_push_locked(c, kind, reason, from, to);
 }
 
 global_stats stats_snapshot() {
-    sched_guard guard(g_sched_lock);
-    global_stats s = g_stats;
-    s.runq_depth   = run_queue_depth_locked();
-    s.sleepers     = sleeper_count();
-    s.zombies      = reaper_zombie_count();
-    s.reaped       = reaper_reaped_count();
+    global_stats s;
+    {
+        sched_guard guard(g_sched_lock);
+        s          = g_stats;
+        s.sleepers = sleeper_count();
+        s.zombies  = reaper_zombie_count();
+        s.reaped   = reaper_reaped_count();
+    }
     // Charge every core's running thread its in-progress slice so idle/busy shares are current;
-    // the anchors are scheduler-lock state, so another core's switch_to cannot race this.
-    uint64_t now   = kernel::arch::timestamp();
+    // the anchors are that core's lock state, so its switch_to cannot race this.
     for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
         auto& c = cpu_at(i);
+        cpu_guard guard(c.lock);
         if (c.current) {
+            uint64_t now = kernel::arch::timestamp();
             c.current->stats().cpu_cycles += now - c.last_switch_ts;
             c.last_switch_ts      = now;
             s.cores[i].online     = true;
             s.cores[i].switches   = c.switches;
             s.cores[i].current_id = c.current->id();
         }
+        s.cores[i].runq_depth = c.run_queue.size();
+        s.cores[i].steals     = c.steals;
+        s.cores[i].handoffs   = c.handoffs;
+        s.cores[i].timer_irqs = c.timer_irqs;
+        s.switches += c.switches;
+        s.preempts += c.preempts;
+        s.yields += c.yields;
+        s.block_switches += c.block_switches;
+        s.sleep_switches += c.sleep_switches;
+        s.exit_switches += c.exit_switches;
+        s.steals += c.steals;
+        s.handoffs += c.handoffs;
+        s.timer_irqs += c.timer_irqs;
+        s.runq_depth += c.run_queue.size();
         if (c.idle) {
             s.cores[i].idle_cycles = c.idle->stats().cpu_cycles;
             s.idle_cycles += c.idle->stats().cpu_cycles;
@@ -55,14 +77,48 @@ global_stats stats_snapshot() {
     return s;
 }
 
+// Newest-first merge of the per-core rings. Each step re-takes one core's lock to read that ring's
+// next-newest record by sequence number, so no two core locks are ever held together; a record
+// overwritten mid-merge ends that ring's contribution rather than repeating or tearing.
 size_t trace_copy_newest(trace_record* out, size_t max) {
-    sched_guard guard(g_sched_lock);
-    return g_trace.copy_newest(out, max);
+    uint64_t cursor[CONFIG_MAX_CORES];
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        cpu_guard guard(cpu_at(i).lock);
+        cursor[i] = cpu_at(i).trace.end_seq();
+    }
+    size_t n = 0;
+    while (n < max) {
+        size_t best = CONFIG_MAX_CORES;
+        trace_record best_record;
+        for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+            if (cursor[i] == 0) { continue; }
+            trace_record r;
+            bool ok;
+            {
+                cpu_guard guard(cpu_at(i).lock);
+                ok = cpu_at(i).trace.read_seq(cursor[i] - 1, r);
+            }
+            if (!ok) {
+                cursor[i] = 0;
+                continue;
+            }
+            if (best == CONFIG_MAX_CORES || r.timestamp > best_record.timestamp) {
+                best        = i;
+                best_record = r;
+            }
+        }
+        if (best == CONFIG_MAX_CORES) { break; }
+        out[n++] = best_record;
+        cursor[best] -= 1;
+    }
+    return n;
 }
 
 void trace_clear() {
-    sched_guard guard(g_sched_lock);
-    g_trace.clear();
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        cpu_guard guard(cpu_at(i).lock);
+        cpu_at(i).trace.clear();
+    }
 }
 
 void set_lifecycle_log(bool enabled) { g_lifecycle_log = enabled; }
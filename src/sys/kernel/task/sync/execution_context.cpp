@@ -24,17 +24,22 @@ void init_execution_context(size_t cpu_index) {
     g_contexts[cpu_index].cpu_index = cpu_index;
 }
 
+// Hosted builds supply the index through the same seam: one core for the host runner, one per
+// thread for the TSan lane.
 execution_context& current_execution_context() {
-#if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
     size_t index = kernel::arch::current_core_index();
-#else
-    size_t index = 0;
-#endif
     if (index >= CONFIG_MAX_CORES) { panic("execution context: current CPU index out of range"); }
     return g_contexts[index];
 }
 
-void set_current_thread_id(uint64_t thread_id) { current_execution_context().thread_id = thread_id; }
+void set_current_thread_id(uint64_t thread_id) {
+    __atomic_store_n(&current_execution_context().thread_id, thread_id, __ATOMIC_RELAXED);
+}
+
+uint64_t thread_on_core(size_t cpu) {
+    return cpu < CONFIG_MAX_CORES ? __atomic_load_n(&g_contexts[cpu].thread_id, __ATOMIC_RELAXED) : 0;
+}
+
 void set_deferred_preempt_hook(deferred_preempt_hook hook) { g_preempt_hook = hook; }
 
 // The depth counters live per core but belong to the running thread, so every update runs with
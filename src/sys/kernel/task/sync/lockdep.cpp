@@ -3,16 +3,20 @@
 #include <kernel/synchronization/execution_context.h>
 #include <kernel/synchronization/lockdep.h>
 
+#include <ktl/string_view>
+
 namespace kernel::synchronization::lockdep {
 
 #ifndef NDEBUG
 namespace {
 struct lock_record {
-    const void* address   = nullptr;
-    const char* name      = nullptr;
-    size_t owner_cpu      = 0;
-    uint64_t owner_thread = 0;
-    bool owned            = false;
+    const void* address     = nullptr;
+    const char* name        = nullptr;
+    size_t owner_cpu        = 0;
+    uint64_t owner_thread   = 0;
+    uint32_t lock_class     = 0;  // index into g_classes
+    const lock_stats* stats = nullptr;
+    bool owned              = false;
 };
 struct edge_record {
     uint32_t from = 0;
@@ -21,7 +25,10 @@ struct edge_record {
 
 lock_record g_locks[CONFIG_LOCKDEP_MAX_LOCKS];
 edge_record g_edges[CONFIG_LOCKDEP_MAX_EDGES];
+// Counters are bumped with relaxed atomics outside the table lock; only registration takes it.
+class_stats g_classes[CONFIG_LOCKDEP_MAX_CLASSES];
 uint32_t g_free_list[CONFIG_LOCKDEP_MAX_LOCKS];
+uint32_t g_class_count        = 0;
 uint32_t g_next_identity      = 1;
 size_t g_edge_count           = 0;
 size_t g_free_count           = 0;
@@ -50,6 +57,16 @@ lock_record& record(uint32_t identity) {
     return g_locks[identity - 1];
 }
 
+// The class named `name`, registered on first sight. Called under the table lock.
+uint32_t class_of(const char* name) {
+    for (uint32_t i = 0; i < g_class_count; ++i) {
+        if (ktl::string_view(g_classes[i].name) == ktl::string_view(name)) { return i; }
+    }
+    if (g_class_count == CONFIG_LOCKDEP_MAX_CLASSES) { panic("lockdep: lock class capacity exhausted"); }
+    g_classes[g_class_count].name = name;
+    return g_class_count++;
+}
+
 bool path_exists(uint32_t from, uint32_t to, bool* visited) {
     if (from == to) { return true; }
     if (visited[from - 1]) { return false; }
@@ -89,9 +106,10 @@ uint32_t allocate_identity(const void* address, const char* name) {
         if (g_next_identity > CONFIG_LOCKDEP_MAX_LOCKS) { panic("lockdep: registered lock capacity exhausted"); }
         identity = g_next_identity++;
     }
-    g_locks[identity - 1]         = lock_record{};
-    g_locks[identity - 1].address = address;
-    g_locks[identity - 1].name    = name;
+    g_locks[identity - 1]            = lock_record{};
+    g_locks[identity - 1].address    = address;
+    g_locks[identity - 1].name       = name;
+    g_locks[identity - 1].lock_class = class_of(name);
     return identity;
 #else
     (void)address;
@@ -173,6 +191,79 @@ void assert_not_owned(const void* address, uint32_t identity) {
 #endif
 }
 
+void contended(uint32_t identity, uint32_t spins, uint32_t parks, uint64_t wait_cycles) {
+#ifndef NDEBUG
+    if (identity == 0) { return; }
+    // The record cannot be released under a lock that is being acquired, so no table lock.
+    auto& stats = g_classes[record(identity).lock_class];
+    __atomic_fetch_add(&stats.contended, 1, __ATOMIC_RELAXED);
+    if (parks == 0) { __atomic_fetch_add(&stats.spun, 1, __ATOMIC_RELAXED); }
+    __atomic_fetch_add(&stats.parks, parks, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats.spins, spins, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats.wait_cycles, wait_cycles, __ATOMIC_RELAXED);
+#else
+    (void)identity;
+    (void)spins;
+    (void)parks;
+    (void)wait_cycles;
+#endif
+}
+
+size_t snapshot_classes(class_stats* out, size_t capacity) {
+#ifndef NDEBUG
+    table_guard guard;
+    size_t count = g_class_count < capacity ? g_class_count : capacity;
+    for (size_t i = 0; i < count; ++i) {
+        out[i].name        = g_classes[i].name;
+        out[i].contended   = __atomic_load_n(&g_classes[i].contended, __ATOMIC_RELAXED);
+        out[i].spun        = __atomic_load_n(&g_classes[i].spun, __ATOMIC_RELAXED);
+        out[i].parks       = __atomic_load_n(&g_classes[i].parks, __ATOMIC_RELAXED);
+        out[i].spins       = __atomic_load_n(&g_classes[i].spins, __ATOMIC_RELAXED);
+        out[i].wait_cycles = __atomic_load_n(&g_classes[i].wait_cycles, __ATOMIC_RELAXED);
+    }
+    return count;
+#else
+    (void)out;
+    (void)capacity;
+    return 0;
+#endif
+}
+
+void attach_stats(uint32_t identity, const lock_stats* stats) {
+#ifndef NDEBUG
+    if (identity == 0) { return; }
+    table_guard guard;
+    record(identity).stats = stats;
+#else
+    (void)identity;
+    (void)stats;
+#endif
+}
+
+// Under the table lock, which a lock's destructor takes to release its identity, so every attached
+// record's counters are still alive while they are read.
+size_t snapshot_locks(lock_row* out, size_t capacity) {
+#ifndef NDEBUG
+    table_guard guard;
+    size_t count = 0;
+    for (uint32_t i = 0; i + 1 < g_next_identity && count < capacity; ++i) {
+        const auto& lock = g_locks[i];
+        if (lock.stats == nullptr) { continue; }
+        out[count].name                  = lock.name;
+        out[count].address               = lock.address;
+        out[count].stats.acquires        = __atomic_load_n(&lock.stats->acquires, __ATOMIC_RELAXED);
+        out[count].stats.contended       = __atomic_load_n(&lock.stats->contended, __ATOMIC_RELAXED);
+        out[count].stats.max_spin_cycles = __atomic_load_n(&lock.stats->max_spin_cycles, __ATOMIC_RELAXED);
+        ++count;
+    }
+    return count;
+#else
+    (void)out;
+    (void)capacity;
+    return 0;
+#endif
+}
+
 #if CONFIG_KERNEL_TESTING
 void reset_for_testing() {
 #ifndef NDEBUG
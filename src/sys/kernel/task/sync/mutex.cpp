@@ -1,3 +1,4 @@
+#include <kernel/arch.h>
 #include <kernel/panic.h>
 #include <kernel/sched/scheduler.h>
 #include <kernel/synchronization/mutex.h>
@@ -13,45 +14,106 @@ mutex::~mutex() {
     lockdep::release_identity(m_lockdep_id);
 }
 
+// The unlocked state is always 0: unlock clears the waiter bit along with the lock bit.
 bool mutex::try_acquire() {
     uint8_t expected = 0;
-    return m_state.compare_exchange(expected, 1, ktl::memory_order::acquire, ktl::memory_order::relaxed);
+    return m_state.compare_exchange(expected, LOCKED, ktl::memory_order::acquire, ktl::memory_order::relaxed);
+}
+
+// Read without pinning the thread to its core: a migration in between records a stale core, which
+// only makes a spinner park early.
+void mutex::note_owner() {
+    auto& context = current_execution_context();
+    m_owner_cpu.store(static_cast<uint32_t>(context.cpu_index), ktl::memory_order::relaxed);
+    m_owner.store(context.thread_id, ktl::memory_order::relaxed);
+}
+
+// No owner recorded means the lock is changing hands -- just taken or just released -- which is
+// worth spinning through.
+bool mutex::owner_running() const {
+    uint64_t owner = m_owner.load(ktl::memory_order::relaxed);
+    return owner == 0 || thread_on_core(m_owner_cpu.load(ktl::memory_order::relaxed)) == owner;
 }
 
 bool mutex::try_lock() {
     assert_blocking_allowed("mutex::try_lock: mutex is only valid in preemptible thread context");
-    return try_acquire();
+    if (!try_acquire()) { return false; }
+    note_owner();
+    return true;
 }
 
 void mutex::lock() {
     assert_blocking_allowed("mutex::lock: mutex is only valid in preemptible thread context");
-    if (try_acquire()) { return; }
+    if (try_acquire()) {
+        note_owner();
+        return;
+    }
 #if !defined(ARCH_X86_64) && !defined(ARCH_RISCV64)
     panic("mutex: hosted contention cannot block");
 #else
     if (!kernel::sched::started()) { panic("mutex: contention before scheduler startup"); }
-    while (true) {
+    lock_contended();
+#endif
+}
+
+#if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
+void mutex::lock_contended() {
+    uint64_t start = kernel::arch::timestamp();
+    uint32_t spins = 0;
+    uint32_t parks = 0;
+    bool acquired  = false;
+    // A running owner is likely to let go sooner than a park and a wake would take.
+    while (!acquired && spins < CONFIG_MUTEX_SPIN_LIMIT && owner_running()) {
+        spins++;
+        acquired = m_state.load(ktl::memory_order::relaxed) == 0 && try_acquire();
+        if (!acquired) { kernel::arch::cpu_relax(); }
+    }
+
+    while (!acquired) {
         struct acquire_context {
             mutex* lock;
+            bool parked;
             bool acquired;
-        } context{this, false};
+        } context{this, parks != 0, false};
+        // Under the queue's lock, so an unlock that sees the waiter bit wakes after the park. A
+        // contender that has parked cannot tell whether others still are, so it takes the lock
+        // with the bit kept and its own unlock wakes the next.
         m_waiters.block_if(
             0,
             [](void* argument) {
-                auto* context     = static_cast<acquire_context*>(argument);
-                context->acquired = context->lock->try_acquire();
-                return !context->acquired;
+                auto* context = static_cast<acquire_context*>(argument);
+                auto& state   = context->lock->m_state;
+                uint8_t seen  = state.load(ktl::memory_order::relaxed);
+                while (true) {
+                    if ((seen & LOCKED) == 0) {
+                        uint8_t desired = context->parked ? LOCKED | WAITERS : LOCKED;
+                        if (state.compare_exchange(seen, desired, ktl::memory_order::acquire,
+                                                   ktl::memory_order::relaxed)) {
+                            context->acquired = true;
+                            return false;
+                        }
+                    } else if ((seen & WAITERS) != 0 ||
+                               state.compare_exchange(seen, seen | WAITERS, ktl::memory_order::relaxed,
+                                                      ktl::memory_order::relaxed)) {
+                        return true;
+                    }
+                }
             },
             &context);
-        if (context.acquired) { return; }
+        acquired = context.acquired;
+        if (!acquired) { parks++; }
     }
-#endif
+    note_owner();
+    lockdep::contended(m_lockdep_id, spins, parks, kernel::arch::timestamp() - start);
 }
+#endif
 
 void mutex::unlock() {
-    if (m_state.exchange(0, ktl::memory_order::release) == 0) { panic("mutex: unlock of unlocked mutex"); }
+    m_owner.store(0, ktl::memory_order::relaxed);
+    uint8_t previous = m_state.exchange(0, ktl::memory_order::release);
+    if (previous == 0) { panic("mutex: unlock of unlocked mutex"); }
 #if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
-    m_waiters.wake_one();
+    if ((previous & WAITERS) != 0) { m_waiters.wake_one(); }
 #endif
 }
 
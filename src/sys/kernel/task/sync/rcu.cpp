@@ -0,0 +1,171 @@
+#include <kernel/arch.h>
+#include <kernel/synchronization/rcu.h>
+
+#if defined(ARCH_X86_64) || defined(ARCH_RISCV64)
+#include <kernel/sched/internal.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/sched/wait_queue.h>
+#endif
+
+namespace kernel::synchronization {
+
+void rcu_state::set_online(size_t core) { m_cores[core].online.store(true); }
+
+void rcu_state::note_quiescent(size_t core) {
+    auto& mine  = m_cores[core];
+    uint64_t gp = m_started.load(ktl::memory_order::acquire);
+    if (mine.reported.load(ktl::memory_order::relaxed) == gp) { return; }
+    // The report and the scan are sequentially consistent: of two cores reporting at once, at least
+    // one sees the other's report, so a grace period every core has reported in always completes.
+    mine.reported.store(gp);
+    for (const auto& other : m_cores) {
+        if (other.online.load() && other.reported.load() < gp) { return; }
+    }
+    // A report for a grace period already completed, or one that has not started, fails this.
+    uint64_t previous = gp - 1;
+    m_completed.compare_exchange(previous, gp, ktl::memory_order::release, ktl::memory_order::relaxed);
+}
+
+bool rcu_state::enqueue(rcu_head* head, rcu_callback func) {
+    critical_lock_guard guard(m_lock);
+    head->next         = nullptr;
+    head->func         = func;
+    head->grace_period = m_started.load(ktl::memory_order::relaxed) + 1;
+    bool was_empty     = m_tail == nullptr;
+    if (was_empty) {
+        m_head = head;
+    } else {
+        m_tail->next = head;
+    }
+    m_tail = head;
+    m_queued.fetch_add(1, ktl::memory_order::relaxed);
+    return was_empty;
+}
+
+bool rcu_state::start() {
+    critical_lock_guard guard(m_lock);
+    uint64_t started = m_started.load(ktl::memory_order::relaxed);
+    if (m_tail == nullptr || m_tail->grace_period <= started) { return false; }
+    if (m_completed.load(ktl::memory_order::acquire) != started) { return false; }
+    m_started.store(started + 1);
+    return true;
+}
+
+rcu_head* rcu_state::take_ready() {
+    critical_lock_guard guard(m_lock);
+    uint64_t done  = m_completed.load(ktl::memory_order::acquire);
+    rcu_head* last = nullptr;
+    size_t count   = 0;
+    for (rcu_head* head = m_head; head != nullptr && head->grace_period <= done; head = head->next) {
+        last = head;
+        count++;
+    }
+    if (last == nullptr) { return nullptr; }
+    rcu_head* first = m_head;
+    m_head          = last->next;
+    if (m_head == nullptr) { m_tail = nullptr; }
+    last->next = nullptr;
+    m_queued.fetch_sub(count, ktl::memory_order::relaxed);
+    return first;
+}
+
+uint64_t rcu_state::pending_cores() const {
+    uint64_t gp = m_started.load(ktl::memory_order::acquire);
+    if (m_completed.load(ktl::memory_order::acquire) == gp) { return 0; }
+    uint64_t pending = 0;
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        if (m_cores[i].online.load() && m_cores[i].reported.load() < gp) { pending |= 1ull << i; }
+    }
+    return pending;
+}
+
+#if !defined(ARCH_X86_64) && !defined(ARCH_RISCV64)
+void call_rcu(rcu_head* head, rcu_callback func) {
+    head->func = func;
+    func(head);
+}
+
+void synchronize_rcu() {}
+#else
+namespace {
+
+rcu_state g_rcu;
+kernel::sched::wait_queue g_rcu_wq;   // the callback thread, parked while nothing is queued
+kernel::sched::wait_queue g_sync_wq;  // synchronize_rcu callers
+constexpr uint32_t SYNC_MASK = 1;
+
+// A core idling tickless reports nothing until it wakes; a reschedule IPI takes it once round the
+// idle loop, which reports.
+void kick_idle_cores() {
+    uint64_t pending = g_rcu.pending_cores();
+    for (size_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        if (((pending >> i) & 1) != 0 && kernel::sched::cpu_at(i).idling.load(ktl::memory_order::relaxed)) {
+            kernel::arch::send_reschedule_ipi(i);
+        }
+    }
+}
+
+// Grace periods are driven from here: open one when callbacks are owed one, run what has become
+// ready, and poll once a tick while anything is outstanding. The thread's own sleep is a quiescent
+// state for its core.
+[[noreturn]] void rcu_main(void*) {
+    while (true) {
+        g_rcu.start();
+        for (rcu_head* head = g_rcu.take_ready(); head != nullptr;) {
+            rcu_head* next = head->next;
+            head->func(head);
+            head = next;
+        }
+        if (!g_rcu.has_callbacks()) {
+            g_rcu_wq.block_if(0, [](void*) { return !g_rcu.has_callbacks(); }, nullptr);
+            continue;
+        }
+        kick_idle_cores();
+        kernel::sched::sleep_ticks(1);
+    }
+}
+
+struct rcu_waiter {
+    rcu_head head;  // first, so the callback recovers the waiter from it
+    ktl::atomic<bool> done{false};
+};
+
+}  // namespace
+
+void call_rcu(rcu_head* head, rcu_callback func) {
+    if (g_rcu.enqueue(head, func)) { g_rcu_wq.wake_one(); }
+}
+
+void synchronize_rcu() {
+    assert_blocking_allowed("synchronize_rcu: only valid in preemptible thread context");
+    // Before the scheduler starts, the boot thread is the only reader there is.
+    if (!kernel::sched::started()) { return; }
+    rcu_waiter waiter;
+    call_rcu(&waiter.head, [](rcu_head* head) {
+        reinterpret_cast<rcu_waiter*>(head)->done.store(true, ktl::memory_order::release);
+        g_sync_wq.wake_matching(SYNC_MASK);
+    });
+    // The queue is shared, so the waker touches nothing in this frame after setting the flag. A
+    // killed thread's masked wait returns at once, which turns this into a poll until the grace
+    // period ends.
+    auto pending = [](void* ctx) { return !static_cast<rcu_waiter*>(ctx)->done.load(ktl::memory_order::acquire); };
+    while (pending(&waiter)) { g_sync_wq.block_if(SYNC_MASK, pending, &waiter); }
+}
+
+void rcu_note_quiescent() { g_rcu.note_quiescent(kernel::arch::current_core_index()); }
+
+// interrupt_depth is 1 for the tick itself: a nested tick, or one that landed in a fault handler or
+// a preemption-disabled section, may have interrupted a reader.
+void rcu_tick() {
+    const auto& context = current_execution_context();
+    if (context.preempt_depth == 0 && context.fault_depth == 0 && context.interrupt_depth == 1) {
+        rcu_note_quiescent();
+    }
+}
+
+void rcu_core_online(size_t core) { g_rcu.set_online(core); }
+
+void rcu_start() { kernel::sched::spawn("rcu", rcu_main, nullptr).expect("rcu: callback thread spawn failed"); }
+#endif
+
+}  // namespace kernel::synchronization
@@ -0,0 +1,83 @@
+#include <kernel/arch.h>
+#include <kernel/panic.h>
+#include <kernel/synchronization/spinlock.h>
+
+namespace kernel::synchronization {
+
+namespace {
+
+// A node of its own cache line, so a waiter spinning on `ready` shares it with nobody.
+struct alignas(CONFIG_CPU_CACHE_LINE_SIZE) queue_node {
+    queue_node* next = nullptr;  // the waiter queued behind this one, once it has linked in
+    uint32_t ready   = 0;        // set by the predecessor when this node reaches the queue's head
+};
+
+// Nodes are indexed by waiting depth, which only an interrupt or fault landing mid-wait raises and
+// which it restores before returning, so the depth needs no atomicity against this core's own
+// handlers and no other core ever touches it. The compiler still must not move the plain depth
+// stores across the node's use, or a handler landing in between would reuse a node still queued;
+// the signal fences in lock_queued pin them, as qspinlock's barrier() does.
+struct core_queue {
+    queue_node nodes[spinlock::SPINLOCK_QUEUE_NODES];
+    uint32_t depth = 0;
+};
+
+core_queue g_queues[CONFIG_MAX_CORES];
+
+uint32_t encode(size_t core, uint32_t depth) {
+    return 1 + static_cast<uint32_t>(core) * spinlock::SPINLOCK_QUEUE_NODES + depth;
+}
+
+queue_node& decode(uint32_t tail) {
+    uint32_t index = tail - 1;
+    return g_queues[index / spinlock::SPINLOCK_QUEUE_NODES].nodes[index % spinlock::SPINLOCK_QUEUE_NODES];
+}
+
+}  // namespace
+
+// Preemption is off, so the core cannot change under the wait.
+void spinlock::lock_queued() {
+#if KERNEL_SPINLOCK_STATS
+    uint64_t start = kernel::arch::timestamp();
+#endif
+    size_t core      = kernel::arch::current_core_index();
+    core_queue& mine = g_queues[core];
+    uint32_t depth   = mine.depth;
+    if (depth == SPINLOCK_QUEUE_NODES) { panic("spinlock: queue nodes exhausted"); }
+    mine.depth = depth + 1;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);  // claim the node before touching it
+    queue_node& me = mine.nodes[depth];
+    me.next        = nullptr;
+    me.ready       = 0;
+    uint32_t self  = encode(core, depth);
+
+    // Appending publishes the node; a predecessor links to it and hands over the head later.
+    uint32_t previous = __atomic_exchange_n(&m_tail, self, __ATOMIC_ACQ_REL);
+    if (previous != 0) {
+        __atomic_store_n(&decode(previous).next, &me, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&me.ready, __ATOMIC_ACQUIRE) == 0) { kernel::arch::cpu_relax(); }
+    }
+
+    // At the head: the lock word has at most this waiter and a barging try_lock to contend with.
+    while (__atomic_load_n(&m_locked, __ATOMIC_RELAXED) != unlocked_state || !try_acquire()) {
+        kernel::arch::cpu_relax();
+    }
+
+    // Leave the queue. If nobody is behind, empty it; otherwise wait for the successor to link in
+    // and make it the head.
+    uint32_t expected = self;
+    if (!__atomic_compare_exchange_n(&m_tail, &expected, 0, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        queue_node* next;
+        while ((next = __atomic_load_n(&me.next, __ATOMIC_ACQUIRE)) == nullptr) { kernel::arch::cpu_relax(); }
+        __atomic_store_n(&next->ready, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);  // done with the node before releasing it
+    mine.depth = depth;
+#if KERNEL_SPINLOCK_STATS
+    note_acquired(true, kernel::arch::timestamp() - start);
+#else
+    note_acquired(true, 0);
+#endif
+}
+
+}  // namespace kernel::synchronization
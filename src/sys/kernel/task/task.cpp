@@ -5,7 +5,7 @@ namespace kernel::sched {
 namespace {
 ktl::ref<Task> g_kernel_task;
 ktl::vector<ktl::ref<Task>> g_tasks;
-kernel::synchronization::mutex g_tasks_lock;
+kernel::synchronization::mutex g_tasks_lock{"task_registry"};
 }  // namespace
 
 ktl::ref<Task> kernel_task() {
@@ -45,20 +45,6 @@ constexpr uintptr_t USER_STACK_TOP  = USER_STACK_BASE + USER_STACK_PAGES * KERNE
     kernel::arch::enter_user(reinterpret_cast<uintptr_t>(entry), USER_STACK_TOP, kstack_top, ipc_base, ipc_size);
 }
 
-// Escrow `object` into the kernel table and attach it to `message`, the same escrow a user-to-user
-// handle transfer rides. False leaves the message unchanged; handles already attached stay owned
-// by the message, whose destruction closes them.
-bool escrow_into(kernel::obj::MessageBuffer& message, ktl::ref<kernel::obj::Object> object,
-                 kernel::obj::Rights rights) {
-    auto escrowed = kernel_task()->handles().insert(ktl::move(object), rights);
-    if (escrowed.is_err()) { return false; }
-    if (!message.attach_handle(escrowed.unwrap())) {
-        (void)kernel_task()->handles().close(escrowed.unwrap());
-        return false;
-    }
-    return true;
-}
-
 }  // namespace
 
 ktl::result<ktl::ref<Task>> create_user_task(const char* name, const void* elf, size_t elf_size,
@@ -105,9 +91,9 @@ ktl::result<ktl::ref<Task>> create_user_task(const char* name, const void* elf,
     task->set_owner_handle(owner.unwrap());
 
     // Everything below unwinds through here. Dropping the mailbox and clearing the table is what
-    // releases the bootstrap escrow: the child endpoint dies with the table, the parent end with
-    // the mailbox, and the pair's destruction closes the kernel-table entries the message carried
-    // -- including the reference that would otherwise pin the task itself.
+    // releases the bootstrap message: the child endpoint dies with the table, the parent end with
+    // the mailbox, and the pair's destruction drops the handles the message carried -- including
+    // the reference that would otherwise pin the task itself.
     auto fail_wired = [&](ktl::errc error) -> ktl::result<ktl::ref<Task>> {
         task->set_mailbox({});
         task->handles().clear();
@@ -137,15 +123,15 @@ ktl::result<ktl::ref<Task>> create_user_task(const char* name, const void* elf,
 
     // The bootstrap message is queued while the thread cannot yet run, so the payload can never
     // observe missing self-handles -- the ordering the old slots-0-and-1 scheme kept safe by
-    // holding interrupts off across spawn. The handles ride as owned escrow entries; the cycle
+    // holding interrupts off across spawn. The handles ride as references the message owns; the cycle
     // (task table -> endpoint -> queued message -> task) is broken by teardown_user_task, which
     // clears the table and drops the mailbox explicitly rather than waiting on refcounts.
     auto message = MessageBuffer::create(0);
     bool endowed = message.is_ok();
     if (endowed) {
         auto boot = message.unwrap();
-        endowed =
-            escrow_into(boot, task, RIGHT_READ | RIGHT_WRITE) && escrow_into(boot, thread, RIGHT_READ | RIGHT_WAIT);
+        endowed   = boot.attach_handle({task, RIGHT_READ | RIGHT_WRITE}) &&
+                  boot.attach_handle({thread, RIGHT_READ | RIGHT_WAIT});
         if (endowed) { endowed = pair.first->write(ktl::move(boot)).is_ok(); }
     }
     if (!endowed) {
@@ -282,8 +268,8 @@ ktl::result<void> endow_boot_modules(const ktl::ref<Task>& task) {
         __builtin_memcpy(mail.data() + sizeof(header), &payload, sizeof(payload));
         __builtin_memcpy(mail.data() + sizeof(header) + sizeof(payload), module.role, name_len);
 
-        if (!escrow_into(mail, image, RIGHT_READ)) {
-            g_log.warn("task: module '{0}' not endowed: escrow failed", module.role);
+        if (!mail.attach_handle({image, RIGHT_READ})) {
+            g_log.warn("task: module '{0}' not endowed: no handle slot", module.role);
             if (outcome.is_ok()) { outcome = ktl::err(ktl::errc::oom); }
             continue;
         }
@@ -351,7 +337,7 @@ ktl::result<void> task_kill(const ktl::ref<Task>& task) {
 void teardown_user_task(ktl::ref<Task> task) {
     task->handles().clear();
     // Dropping the parent's end after the table means both endpoints are now gone, which frees
-    // the pair's state and closes any handles still escrowed on its queues -- an undrained
+    // the pair's state and closes any handles still carried on its queues -- an undrained
     // bootstrap message is what releases the task's self-reference here.
     task->set_mailbox({});
     auto* aspace = task->aspace();
@@ -176,14 +176,14 @@ uint32_t Object::wait_signals_deadline(uint32_t mask, ktime_t deadline) {
     Ctx ctx{this, mask, deadline};
     uint32_t cur = signals();
     while ((cur & mask) == 0 && kernel::time::now() < deadline && !kernel::sched::current()->killed()) {
-        // The node lives in this frame and the registry entry points at it; register before
-        // parking so the expiry scan can find the node, and unregister after every wake before
-        // the next iteration reuses the frame. The predicate re-checks the deadline under the
-        // queue lock: if the expiry scan already ran past a not-yet-parked node (claim finds no
-        // thread and leaves the entry), the predicate refuses the park instead of sleeping
-        // forever on a deadline nobody watches anymore.
+        // The node and its timer live in this frame; register before parking so expiry can find
+        // the node, and unregister after every wake before the next iteration reuses the frame.
+        // The predicate re-checks the deadline under the queue lock: if the timer already fired
+        // at a not-yet-parked node (claim finds no thread and the timer is spent), the predicate
+        // refuses the park instead of sleeping forever on a deadline nobody watches anymore.
         kernel::sched::wait_node node;
-        kernel::sched::timed_wait_register(&m_waiters, &node, deadline);
+        kernel::sched::timed_wait wait;
+        kernel::sched::timed_wait_register(wait, &m_waiters, &node, deadline);
         m_waiters.block_if(
             node, mask,
             [](void* p) {
@@ -191,7 +191,7 @@ uint32_t Object::wait_signals_deadline(uint32_t mask, ktime_t deadline) {
                 return (c->obj->signals() & c->mask) == 0 && kernel::time::now() < c->deadline;
             },
             &ctx);
-        kernel::sched::timed_wait_unregister(&node);
+        kernel::sched::timed_wait_unregister(wait);
         cur = signals();
     }
     return cur;
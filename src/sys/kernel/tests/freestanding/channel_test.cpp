@@ -0,0 +1,319 @@
+#include <kernel/arch.h>
+#include <kernel/obj/channel.h>
+#include <kernel/platform.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/sched/thread.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+#include <kernel/time.h>
+
+#include <ktl/atomic>
+
+using namespace kernel::obj;
+
+KTEST_MODULE("kernel/channel");
+
+namespace {
+
+constexpr size_t ROUNDS = 2000;
+
+// Mean cost in nanoseconds of the kernel half of one send/recv round trip at `size` bytes: stage
+// the payload (create + fill, as sys_channel_send does from the IPC buffer), queue it, dequeue it,
+// and let it die, as sys_channel_recv does once the payload is copied out.
+uint64_t round_trip_ns(Channel::Pair& pair, size_t size) {
+    uint64_t start = kernel::arch::timestamp();
+    for (size_t i = 0; i < ROUNDS; i++) {
+        auto created = MessageBuffer::create(size);
+        if (created.is_err()) { return 0; }
+        auto msg = created.unwrap();
+        for (size_t b = 0; b < size; b++) { msg.data()[b] = static_cast<uint8_t>(b); }
+        if (pair.first->write(ktl::move(msg)).is_err()) { return 0; }
+        if (pair.second->read(Channel::MAX_MESSAGE_BYTES).is_err()) { return 0; }
+    }
+    uint64_t cycles = kernel::arch::timestamp() - start;
+    uint64_t hz     = kernel::platform::timestamp_hz();
+    return hz == 0 ? 0 : cycles * 1'000'000'000ull / hz / ROUNDS;
+}
+
+// One 8-byte word as a message; an invalid (empty) buffer if allocation fails.
+MessageBuffer word(uint64_t value) {
+    auto created = MessageBuffer::create(sizeof(value));
+    if (created.is_err()) { return MessageBuffer(); }
+    auto msg = created.unwrap();
+    __builtin_memcpy(msg.data(), &value, sizeof(value));
+    return msg;
+}
+
+uint64_t value_of(const MessageBuffer& msg) {
+    uint64_t value = 0;
+    if (msg.size() == sizeof(value)) { __builtin_memcpy(&value, msg.data(), sizeof(value)); }
+    return value;
+}
+
+// Mean nanoseconds per request/reply round trip between a client pinned to `client_core` and a
+// server pinned to `server_core`, both kernel threads. `direct` runs Channel::call against
+// Channel::reply_and_wait; otherwise each side composes the non-blocking operations -- write, wait
+// for READABLE, read -- as a user program does with send, object wait and recv. 0 on any failure.
+uint64_t rpc_ns(bool direct, uint32_t client_core, uint32_t server_core) {
+    auto created = Channel::create();
+    if (created.is_err()) { return 0; }
+    auto pair      = created.unwrap();
+    bool served    = true;
+    bool answered  = true;
+    uint64_t start = 0;
+    uint64_t end   = 0;
+
+    auto server = [&] {
+        Channel& endpoint = *pair.second;
+        if (direct) {
+            served = endpoint.wait_and_read(Channel::MAX_MESSAGE_BYTES, 0, 0).is_ok();
+            for (size_t i = 1; served && i < ROUNDS; i++) {
+                served = endpoint.reply_and_wait(word(i), Channel::MAX_MESSAGE_BYTES, 0, 0).is_ok();
+            }
+            served = served && endpoint.write(word(ROUNDS)).is_ok();
+            return;
+        }
+        for (size_t i = 1; served && i <= ROUNDS; i++) {
+            endpoint.wait_signals(Channel::SIGNAL_READABLE);
+            served = endpoint.read(Channel::MAX_MESSAGE_BYTES).is_ok() && endpoint.write(word(i)).is_ok();
+        }
+    };
+    auto client = [&] {
+        Channel& endpoint = *pair.first;
+        start             = kernel::arch::timestamp();
+        for (size_t i = 1; answered && i <= ROUNDS; i++) {
+            if (direct) {
+                auto reply = endpoint.call(word(i), Channel::MAX_MESSAGE_BYTES, 0, 0);
+                answered   = reply.is_ok() && value_of(reply.unwrap()) == i;
+                continue;
+            }
+            answered = endpoint.write(word(i)).is_ok();
+            endpoint.wait_signals(Channel::SIGNAL_READABLE);
+            auto reply = endpoint.read(Channel::MAX_MESSAGE_BYTES);
+            answered   = answered && reply.is_ok() && value_of(reply.unwrap()) == i;
+        }
+        end = kernel::arch::timestamp();
+    };
+
+    auto serving = kernel::testing::spawn_fn_on("rpc-server", server, server_core);
+    if (serving.is_err()) { return 0; }
+    auto calling = kernel::testing::spawn_fn_on("rpc-client", client, client_core);
+    if (calling.is_err()) {
+        // The server is parked on the channel; closing the client end wakes it with peer_closed.
+        pair.first = ktl::ref<Channel>();
+        serving.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+        return 0;
+    }
+    calling.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+    serving.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+
+    uint64_t hz = kernel::platform::timestamp_hz();
+    if (!served || !answered || hz == 0) { return 0; }
+    return (end - start) * 1'000'000'000ull / hz / ROUNDS;
+}
+
+constexpr size_t STREAM_MESSAGES = 20000;
+
+struct stream_result {
+    uint64_t messages_per_sec = 0;
+    uint64_t wakeups          = 0;  // waits that found their signal clear, both sides together
+};
+
+// One producer streaming STREAM_MESSAGES 8-byte messages to one consumer over a pair of `depth`,
+// pinned to `producer_core` and `consumer_core`. Each side composes the non-blocking operations as
+// a user program does: the producer writes until the queue refuses and then waits on WRITABLE, the
+// consumer reads until it is empty and then waits on READABLE. All zero on failure.
+stream_result stream(size_t depth, uint32_t producer_core, uint32_t consumer_core) {
+    auto created = Channel::create(depth);
+    if (created.is_err()) { return {}; }
+    auto pair                     = created.unwrap();
+    ktl::atomic<uint64_t> wakeups = 0;
+    bool sent                     = true;
+    bool received                 = true;
+    uint64_t start                = 0;
+    uint64_t end                  = 0;
+
+    auto producer = [&] {
+        Channel& endpoint = *pair.first;
+        start             = kernel::arch::timestamp();
+        for (size_t i = 0; sent && i < STREAM_MESSAGES;) {
+            auto wrote = endpoint.write(word(i));
+            if (wrote.is_ok()) {
+                i++;
+                continue;
+            }
+            sent = wrote.unwrap_err() == ktl::errc::capacity_exhausted;
+            if ((endpoint.signals() & Channel::SIGNAL_WRITABLE) == 0) { wakeups.fetch_add(1); }
+            endpoint.wait_signals(Channel::SIGNAL_WRITABLE | Channel::SIGNAL_PEER_CLOSED);
+        }
+    };
+    auto consumer = [&] {
+        Channel& endpoint = *pair.second;
+        for (size_t i = 0; received && i < STREAM_MESSAGES;) {
+            auto read = endpoint.read(Channel::MAX_MESSAGE_BYTES);
+            if (read.is_ok()) {
+                received = value_of(read.unwrap()) == i++;
+                continue;
+            }
+            received = read.unwrap_err() == ktl::errc::would_block;
+            if ((endpoint.signals() & Channel::SIGNAL_READABLE) == 0) { wakeups.fetch_add(1); }
+            endpoint.wait_signals(Channel::SIGNAL_READABLE | Channel::SIGNAL_PEER_CLOSED);
+        }
+        end = kernel::arch::timestamp();
+    };
+
+    auto consuming = kernel::testing::spawn_fn_on("stream-consumer", consumer, consumer_core);
+    if (consuming.is_err()) { return {}; }
+    auto producing = kernel::testing::spawn_fn_on("stream-producer", producer, producer_core);
+    if (producing.is_err()) {
+        // The consumer is parked on the channel; closing the producer end wakes it with peer_closed.
+        pair.first = ktl::ref<Channel>();
+        consuming.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+        return {};
+    }
+    producing.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+    consuming.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+
+    uint64_t hz = kernel::platform::timestamp_hz();
+    if (!sent || !received || hz == 0 || end <= start) { return {}; }
+    return {STREAM_MESSAGES * hz / (end - start), wakeups.load()};
+}
+
+}  // namespace
+
+// A call returns the server's reply to that request, round after round, with the server answering
+// through reply_and_wait.
+KTEST_CASE(channel_call_gets_reply) {
+    KTEST_UNWRAP(pair, Channel::create());
+    constexpr uint64_t CALLS = 16;
+    bool served              = true;
+    auto server              = [&] {
+        auto request = pair.second->wait_and_read(Channel::MAX_MESSAGE_BYTES, 0, 0);
+        for (uint64_t i = 0; served && i < CALLS; i++) {
+            served = request.is_ok();
+            if (!served) { return; }
+            uint64_t answer = value_of(request.unwrap()) * 2;
+            if (i + 1 == CALLS) {
+                served = pair.second->write(word(answer)).is_ok();
+                return;
+            }
+            request = pair.second->reply_and_wait(word(answer), Channel::MAX_MESSAGE_BYTES, 0, 0);
+        }
+    };
+    KTEST_UNWRAP(thread, kernel::testing::spawn_fn("call-server", server));
+    for (uint64_t i = 1; i <= CALLS; i++) {
+        KTEST_UNWRAP(reply, pair.first->call(word(i), Channel::MAX_MESSAGE_BYTES, 0, 0));
+        KTEST_EXPECT_EQUAL(value_of(reply), i * 2);
+    }
+    thread->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(served);
+}
+
+// A call fails without blocking when nothing can answer, and refuses to start while a message
+// already queued on the endpoint would be taken for its reply.
+KTEST_CASE(channel_call_errors) {
+    KTEST_UNWRAP(pair, Channel::create());
+    KTEST_REQUIRE_TRUE(pair.second->write(word(1)).is_ok());
+    auto stale = pair.first->call(word(2), Channel::MAX_MESSAGE_BYTES, 0, 0);
+    KTEST_REQUIRE_TRUE(stale.is_err());
+    KTEST_EXPECT_EQUAL(stale.unwrap_err(), ktl::errc::invalid_operation);
+    KTEST_EXPECT_EQUAL(pair.second->signals() & Channel::SIGNAL_READABLE, 0u);
+
+    pair.second = ktl::ref<Channel>();
+    KTEST_REQUIRE_TRUE(pair.first->read(Channel::MAX_MESSAGE_BYTES).is_ok());
+    auto closed = pair.first->call(word(3), Channel::MAX_MESSAGE_BYTES, 0, 0);
+    KTEST_REQUIRE_TRUE(closed.is_err());
+    KTEST_EXPECT_EQUAL(closed.unwrap_err(), ktl::errc::peer_closed);
+}
+
+// With no server, a bounded call sends its request and then times out; the request stays queued.
+KTEST_CASE(channel_call_times_out) {
+    KTEST_UNWRAP(pair, Channel::create());
+    ktime_t before = kernel::time::now();
+    auto reply     = pair.first->call(word(7), Channel::MAX_MESSAGE_BYTES, 0, before + 3);
+    KTEST_REQUIRE_TRUE(reply.is_err());
+    KTEST_EXPECT_EQUAL(reply.unwrap_err(), ktl::errc::timed_out);
+    KTEST_EXPECT_TRUE(kernel::time::now() - before >= 3);
+    KTEST_UNWRAP(request, pair.second->read(Channel::MAX_MESSAGE_BYTES));
+    KTEST_EXPECT_EQUAL(value_of(request), 7u);
+}
+
+// Benchmark: request/reply round trips composed from the non-blocking operations against call and
+// reply_and_wait, with client and server pinned to one core and then to two. On one core the
+// direct handoff replaces a run-queue round trip per direction, and the handoff counter must move.
+// Across cores neither side may run on the other's core, so the wake is an ordinary queued one and
+// only the saved operations show.
+KTEST_CASE(channel_call_vs_send_wait_recv) {
+    uint32_t here  = static_cast<uint32_t>(kernel::arch::current_core_index());
+    uint32_t other = here;
+    auto snapshot  = kernel::sched::stats_snapshot();
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        if (i != here && snapshot.cores[i].online) {
+            other = i;
+            break;
+        }
+    }
+
+    uint64_t handoffs = snapshot.handoffs;
+    uint64_t four_op  = rpc_ns(false, here, here);
+    uint64_t call     = rpc_ns(true, here, here);
+    KTEST_EXPECT_TRUE(four_op > 0 && call > 0);
+    KTEST_EXPECT_TRUE(kernel::sched::stats_snapshot().handoffs > handoffs);
+    KTEST_METRIC("rpc_send_wait_recv_same_core_ns", four_op);
+    KTEST_METRIC("rpc_call_same_core_ns", call);
+
+    if (other == here) { return; }
+    four_op = rpc_ns(false, here, other);
+    call    = rpc_ns(true, here, other);
+    KTEST_EXPECT_TRUE(four_op > 0 && call > 0);
+    KTEST_METRIC("rpc_send_wait_recv_cross_core_ns", four_op);
+    KTEST_METRIC("rpc_call_cross_core_ns", call);
+}
+
+// Benchmark: channel round-trip latency across payload sizes. Payloads up to 1 KiB take a slot
+// from a size-class arena; larger ones still take a zeroed PMM page. Reported rather than
+// bounded -- the numbers track a regression, the emulator's timing is too noisy to gate on.
+KTEST_CASE(channel_round_trip_latency_by_size) {
+    const size_t sizes[]      = {16, 64, 256, 1024, 4096};
+    const char* const names[] = {"round_trip_ns_16", "round_trip_ns_64", "round_trip_ns_256", "round_trip_ns_1024",
+                                 "round_trip_ns_4096"};
+    KTEST_UNWRAP(pair, Channel::create());
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint64_t ns = round_trip_ns(pair, sizes[s]);
+        KTEST_EXPECT_TRUE(ns > 0);
+        KTEST_METRIC(names[s], ns);
+    }
+}
+
+// Benchmark: one-way producer/consumer streaming across queue depths, producer and consumer on
+// different cores where there are two. Reports messages per second and wakeups per thousand
+// messages: a deeper queue absorbs longer bursts, and WRITABLE's half-drain hysteresis lets a
+// stalled producer sleep through a batch of reads instead of waking for every freed slot.
+KTEST_CASE(channel_stream_throughput_by_depth) {
+    uint32_t here  = static_cast<uint32_t>(kernel::arch::current_core_index());
+    uint32_t other = here;
+    auto snapshot  = kernel::sched::stats_snapshot();
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) {
+        if (i != here && snapshot.cores[i].online) {
+            other = i;
+            break;
+        }
+    }
+
+    struct depth_case {
+        size_t depth;
+        const char* rate_key;
+        const char* wakeups_key;
+    };
+    const depth_case cases[] = {
+        {Channel::QUEUE_DEPTH, "messages_per_sec_depth_8", "wakeups_per_kmsg_depth_8"},
+        {64, "messages_per_sec_depth_64", "wakeups_per_kmsg_depth_64"},
+        {Channel::MAX_QUEUE_DEPTH, "messages_per_sec_depth_256", "wakeups_per_kmsg_depth_256"},
+    };
+    for (const auto& c : cases) {
+        stream_result result = stream(c.depth, here, other);
+        KTEST_EXPECT_TRUE(result.messages_per_sec > 0);
+        KTEST_METRIC(c.rate_key, result.messages_per_sec);
+        KTEST_METRIC(c.wakeups_key, result.wakeups * 1000 / STREAM_MESSAGES);
+    }
+}
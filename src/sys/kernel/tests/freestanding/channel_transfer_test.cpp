@@ -0,0 +1,161 @@
+#include <kernel/arch.h>
+#include <kernel/mm/vm_aspace.h>
+#include <kernel/obj/channel.h>
+#include <kernel/platform.h>
+#include <kernel/sched/ipc_buffer.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/sched/task.h>
+#include <kernel/syscall.h>
+#include <kernel/testing/test_objects.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::obj;
+using namespace kernel::sched;
+
+namespace sys = kernel::syscall;
+
+KTEST_MODULE("kernel/channel_transfer");
+
+namespace {
+
+constexpr size_t MAX_LANES  = 8;
+constexpr size_t CHANNELS   = 2;  // per lane
+constexpr size_t CARGO      = MessageBuffer::MAX_HANDLES;
+constexpr size_t ROUNDS     = 2000;  // sends per channel
+constexpr uint64_t MSG_AT   = 0;
+constexpr uint64_t MSG_SIZE = 16;
+constexpr uint64_t CARGO_AT = 256;  // one CARGO-handle array per channel
+
+static_assert(CARGO == 8, "the benchmark reports handle-passing at eight handles per message");
+
+// One lane per core: a bare task of its own, so no two lanes share a handle table, with CHANNELS
+// pairs in that table and CARGO handles riding each. The worker borrows an IPC buffer the way
+// submit_test's does; syscalls reach it through the physmap only.
+struct lane {
+    ktl::ref<Task> task;
+    ipc_buffer buffer;
+    ktl::atomic<bool>* go      = nullptr;
+    uint64_t ends[CHANNELS][2] = {};
+    uint64_t cycles            = 0;
+    bool ok                    = true;
+};
+
+void stage(const ipc_buffer& buffer, uint64_t offset, const void* src, size_t length) {
+    size_t run = 0;
+    __builtin_memcpy(reinterpret_cast<void*>(buffer.kernel_at(offset, run)), src, length);
+}
+
+uint64_t call(uint64_t nr, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t a4) {
+    return syscall_dispatch(nr, a0, a1, a2, a3, a4, 0);
+}
+
+// Every round sends each channel's cargo through it and receives it on the other end, which
+// writes the arrived handles' new values over the array the next send reads. Each handle is taken
+// from the lane's table on send and inserted back on recv -- the whole cost of a transfer.
+void lane_worker(void* arg) {
+    auto& l = *static_cast<lane*>(arg);
+    current()->set_ipc(l.buffer);
+    const uint64_t arrived = (CARGO << 32) | MSG_SIZE;
+    while (!l.go->load(ktl::memory_order::acquire)) {}
+
+    uint64_t start = kernel::arch::timestamp();
+    for (size_t i = 0; l.ok && i < ROUNDS; i++) {
+        for (size_t c = 0; l.ok && c < CHANNELS; c++) {
+            uint64_t cargo = CARGO_AT + c * CARGO * sizeof(uint64_t);
+            l.ok = call(sys::SYS_CHANNEL_SEND, l.ends[c][0], MSG_AT, MSG_SIZE, cargo, CARGO) == 0 &&
+                   call(sys::SYS_CHANNEL_RECV, l.ends[c][1], MSG_AT, MSG_SIZE, cargo, CARGO) == arrived;
+        }
+    }
+    l.cycles = kernel::arch::timestamp() - start;
+    current()->set_ipc(ipc_buffer());
+}
+
+// Build a lane in `aspace` at IPC slot `slot`: the task, its channels, and each channel's cargo --
+// CARGO handles to one object per lane, so the lanes share no reference count either.
+bool build_lane(lane& l, kernel::mm::vm_aspace& aspace, size_t slot) {
+    l.task = ktl::make_ref<Task>();
+    if (!l.task) { return false; }
+    auto created = ipc_buffer::create(aspace, 1, slot);
+    if (created.is_err()) { return false; }
+    l.buffer    = created.unwrap();
+    auto object = ktl::make_ref<kernel::testing::TestObjA>();
+    if (!object) { return false; }
+
+    auto& table = l.task->handles();
+    for (size_t c = 0; c < CHANNELS; c++) {
+        auto pair = Channel::create();
+        if (pair.is_err()) { return false; }
+        auto first  = table.insert(pair.unwrap().first, Channel::DEFAULT_RIGHTS);
+        auto second = table.insert(pair.unwrap().second, Channel::DEFAULT_RIGHTS);
+        if (first.is_err() || second.is_err()) { return false; }
+        l.ends[c][0] = pack_handle(first.unwrap());
+        l.ends[c][1] = pack_handle(second.unwrap());
+
+        uint64_t cargo[CARGO];
+        for (auto& value : cargo) {
+            auto inserted = table.insert(object, RIGHT_READ);
+            if (inserted.is_err()) { return false; }
+            value = pack_handle(inserted.unwrap());
+        }
+        stage(l.buffer, CARGO_AT + c * sizeof(cargo), cargo, sizeof(cargo));
+    }
+    return true;
+}
+
+// Handles moved per second summed over one lane on each of the first `cores` online cores, or 0
+// on failure. A lane's task is torn down by the reaper once its worker exits, clearing its table.
+uint64_t handles_per_sec(uint32_t cores) {
+    kernel::mm::vm_aspace aspace;
+    if (!aspace.init()) { return 0; }
+    ktl::atomic<bool> go = false;
+    lane lanes[MAX_LANES];
+    ktl::ref<Thread> threads[MAX_LANES];
+    auto snapshot  = stats_snapshot();
+    uint32_t count = 0;
+    for (uint32_t core = 0; core < CONFIG_MAX_CORES && count < cores; core++) {
+        if (!snapshot.cores[core].online) { continue; }
+        lane& l = lanes[count];
+        l.go    = &go;
+        if (!build_lane(l, aspace, count)) { break; }
+        auto created = thread_create_in(l.task, "transfer-lane", lane_worker, &l);
+        if (created.is_err()) { break; }
+        auto thread = created.unwrap();
+        thread->set_pinned_core(core);
+        if (thread_enqueue(thread).is_err()) { break; }
+        threads[count++] = ktl::move(thread);
+    }
+
+    go.store(true, ktl::memory_order::release);
+    for (uint32_t i = 0; i < count; i++) { threads[i]->wait_signals(Thread::SIGNAL_TERMINATED); }
+    uint64_t hz    = kernel::platform::timestamp_hz();
+    uint64_t total = 0;
+    bool ok        = count == cores;
+    for (uint32_t i = 0; ok && i < count; i++) {
+        ok = lanes[i].ok && lanes[i].cycles != 0;
+        if (ok) { total += ROUNDS * CHANNELS * CARGO * hz / lanes[i].cycles; }
+    }
+    return ok ? total : 0;
+}
+
+}  // namespace
+
+// Benchmark: handles moved per second through SYS_CHANNEL_SEND/RECV at eight handles per message,
+// from one core and from every online core (up to MAX_LANES) at once, CHANNELS channels per core.
+// A message holds its handles' references itself, so a lane touches only its own task's table and
+// lanes share nothing but the allocators. Driven through syscall_dispatch from kernel threads, as
+// submit_test is.
+KTEST_CASE(channel_handle_transfer_throughput) {
+    kernel::testing::register_all_test_types();
+    auto snapshot  = stats_snapshot();
+    uint32_t cores = 0;
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) { cores += snapshot.cores[i].online ? 1 : 0; }
+
+    uint64_t one = handles_per_sec(1);
+    KTEST_EXPECT_TRUE(one > 0);
+    KTEST_METRIC("handles_per_sec_one_core", one);
+    if (cores < 2) { return; }
+
+    uint64_t all = handles_per_sec(cores < MAX_LANES ? cores : MAX_LANES);
+    KTEST_EXPECT_TRUE(all > 0);
+    KTEST_METRIC("handles_per_sec_all_cores", all);
+}
@@ -0,0 +1,165 @@
+#include <kernel/mm/vmo.h>
+#include <kernel/sched/futex.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/testing/contention.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+#include <kernel/time.h>
+
+extern uintptr_t g_hhdm_offset;
+
+using namespace kernel::sched;
+
+KTEST_MODULE("kernel/futex");
+
+namespace {
+
+constexpr size_t LOCKS    = 20'000;  // per thread per measurement
+constexpr size_t PATIENCE = 100'000;  // yields to wait for a waiter to show up
+
+// A word of VMO memory as the kernel reads it, through the physmap -- what a user thread's store
+// through its own mapping lands in.
+uint32_t* word_at(const ktl::ref<kernel::mm::vmo>& object, uint64_t offset) {
+    auto frame = object->get_or_fill_page(offset / KERNEL_MINIMUM_PAGE_SIZE);
+    if (frame.is_err()) { return nullptr; }
+    return reinterpret_cast<uint32_t*>(frame.unwrap() + g_hhdm_offset + offset % KERNEL_MINIMUM_PAGE_SIZE);
+}
+
+// Wake (or move) `count` waiters, retrying while they have yet to park. Returns how many it got.
+template <typename F> size_t collect(size_t count, F&& once) {
+    size_t got = 0;
+    for (size_t i = 0; got < count && i < PATIENCE; i++) {
+        got += once(count - got);
+        if (got < count) { yield(); }
+    }
+    return got;
+}
+
+struct waiter {
+    const ktl::ref<kernel::mm::vmo>* object;
+    uint64_t offset;
+    bool ok = false;
+
+    void operator()() { ok = futex_wait(*object, offset, 0, FUTEX_NO_DEADLINE).is_ok(); }
+};
+
+// The crt's mutex (lib/crt/sync.c) with the syscalls swapped for the kernel calls under them,
+// counting those calls: 0 unlocked, 1 locked, 2 locked with sleepers possible.
+struct futex_mutex {
+    const ktl::ref<kernel::mm::vmo>* object;
+    uint64_t offset;
+    uint32_t* state;
+
+    void lock(uint64_t& calls) {
+        uint32_t expected = 0;
+        if (__atomic_compare_exchange_n(state, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) { return; }
+        while (__atomic_exchange_n(state, 2, __ATOMIC_ACQUIRE) != 0) {
+            (void)futex_wait(*object, offset, 2, FUTEX_NO_DEADLINE);
+            calls++;
+        }
+    }
+    void unlock(uint64_t& calls) {
+        if (__atomic_exchange_n(state, 0, __ATOMIC_RELEASE) == 2) {
+            (void)futex_wake(*object, offset, 1);
+            calls++;
+        }
+    }
+};
+
+// `threads` contenders taking the mutex LOCKS times each, tallying their futex calls. Fails (all
+// zero) if the guarded counter comes out short.
+kernel::testing::contention_result contend(const ktl::ref<kernel::mm::vmo>& object, size_t threads) {
+    futex_mutex mutex{&object, 0, word_at(object, 0)};
+    uint64_t* counter = reinterpret_cast<uint64_t*>(word_at(object, 64));  // guarded by mutex
+    *mutex.state      = 0;
+    *counter          = 0;
+    auto body         = [&](uint64_t& calls) {
+        mutex.lock(calls);
+        *counter += 1;
+        mutex.unlock(calls);
+    };
+    auto run = kernel::testing::contend("futex-contender", threads, LOCKS, body);
+    if (*counter != threads * LOCKS) { return {}; }
+    return run;
+}
+
+}  // namespace
+
+KTEST_CASE(futex_wait_checks_and_timeouts) {
+    auto object = kernel::mm::create_anonymous_vmo(1);
+    KTEST_REQUIRE_TRUE(object);
+    uint32_t* word = word_at(object, 0);
+    KTEST_REQUIRE_TRUE(word != nullptr);
+    *word = 7;
+
+    auto mismatch = futex_wait(object, 0, 6, FUTEX_NO_DEADLINE);
+    KTEST_EXPECT_TRUE(mismatch.is_err() && mismatch.unwrap_err() == ktl::errc::would_block);
+    auto unaligned = futex_wait(object, 2, 7, FUTEX_NO_DEADLINE);
+    KTEST_EXPECT_TRUE(unaligned.is_err() && unaligned.unwrap_err() == ktl::errc::invalid_operation);
+    auto outside = futex_wait(object, KERNEL_MINIMUM_PAGE_SIZE, 7, FUTEX_NO_DEADLINE);
+    KTEST_EXPECT_TRUE(outside.is_err() && outside.unwrap_err() == ktl::errc::out_of_range);
+
+    auto lapsed = futex_wait(object, 0, 7, kernel::time::now() + 2);
+    KTEST_EXPECT_TRUE(lapsed.is_err() && lapsed.unwrap_err() == ktl::errc::timed_out);
+    KTEST_EXPECT_EQUAL(futex_wake(object, 0, 1), 0u);
+
+    auto refused = futex_requeue(object, 0, 6, 1, object, 4, 1);
+    KTEST_EXPECT_TRUE(refused.is_err() && refused.unwrap_err() == ktl::errc::would_block);
+}
+
+// Two sleepers on one word: a requeue moves both to another word unwoken, after which the first
+// word has nobody to wake and the second has both.
+KTEST_CASE(futex_wake_and_requeue) {
+    auto object = kernel::mm::create_anonymous_vmo(1);
+    KTEST_REQUIRE_TRUE(object);
+    uint32_t* word = word_at(object, 0);
+    KTEST_REQUIRE_TRUE(word != nullptr);
+    *word = 0;
+
+    waiter single{&object, 0};
+    auto first = kernel::testing::spawn_fn("futex-waiter", single);
+    KTEST_REQUIRE_TRUE(first.is_ok());
+    KTEST_EXPECT_EQUAL(collect(1, [&](size_t n) { return futex_wake(object, 0, n); }), 1u);
+    first.unwrap()->wait_signals(Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(single.ok);
+
+    waiter pair[2] = {{&object, 0}, {&object, 0}};
+    auto a         = kernel::testing::spawn_fn("futex-waiter", pair[0]);
+    auto b         = kernel::testing::spawn_fn("futex-waiter", pair[1]);
+    KTEST_REQUIRE_TRUE(a.is_ok() && b.is_ok());
+    size_t moved = collect(2, [&](size_t n) {
+        auto requeued = futex_requeue(object, 0, 0, 0, object, 512, n);
+        return requeued.is_ok() ? requeued.unwrap() : 0;
+    });
+    KTEST_EXPECT_EQUAL(moved, 2u);
+    KTEST_EXPECT_EQUAL(futex_wake(object, 0, 2), 0u);
+    KTEST_EXPECT_EQUAL(futex_wake(object, 512, 2), 2u);
+    a.unwrap()->wait_signals(Thread::SIGNAL_TERMINATED);
+    b.unwrap()->wait_signals(Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(pair[0].ok && pair[1].ok);
+}
+
+// Benchmark: a futex mutex guarding a counter in VMO memory, taken LOCKS times by each of 1, 2,
+// 4 and 8 kernel threads spread over the online cores. Reports aggregate lock/unlock pairs per
+// second and the futex calls -- sleeps plus wakes -- per thousand of them: zero uncontended, and
+// the rest is what contention costs in kernel entries. The kernel calls stand in for the syscalls,
+// whose address resolution is a region-tree lookup on top.
+KTEST_CASE(futex_mutex_contention) {
+    auto object = kernel::mm::create_anonymous_vmo(1);
+    KTEST_REQUIRE_TRUE(object);
+
+    using kernel::testing::CONTENTION_CASE_COUNT;
+    const char* const calls_keys[CONTENTION_CASE_COUNT] = {
+        "futex_calls_per_klock_threads_1",
+        "futex_calls_per_klock_threads_2",
+        "futex_calls_per_klock_threads_4",
+        "futex_calls_per_klock_threads_8",
+    };
+    for (size_t i = 0; i < CONTENTION_CASE_COUNT; i++) {
+        const auto& c = kernel::testing::CONTENTION_CASES[i];
+        auto result   = contend(object, c.threads);
+        KTEST_EXPECT_TRUE(result.ops_per_sec > 0);
+        KTEST_METRIC(c.rate_key, result.ops_per_sec);
+        KTEST_METRIC(calls_keys[i], result.tally * 1000 / (c.threads * LOCKS));
+    }
+}
@@ -0,0 +1,193 @@
+#include <kernel/arch.h>
+#include <kernel/platform.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/test_objects.h>
+#include <kernel/testing/testing.h>
+#include <std/new.h>
+
+using namespace kernel::obj;
+
+KTEST_MODULE("kernel/handle_table");
+
+namespace {
+
+constexpr size_t HANDLES  = 64;
+constexpr size_t VERIFIES = 200'000;  // per reader thread
+
+// The open/close run keeps at most LIVE handles open at once: a million live entries would not fit
+// the smaller guests' memory, and past the first fill every open recycles a slot anyway.
+constexpr size_t OPENS = 1'000'000;
+constexpr size_t LIVE  = 131'072;
+
+struct bench {
+    HandleTable table;
+    HandleId ids[HANDLES];
+    ktl::atomic<bool> go          = false;
+    ktl::atomic<uint32_t> running = 0;
+    ktl::atomic<uint64_t> rate    = 0;  // sum of the readers' own verifies per second
+    ktl::atomic<bool> ok          = true;
+};
+
+// Each reader walks the shared ids from its own offset, so the readers hit the same entries and
+// the same objects' reference counts at once -- the sharing a server's worker threads would see.
+struct reader {
+    bench* b;
+    size_t offset;
+
+    void operator()() {
+        while (!b->go.load(ktl::memory_order::acquire)) {}
+        bool ok        = true;
+        uint64_t start = kernel::arch::timestamp();
+        for (size_t i = 0; ok && i < VERIFIES; i++) {
+            ok = b->table.verify(b->ids[(offset + i) % HANDLES], RIGHT_READ, kernel::testing::TEST_TYPE_A).is_ok();
+        }
+        uint64_t cycles = kernel::arch::timestamp() - start;
+        uint64_t hz     = kernel::platform::timestamp_hz();
+        if (!ok) { b->ok.store(false); }
+        if (cycles != 0) { b->rate.fetch_add(VERIFIES * hz / cycles, ktl::memory_order::relaxed); }
+        b->running.fetch_sub(1, ktl::memory_order::release);
+    }
+};
+
+// One reader pinned to each of the first `cores` online cores. With `churn`, this thread closes
+// and reopens a handle outside the readers' set until they finish, so every round also waits out
+// the readers' sections. Returns the readers' aggregate verifies per second, or 0 on failure.
+uint64_t verifies_per_sec(bench& b, uint32_t cores, bool churn) {
+    reader readers[CONFIG_MAX_CORES];
+    ktl::ref<kernel::sched::Thread> threads[CONFIG_MAX_CORES];
+    auto snapshot  = kernel::sched::stats_snapshot();
+    uint32_t count = 0;
+    b.go.store(false);
+    b.rate.store(0);
+    for (uint32_t core = 0; core < CONFIG_MAX_CORES && count < cores; core++) {
+        if (!snapshot.cores[core].online) { continue; }
+        readers[count] = reader{&b, count * (HANDLES / 4)};
+        b.running.fetch_add(1);
+        auto spawned = kernel::testing::spawn_fn_on("verify-reader", readers[count], core);
+        if (spawned.is_err()) {
+            b.running.fetch_sub(1);
+            b.ok.store(false);
+            break;
+        }
+        threads[count++] = spawned.unwrap();
+    }
+
+    b.go.store(true, ktl::memory_order::release);
+    while (churn && b.running.load(ktl::memory_order::acquire) != 0) {
+        auto spare = b.table.emplace<kernel::testing::TestObjA>(RIGHT_READ);
+        if (spare.is_err() || b.table.close(spare.unwrap()).is_err()) { b.ok.store(false); }
+    }
+    for (uint32_t i = 0; i < count; i++) { threads[i]->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED); }
+    return b.ok.load() && count == cores ? b.rate.load() : 0;
+}
+
+// Latency histogram with eight linear buckets per power of two, so a percentile read back from it is
+// within an eighth of the true value.
+struct histogram {
+    static constexpr uint32_t SUB = 8;
+    uint64_t buckets[64 * SUB] = {};
+    uint64_t total             = 0;
+    uint64_t max               = 0;
+
+    static size_t bucket_of(uint64_t value) {
+        if (value < SUB) { return value; }
+        uint32_t shift = 63 - __builtin_clzll(value) - 3;
+        return (shift + 1) * SUB + ((value >> shift) - SUB);
+    }
+    static uint64_t upper_bound(size_t bucket) {
+        if (bucket < SUB) { return bucket; }
+        uint32_t shift = bucket / SUB - 1;
+        return ((bucket % SUB + SUB + 1) << shift) - 1;
+    }
+
+    void record(uint64_t value) {
+        buckets[bucket_of(value)]++;
+        total++;
+        if (value > max) { max = value; }
+    }
+    uint64_t percentile(uint32_t pct) const {
+        uint64_t rank = (total * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < 64 * SUB; i++) {
+            seen += buckets[i];
+            if (seen >= rank && seen != 0) { return upper_bound(i) < max ? upper_bound(i) : max; }
+        }
+        return max;
+    }
+};
+
+uint64_t cycles_to_ns(uint64_t cycles) {
+    uint64_t hz = kernel::platform::timestamp_hz();
+    return hz == 0 ? 0 : cycles * 1'000'000'000 / hz;
+}
+
+}  // namespace
+
+// Benchmark: a million handle opens against one table, closing the oldest once LIVE are open.
+// The fill pays every chunk allocation and directory doubling; the churn after it recycles slots
+// from the free list. Reports the p99 and worst insert latency over all of them.
+KTEST_CASE(handle_table_open_close_million) {
+    kernel::testing::register_all_test_types();
+    auto object = ktl::make_ref<kernel::testing::TestObjA>();
+    KTEST_REQUIRE_TRUE(object);
+    auto* open = new (std::nothrow) HandleId[LIVE];
+    auto* hist = new (std::nothrow) histogram;
+    KTEST_REQUIRE_TRUE(open != nullptr && hist != nullptr);
+
+    {
+        HandleTable table;
+        bool ok = true;
+        for (size_t i = 0; ok && i < OPENS; i++) {
+            HandleId& slot = open[i % LIVE];
+            if (i >= LIVE) { ok = table.close(slot).is_ok(); }
+            uint64_t start = kernel::arch::timestamp();
+            auto created   = table.insert(object, RIGHT_READ);
+            hist->record(kernel::arch::timestamp() - start);
+            ok = ok && created.is_ok();
+            if (ok) { slot = created.unwrap(); }
+        }
+        KTEST_EXPECT_TRUE(ok);
+        KTEST_EXPECT_EQUAL(table.count(), LIVE);
+        for (size_t i = 0; ok && i < LIVE; i++) { ok = table.close(open[i]).is_ok(); }
+        KTEST_EXPECT_TRUE(ok);
+        KTEST_EXPECT_EQUAL(table.count(), 0u);
+    }
+
+    KTEST_METRIC("create_p99_ns", cycles_to_ns(hist->percentile(99)));
+    KTEST_METRIC("create_max_ns", cycles_to_ns(hist->max));
+    delete hist;
+    delete[] open;
+}
+
+// Benchmark: verify() throughput from one core, from every online core, and from every core while
+// another thread mutates the same table. verify takes no lock, so readers share nothing but the
+// table's reader counters and the objects' reference counts; the mutating run adds the writers'
+// grace-period waits.
+KTEST_CASE(handle_table_verify_throughput) {
+    kernel::testing::register_all_test_types();
+    bench b;
+    for (auto& id : b.ids) {
+        auto created = b.table.emplace<kernel::testing::TestObjA>(RIGHT_READ);
+        KTEST_REQUIRE_TRUE(created.is_ok());
+        id = created.unwrap();
+    }
+
+    auto snapshot  = kernel::sched::stats_snapshot();
+    uint32_t cores = 0;
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) { cores += snapshot.cores[i].online ? 1 : 0; }
+
+    uint64_t one = verifies_per_sec(b, 1, false);
+    KTEST_EXPECT_TRUE(one > 0);
+    KTEST_METRIC("verify_per_sec_one_core", one);
+    if (cores < 2) { return; }
+
+    uint64_t all = verifies_per_sec(b, cores, false);
+    KTEST_EXPECT_TRUE(all > 0);
+    KTEST_METRIC("verify_per_sec_all_cores", all);
+
+    uint64_t churned = verifies_per_sec(b, cores, true);
+    KTEST_EXPECT_TRUE(churned > 0);
+    KTEST_METRIC("verify_per_sec_all_cores_churn", churned);
+    KTEST_EXPECT_EQUAL(b.table.count(), HANDLES);
+}
@@ -244,3 +244,62 @@ KTEST_CASE(paging_activate_and_touch) {
     KTEST_REQUIRE_TRUE(space.unmap_page(mid_vaddr).has_value());
     kernel::mm::g_page_frame_allocator.free(frame);
 }
+
+// Mixed leaf sizes in one space: a 4K page, a 2 MiB leaf and (where the MMU has
+// them) a 1 GiB leaf each resolve through walk_ext with the right frame, offset
+// and leaf size. A large span refuses anything that would overlap it, comes
+// down only from its base, and the physmap itself resolves through large leaves.
+KTEST_CASE(paging_mixed_size_walks) {
+    using kernel::mm::LARGE_PAGE_1G;
+    using kernel::mm::LARGE_PAGE_2M;
+    constexpr size_t RUN_PAGES = LARGE_PAGE_2M / 0x1000;
+    vm_aspace space;
+    KTEST_REQUIRE_TRUE(space.init());
+    KTEST_REQUIRE_VALUE(frame, kernel::mm::g_page_frame_allocator.alloc());
+    KTEST_REQUIRE_VALUE(run, kernel::mm::g_page_frame_allocator.alloc_contiguous(RUN_PAGES, RUN_PAGES));
+    KTEST_REQUIRE_EQUAL(run & (LARGE_PAGE_2M - 1), 0u);
+
+    KTEST_REQUIRE_TRUE(space.map_page(low_vaddr, frame, vm_prot::READ | vm_prot::WRITE));
+    KTEST_EXPECT_TRUE(space.span_empty(mid_vaddr, LARGE_PAGE_2M));
+    KTEST_REQUIRE_TRUE(space.map_large(mid_vaddr, run, LARGE_PAGE_2M, vm_prot::READ | vm_prot::WRITE));
+    KTEST_EXPECT_FALSE(space.span_empty(mid_vaddr, LARGE_PAGE_2M));
+
+    auto small = space.walk_ext(low_vaddr + 0x123);
+    auto large = space.walk_ext(mid_vaddr + 0x12345);
+    KTEST_REQUIRE_TRUE(small.has_value() && large.has_value());
+    KTEST_EXPECT_ALL(small.value().paddr == frame + 0x123, small.value().size == 0x1000u,
+                     large.value().paddr == run + 0x12345, large.value().size == LARGE_PAGE_2M,
+                     (large.value().prot & vm_prot::WRITE) != 0);
+
+    // 1 GiB: walk-only, so any aligned physical address will do.
+    if (vm_aspace::large_page_supported(LARGE_PAGE_1G)) {
+        constexpr vm_paddr_t GIANT = LARGE_PAGE_1G;
+        KTEST_REQUIRE_TRUE(space.map_large(high_vaddr, GIANT, LARGE_PAGE_1G, vm_prot::READ));
+        auto giant = space.walk_ext(high_vaddr + 0x2345678);
+        KTEST_REQUIRE_TRUE(giant.has_value());
+        KTEST_EXPECT_ALL(giant.value().paddr == GIANT + 0x2345678, giant.value().size == LARGE_PAGE_1G,
+                         (giant.value().prot & vm_prot::WRITE) == 0);
+        KTEST_EXPECT_VALUE(space.unmap_page(high_vaddr), GIANT);
+    }
+
+    // Overlaps are refused both ways: a 4K page inside the large leaf, and a
+    // large leaf over the span already holding the 4K page's table.
+    KTEST_EXPECT_FALSE(space.map_page(mid_vaddr + 0x1000, frame, vm_prot::READ));
+    KTEST_EXPECT_FALSE(space.map_large(low_vaddr & ~(LARGE_PAGE_2M - 1), run, LARGE_PAGE_2M, vm_prot::READ));
+    KTEST_EXPECT_FALSE(space.map_large(mid_vaddr + 0x1000, run, LARGE_PAGE_2M, vm_prot::READ));
+
+    KTEST_EXPECT_FALSE(space.unmap_page(mid_vaddr + 0x1000).has_value());
+    KTEST_EXPECT_VALUE(space.unmap_page(mid_vaddr), run);
+    KTEST_EXPECT_FALSE(space.walk_ext(mid_vaddr).has_value());
+    KTEST_EXPECT_VALUE(space.unmap_page(low_vaddr), frame);
+
+    // The run is ordinary RAM, so its physmap alias is a large leaf: the
+    // bootloader's, or one vmm_init collapsed.
+    auto physmap = space.walk_ext(g_hhdm_offset + run);
+    KTEST_REQUIRE_TRUE(physmap.has_value());
+    KTEST_EXPECT_EQUAL(physmap.value().paddr, run);
+    KTEST_EXPECT_TRUE(physmap.value().size >= LARGE_PAGE_2M);
+
+    kernel::mm::g_page_frame_allocator.free_contiguous(run, RUN_PAGES);
+    kernel::mm::g_page_frame_allocator.free(frame);
+}
@@ -5,6 +5,7 @@
 #include "kernel/mm/page.h"
 #include "kernel/mm/page_descriptor.h"
 #include "kernel/mm/pmm.h"
+#include "kernel/synchronization/execution_context.h"
 #include "kernel/testing/testing.h"
 
 // These tests drive the global page frame allocator, which zeroes pages through
@@ -14,7 +15,9 @@
 // needs at its own start and asserts deltas; only the story's first phase may
 // rely on anything boot-shaped. The zeroer thread runs alongside them, so no
 // phase may assume which pool a page comes from -- only end-state invariants
-// (counts, zeroed contents) are asserted.
+// (counts, zeroed contents) are asserted. Single pages pass through per-core
+// caches, so a phase that follows one page from free to reallocation holds
+// preemption off to stay on the core whose cache has it.
 
 // Set during boot from the Limine HHDM response; lets us touch a physical page
 // through its higher-half identity mapping.
@@ -82,18 +85,20 @@ KTEST_CASE(pmm_allocation_lifecycle) {
     }
 
     // Phase 4: dirty the page and free it, then allocate until it comes back.
-    // It may return via the inline alloc path or via the zeroer thread, but
-    // every page handed out along the way must be zeroed. Recycled pages sit
-    // ahead of pre-zeroed region tails in alloc order, so the bound only needs
-    // to clear the small pool of pages recycled since boot plus the handful
-    // the earlier phases cycled through.
+    // It lands on this core's hot list and returns after the cold pages ahead
+    // of it, zeroed inline; were it drained to the global pools instead, it
+    // would merge into its buddy block and single pages are split off a
+    // block's low end first, so the bound clears the recycled blocks of every
+    // order up to the one the page landed in. Every page handed out along the
+    // way must be zeroed.
     {
+        kernel::synchronization::critical_section pinned;
         KTEST_REQUIRE_VALUE(addr, pmm.alloc());
         dirty_page(addr);
         pmm.free(addr);
 
-        constexpr size_t MAX_ALLOCS = 256;
-        kernel::mm::vm_paddr_t taken[MAX_ALLOCS];
+        constexpr size_t MAX_ALLOCS = 4096;
+        static kernel::mm::vm_paddr_t taken[MAX_ALLOCS];
         size_t taken_count = 0;
         bool found         = false;
         while (taken_count < MAX_ALLOCS) {
@@ -110,6 +115,26 @@ KTEST_CASE(pmm_allocation_lifecycle) {
 
         for (size_t i = 0; i < taken_count; ++i) { pmm.free(taken[i]); }
     }
+
+    // Phase 5: alloc/free pairs on one core are served by its cache alone --
+    // a freed page is the next one handed out once the cold pages are gone,
+    // so nothing refills from the global pools.
+    {
+        kernel::synchronization::critical_section pinned;
+        KTEST_REQUIRE_VALUE(warm, pmm.alloc());
+        pmm.free(warm);
+        auto before = pmm.stats();
+        for (size_t i = 0; i < 256; ++i) {
+            KTEST_REQUIRE_VALUE(page, pmm.alloc());
+            KTEST_EXPECT_TRUE(page_is_zeroed(page));
+            dirty_page(page);
+            pmm.free(page);
+        }
+        auto after = pmm.stats();
+        KTEST_EXPECT_EQUAL(after.cache_refills, before.cache_refills);
+        KTEST_EXPECT_TRUE(after.cache_hits >= before.cache_hits + 256);
+        KTEST_EXPECT_EQUAL(after.free_pages, before.free_pages);
+    }
 }
 
 // Story: the zeroer and the statistics counters. Draining the zeroer reaches
@@ -139,23 +164,27 @@ KTEST_CASE(pmm_zeroer_and_stats) {
     // Phase 2: a dirtied, freed page drained through zero_one_page must come
     // back from the zeroed pool actually clean; alloc does not re-zero pool
     // pages, so a missed memset in zero_one_page shows up as a dirty
-    // allocation here. The page cannot be inspected while pooled -- the pools
+    // allocation here. zero_one_page starts with the running core's hot list,
+    // where the freed page sits, so the phase stays on one core. The page cannot be inspected while pooled -- the pools
     // are intrusive, so a pooled page carries the freelist link word -- which
     // is why the check happens at reallocation, where the guarantee is owed.
     // Its depth in the zeroed pool depends on what earlier activity left
-    // pooled (pool order is not a contract), so hunt for it within a bound
-    // rather than assuming the next alloc returns exactly it.
+    // pooled and how far it coalesced (pool order is not a contract), so hunt
+    // for it within a bound rather than assuming the next alloc returns
+    // exactly it.
     {
+        kernel::synchronization::critical_section pinned;
         KTEST_REQUIRE_VALUE(addr, pmm.alloc());
         dirty_page(addr);
         pmm.free(addr);
 
         while (pmm.stats().dirty != 0 && pmm.zero_one_page()) {}
 
-        uintptr_t held[64];
+        constexpr size_t MAX_HELD = 4096;
+        static uintptr_t held[MAX_HELD];
         size_t held_count = 0;
         uintptr_t again   = 0;
-        while (held_count < 64) {
+        while (held_count < MAX_HELD) {
             KTEST_REQUIRE_VALUE(page, pmm.alloc());
             if (page == addr) {
                 again = page;
@@ -186,4 +215,52 @@ KTEST_CASE(pmm_zeroer_and_stats) {
         KTEST_EXPECT_EQUAL(after.free_count, before.free_count + 1);
         KTEST_EXPECT_EQUAL(after.free_pages, before.free_pages);
     }
+
+    // Phase 3b: runs count in alloc_count by the page, as free_contiguous counts in free_count, and
+    // a flush empties this core's cache into the global pools without losing a page.
+    {
+        kernel::synchronization::critical_section pinned;
+        auto before = pmm.stats();
+        KTEST_REQUIRE_VALUE(run, pmm.alloc_contiguous(4));
+        KTEST_EXPECT_EQUAL(pmm.stats().alloc_count, before.alloc_count + 4);
+        pmm.free_contiguous(run, 4);
+
+        KTEST_REQUIRE_VALUE(page, pmm.alloc());
+        pmm.free(page);
+        size_t cached_before = pmm.stats().cached;
+        KTEST_EXPECT_TRUE(cached_before != 0);
+        pmm.flush_caches();
+        auto flushed = pmm.stats();
+        KTEST_EXPECT_ALL(flushed.cached < cached_before, flushed.free_pages == before.free_pages,
+                         flushed.free_count == before.free_count + 5);
+    }
+
+    // Phase 4: contiguous runs freed page by page coalesce. Each run is
+    // dirtied and handed back one page at a time, the way a driver or a heap
+    // returns memory; the next request must be served from the coalesced
+    // blocks rather than by carving more of the region tails, so the longest
+    // available run barely moves however many times this repeats. Single
+    // frees park in this core's hot list first and reach the buddy a batch at
+    // a time, so the slack covers what the cache holds back. Every run handed
+    // out must still be zeroed.
+    {
+        using pfa = kernel::mm::page_frame_allocator;
+        kernel::synchronization::critical_section pinned;
+        constexpr size_t RUN    = 16;
+        constexpr size_t ROUNDS = 200;
+        size_t before           = pmm.largest_free_run();
+        size_t free_before      = pmm.free_pages();
+        for (size_t round = 0; round < ROUNDS; ++round) {
+            KTEST_REQUIRE_VALUE(base, pmm.alloc_contiguous(RUN));
+            KTEST_EXPECT_ALIGNED(base, PAGE_SIZE);
+            bool zeroed = true;
+            for (size_t i = 0; i < RUN; ++i) { zeroed = zeroed && page_is_zeroed(base + i * PAGE_SIZE); }
+            KTEST_EXPECT_TRUE(zeroed);
+            for (size_t i = 0; i < RUN; ++i) { dirty_page(base + i * PAGE_SIZE); }
+            for (size_t i = RUN; i-- > 0;) { pmm.free(base + i * PAGE_SIZE); }
+        }
+        KTEST_EXPECT_EQUAL(pmm.free_pages(), free_before);
+        size_t after = pmm.largest_free_run();
+        KTEST_EXPECT_TRUE(after + 2 * pfa::CACHE_HOT_MAX + 2 * RUN >= before);
+    }
 }
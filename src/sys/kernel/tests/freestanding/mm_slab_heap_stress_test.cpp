@@ -1,6 +1,8 @@
-#include <kernel/log.h>
+#include <kernel/arch.h>
+#include <kernel/config.h>
 #include <kernel/mm/pmm.h>
 #include <kernel/mm/slab_heap.h>
+#include <kernel/platform.h>
 #include <kernel/sched/scheduler.h>
 #include <kernel/sched/thread.h>
 #include <kernel/testing/testing.h>
@@ -15,6 +17,8 @@ KTEST_MODULE("mm/slab_heap_stress");
 
 namespace {
 
+constexpr size_t OPS_PER_WORKER = 20000;
+
 struct hammer_ctx {
     uint64_t seed;
     ktl::atomic<uint32_t>* errors;
@@ -27,9 +31,9 @@ uint64_t xorshift(uint64_t& s) {
     return s;
 }
 
-// Each worker churns its own pocket of allocations with content tags, yielding often enough that
-// the timer preempts workers inside the allocator: the point is the heap spinlock and the
-// two-phase alloc under real interleaving, not throughput.
+// Each worker churns its own pocket of allocations with content tags. The timer still preempts
+// workers inside the allocator, and the occasional yield mixes them across cores, so the oracle
+// covers the magazines, the depot and the slab lock under real interleaving.
 void heap_hammer_thread(void* arg) {
     auto* ctx  = static_cast<hammer_ctx*>(arg);
     uint64_t s = ctx->seed;
@@ -41,8 +45,7 @@ void heap_hammer_thread(void* arg) {
     };
     pocket slots[24] = {};
 
-    for (size_t op = 0; op < 6000; ++op) {
-        if (op % 1000 == 0) { g_log.info("hammer {0}: op {1}", ctx->seed & 0xFF, op); }
+    for (size_t op = 0; op < OPS_PER_WORKER; ++op) {
         size_t index = xorshift(s) % 24;
         if (slots[index].ptr != nullptr) {
             auto* bytes = static_cast<uint8_t*>(slots[index].ptr);
@@ -64,7 +67,7 @@ void heap_hammer_thread(void* arg) {
             memset(p, tag, size);
             slots[index] = {p, size, tag};
         }
-        if ((op & 63) == 0) { yield(); }
+        if ((op & 1023) == 0) { yield(); }
     }
 
     for (auto& slot : slots) {
@@ -77,37 +80,67 @@ void heap_hammer_thread(void* arg) {
     }
 }
 
+struct magazine_totals {
+    uint64_t hits      = 0;
+    uint64_t misses    = 0;
+    uint64_t exchanges = 0;
+};
+
+magazine_totals magazine_totals_now() {
+    magazine_totals t;
+    for (const auto& cls : g_slab_heap.stats().classes) {
+        t.hits += cls.magazine_hits;
+        t.misses += cls.magazine_misses;
+        t.exchanges += cls.depot_exchanges;
+    }
+    return t;
+}
+
 }  // namespace
 
-// Three workers hammer the heap concurrently under timer preemption, with per-allocation content
-// tags as the corruption oracle. Afterwards the heap must be back to its idle shape and the
-// borrowed PMM pages returned.
+// Benchmark: one worker per online core (at least two) hammers the heap concurrently, with
+// per-allocation content tags as the corruption oracle. Reports whole-run heap throughput and how
+// the magazine layer served it -- hits stay on the calling core, exchanges touch the depot, misses
+// reach the slab lock. Afterwards the borrowed PMM pages must come back once the caches drain.
 KTEST_CASE(slab_heap_concurrent_hammer) {
     size_t free_before = g_page_frame_allocator.free_pages();
     ktl::atomic<uint32_t> errors{0};
 
-    hammer_ctx contexts[3] = {
-        {0x9E3779B97F4A7C15ull, &errors},
-        {0xD1B54A32D192ED03ull, &errors},
-        {0x94D049BB133111EBull, &errors},
-    };
-    ktl::ref<Thread> workers[3];
-    for (size_t i = 0; i < 3; ++i) {
+    auto snapshot  = stats_snapshot();
+    size_t workers = 0;
+    for (const auto& core : snapshot.cores) { workers += core.online ? 1 : 0; }
+    if (workers < 2) { workers = 2; }
+
+    hammer_ctx contexts[CONFIG_MAX_CORES];
+    ktl::ref<Thread> threads[CONFIG_MAX_CORES];
+    magazine_totals before = magazine_totals_now();
+    uint64_t start         = kernel::arch::timestamp();
+    for (size_t i = 0; i < workers; ++i) {
+        contexts[i] = {0x9E3779B97F4A7C15ull * (2 * i + 1), &errors};
         KTEST_UNWRAP(t, spawn("heap-hammer", heap_hammer_thread, &contexts[i]));
-        workers[i] = t;
-    }
-    for (auto& worker : workers) {
-        worker->wait_signals(Thread::SIGNAL_TERMINATED);
-        g_log.info("hammer: worker joined");
+        threads[i] = t;
     }
+    for (size_t i = 0; i < workers; ++i) { threads[i]->wait_signals(Thread::SIGNAL_TERMINATED); }
+    uint64_t cycles       = kernel::arch::timestamp() - start;
+    magazine_totals after = magazine_totals_now();
 
     KTEST_EXPECT_EQUAL(errors.load(ktl::memory_order::relaxed), 0u);
 
+    uint64_t hz  = kernel::platform::timestamp_hz();
+    uint64_t ops = workers * OPS_PER_WORKER;
+    KTEST_METRIC("workers", workers);
+    KTEST_METRIC("heap_ops_per_sec", hz == 0 || cycles == 0 ? 0 : ops * hz / cycles);
+    KTEST_METRIC("magazine_hits", after.hits - before.hits);
+    KTEST_METRIC("magazine_misses", after.misses - before.misses);
+    KTEST_METRIC("depot_exchanges", after.exchanges - before.exchanges);
+
     // Other kernel threads allocate from the same classes, so per-class shapes and exact-zero
     // liveness are not provable here (the hosted stress suite owns those). What is provable: no
-    // allocation ever failed, and the borrowed pages came back to within the per-class spares
-    // plus a small allowance for unrelated kernel activity.
+    // allocation ever failed, and once the magazines drain the borrowed pages came back to within
+    // the per-class spares plus a small allowance for unrelated kernel activity and the slots
+    // other cores still cache until their next free.
     KTEST_EXPECT_TRUE(g_slab_heap.stats().failures == 0);
+    g_slab_heap.drain();
     size_t free_after = g_page_frame_allocator.free_pages();
     KTEST_EXPECT_TRUE(free_before <= free_after + slab_heap::CLASS_COUNT + 16);
 }
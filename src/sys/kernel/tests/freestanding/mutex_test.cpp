@@ -0,0 +1,120 @@
+#include <kernel/sched/scheduler.h>
+#include <kernel/synchronization/guard.h>
+#include <kernel/synchronization/lockdep.h>
+#include <kernel/synchronization/mutex.h>
+#include <kernel/testing/contention.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+
+#include <ktl/string_view>
+
+using namespace kernel::sched;
+using namespace kernel::synchronization;
+
+KTEST_MODULE("kernel/mutex");
+
+namespace {
+
+constexpr size_t LOCKS = 20'000;  // per thread per measurement
+
+// The named class's counters, or all zero when it has not registered (or lockdep is compiled out).
+lockdep::class_stats class_named(const char* name) {
+    static lockdep::class_stats classes[CONFIG_LOCKDEP_MAX_CLASSES];
+    size_t count = lockdep::snapshot_classes(classes, CONFIG_LOCKDEP_MAX_CLASSES);
+    for (size_t i = 0; i < count; i++) {
+        if (ktl::string_view(classes[i].name) == ktl::string_view(name)) { return classes[i]; }
+    }
+    return {};
+}
+
+struct contention_result {
+    uint64_t locks_per_sec = 0;
+    lockdep::class_stats counted;  // this run's share of the class counters
+};
+
+// `threads` contenders taking the mutex LOCKS times each around a one-increment critical section.
+// Fails (rate zero) if the counter comes out short.
+contention_result contend(size_t threads) {
+    mutex lock{"mutex_bench"};
+    uint64_t counter = 0;  // guarded by lock
+    auto body        = [&](uint64_t&) {
+        lock_guard guard(lock);
+        counter += 1;
+    };
+    lockdep::class_stats before = class_named("mutex_bench");
+    auto run                    = kernel::testing::contend("mutex-contender", threads, LOCKS, body);
+
+    contention_result result;
+    lockdep::class_stats after = class_named("mutex_bench");
+    result.counted.contended   = after.contended - before.contended;
+    result.counted.spun        = after.spun - before.spun;
+    result.counted.parks       = after.parks - before.parks;
+    if (run.ops_per_sec == 0 || counter != threads * LOCKS || lock.is_locked()) { return {}; }
+    result.locks_per_sec = run.ops_per_sec;
+    return result;
+}
+
+}  // namespace
+
+// Every contender gets through, the count comes out exact, and the class counters agree with
+// themselves: acquisitions won by spinning are a subset of the contended ones.
+KTEST_CASE(mutex_contention_is_exact) {
+    contention_result result = contend(4);
+    KTEST_EXPECT_TRUE(result.locks_per_sec > 0);
+    KTEST_EXPECT_TRUE(result.counted.spun <= result.counted.contended);
+    KTEST_EXPECT_TRUE(result.counted.contended <= 4 * LOCKS);
+}
+
+// A contender whose owner is asleep holding the lock stops spinning and parks, and the unlock
+// that follows finds the waiter bit and wakes it.
+KTEST_CASE(mutex_parks_behind_sleeping_owner) {
+    mutex lock{"mutex_sleeper"};
+    lockdep::class_stats before = class_named("mutex_sleeper");
+    volatile bool done          = false;
+    auto body                   = [&] {
+        lock_guard guard(lock);
+        done = true;
+    };
+    lock.lock();
+    KTEST_UNWRAP(t, kernel::testing::spawn_fn("mutex-sleeper", body));
+    while (t->state() != thread_state::BLOCKED) { sleep_ticks(1); }
+    lock.unlock();
+    t->wait_signals(Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(done);
+    KTEST_EXPECT_FALSE(lock.is_locked());
+
+    lockdep::class_stats after = class_named("mutex_sleeper");
+    if (after.name != nullptr) {
+        KTEST_EXPECT_EQUAL(after.contended - before.contended, 1u);
+        KTEST_EXPECT_TRUE(after.parks - before.parks >= 1);
+    }
+}
+
+// Benchmark: a kernel mutex around a one-increment critical section, taken LOCKS times by each of
+// 1, 2, 4 and 8 threads spread over the online cores. Reports aggregate lock/unlock pairs per
+// second, and per thousand of them the acquisitions that spun to the lock and the parks --
+// context switches -- contention cost; the counters come from lockdep and read zero in NDEBUG
+// builds.
+KTEST_CASE(mutex_contention) {
+    using kernel::testing::CONTENTION_CASE_COUNT;
+    const char* const spun_keys[CONTENTION_CASE_COUNT] = {
+        "spun_per_klock_threads_1",
+        "spun_per_klock_threads_2",
+        "spun_per_klock_threads_4",
+        "spun_per_klock_threads_8",
+    };
+    const char* const parks_keys[CONTENTION_CASE_COUNT] = {
+        "parks_per_klock_threads_1",
+        "parks_per_klock_threads_2",
+        "parks_per_klock_threads_4",
+        "parks_per_klock_threads_8",
+    };
+    for (size_t i = 0; i < CONTENTION_CASE_COUNT; i++) {
+        const auto& c            = kernel::testing::CONTENTION_CASES[i];
+        contention_result result = contend(c.threads);
+        KTEST_EXPECT_TRUE(result.locks_per_sec > 0);
+        KTEST_METRIC(c.rate_key, result.locks_per_sec);
+        KTEST_METRIC(spun_keys[i], result.counted.spun * 1000 / (c.threads * LOCKS));
+        KTEST_METRIC(parks_keys[i], result.counted.parks * 1000 / (c.threads * LOCKS));
+    }
+}
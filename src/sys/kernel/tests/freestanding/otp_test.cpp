@@ -0,0 +1,85 @@
+#include <abi/otp.h>
+#include <abi/syscall.h>
+#include <kernel/arch.h>
+#include <kernel/obj/channel.h>
+#include <kernel/obj/handle_dispatch.h>
+#include <kernel/platform.h>
+#include <kernel/sched/thread.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/test_objects.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::obj;
+
+namespace isa = abi::otp;
+
+KTEST_MODULE("kernel/otp");
+
+namespace {
+
+constexpr size_t ROUNDS = 2000;
+
+uint64_t to_ns(uint64_t cycles) {
+    uint64_t hz = kernel::platform::timestamp_hz();
+    return hz == 0 ? 0 : cycles * 1'000'000'000ull / hz / ROUNDS;
+}
+
+// Bump the 8-byte counter at storage offset 0 and return the new value.
+const isa::insn INCREMENT[] = {
+    {isa::OP_LDS, 0, 0, 8, 0, 0},
+    {isa::OP_ADD, 0, isa::SRC_IMM, 0, 0, 1},
+    {isa::OP_STS, 0, 0, 8, 0, 0},
+    {isa::OP_COMPLETE, 0, 0, 0, 0, 0},
+};
+
+}  // namespace
+
+// Benchmark: the same type-defined operation -- bump a counter, return it -- completed in the
+// kernel by an attached program, against served by a server thread over a channel, the cheapest
+// round trip a server-registered type could offer today. The ratio is the point.
+KTEST_CASE(otp_completed_invoke_vs_server_round_trip) {
+    kernel::testing::register_all_test_types();
+    KTEST_REQUIRE_TRUE(
+        g_type_registry.attach_program(kernel::testing::TEST_TYPE_STORED, INCREMENT, 4, isa::VERSION).is_ok());
+    HandleTable table;
+    KTEST_UNWRAP(id, table.emplace<kernel::testing::TestObjStored>(RIGHT_READ));
+
+    uint64_t start = kernel::arch::timestamp();
+    uint64_t last  = 0;
+    for (size_t i = 0; i < ROUNDS; i++) {
+        last = dispatch_handle_op(table, abi::syscall::SYS_OBJ_INVOKE, pack_handle(id), 1, 0);
+    }
+    uint64_t completed_ns = to_ns(kernel::arch::timestamp() - start);
+    KTEST_EXPECT_TRUE(last == ROUNDS);
+
+    KTEST_UNWRAP(pair, Channel::create());
+    uint64_t counter = 0;
+    auto server      = [&] {
+        for (size_t i = 0; i < ROUNDS; i++) {
+            pair.second->wait_signals(Channel::SIGNAL_READABLE);
+            if (pair.second->read(Channel::MAX_MESSAGE_BYTES).is_err()) { return; }
+            auto reply = MessageBuffer::create(sizeof(counter));
+            if (reply.is_err()) { return; }
+            auto msg = reply.unwrap();
+            counter++;
+            __builtin_memcpy(msg.data(), &counter, sizeof(counter));
+            if (pair.second->write(ktl::move(msg)).is_err()) { return; }
+        }
+    };
+    KTEST_UNWRAP(thread, kernel::testing::spawn_fn("otp-server", server));
+
+    start = kernel::arch::timestamp();
+    for (size_t i = 0; i < ROUNDS; i++) {
+        auto request = MessageBuffer::create(sizeof(uint64_t));
+        KTEST_REQUIRE_TRUE(request.is_ok());
+        KTEST_REQUIRE_TRUE(pair.first->write(request.unwrap()).is_ok());
+        pair.first->wait_signals(Channel::SIGNAL_READABLE);
+        KTEST_REQUIRE_TRUE(pair.first->read(Channel::MAX_MESSAGE_BYTES).is_ok());
+    }
+    uint64_t served_ns = to_ns(kernel::arch::timestamp() - start);
+    thread->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(counter == ROUNDS);
+
+    KTEST_METRIC("invoke_completed_ns", completed_ns);
+    KTEST_METRIC("invoke_served_ns", served_ns);
+}
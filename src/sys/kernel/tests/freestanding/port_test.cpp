@@ -1,12 +1,20 @@
+#include <kernel/arch.h>
+#include <kernel/mm/vm_aspace.h>
 #include <kernel/obj/event.h>
 #include <kernel/obj/port.h>
+#include <kernel/platform.h>
+#include <kernel/sched/ipc_buffer.h>
 #include <kernel/sched/scheduler.h>
+#include <kernel/sched/task.h>
+#include <kernel/syscall.h>
 #include <kernel/testing/spawn.h>
 #include <kernel/testing/testing.h>
 #include <kernel/time.h>
 
 using namespace kernel::obj;
 
+namespace sys = kernel::syscall;
+
 KTEST_MODULE("kernel/port");
 
 // The full wake chain with a real sleeper: a thread parked on the port is woken by a bound
@@ -38,3 +46,166 @@ KTEST_CASE(port_wait_wakes_through_binding) {
     KTEST_EXPECT_TRUE(kernel::time::now() - before >= 3);
     KTEST_EXPECT_TRUE(port->unbind(9) == 1);
 }
+
+namespace {
+
+constexpr uint32_t PORTS         = 2;  // K, one consumer each
+constexpr uint32_t MAX_PRODUCERS = 4;  // M, one per remaining core
+constexpr size_t EVENTS          = 8;  // per producer, dealt across the ports
+constexpr size_t ROUNDS          = 4000;
+constexpr uint64_t PACKETS_AT    = 0;
+constexpr uint64_t IDLE_NS       = 2'000'000;  // a consumer's wait once the producers are done
+
+// Producers pulse their own events -- clear, then set, so every pulse is a fresh edge -- and the
+// consumers drain one port each through SYS_PORT_WAIT or SYS_PORT_WAIT_MANY, on borrowed IPC
+// buffers the way submit_test's worker does. A pulse on a binding still pending coalesces, so the
+// packet count is what the consumers kept up with, and the rate is what the ports delivered.
+struct bench {
+    ktl::ref<Port> ports[PORTS];
+    uint64_t handles[PORTS] = {};
+    kernel::sched::ipc_buffer buffers[PORTS];
+    ktl::ref<Event> events[MAX_PRODUCERS][EVENTS];
+    uint64_t batch                  = 1;  // packets per wait; 1 is SYS_PORT_WAIT
+    ktl::atomic<bool> go            = false;
+    ktl::atomic<uint32_t> producing = 0;
+    ktl::atomic<uint64_t> packets   = 0;
+    ktl::atomic<uint64_t> last      = 0;  // timestamp of the latest packet taken
+    ktl::atomic<bool> ok            = true;
+};
+
+struct producer {
+    bench* b;
+    uint32_t index;
+
+    void operator()() {
+        while (!b->go.load(ktl::memory_order::acquire)) {}
+        for (size_t round = 0; round < ROUNDS; round++) {
+            for (auto& event : b->events[index]) {
+                event->signal_clear(0b1);
+                event->signal_set(0b1);
+            }
+        }
+        b->producing.fetch_sub(1, ktl::memory_order::release);
+    }
+};
+
+struct consumer {
+    bench* b;
+    uint32_t port;
+
+    void operator()() {
+        kernel::sched::current()->set_ipc(b->buffers[port]);
+        uint64_t taken = 0;
+        for (;;) {
+            bool done   = b->producing.load(ktl::memory_order::acquire) == 0;
+            uint64_t nr = b->batch == 1 ? sys::SYS_PORT_WAIT : sys::SYS_PORT_WAIT_MANY;
+            uint64_t got =
+                b->batch == 1 ? syscall_dispatch(nr, b->handles[port], PACKETS_AT, IDLE_NS, 0, 0, 0)
+                              : syscall_dispatch(nr, b->handles[port], PACKETS_AT, b->batch, IDLE_NS, 0, 0);
+            if (got == static_cast<uint64_t>(sys::ERR_TIMED_OUT)) {
+                if (done) { break; }
+                continue;
+            }
+            if (got > b->batch) {
+                b->ok.store(false);
+                break;
+            }
+            taken += b->batch == 1 ? 1 : got;
+            b->last.store(kernel::arch::timestamp(), ktl::memory_order::relaxed);
+        }
+        b->packets.fetch_add(taken, ktl::memory_order::relaxed);
+        kernel::sched::current()->set_ipc(kernel::sched::ipc_buffer());
+    }
+};
+
+// Packets per second delivered to PORTS consumers by `producers` producer threads, taking `batch`
+// packets per wait; 0 on failure. Consumers take the first online cores, producers the rest,
+// wrapping when there are fewer cores than threads.
+uint64_t packets_per_sec(bench& b, uint32_t producers, uint64_t batch) {
+    uint32_t online[CONFIG_MAX_CORES];
+    size_t cores = kernel::testing::online_cores(online);
+
+    b.batch = batch;
+    b.go.store(false);
+    b.packets.store(0);
+    b.last.store(0);
+    b.producing.store(producers);
+    consumer consumers[PORTS];
+    producer feeders[MAX_PRODUCERS];
+    ktl::ref<kernel::sched::Thread> threads[PORTS + MAX_PRODUCERS];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < PORTS; i++) {
+        consumers[i] = consumer{&b, i};
+        auto spawned = kernel::testing::spawn_fn_on("port-consumer", consumers[i], online[i % cores]);
+        if (spawned.is_err()) { return 0; }
+        threads[count++] = spawned.unwrap();
+    }
+    for (uint32_t i = 0; i < producers; i++) {
+        feeders[i]   = producer{&b, i};
+        auto spawned = kernel::testing::spawn_fn_on("port-producer", feeders[i], online[(PORTS + i) % cores]);
+        if (spawned.is_err()) {
+            b.producing.fetch_sub(1);
+            b.ok.store(false);
+            continue;
+        }
+        threads[count++] = spawned.unwrap();
+    }
+
+    uint64_t start = kernel::arch::timestamp();
+    b.go.store(true, ktl::memory_order::release);
+    for (uint32_t i = 0; i < count; i++) { threads[i]->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED); }
+    uint64_t last = b.last.load();
+    uint64_t hz   = kernel::platform::timestamp_hz();
+    if (!b.ok.load() || b.packets.load() == 0 || last <= start) { return 0; }
+    return b.packets.load() * hz / (last - start);
+}
+
+}  // namespace
+
+// Benchmark: packets per second through PORTS ports, each drained by its own consumer, while M
+// producers pulse EVENTS events apiece, dealt across the ports. Once with one packet per
+// SYS_PORT_WAIT, once with SYS_PORT_WAIT_MANY draining up to ABI_PORT_WAIT_MAX_PACKETS per call.
+// Each port has its own lock and each event's binding list its own stripe, so producers feeding
+// different ports contend only on the stripes they share. Driven through syscall_dispatch from
+// kernel threads, as submit_test is.
+KTEST_CASE(port_packets_per_second) {
+    auto snapshot  = kernel::sched::stats_snapshot();
+    uint32_t cores = 0;
+    for (uint32_t i = 0; i < CONFIG_MAX_CORES; i++) { cores += snapshot.cores[i].online ? 1 : 0; }
+    uint32_t producers = cores > PORTS + 1 ? cores - PORTS : 1;
+    if (producers > MAX_PRODUCERS) { producers = MAX_PRODUCERS; }
+
+    kernel::mm::vm_aspace aspace;
+    KTEST_REQUIRE_TRUE(aspace.init());
+    bench b;
+    auto& table = kernel::sched::kernel_task()->handles();
+    HandleId ids[PORTS];
+    for (uint32_t i = 0; i < PORTS; i++) {
+        b.ports[i] = ktl::make_ref<Port>();
+        KTEST_REQUIRE_TRUE(b.ports[i]);
+        auto inserted = table.insert(b.ports[i], Port::DEFAULT_RIGHTS);
+        KTEST_REQUIRE_TRUE(inserted.is_ok());
+        ids[i]       = inserted.unwrap();
+        b.handles[i] = pack_handle(ids[i]);
+        auto created = kernel::sched::ipc_buffer::create(aspace, 1, i);
+        KTEST_REQUIRE_TRUE(created.is_ok());
+        b.buffers[i] = created.unwrap();
+    }
+    for (uint32_t p = 0; p < producers; p++) {
+        for (size_t e = 0; e < EVENTS; e++) {
+            b.events[p][e] = ktl::make_ref<Event>();
+            KTEST_REQUIRE_TRUE(b.events[p][e]);
+            uint64_t key = p * EVENTS + e;
+            KTEST_REQUIRE_TRUE(b.ports[key % PORTS]->bind(b.events[p][e], key, 0b1).is_ok());
+        }
+    }
+
+    uint64_t single = packets_per_sec(b, producers, 1);
+    KTEST_EXPECT_TRUE(single > 0);
+    KTEST_METRIC("packets_per_sec_single", single);
+    uint64_t batched = packets_per_sec(b, producers, ABI_PORT_WAIT_MAX_PACKETS);
+    KTEST_EXPECT_TRUE(batched > 0);
+    KTEST_METRIC("packets_per_sec_batched", batched);
+
+    for (auto id : ids) { KTEST_EXPECT_TRUE(table.close(id).is_ok()); }
+}
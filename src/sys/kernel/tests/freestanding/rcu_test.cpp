@@ -0,0 +1,133 @@
+#include <kernel/arch.h>
+#include <kernel/platform.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/synchronization/rcu.h>
+#include <kernel/synchronization/spinlock.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::sched;
+using namespace kernel::synchronization;
+
+KTEST_MODULE("kernel/rcu");
+
+namespace {
+
+constexpr size_t SYNC_ROUNDS   = 32;
+constexpr size_t READ_SECTIONS = 100'000;
+constexpr uint64_t HOLD_TICKS  = 5;  // how long the reader keeps a grace period open
+
+struct flagged {
+    rcu_head head;  // first, so the callback recovers the struct from it
+    ktl::atomic<bool> ran = false;
+};
+
+void mark_ran(rcu_head* head) { reinterpret_cast<flagged*>(head)->ran.store(true, ktl::memory_order::release); }
+
+uint64_t cycles_to_ns(uint64_t cycles) {
+    uint64_t hz = kernel::platform::timestamp_hz();
+    return hz != 0 ? cycles * 1'000'000'000 / hz : 0;
+}
+
+struct sync_latency {
+    uint64_t avg_us = 0;
+    uint64_t max_us = 0;
+};
+
+sync_latency measure_sync() {
+    uint64_t total   = 0;
+    uint64_t longest = 0;
+    for (size_t i = 0; i < SYNC_ROUNDS; i++) {
+        uint64_t start = kernel::arch::timestamp();
+        synchronize_rcu();
+        uint64_t cycles = kernel::arch::timestamp() - start;
+        total += cycles;
+        if (cycles > longest) { longest = cycles; }
+    }
+    return {cycles_to_ns(total / SYNC_ROUNDS) / 1000, cycles_to_ns(longest) / 1000};
+}
+
+}  // namespace
+
+// A reader on one core holds a grace period open: a callback queued behind it stays pending for as
+// long as the reader stays inside, and runs once it leaves. The checker runs pinned to a second
+// core, since the reader holds its own with preemption off.
+KTEST_CASE(rcu_callback_waits_for_reader_on_another_core) {
+    uint32_t cores[CONFIG_MAX_CORES];
+    if (kernel::testing::online_cores(cores) < 2) { return; }
+
+    ktl::atomic<bool> inside = false;
+    ktl::atomic<bool> leave  = false;
+    bool pending_while_read  = false;
+    bool ran_after_sync      = false;
+    auto reader              = [&] {
+        rcu_read_guard guard;
+        inside.store(true, ktl::memory_order::release);
+        while (!leave.load(ktl::memory_order::acquire)) { kernel::arch::cpu_relax(); }
+    };
+    auto checker = [&] {
+        while (!inside.load(ktl::memory_order::acquire)) { yield(); }
+        flagged f;
+        call_rcu(&f.head, mark_ran);
+        sleep_ticks(HOLD_TICKS);
+        pending_while_read = !f.ran.load(ktl::memory_order::acquire);
+        leave.store(true, ktl::memory_order::release);
+        // Callbacks run in queue order, so the grace period this waits for covers f's as well.
+        synchronize_rcu();
+        ran_after_sync = f.ran.load(ktl::memory_order::acquire);
+    };
+    KTEST_UNWRAP(r, kernel::testing::spawn_fn_on("rcu-reader", reader, cores[0]));
+    KTEST_UNWRAP(c, kernel::testing::spawn_fn_on("rcu-checker", checker, cores[1]));
+    r->wait_signals(Thread::SIGNAL_TERMINATED);
+    c->wait_signals(Thread::SIGNAL_TERMINATED);
+    KTEST_EXPECT_TRUE(pending_while_read);
+    KTEST_EXPECT_TRUE(ran_after_sync);
+}
+
+// Benchmark: synchronize_rcu latency over SYNC_ROUNDS calls, first with the other cores idle --
+// reached by the callback thread's IPI -- then with a preemptible spinner pinned to each of them,
+// which only the tick reports for. Also the cost of a one-access read-side section against a spinlock
+// critical section, each averaged over READ_SECTIONS.
+KTEST_CASE(rcu_grace_period_latency) {
+    sync_latency idle = measure_sync();
+
+    uint32_t cores[CONFIG_MAX_CORES];
+    size_t online         = kernel::testing::online_cores(cores);
+    ktl::atomic<bool> run = true;
+    auto spinner          = [&] {
+        while (run.load(ktl::memory_order::relaxed)) { kernel::arch::cpu_relax(); }
+    };
+    ktl::ref<Thread> spinners[CONFIG_MAX_CORES];
+    size_t spawned = 0;
+    for (size_t i = 1; i < online; i++) {
+        auto thread = kernel::testing::spawn_fn_on("rcu-spinner", spinner, cores[i]);
+        if (thread.is_err()) { break; }
+        spinners[spawned++] = thread.unwrap();
+    }
+    sync_latency busy = measure_sync();
+    run.store(false, ktl::memory_order::relaxed);
+    for (size_t i = 0; i < spawned; i++) { spinners[i]->wait_signals(Thread::SIGNAL_TERMINATED); }
+
+    volatile uint64_t touched = 0;  // the same one access inside each kind of section
+    uint64_t start            = kernel::arch::timestamp();
+    for (size_t i = 0; i < READ_SECTIONS; i++) {
+        rcu_read_guard guard;
+        touched = touched + 1;
+    }
+    uint64_t read_cycles = kernel::arch::timestamp() - start;
+    spinlock lock{"rcu_bench"};
+    start = kernel::arch::timestamp();
+    for (size_t i = 0; i < READ_SECTIONS; i++) {
+        critical_lock_guard guard(lock);
+        touched = touched + 1;
+    }
+    uint64_t lock_cycles = kernel::arch::timestamp() - start;
+
+    KTEST_EXPECT_TRUE(idle.max_us > 0 || kernel::platform::timestamp_hz() == 0);
+    KTEST_METRIC("sync_avg_us_idle", idle.avg_us);
+    KTEST_METRIC("sync_max_us_idle", idle.max_us);
+    KTEST_METRIC("sync_avg_us_busy", busy.avg_us);
+    KTEST_METRIC("sync_max_us_busy", busy.max_us);
+    KTEST_METRIC("read_section_ns", cycles_to_ns(read_cycles) / READ_SECTIONS);
+    KTEST_METRIC("spinlock_section_ns", cycles_to_ns(lock_cycles) / READ_SECTIONS);
+}
@@ -294,6 +294,35 @@ KTEST_CASE(sched_global_stats_advance) {
     KTEST_EXPECT_TRUE(s1.boot_ts != 0);
 }
 
+// With the cycle counter as the clock a sleep is woken by a one-shot timer at its deadline, so a
+// quarter-millisecond sleep is not rounded up to the next 1 ms tick. Floor checked exactly; the
+// overshoot is reported rather than bounded, since a loaded host can stretch any wake.
+KTEST_CASE(sched_sleep_ns_sub_tick) {
+    if (!kernel::time::high_resolution()) { return; }
+    constexpr uint64_t SLEEP_NS = 250'000;
+    time_ns_t before            = kernel::time::ns_since_boot();
+    sleep_ns(SLEEP_NS);
+    time_ns_t elapsed = kernel::time::ns_since_boot() - before;
+    KTEST_EXPECT_TRUE(elapsed >= static_cast<time_ns_t>(SLEEP_NS));
+    KTEST_METRIC("sleep_250us_elapsed_ns", static_cast<uint64_t>(elapsed));
+}
+
+// Tickless idle: while this thread sleeps 50 ticks, idle cores stop their timers and the boot core
+// programs only the deadlines it has, so the machine takes far fewer interrupts than a periodic
+// tick's one per tick per core.
+KTEST_CASE(sched_idle_cores_stop_ticking) {
+    if (!kernel::time::high_resolution()) { return; }
+    constexpr uint64_t TICKS = 50;
+    auto s0                  = kernel::sched::stats_snapshot();
+    sleep_ticks(TICKS);
+    auto s1       = kernel::sched::stats_snapshot();
+    uint64_t irqs = s1.timer_irqs - s0.timer_irqs;
+    size_t online = 0;
+    for (size_t i = 0; i < CONFIG_MAX_CORES; ++i) { online += s1.cores[i].online ? 1 : 0; }
+    KTEST_EXPECT_TRUE(irqs < TICKS * online);
+    KTEST_METRIC("timer_irqs_per_50_ticks", irqs);
+}
+
 KTEST_CASE(sched_idle_state_truthful_while_switched_out) {
     // We (the kshell thread) are RUNNING on some core, so that core's idle thread must report
     // READY: never every idle RUNNING at once.
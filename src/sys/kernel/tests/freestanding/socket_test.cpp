@@ -0,0 +1,129 @@
+#include <kernel/arch.h>
+#include <kernel/obj/socket.h>
+#include <kernel/platform.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+#include <std/new.h>
+
+using namespace kernel::obj;
+
+KTEST_MODULE("kernel/socket");
+
+namespace {
+
+constexpr size_t STREAM_BYTES = 8 * 1024 * 1024;  // per measurement
+constexpr size_t CHUNK_BYTES  = 16 * 1024;        // per write and per read call
+
+// A writer and a reader on different cores (when there are two) streaming STREAM_BYTES through
+// one pair. Each side parks on its signal when the ring stalls it; the watermarks put those wakes
+// at a quarter and half of the ring instead of at every byte.
+struct stream {
+    Socket::Pair pair;
+    uint8_t* chunk       = nullptr;  // the writer's source
+    uint8_t* sink        = nullptr;  // the reader's
+    ktl::atomic<bool> go = false;
+    uint64_t read_cycles = 0;
+    ktl::atomic<bool> ok = true;
+};
+
+struct writer {
+    stream* s;
+    void operator()() {
+        while (!s->go.load(ktl::memory_order::acquire)) {}
+        for (size_t sent = 0; s->ok.load() && sent < STREAM_BYTES;) {
+            size_t want = STREAM_BYTES - sent < CHUNK_BYTES ? STREAM_BYTES - sent : CHUNK_BYTES;
+            auto wrote  = s->pair.first->write(s->chunk, want);
+            if (wrote.is_ok()) {
+                sent += wrote.unwrap();
+            } else if (wrote.unwrap_err() == ktl::errc::capacity_exhausted) {
+                (void)s->pair.first->wait_signals(Socket::SIGNAL_WRITABLE);
+            } else {
+                s->ok.store(false);
+            }
+        }
+        // Hang up: the tail may sit short of the reader's mark, and only a hangup asserts it.
+        s->pair.first = ktl::ref<Socket>{};
+    }
+};
+
+struct reader {
+    stream* s;
+    void operator()() {
+        while (!s->go.load(ktl::memory_order::acquire)) {}
+        uint64_t start = kernel::arch::timestamp();
+        for (size_t got = 0; s->ok.load() && got < STREAM_BYTES;) {
+            auto read = s->pair.second->read(s->sink, CHUNK_BYTES);
+            if (read.is_ok()) {
+                got += read.unwrap();
+            } else if (read.unwrap_err() == ktl::errc::would_block) {
+                (void)s->pair.second->wait_signals(Socket::SIGNAL_READABLE | Socket::SIGNAL_PEER_CLOSED);
+            } else {
+                s->ok.store(false);
+            }
+        }
+        s->read_cycles = kernel::arch::timestamp() - start;
+    }
+};
+
+// Bytes per second streamed through a pair with `capacity` bytes per direction, or 0 on failure.
+uint64_t bytes_per_sec(size_t capacity, uint8_t* chunk, uint8_t* sink) {
+    auto created = Socket::create(capacity);
+    if (created.is_err()) { return 0; }
+    stream s;
+    s.pair  = created.unwrap();
+    s.chunk = chunk;
+    s.sink  = sink;
+    if (s.pair.second->set_watermarks(capacity / 4, 0).is_err()) { return 0; }
+    if (s.pair.first->set_watermarks(1, capacity / 2).is_err()) { return 0; }
+
+    auto snapshot = kernel::sched::stats_snapshot();
+    uint32_t online[2];
+    uint32_t cores = 0;
+    for (uint32_t core = 0; core < CONFIG_MAX_CORES && cores < 2; core++) {
+        if (snapshot.cores[core].online) { online[cores++] = core; }
+    }
+    writer w{&s};
+    reader r{&s};
+    auto wt = kernel::testing::spawn_fn_on("socket-writer", w, online[0]);
+    if (wt.is_err()) { return 0; }
+    auto rt = kernel::testing::spawn_fn_on("socket-reader", r, online[cores - 1]);
+    if (rt.is_err()) {
+        s.ok.store(false);
+        s.go.store(true, ktl::memory_order::release);
+        wt.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+        return 0;
+    }
+    s.go.store(true, ktl::memory_order::release);
+    wt.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+    rt.unwrap()->wait_signals(kernel::sched::Thread::SIGNAL_TERMINATED);
+
+    uint64_t hz = kernel::platform::timestamp_hz();
+    return s.ok.load() && s.read_cycles != 0 ? STREAM_BYTES * hz / s.read_cycles : 0;
+}
+
+}  // namespace
+
+// Benchmark: bulk streaming throughput against ring size, one writer and one reader on separate
+// cores, from the one-page default up to MAX_BUFFER_BYTES. A bigger ring lets the writer run
+// further ahead before it parks, and the watermarks make each park and wake cover a quarter of
+// the ring.
+KTEST_CASE(socket_stream_throughput_by_capacity) {
+    auto* chunk = new (std::nothrow) uint8_t[CHUNK_BYTES];
+    auto* sink  = new (std::nothrow) uint8_t[CHUNK_BYTES];
+    KTEST_REQUIRE_TRUE(chunk != nullptr && sink != nullptr);
+    for (size_t i = 0; i < CHUNK_BYTES; i++) { chunk[i] = static_cast<uint8_t>(i); }
+
+    uint64_t page = bytes_per_sec(Socket::BUFFER_BYTES, chunk, sink);
+    KTEST_EXPECT_TRUE(page > 0);
+    KTEST_METRIC("bytes_per_sec_4k", page);
+    uint64_t mid = bytes_per_sec(16 * 1024, chunk, sink);
+    KTEST_EXPECT_TRUE(mid > 0);
+    KTEST_METRIC("bytes_per_sec_16k", mid);
+    uint64_t max = bytes_per_sec(Socket::MAX_BUFFER_BYTES, chunk, sink);
+    KTEST_EXPECT_TRUE(max > 0);
+    KTEST_METRIC("bytes_per_sec_64k", max);
+
+    delete[] sink;
+    delete[] chunk;
+}
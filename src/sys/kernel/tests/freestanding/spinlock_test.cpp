@@ -0,0 +1,156 @@
+#include <kernel/arch.h>
+#include <kernel/platform.h>
+#include <kernel/sched/scheduler.h>
+#include <kernel/synchronization/lockdep.h>
+#include <kernel/synchronization/spinlock.h>
+#include <kernel/testing/spawn.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::sched;
+using namespace kernel::synchronization;
+
+KTEST_MODULE("kernel/spinlock");
+
+namespace {
+
+constexpr size_t MAX_THREADS = 8;
+constexpr uint64_t RUN_TICKS = 200;  // measurement window
+constexpr uint64_t CS_WORK   = 8;    // plain stores per critical section
+
+// The test-and-set lock the queued spinlock replaced, kept as the benchmark's baseline: every
+// waiter spins on the lock word itself.
+class tas_lock {
+   public:
+    explicit tas_lock(const char*) {}
+    void lock() {
+        while (__atomic_exchange_n(&m_state, 1, __ATOMIC_ACQUIRE) != 0) {
+            while (__atomic_load_n(&m_state, __ATOMIC_RELAXED) != 0) {}
+        }
+    }
+    void unlock() { __atomic_store_n(&m_state, 0, __ATOMIC_RELEASE); }
+
+   private:
+    alignas(CONFIG_CPU_CACHE_LINE_SIZE) uint32_t m_state = 0;
+};
+
+struct alignas(CONFIG_CPU_CACHE_LINE_SIZE) worker_count {
+    uint64_t acquires = 0;
+};
+
+template <typename Lock> struct bench {
+    Lock lock{"spinlock_bench"};
+    uint64_t shared[CS_WORK]    = {};  // guarded by lock
+    uint64_t total              = 0;   // guarded by lock
+    ktl::atomic<uint32_t> ready = 0;
+    ktl::atomic<bool> go        = false;
+    ktl::atomic<bool> stop      = false;
+    worker_count counts[MAX_THREADS];
+};
+
+template <typename Lock> struct worker {
+    bench<Lock>* b;
+    size_t index;
+
+    void operator()() {
+        b->ready.fetch_add(1, ktl::memory_order::relaxed);
+        while (!b->go.load(ktl::memory_order::acquire)) {}
+        uint64_t acquires = 0;
+        while (!b->stop.load(ktl::memory_order::relaxed)) {
+            critical_lock_guard guard(b->lock);
+            for (auto& word : b->shared) { word += 1; }
+            b->total += 1;
+            acquires++;
+        }
+        b->counts[index].acquires = acquires;
+    }
+};
+
+struct fairness_result {
+    uint64_t acquires         = 0;
+    size_t threads            = 0;  // workers run: the request clamped to the online cores
+    uint64_t acquires_per_sec = 0;
+    uint64_t fairness         = 0;  // fewest acquisitions per thread over most, per mille
+    bool ok                   = false;
+    lockdep::lock_stats counted;  // the lock's own counters, when it keeps them
+};
+
+// One worker pinned to each of the first `threads` online cores (fewer if fewer are online), all
+// taking one lock for RUN_TICKS. Checks that the guarded total matches the per-thread counts.
+template <typename Lock> fairness_result run(size_t threads) {
+    uint32_t cores[CONFIG_MAX_CORES];
+    size_t online = kernel::testing::online_cores(cores);
+    if (threads > online) { threads = online; }
+
+    bench<Lock> b;
+    worker<Lock> workers[MAX_THREADS];
+    ktl::ref<Thread> spawned[MAX_THREADS];
+    size_t count = 0;
+    for (; count < threads; count++) {
+        workers[count] = worker<Lock>{&b, count};
+        auto thread    = kernel::testing::spawn_fn_on("spinlock-worker", workers[count], cores[count]);
+        if (thread.is_err()) { break; }
+        spawned[count] = thread.unwrap();
+    }
+    while (b.ready.load(ktl::memory_order::relaxed) < count) { yield(); }
+
+    uint64_t start = kernel::arch::timestamp();
+    b.go.store(true, ktl::memory_order::release);
+    sleep_ticks(RUN_TICKS);
+    b.stop.store(true, ktl::memory_order::relaxed);
+    uint64_t cycles = kernel::arch::timestamp() - start;
+    for (size_t i = 0; i < count; i++) { spawned[i]->wait_signals(Thread::SIGNAL_TERMINATED); }
+
+    fairness_result result;
+    result.threads = threads;
+    static lockdep::lock_row rows[CONFIG_LOCKDEP_MAX_LOCKS];
+    size_t rows_found = lockdep::snapshot_locks(rows, CONFIG_LOCKDEP_MAX_LOCKS);
+    for (size_t i = 0; i < rows_found; i++) {
+        if (rows[i].address == &b.lock) { result.counted = rows[i].stats; }
+    }
+    uint64_t sum    = 0;
+    uint64_t fewest = UINT64_MAX;
+    uint64_t most   = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t n = b.counts[i].acquires;
+        sum += n;
+        if (n < fewest) { fewest = n; }
+        if (n > most) { most = n; }
+    }
+    uint64_t hz     = kernel::platform::timestamp_hz();
+    result.acquires = sum;
+    result.ok       = count == threads && count > 0 && sum == b.total && b.shared[0] == b.total && most > 0;
+    if (result.ok && hz != 0 && cycles != 0) {
+        result.acquires_per_sec = sum * hz / cycles;
+        result.fairness         = fewest * 1000 / most;
+    }
+    return result;
+}
+
+}  // namespace
+
+// A lock contended from every core keeps the guarded state exact, and in debug builds its own
+// counters see every acquisition, with the ones that queued among them.
+KTEST_CASE(spinlock_queued_contention_is_exact) {
+    auto result = run<spinlock>(MAX_THREADS);
+    KTEST_EXPECT_TRUE(result.ok);
+    if (result.counted.acquires != 0) {
+        KTEST_EXPECT_EQUAL(result.counted.acquires, result.acquires);
+        KTEST_EXPECT_TRUE(result.counted.contended <= result.counted.acquires);
+    }
+}
+
+// Benchmark: one worker pinned per online core (up to MAX_THREADS) taking a single lock around a
+// short critical section for RUN_TICKS, with the queued spinlock and with the test-and-set lock it
+// replaced. Reports aggregate acquisitions per second and fairness -- the least-served worker's
+// acquisitions over the most-served one's, per mille, where 1000 is perfectly even.
+KTEST_CASE(spinlock_fairness) {
+    auto queued = run<spinlock>(MAX_THREADS);
+    auto tas    = run<tas_lock>(MAX_THREADS);
+    KTEST_EXPECT_TRUE(queued.ok);
+    KTEST_EXPECT_TRUE(tas.ok);
+    KTEST_METRIC("threads", queued.threads);
+    KTEST_METRIC("acquires_per_sec_queued", queued.acquires_per_sec);
+    KTEST_METRIC("fairness_permille_queued", queued.fairness);
+    KTEST_METRIC("acquires_per_sec_tas", tas.acquires_per_sec);
+    KTEST_METRIC("fairness_permille_tas", tas.fairness);
+}
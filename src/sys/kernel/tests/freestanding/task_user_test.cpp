@@ -1,4 +1,5 @@
 #include <abi/message.h>
+#include <kernel/arch.h>
 #include <kernel/boot.h>
 #include <kernel/elf.h>
 #include <kernel/log.h>
@@ -13,6 +14,7 @@
 #include <kernel/time.h>
 #include <std/string.h>
 
+#include <ktl/atomic>
 #include <ktl/string_view>
 #include <ktl/vector>
 
@@ -319,11 +321,9 @@ KTEST_CASE(boot_module_endowment) {
 
         // The riding handle: a read-only VMO named after the module, sized to its pages, whose
         // first frame is the module's own physical memory -- wrapped, not copied.
-        HandleId escrowed[MessageBuffer::MAX_HANDLES];
-        KTEST_REQUIRE_EQUAL(mail.detach_handles(escrowed), 1u);
-        auto taken = kernel::sched::kernel_task()->handles().take(escrowed[0]);
-        KTEST_REQUIRE_TRUE(taken.is_ok());
-        auto moved = taken.unwrap();
+        VerifiedHandle carried[MessageBuffer::MAX_HANDLES];
+        KTEST_REQUIRE_EQUAL(mail.detach_handles(carried), 1u);
+        auto& moved = carried[0];
         KTEST_EXPECT_ALL(moved.object->type_id() == type_ids::VMO, moved.rights == RIGHT_READ);
         KTEST_EXPECT_TRUE(strlen(moved.object->name()) == name_len &&
                           memcmp(moved.object->name(), module.role, name_len) == 0);
@@ -331,8 +331,7 @@ KTEST_CASE(boot_module_endowment) {
         auto image   = ktl::static_ref_cast<kernel::mm::vmo>(moved.object);
         size_t pages = (module.size + KERNEL_MINIMUM_PAGE_SIZE - 1) / KERNEL_MINIMUM_PAGE_SIZE;
         KTEST_EXPECT_EQUAL(image->size_pages(), pages);
-        // Translation-only fill (device-window pager): safe to call without the VMM lock on a VMO
-        // nothing else references.
+        // Translation-only fill (device-window pager), under the VMO's own lock.
         auto frame = image->get_or_fill_page(0);
         KTEST_REQUIRE_TRUE(frame.is_ok());
         KTEST_EXPECT_EQUAL(frame.unwrap(), reinterpret_cast<uintptr_t>(module.data) - g_hhdm_offset);
@@ -420,10 +419,11 @@ KTEST_CASE(object_wait_timeout) {
 
 namespace {
 
-// Build a test-only copy of init with its entry overwritten by a small native store through the
-// unmapped null page. It remains a normal loader input, while avoiding a second user-program
-// package solely for this regression test.
-bool make_faulting_image(const kernel::boot::boot_module& module, ktl::vector<uint8_t>& image) {
+// Build a test-only copy of `module` with its entry overwritten by `code`, a few native
+// instructions. It remains a normal loader input, while avoiding a second user-program package
+// for each test that needs one.
+bool make_patched_image(const kernel::boot::boot_module& module, const uint8_t* code, size_t code_size,
+                        ktl::vector<uint8_t>& image) {
     if (!image.reserve(module.size)) { return false; }
     for (size_t i = 0; i < module.size; ++i) {
         if (!image.push_back(static_cast<const uint8_t*>(module.data)[i])) { return false; }
@@ -450,21 +450,20 @@ bool make_faulting_image(const kernel::boot::boot_module& module, ktl::vector<ui
         break;
     }
 
+    if (!found_entry || entry_offset > image.size() || code_size > image.size() - entry_offset) { return false; }
+    memcpy(image.data() + entry_offset, code, code_size);
+    return true;
+}
+
+// A store through the unmapped null page.
 #if defined(ARCH_X86_64)
-    constexpr uint8_t FAULT_CODE[] = {0x48, 0xc7, 0xc0, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x00, 0x00};
+constexpr uint8_t FAULT_CODE[] = {0x48, 0xc7, 0xc0, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x00, 0x00};
 #elif defined(ARCH_RISCV64)
-    constexpr uint8_t FAULT_CODE[] = {0x93, 0x02, 0x00, 0x00, 0x23, 0x80, 0x02, 0x00};
+constexpr uint8_t FAULT_CODE[] = {0x93, 0x02, 0x00, 0x00, 0x23, 0x80, 0x02, 0x00};
 #else
 #error unsupported architecture
 #endif
 
-    if (!found_entry || entry_offset > image.size() || sizeof(FAULT_CODE) > image.size() - entry_offset) {
-        return false;
-    }
-    memcpy(image.data() + entry_offset, FAULT_CODE, sizeof(FAULT_CODE));
-    return true;
-}
-
 }  // namespace
 
 KTEST_CASE(user_task_unresolved_fault_terminates_task) {
@@ -472,7 +471,7 @@ KTEST_CASE(user_task_unresolved_fault_terminates_task) {
     KTEST_REQUIRE_TRUE(module != nullptr);
 
     ktl::vector<uint8_t> image;
-    KTEST_REQUIRE_TRUE(make_faulting_image(*module, image));
+    KTEST_REQUIRE_TRUE(make_patched_image(*module, FAULT_CODE, sizeof(FAULT_CODE), image));
     auto created = create_user_task("ufault", image.data(), image.size());
     KTEST_REQUIRE_TRUE(created.is_ok());
     ktl::ref<Task> task = created.unwrap();
@@ -486,3 +485,131 @@ KTEST_CASE(user_task_unresolved_fault_terminates_task) {
     // Returning a passing test result makes the harness wait for the next shell-ready record,
     // proving the kernel remained live and the shell stayed reachable after the fault.
 }
+
+namespace {
+
+constexpr uint32_t SWITCH_YIELDS = 20000;  // per thread; baked into the loop count of the code below
+
+// Yield SWITCH_YIELDS times, counting rounds in an integer register, and exit with the count.
+// The SIMD variant counts in a vector register instead and feeds each round down a chain of six
+// more, so every switch carries live vector state -- and its exit status is the count only if
+// every switch kept that state intact. riscv64 has no vector unit enabled; its variant uses the
+// D registers the same way.
+#if defined(ARCH_X86_64)
+// xor r12d,r12d; mov ebx,20000; 1: inc r12; mov eax,SYS_YIELD; xor edi,edi; syscall; dec ebx;
+// jnz 1b; mov rdi,r12; xor eax,eax (SYS_EXIT); syscall; ud2
+constexpr uint8_t YIELD_INT_CODE[] = {0x45, 0x31, 0xe4, 0xbb, 0x20, 0x4e, 0x00, 0x00, 0x49, 0xff, 0xc4, 0xb8, 0x01,
+                                      0x00, 0x00, 0x00, 0x31, 0xff, 0x0f, 0x05, 0xff, 0xcb, 0x75, 0xf0, 0x4c, 0x89,
+                                      0xe7, 0x31, 0xc0, 0x0f, 0x05, 0x0f, 0x0b};
+// mov eax,1; movq xmm1,rax; pxor xmm0,xmm0; mov ebx,20000; 1: paddq xmm0,xmm1; paddq xmm2,xmm0;
+// ... paddq xmm7,xmm6; mov eax,SYS_YIELD; xor edi,edi; syscall; dec ebx; jnz 1b; movq rdi,xmm0;
+// xor eax,eax (SYS_EXIT); syscall; ud2
+constexpr uint8_t YIELD_SIMD_CODE[] = {
+    0xb8, 0x01, 0x00, 0x00, 0x00, 0x66, 0x48, 0x0f, 0x6e, 0xc8, 0x66, 0x0f, 0xef, 0xc0, 0xbb, 0x20, 0x4e, 0x00,
+    0x00, 0x66, 0x0f, 0xd4, 0xc1, 0x66, 0x0f, 0xd4, 0xd0, 0x66, 0x0f, 0xd4, 0xda, 0x66, 0x0f, 0xd4, 0xe3, 0x66,
+    0x0f, 0xd4, 0xec, 0x66, 0x0f, 0xd4, 0xf5, 0x66, 0x0f, 0xd4, 0xfe, 0xb8, 0x01, 0x00, 0x00, 0x00, 0x31, 0xff,
+    0x0f, 0x05, 0xff, 0xcb, 0x75, 0xd7, 0x66, 0x48, 0x0f, 0x7e, 0xc7, 0x31, 0xc0, 0x0f, 0x05, 0x0f, 0x0b};
+#elif defined(ARCH_RISCV64)
+// li s2,0; li s1,20000; 1: addi s2,s2,1; li a7,SYS_YIELD; li a0,0; ecall; addi s1,s1,-1; bnez s1,1b;
+// mv a0,s2; li a7,SYS_EXIT; ecall; unimp
+constexpr uint8_t YIELD_INT_CODE[] = {0x13, 0x09, 0x00, 0x00, 0xb7, 0x54, 0x00, 0x00, 0x93, 0x84, 0x04, 0xe2, 0x13,
+                                      0x09, 0x19, 0x00, 0x93, 0x08, 0x10, 0x00, 0x13, 0x05, 0x00, 0x00, 0x73, 0x00,
+                                      0x00, 0x00, 0x93, 0x84, 0xf4, 0xff, 0xe3, 0x96, 0x04, 0xfe, 0x13, 0x05, 0x09,
+                                      0x00, 0x93, 0x08, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x73, 0x10, 0x00, 0xc0};
+// li t0,1; fcvt.d.l f1,t0; fcvt.d.l f0,zero; li s1,20000; 1: fadd.d f0,f0,f1; fadd.d f2,f2,f0; ...
+// fadd.d f7,f7,f6; li a7,SYS_YIELD; li a0,0; ecall; addi s1,s1,-1; bnez s1,1b; fcvt.l.d a0,f0,rtz;
+// li a7,SYS_EXIT; ecall; unimp
+constexpr uint8_t YIELD_SIMD_CODE[] = {
+    0x93, 0x02, 0x10, 0x00, 0xd3, 0xf0, 0x22, 0xd2, 0x53, 0x70, 0x20, 0xd2, 0xb7, 0x54, 0x00, 0x00, 0x93, 0x84,
+    0x04, 0xe2, 0x53, 0x70, 0x10, 0x02, 0x53, 0x71, 0x01, 0x02, 0xd3, 0xf1, 0x21, 0x02, 0x53, 0x72, 0x32, 0x02,
+    0xd3, 0xf2, 0x42, 0x02, 0x53, 0x73, 0x53, 0x02, 0xd3, 0xf3, 0x63, 0x02, 0x93, 0x08, 0x10, 0x00, 0x13, 0x05,
+    0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x93, 0x84, 0xf4, 0xff, 0xe3, 0x9a, 0x04, 0xfc, 0x53, 0x15, 0x20, 0xc2,
+    0x93, 0x08, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x73, 0x10, 0x00, 0xc0};
+#endif
+
+struct switch_run {
+    uint64_t cycles_per_switch = 0;
+    bool ok                    = false;
+};
+
+// Two tasks running `image`, both queued on the calling core, yield to each other until they exit.
+// Each must exit with the full count, and hold an FPU area exactly when it used FP. The cost is
+// the two threads' cycles over their switches-in: one yield round trip, user loop included.
+switch_run run_yield_pair(const ktl::vector<uint8_t>& image, bool uses_fp) {
+    switch_run result;
+    ktl::ref<Task> tasks[2];
+    ktl::ref<Thread> threads[2];
+    for (size_t i = 0; i < 2; ++i) {
+        auto created = create_user_task("uswitch", image.data(), image.size());
+        if (created.is_err()) { return result; }
+        tasks[i] = created.unwrap();
+        ktl::vector<ktl::ref<Thread>> snapshot;
+        if (!tasks[i]->snapshot_threads(snapshot) || snapshot.size() != 1) { return result; }
+        threads[i] = snapshot[0];
+    }
+    for (int i = 0; i < 4000 && (tasks[0]->state() != task_state::TERMINATED ||
+                                 tasks[1]->state() != task_state::TERMINATED);
+         ++i) {
+        sleep_ticks(1);
+    }
+
+    uint64_t cycles   = 0;
+    uint64_t switches = 0;
+    result.ok         = true;
+    for (size_t i = 0; i < 2; ++i) {
+        uint64_t code = tasks[i]->exit_code();
+        bool exited   = tasks[i]->state() == task_state::TERMINATED && code >> 32 == kernel::syscall::TASK_EXIT_EXITED;
+        result.ok     = result.ok && exited && (code & 0xFFFFFFFF) == SWITCH_YIELDS;
+        result.ok     = result.ok && (threads[i]->fpu_area() != nullptr) == uses_fp;
+        cycles += threads[i]->stats().cpu_cycles;
+        switches += threads[i]->stats().scheduled;
+    }
+    result.cycles_per_switch = switches != 0 ? cycles / switches : 0;
+    return result;
+}
+
+}  // namespace
+
+// Lazy FP switching, end to end through user mode: integer-only threads never take an FPU area,
+// and vector-using threads keep their state across every switch. Benchmark: cycles per yield
+// round trip between two such threads on one core, integer-only against vector-heavy, with a
+// preemptible spinner pinned to every other core so none goes idle and steals one of the pair.
+KTEST_CASE(fpu_lazy_switch_cost) {
+    const auto* module = kernel::boot::find_module("init");
+    KTEST_REQUIRE_TRUE(module != nullptr);
+    ktl::vector<uint8_t> int_image;
+    ktl::vector<uint8_t> simd_image;
+    KTEST_REQUIRE_TRUE(make_patched_image(*module, YIELD_INT_CODE, sizeof(YIELD_INT_CODE), int_image));
+    KTEST_REQUIRE_TRUE(make_patched_image(*module, YIELD_SIMD_CODE, sizeof(YIELD_SIMD_CODE), simd_image));
+
+    uint32_t cores[CONFIG_MAX_CORES];
+    size_t online         = kernel::testing::online_cores(cores);
+    ktl::atomic<bool> run = true;
+    auto spinner          = [&] {
+        while (run.load(ktl::memory_order::relaxed)) { kernel::arch::cpu_relax(); }
+    };
+    ktl::ref<Thread> spinners[CONFIG_MAX_CORES];
+    size_t spawned = 0;
+    for (size_t i = 1; i < online; i++) {
+        auto thread = kernel::testing::spawn_fn_on("fpu-spinner", spinner, cores[i]);
+        if (thread.is_err()) { break; }
+        spinners[spawned++] = thread.unwrap();
+    }
+
+    switch_run integer;
+    switch_run simd;
+    auto runner = [&] {
+        integer = run_yield_pair(int_image, false);
+        simd    = run_yield_pair(simd_image, true);
+    };
+    auto bench = kernel::testing::spawn_fn_on("fpu-bench", runner, cores[0]);
+    if (bench.is_ok()) { bench.unwrap()->wait_signals(Thread::SIGNAL_TERMINATED); }
+    run.store(false, ktl::memory_order::relaxed);
+    for (size_t i = 0; i < spawned; i++) { spinners[i]->wait_signals(Thread::SIGNAL_TERMINATED); }
+
+    KTEST_REQUIRE_TRUE(bench.is_ok());
+    KTEST_EXPECT_TRUE(integer.ok);
+    KTEST_EXPECT_TRUE(simd.ok);
+    KTEST_METRIC("switch_cycles_int", integer.cycles_per_switch);
+    KTEST_METRIC("switch_cycles_simd", simd.cycles_per_switch);
+}
@@ -0,0 +1,185 @@
+#include <kernel/mm/buddy.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::mm;
+
+KTEST_MODULE("mm/buddy");
+
+namespace {
+
+// Deterministic xorshift so failures replay; seeded per case.
+struct rng {
+    uint64_t state;
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// 256 MiB worth of 4 KiB frames, backed by plain arrays the way the kernel backs them with page
+// descriptors and the frames themselves. Fork-per-test isolation starts every case zeroed.
+constexpr size_t FRAMES = size_t{1} << 16;
+uint8_t g_tags[FRAMES];
+buddy_link g_links[FRAMES];
+bool g_zero[FRAMES];
+
+struct array_frames {
+    uint8_t order_tag(uint64_t frame) { return frame < FRAMES ? g_tags[frame] : 0; }
+    void set_order_tag(uint64_t frame, uint8_t tag) { g_tags[frame] = tag; }
+    buddy_link& link(uint64_t frame) { return g_links[frame]; }
+    bool zeroed(uint64_t frame) { return g_zero[frame]; }
+};
+
+using buddy = buddy_allocator<array_frames>;
+constexpr size_t MAX_BLOCK = size_t{1} << buddy::MAX_ORDER;
+
+size_t zero_all(buddy& b) {
+    size_t zeroed = 0;
+    while (b.zero_step([&](uint64_t frame) {
+        g_zero[frame] = true;
+        zeroed += 1;
+    })) {}
+    return zeroed;
+}
+
+}  // namespace
+
+// A range released unaligned decomposes into aligned blocks, and releasing the missing head
+// merges everything back into one block of the enclosing order.
+KTEST_CASE(buddy_release_decomposes_and_merges) {
+    buddy b;
+    b.release(3, 13);  // 3 | 4-7 | 8-15
+    KTEST_EXPECT_ALL(b.free_frames() == 13, b.blocks(0) == 1, b.blocks(2) == 1, b.blocks(3) == 1);
+    b.release(0, 3);  // 0-1 | 2, then 2+3, 0-3, 0-7, 0-15
+    KTEST_EXPECT_ALL(b.free_frames() == 16, b.blocks(4) == 1, b.largest_block() == 16);
+    for (size_t order = 0; order < 4; ++order) { KTEST_EXPECT_EQUAL(b.blocks(order), 0u); }
+}
+
+// Splitting keeps the low half, so single frames come out of a block in address order, and
+// freeing them back in any order coalesces to the full blocks again -- the capacity a
+// page-by-page free used to lose for good.
+KTEST_CASE(buddy_page_by_page_frees_coalesce) {
+    buddy b;
+    b.release(0, FRAMES);
+    KTEST_REQUIRE_EQUAL(b.blocks(buddy::MAX_ORDER), FRAMES / MAX_BLOCK);
+
+    constexpr size_t TAKEN = 3000;
+    uint64_t taken[TAKEN];
+    for (size_t i = 0; i < TAKEN; ++i) {
+        KTEST_REQUIRE_TRUE(b.take(0, taken[i]));
+        if (i < MAX_BLOCK) { KTEST_EXPECT_EQUAL(taken[i], taken[0] + i); }
+    }
+    KTEST_EXPECT_EQUAL(b.free_frames(), FRAMES - TAKEN);
+
+    rng r{0x9e3779b97f4a7c15ull};
+    for (size_t i = TAKEN; i > 1; --i) {
+        size_t j     = r.next() % i;
+        uint64_t tmp = taken[i - 1];
+        taken[i - 1] = taken[j];
+        taken[j]     = tmp;
+    }
+    for (uint64_t frame : taken) { b.release(frame, 1); }
+    KTEST_EXPECT_ALL(b.free_frames() == FRAMES, b.blocks(buddy::MAX_ORDER) == FRAMES / MAX_BLOCK,
+                     b.largest_block() == MAX_BLOCK);
+}
+
+// A run that is not a power of two hands its block's tail straight back.
+KTEST_CASE(buddy_take_run_returns_the_tail) {
+    buddy b;
+    b.release(0, 64);
+    uint64_t run = 0;
+    KTEST_REQUIRE_TRUE(b.take_run(5, run));
+    KTEST_EXPECT_ALL(run == 0, b.free_frames() == 59, b.largest_block() == 32);
+    KTEST_EXPECT_FALSE(b.take_run(0, run));
+    KTEST_EXPECT_FALSE(b.take_run(MAX_BLOCK + 1, run));
+    b.release(run, 5);
+    KTEST_EXPECT_ALL(b.free_frames() == 64, b.blocks(6) == 1);
+}
+
+// The zeroer's view: every dirty frame is zeroed exactly once, a zeroed block moves to the clean
+// list and is preferred over a dirty one of the same order, and a merge with a clean buddy only
+// leaves the freshly dirtied half to zero.
+KTEST_CASE(buddy_zero_step_tracks_clean_blocks) {
+    buddy b;
+    b.release(0, 16);
+    KTEST_EXPECT_EQUAL(zero_all(b), 16u);
+    KTEST_EXPECT_FALSE(b.zero_step([](uint64_t) {}));
+
+    uint64_t low = 0;
+    KTEST_REQUIRE_TRUE(b.take(3, low));
+    KTEST_EXPECT_EQUAL(low, 0u);
+    for (uint64_t f = 0; f < 8; ++f) { g_zero[f] = false; }  // the owner wrote to them
+    b.release(low, 8);
+    KTEST_EXPECT_EQUAL(b.blocks(4), 1u);
+    KTEST_EXPECT_EQUAL(zero_all(b), 8u);
+
+    // Two order-0 blocks, one dirty: take prefers the clean one whatever the list order.
+    buddy c;
+    c.release(100, 1);
+    c.release(102, 1);
+    c.zero_step([](uint64_t frame) { g_zero[frame] = true; });  // cleans the dirty list's head, 102
+    uint64_t frame = 0;
+    KTEST_REQUIRE_TRUE(c.take(0, frame));
+    KTEST_EXPECT_TRUE(g_zero[frame]);
+}
+
+// Benchmark: fragmentation under churn. Two million mixed-size run allocations and frees against
+// a 64Ki-frame pool held about half full, sampling the largest run the allocator could still
+// serve. The shape a long-running kernel drives: mostly single pages (slab and table pages), some
+// small runs (stacks, large heap objects), a few hundred-page runs. Reported over time rather
+// than bounded; what must hold is that once everything is freed the pool is whole again.
+KTEST_CASE(buddy_fragmentation_churn) {
+    constexpr size_t ITERATIONS = 2'000'000;
+    constexpr size_t SLOTS      = 4096;
+    constexpr size_t SAMPLES    = 8;
+    const char* const names[]   = {"largest_run_250k",  "largest_run_500k",  "largest_run_750k",
+                                   "largest_run_1000k", "largest_run_1250k", "largest_run_1500k",
+                                   "largest_run_1750k", "largest_run_2000k"};
+    struct live_run {
+        uint64_t frame;
+        size_t count;
+    };
+    static live_run live[SLOTS];
+
+    buddy b;
+    b.release(0, FRAMES);
+    rng r{0x2545f4914f6cdd1dull};
+    uint64_t failures = 0;
+    size_t smallest   = MAX_BLOCK;
+    for (size_t i = 1; i <= ITERATIONS; ++i) {
+        live_run& slot = live[r.next() % SLOTS];
+        if (slot.count != 0) {
+            b.release(slot.frame, slot.count);
+            slot.count = 0;
+        } else {
+            uint64_t shape = r.next() % 100;
+            size_t count   = 1;
+            if (shape >= 97) {
+                count = 65 + r.next() % 448;
+            } else if (shape >= 85) {
+                count = 9 + r.next() % 56;
+            } else if (shape >= 60) {
+                count = 2 + r.next() % 7;
+            }
+            if (b.take_run(count, slot.frame)) {
+                slot.count = count;
+            } else {
+                failures += 1;
+            }
+        }
+        if (i % (ITERATIONS / SAMPLES) == 0) {
+            size_t largest = b.largest_block();
+            if (largest < smallest) { smallest = largest; }
+            KTEST_METRIC(names[i / (ITERATIONS / SAMPLES) - 1], largest);
+        }
+    }
+    KTEST_METRIC("largest_run_min", smallest);
+    KTEST_METRIC("run_alloc_failures", failures);
+
+    for (auto& slot : live) {
+        if (slot.count != 0) { b.release(slot.frame, slot.count); }
+    }
+    KTEST_EXPECT_ALL(b.free_frames() == FRAMES, b.blocks(buddy::MAX_ORDER) == FRAMES / MAX_BLOCK);
+}
@@ -82,6 +82,7 @@ KTEST_CASE(slab_heap_stress_randomized_oracle) {
         KTEST_REQUIRE_TRUE(intact(live[i]));
         g_slab_heap.free(live[i].ptr);
     }
+    g_slab_heap.drain();
 
     auto stats  = g_slab_heap.stats();
     size_t held = stats.large_allocs;
@@ -47,8 +47,9 @@ KTEST_CASE(slab_heap_grows_and_shrinks) {
     KTEST_EXPECT_TRUE(g_slab_heap.stats().classes[2].slabs == 2);
 
     for (size_t i = 0; i < held.size(); ++i) { g_slab_heap.free(held[i]); }
+    g_slab_heap.drain();  // the magazines keep a slab's worth cached; shape checks want it back
     auto after = g_slab_heap.stats();
-    KTEST_EXPECT_ALL(after.classes[2].live_objects == 0, after.classes[2].slabs == 1);
+    KTEST_EXPECT_ALL(after.classes[2].live_objects == 0, after.classes[2].slabs == 1, after.classes[2].cached == 0);
 }
 
 // Freed slots are reused before fresh ones: a full free/realloc cycle of a small batch stays
@@ -151,6 +152,7 @@ KTEST_CASE(slab_heap_mixed_churn) {
         }
     }
     for (size_t i = 0; i < held.size(); ++i) { g_slab_heap.free(held[i]); }
+    g_slab_heap.drain();
 
     auto after  = g_slab_heap.stats();
     size_t live = after.large_allocs;
@@ -160,3 +162,52 @@ KTEST_CASE(slab_heap_mixed_churn) {
     }
     KTEST_EXPECT_TRUE(live == 0);
 }
+
+// A freed batch comes back through the calling core's magazines and the depot, not the slab
+// layer: the second round of allocations misses nothing, and drain() returns every cached slot.
+KTEST_CASE(slab_heap_magazines_serve_reallocation) {
+    constexpr size_t N = 100;
+    void* held[N];
+    for (auto& p : held) {
+        p = g_slab_heap.alloc(32);
+        KTEST_REQUIRE_TRUE(p != nullptr);
+    }
+    for (auto* p : held) { g_slab_heap.free(p); }
+    // Refills take whole batches, so the cache may hold a few never-used slots beyond the N.
+    auto parked = g_slab_heap.stats().classes[1];
+    KTEST_EXPECT_ALL(parked.live_objects == 0, parked.cached >= N, parked.depot_exchanges > 0);
+
+    for (auto& p : held) {
+        p = g_slab_heap.alloc(32);
+        KTEST_REQUIRE_TRUE(p != nullptr);
+    }
+    auto reused = g_slab_heap.stats().classes[1];
+    KTEST_EXPECT_ALL(reused.magazine_misses == parked.magazine_misses, reused.cached == parked.cached - N,
+                     reused.live_objects == N, reused.magazine_hits > parked.magazine_hits);
+
+    for (auto* p : held) { g_slab_heap.free(p); }
+    g_slab_heap.drain();
+    auto drained = g_slab_heap.stats().classes[1];
+    KTEST_EXPECT_ALL(drained.cached == 0, drained.live_objects == 0, drained.slabs == 1);
+}
+
+// A slot freed twice while it sits in a magazine is caught by its cached bit, before the cache
+// could hand it out to two owners.
+KTEST_CASE_CRASH(slab_heap_double_free_of_cached_slot_panics) {
+    void* p = g_slab_heap.alloc(48);
+    KTEST_REQUIRE_TRUE(p != nullptr);
+    g_slab_heap.free(p);
+    g_slab_heap.free(p);
+}
+
+// The cached state lives in the slab header, not the slot: contents a caller chose -- here the
+// word that once served as an in-slot cached mark -- never make a first free look like a second.
+KTEST_CASE(slab_heap_free_ignores_slot_contents) {
+    auto* p = static_cast<uint64_t*>(g_slab_heap.alloc(48));
+    KTEST_REQUIRE_TRUE(p != nullptr);
+    *p = 0x6d61677a6361636bull;
+    g_slab_heap.free(p);
+    void* again = g_slab_heap.alloc(48);
+    KTEST_EXPECT_TRUE(again == p);
+    g_slab_heap.free(again);
+}
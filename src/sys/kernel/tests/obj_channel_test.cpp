@@ -1,8 +1,11 @@
+#include <kernel/mm/object_arena.h>
 #include <kernel/obj/channel.h>
 #include <kernel/sched/task.h>
 #include <kernel/testing/test_objects.h>
 #include <kernel/testing/testing.h>
 
+#include <ktl/string_view>
+
 using namespace kernel::testing;
 using namespace kernel::obj;
 
@@ -93,8 +96,51 @@ KTEST_CASE(obj_channel_empty_and_bounds) {
     KTEST_EXPECT_ERR(MessageBuffer::create(Channel::MAX_MESSAGE_BYTES + 1), ktl::errc::out_of_range);
 }
 
-// Filling the peer's queue clears the writer's WRITABLE and fails further writes immediately;
-// draining one message re-asserts it and the write goes through again.
+// Payloads on either side of every storage class boundary -- the three arenas and the page
+// fallback -- round-trip intact, and storage always starts zeroed, even in a slot a previous
+// message just gave back.
+KTEST_CASE(obj_channel_size_classes_round_trip) {
+    const size_t sizes[] = {1, 63, 64, 65, 256, 257, 1023, 1024, 1025, Channel::MAX_MESSAGE_BYTES};
+    KTEST_UNWRAP(pair, Channel::create());
+    for (size_t size : sizes) {
+        for (int round = 0; round < 2; round++) {
+            KTEST_UNWRAP(msg, MessageBuffer::create(size));
+            bool zeroed = true;
+            for (size_t i = 0; i < size; i++) { zeroed = zeroed && msg.data()[i] == 0; }
+            KTEST_EXPECT_TRUE(zeroed);
+            for (size_t i = 0; i < size; i++) { msg.data()[i] = static_cast<uint8_t>(i * 7 + size); }
+            KTEST_REQUIRE_TRUE(pair.first->write(ktl::move(msg)).is_ok());
+            KTEST_UNWRAP(got, pair.second->read(Channel::MAX_MESSAGE_BYTES));
+            KTEST_REQUIRE_EQUAL(got.size(), size);
+            bool intact = true;
+            for (size_t i = 0; i < size; i++) {
+                intact = intact && got.data()[i] == static_cast<uint8_t>(i * 7 + size);
+            }
+            KTEST_EXPECT_TRUE(intact);
+        }
+    }
+}
+
+// Small payloads come from the size-class arenas, not the page allocator, and go back on
+// destruction.
+KTEST_CASE(obj_channel_small_messages_use_arenas) {
+    kernel::mm::object_arena* arena = nullptr;
+    for (auto* a = kernel::mm::object_arena::first_arena(); a; a = a->next_arena()) {
+        auto name = ktl::string_view(a->stats().name);
+        if (name == "channel-msg-64") { arena = a; }
+    }
+    KTEST_REQUIRE_TRUE(arena != nullptr);
+    size_t live = arena->stats().live;
+    {
+        KTEST_UNWRAP(msg, MessageBuffer::create(16));
+        KTEST_EXPECT_EQUAL(arena->stats().live, live + 1);
+    }
+    KTEST_EXPECT_EQUAL(arena->stats().live, live);
+}
+
+// Filling the peer's queue clears the writer's WRITABLE and fails further writes immediately.
+// Draining one message makes room -- a write goes through again -- but WRITABLE stays clear until
+// the queue is down to half its depth, so a waiting writer wakes to a batch of room.
 KTEST_CASE(obj_channel_full_queue_flow_control) {
     KTEST_UNWRAP(pair, Channel::create());
 
@@ -106,8 +152,65 @@ KTEST_CASE(obj_channel_full_queue_flow_control) {
     KTEST_EXPECT_ERR(pair.first->write(message_of("overflow")), ktl::errc::capacity_exhausted);
 
     KTEST_EXPECT_TRUE(pair.second->read(64).is_ok());
-    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) == 0);
     KTEST_EXPECT_TRUE(pair.first->write(message_of("fits now")).is_ok());
+
+    for (size_t i = 0; i < Channel::QUEUE_DEPTH / 2 - 1; i++) { KTEST_EXPECT_TRUE(pair.second->read(64).is_ok()); }
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) == 0);
+    KTEST_EXPECT_TRUE(pair.second->read(64).is_ok());
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
+}
+
+// A deep pair's queue grows past its first ring, keeps FIFO order across the growth, and stops at
+// the depth it was created with; a depth of 0 or past the limit is refused.
+KTEST_CASE(obj_channel_configured_depth) {
+    KTEST_EXPECT_ERR(Channel::create(0), ktl::errc::out_of_range);
+    KTEST_EXPECT_ERR(Channel::create(Channel::MAX_QUEUE_DEPTH + 1), ktl::errc::out_of_range);
+    KTEST_EXPECT_ERR(Channel::create(Channel::QUEUE_DEPTH, Channel::MAX_BYTE_BUDGET + 1), ktl::errc::out_of_range);
+
+    constexpr size_t DEPTH = 4 * Channel::QUEUE_DEPTH + 3;
+    KTEST_UNWRAP(pair, Channel::create(DEPTH));
+    for (size_t i = 0; i < DEPTH; i++) {
+        auto msg = MessageBuffer::create(1).unwrap();
+        msg.data()[0] = static_cast<uint8_t>(i);
+        KTEST_REQUIRE_TRUE(pair.first->write(ktl::move(msg)).is_ok());
+        if (i == Channel::QUEUE_DEPTH / 2) { KTEST_REQUIRE_TRUE(pair.second->read(64).is_ok()); }
+    }
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
+    KTEST_REQUIRE_TRUE(pair.first->write(message_of("z")).is_ok());
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) == 0);
+    KTEST_EXPECT_ERR(pair.first->write(message_of("over")), ktl::errc::capacity_exhausted);
+
+    for (size_t i = 1; i < DEPTH; i++) {
+        KTEST_UNWRAP(msg, pair.second->read(64));
+        KTEST_EXPECT_EQUAL(static_cast<size_t>(msg.data()[0]), i);
+    }
+    KTEST_UNWRAP(last, pair.second->read(64));
+    KTEST_EXPECT_TRUE(payload_equals(last, "z"));
+}
+
+// The byte budget bounds the queue before its depth does: a write that would pass it is refused
+// and stalls the writer, but an empty queue still takes a message larger than the whole budget.
+KTEST_CASE(obj_channel_byte_budget) {
+    KTEST_UNWRAP(pair, Channel::create(Channel::QUEUE_DEPTH, 8));
+    KTEST_REQUIRE_TRUE(pair.first->write(message_of("abcd")).is_ok());
+    KTEST_REQUIRE_TRUE(pair.first->write(message_of("ef")).is_ok());
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
+
+    KTEST_EXPECT_ERR(pair.first->write(message_of("ghi")), ktl::errc::capacity_exhausted);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) == 0);
+
+    // Down to two bytes queued: half the budget, and WRITABLE is back.
+    KTEST_REQUIRE_TRUE(pair.second->read(64).is_ok());
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
+    KTEST_REQUIRE_TRUE(pair.second->read(64).is_ok());
+
+    KTEST_REQUIRE_TRUE(pair.first->write(message_of("longer than eight")).is_ok());
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) == 0);
+    KTEST_EXPECT_ERR(pair.first->write(message_of("x")), ktl::errc::capacity_exhausted);
+    KTEST_UNWRAP(big, pair.second->read(64));
+    KTEST_EXPECT_TRUE(payload_equals(big, "longer than eight"));
+    KTEST_EXPECT_TRUE((pair.first->signals() & Channel::SIGNAL_WRITABLE) != 0);
 }
 
 // A message wider than the reader's capacity fails with truncated and is discarded -- leaving it
@@ -144,76 +247,96 @@ KTEST_CASE(obj_channel_peer_close) {
     KTEST_EXPECT_ERR(pair.second->read(64), ktl::errc::peer_closed);
 }
 
-// Handle escrow: a message owns kernel-table entries for handles in transit. They ride FIFO with
-// the payload, a reader without room for them discards the message (closing its handles in the
-// kernel table), and detaching hands them onward with rights intact and the kernel table back at
-// its baseline.
-KTEST_CASE(obj_channel_escrow_rides_message) {
-    auto& escrow    = kernel::sched::kernel_task()->handles();
-    size_t baseline = escrow.count();
+// Handles in transit: a message owns the references and rights its handles carry, and no table --
+// the kernel's included -- holds them meanwhile. They ride FIFO with the payload, a reader without
+// room for them discards the message (dropping its handles), and detaching hands them onward with
+// rights intact.
+KTEST_CASE(obj_channel_handles_ride_message) {
+    auto& kernel_table = kernel::sched::kernel_task()->handles();
+    size_t baseline    = kernel_table.count();
 
     KTEST_UNWRAP(pair, Channel::create());
-    bool lost = false;
-    KTEST_UNWRAP(doomed, escrow.emplace<TestObjA>(RIGHT_READ, &lost));
+    bool lost    = false;
     auto no_room = message_of("no room for cargo");
-    KTEST_REQUIRE_TRUE(no_room.attach_handle(doomed));
+    KTEST_REQUIRE_TRUE(no_room.attach_handle({ktl::make_ref<TestObjA>(&lost), RIGHT_READ}));
     KTEST_REQUIRE_TRUE(pair.first->write(ktl::move(no_room)).is_ok());
 
     KTEST_EXPECT_ERR(pair.second->read(64, 0), ktl::errc::truncated);
-    KTEST_EXPECT_ALL(lost, escrow.count() == baseline);
+    KTEST_EXPECT_TRUE(lost);
     KTEST_EXPECT_TRUE((pair.second->signals() & Channel::SIGNAL_READABLE) == 0);
 
     bool destroyed = false;
-    KTEST_UNWRAP(cargo, escrow.emplace<TestObjA>(RIGHT_READ, &destroyed));
-    auto msg = message_of("with cargo");
-    KTEST_REQUIRE_TRUE(msg.attach_handle(cargo));
+    auto msg       = message_of("with cargo");
+    KTEST_REQUIRE_TRUE(msg.attach_handle({ktl::make_ref<TestObjA>(&destroyed), RIGHT_READ}));
     KTEST_REQUIRE_TRUE(pair.first->write(ktl::move(msg)).is_ok());
+    KTEST_EXPECT_TRUE(kernel_table.count() == baseline);
 
     KTEST_UNWRAP(arrived, pair.second->read(64));
     KTEST_EXPECT_ALL(payload_equals(arrived, "with cargo"), arrived.handle_count() == 1);
 
-    HandleId ids[MessageBuffer::MAX_HANDLES];
-    KTEST_REQUIRE_TRUE(arrived.detach_handles(ids) == 1);
-    KTEST_UNWRAP(taken, escrow.take(ids[0]));
-    KTEST_EXPECT_ALL(taken.rights == RIGHT_READ, !destroyed, escrow.count() == baseline);
-    taken.object.reset();
+    VerifiedHandle carried[MessageBuffer::MAX_HANDLES];
+    KTEST_REQUIRE_TRUE(arrived.detach_handles(carried) == 1);
+    KTEST_EXPECT_ALL(carried[0].rights == RIGHT_READ, !destroyed, arrived.handle_count() == 0);
+    carried[0].object.reset();
     KTEST_EXPECT_TRUE(destroyed);
 }
 
-// The channel dies with a handle-carrying message still queued: the kernel closes the escrowed
+// A message holds every slot up to MAX_HANDLES and refuses the next, dropping the refused handle.
+// The slots are one block from their own arena, taken on the first attach -- or ahead of it by
+// reserve_handles -- and returned with the message.
+KTEST_CASE(obj_channel_message_handle_capacity) {
+    kernel::mm::object_arena* arena = nullptr;
+    for (auto* a = kernel::mm::object_arena::first_arena(); a; a = a->next_arena()) {
+        if (ktl::string_view(a->stats().name) == "channel-handles") { arena = a; }
+    }
+    KTEST_REQUIRE_TRUE(arena != nullptr);
+    size_t live = arena->stats().live;
+    {
+        auto msg = message_of("full");
+        KTEST_EXPECT_EQUAL(arena->stats().live, live);
+        KTEST_REQUIRE_TRUE(msg.reserve_handles());
+        KTEST_REQUIRE_TRUE(msg.reserve_handles());
+        KTEST_EXPECT_EQUAL(arena->stats().live, live + 1);
+        for (size_t i = 0; i < MessageBuffer::MAX_HANDLES; i++) {
+            KTEST_REQUIRE_TRUE(msg.attach_handle({ktl::make_ref<TestObjA>(), RIGHT_READ}));
+        }
+        bool refused = false;
+        KTEST_EXPECT_FALSE(msg.attach_handle({ktl::make_ref<TestObjA>(&refused), RIGHT_READ}));
+        KTEST_EXPECT_ALL(refused, msg.handle_count() == MessageBuffer::MAX_HANDLES, arena->stats().live == live + 1);
+    }
+    KTEST_EXPECT_EQUAL(arena->stats().live, live);
+}
+
+// The channel dies with a handle-carrying message still queued: the kernel closes the carried
 // handle normally -- no in-flight state survives the queue it rode in.
-KTEST_CASE(obj_channel_escrow_closed_with_channel) {
-    auto& escrow    = kernel::sched::kernel_task()->handles();
-    size_t baseline = escrow.count();
-    bool destroyed  = false;
+KTEST_CASE(obj_channel_handles_closed_with_channel) {
+    bool destroyed = false;
     {
         KTEST_UNWRAP(pair, Channel::create());
-        KTEST_UNWRAP(cargo, escrow.emplace<TestObjA>(RIGHT_READ, &destroyed));
         auto msg = message_of("never read");
-        KTEST_REQUIRE_TRUE(msg.attach_handle(cargo));
+        KTEST_REQUIRE_TRUE(msg.attach_handle({ktl::make_ref<TestObjA>(&destroyed), RIGHT_READ}));
         KTEST_REQUIRE_TRUE(pair.first->write(ktl::move(msg)).is_ok());
         KTEST_EXPECT_FALSE(destroyed);
     }
-    KTEST_EXPECT_ALL(destroyed, escrow.count() == baseline);
+    KTEST_EXPECT_TRUE(destroyed);
 }
 
 // Neither endpoint may ride through its own pair: the peer would land in its own inbound queue,
 // forming queue -> message -> endpoint -> queue, while the sender would form the mirror cycle.
-KTEST_CASE(obj_channel_rejects_pair_endpoint_in_escrow) {
-    auto& escrow    = kernel::sched::kernel_task()->handles();
-    size_t baseline = escrow.count();
-
+KTEST_CASE(obj_channel_rejects_pair_endpoint_in_transit) {
     KTEST_UNWRAP(pair, Channel::create());
-    KTEST_UNWRAP(peer, escrow.insert(pair.second, Channel::DEFAULT_RIGHTS));
     auto peer_message = message_of("peer");
-    KTEST_REQUIRE_TRUE(peer_message.attach_handle(peer));
+    KTEST_REQUIRE_TRUE(peer_message.attach_handle({pair.second, Channel::DEFAULT_RIGHTS}));
     KTEST_EXPECT_ERR(pair.first->write(ktl::move(peer_message)), ktl::errc::invalid_operation);
-    KTEST_EXPECT_TRUE(escrow.count() == baseline);
 
-    KTEST_UNWRAP(sender, escrow.insert(pair.first, Channel::DEFAULT_RIGHTS));
     auto sender_message = message_of("sender");
-    KTEST_REQUIRE_TRUE(sender_message.attach_handle(sender));
+    KTEST_REQUIRE_TRUE(sender_message.attach_handle({pair.first, Channel::DEFAULT_RIGHTS}));
     KTEST_EXPECT_ERR(pair.first->write(ktl::move(sender_message)), ktl::errc::invalid_operation);
-    KTEST_EXPECT_TRUE(escrow.count() == baseline);
     KTEST_EXPECT_ERR(pair.second->read(64), ktl::errc::would_block);
+
+    // An endpoint of another pair is ordinary cargo.
+    KTEST_UNWRAP(other, Channel::create());
+    auto other_message = message_of("other");
+    KTEST_REQUIRE_TRUE(other_message.attach_handle({other.second, Channel::DEFAULT_RIGHTS}));
+    KTEST_EXPECT_TRUE(pair.first->write(ktl::move(other_message)).is_ok());
 }
@@ -1,3 +1,4 @@
+#include <kernel/mm/object_arena.h>
 #include <kernel/sched/task.h>
 #include <kernel/testing/test_objects.h>
 #include <kernel/testing/testing.h>
@@ -57,6 +58,29 @@ KTEST_CASE(obj_handle_table_take_moves_reference) {
     KTEST_EXPECT_TRUE(destroyed);
 }
 
+// A reserved slot is invisible until committed -- not live, not counted, not handed to another
+// insert -- and the committed handle is the reserved id. A cancelled slot is the next one issued.
+KTEST_CASE(obj_handle_table_reserve_commit_cancel) {
+    HandleTable table;
+    KTEST_UNWRAP(reserved, table.reserve(TEST_TYPE_A, RIGHT_READ));
+    KTEST_EXPECT_ALL(!table.is_valid(reserved), table.count() == 0);
+    KTEST_UNWRAP(other, table.emplace<TestObjA>(RIGHT_READ));
+    KTEST_EXPECT_TRUE(other.index != reserved.index);
+
+    table.commit(reserved, ktl::make_ref<TestObjA>(), RIGHT_READ);
+    KTEST_EXPECT_ALL(table.is_valid(reserved), table.count() == 2);
+    KTEST_UNWRAP(got, table.verify(reserved, RIGHT_READ, TEST_TYPE_A));
+    KTEST_EXPECT_TRUE(got.rights == RIGHT_READ);
+
+    KTEST_UNWRAP(cancelled, table.reserve(TEST_TYPE_A, RIGHT_READ));
+    table.cancel(cancelled);
+    KTEST_UNWRAP(reused, table.emplace<TestObjA>(RIGHT_READ));
+    KTEST_EXPECT_ALL(reused == cancelled, table.count() == 3);
+
+    // The type and rights checks happen at reserve, so commit has nothing left to refuse.
+    KTEST_EXPECT_ERR(table.reserve(TEST_TYPE_UNREGISTERED, RIGHT_READ), ktl::errc::wrong_type);
+}
+
 KTEST_CASE(obj_handle_table_generation_counter) {
     HandleTable table;
     KTEST_UNWRAP(id1, table.emplace<TestObjA>(RIGHTS_ALL));
@@ -113,6 +137,34 @@ KTEST_CASE(obj_handle_table_growth) {
     KTEST_EXPECT_TRUE(table.get<TestObjA>(first_id).is_ok());
 }
 
+// Entries come in arena-backed chunks that never move, so ids handed out early stay where they
+// are as the table grows past several chunks and a directory doubling, and a destroyed table
+// gives every chunk back.
+KTEST_CASE(obj_handle_table_chunked_growth) {
+    kernel::mm::object_arena* arena = nullptr;
+    for (auto* a = kernel::mm::object_arena::first_arena(); a; a = a->next_arena()) {
+        if (ktl::string_view(a->stats().name) == "handle-chunk") { arena = a; }
+    }
+    KTEST_REQUIRE_TRUE(arena != nullptr);
+    size_t live = arena->stats().live;
+
+    constexpr uint32_t HANDLES = 300;  // ten chunks of 32; the directory starts with eight
+    auto object                = ktl::make_ref<TestObjA>();
+    KTEST_REQUIRE_TRUE(static_cast<bool>(object));
+    {
+        HandleTable table;
+        for (uint32_t i = 0; i < HANDLES; i++) {
+            KTEST_UNWRAP(id, table.insert(object, RIGHTS_ALL));
+            KTEST_REQUIRE_TRUE(id == (HandleId{i, 0}));
+        }
+        KTEST_EXPECT_EQUAL(arena->stats().live, live + 10);
+        for (uint32_t i = 0; i < HANDLES; i++) { KTEST_EXPECT_TRUE(table.get<TestObjA>(HandleId{i, 0}).is_ok()); }
+        // Generations stop below bit 31; an id carrying it was never issued and names nothing.
+        KTEST_EXPECT_ERR(table.verify(HandleId{0, 0x80000000u}, 0), ktl::errc::handle_invalid);
+    }
+    KTEST_EXPECT_EQUAL(arena->stats().live, live);
+}
+
 KTEST_CASE(obj_handle_table_invalid_handle) {
     HandleTable table;
     KTEST_EXPECT_FALSE(table.is_valid(HandleId::invalid()));
@@ -0,0 +1,200 @@
+#include <abi/otp.h>
+#include <abi/syscall.h>
+#include <kernel/obj/handle_dispatch.h>
+#include <kernel/obj/otp.h>
+#include <kernel/testing/test_objects.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::testing;
+using namespace kernel::obj;
+
+namespace sys = abi::syscall;
+namespace isa = abi::otp;
+
+KTEST_MODULE_WITH_INIT("obj/otp", otp_init);
+
+static void otp_init() { register_all_test_types(); }
+
+namespace {
+
+otp::insn op(uint8_t code, uint8_t dst = 0, uint8_t src = 0, uint8_t width = 0, uint32_t off = 0, uint64_t imm = 0) {
+    return otp::insn{code, dst, src, width, off, imm};
+}
+
+uint64_t as_ret(ktl::errc error) { return static_cast<uint64_t>(error); }
+
+template <size_t N> ktl::result<ktl::ref<otp::Program>> build(const otp::insn (&code)[N], size_t storage = 0) {
+    return otp::Program::create(code, N, isa::VERSION, storage);
+}
+
+template <size_t N> ktl::result<void> attach(const otp::insn (&code)[N]) {
+    return g_type_registry.attach_program(TEST_TYPE_STORED, code, N, isa::VERSION);
+}
+
+uint64_t invoke(HandleTable& table, HandleId id, uint64_t opcode, uint64_t arg = 0) {
+    return dispatch_handle_op(table, sys::SYS_OBJ_INVOKE, pack_handle(id), opcode, arg);
+}
+
+// A counter type's fast path: opcode 1 reads the 8-byte counter at offset 0, opcode 2 bumps it
+// and asserts signal bit 0, opcode 3 rejects callers without the write right; anything else goes
+// to the server.
+const otp::insn COUNTER[] = {
+    op(isa::OP_LDM, 1, 0, 0, isa::META_OPCODE),
+    op(isa::OP_LDS, 0, 0, 8, 0),
+    op(isa::OP_CMP_EQ, 1, isa::SRC_IMM, 0, 0, 1),
+    op(isa::OP_JF, 0, 0, 0, 1),
+    op(isa::OP_COMPLETE, 0, 0),
+    op(isa::OP_CMP_EQ, 1, isa::SRC_IMM, 0, 0, 2),
+    op(isa::OP_JF, 0, 0, 0, 4),
+    op(isa::OP_ADD, 0, isa::SRC_IMM, 0, 0, 1),
+    op(isa::OP_STS, 0, 0, 8, 0),
+    op(isa::OP_SIGNAL_SET, 0, 0, 0, 0, 1),
+    op(isa::OP_COMPLETE, 0, 0),
+    op(isa::OP_CMP_EQ, 1, isa::SRC_IMM, 0, 0, 3),
+    op(isa::OP_JF, 0, 0, 0, 4),
+    op(isa::OP_LDM, 2, 0, 0, isa::META_RIGHTS),
+    op(isa::OP_TEST, 2, isa::SRC_IMM, 0, 0, RIGHT_WRITE),
+    op(isa::OP_JT, 0, 0, 0, 1),
+    op(isa::OP_REJECT, 0, 0, 0, 0, static_cast<uint64_t>(ktl::errc::rights_violation)),
+    op(isa::OP_DISPATCH),
+};
+
+}  // namespace
+
+// The smallest valid program, and the structural faults that keep a program from attaching.
+KTEST_CASE(otp_validate_structure) {
+    const otp::insn minimal[] = {op(isa::OP_COMPLETE, 0, 0)};
+    KTEST_EXPECT_TRUE(build(minimal).is_ok());
+
+    const otp::insn falls_off[]    = {op(isa::OP_LDI, 0, 0, 0, 0, 1)};
+    const otp::insn jumps_past[]   = {op(isa::OP_JMP, 0, 0, 0, 1), op(isa::OP_DISPATCH)};
+    const otp::insn unknown[]      = {op(0x7F), op(isa::OP_DISPATCH)};
+    const otp::insn bad_register[] = {op(isa::OP_MOV, isa::REGISTERS, 0), op(isa::OP_DISPATCH)};
+    const otp::insn bad_shift[]    = {op(isa::OP_SHL, 0, 0, 0, 0, 64), op(isa::OP_DISPATCH)};
+    const otp::insn bad_width[]    = {op(isa::OP_LDS, 0, 0, 3, 0), op(isa::OP_DISPATCH)};
+    const otp::insn not_an_error[] = {op(isa::OP_REJECT, 0, 0, 0, 0, 5)};
+    KTEST_EXPECT_ERR(build(falls_off), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(jumps_past), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(unknown), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(bad_register), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(bad_shift), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(bad_width, 64), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(build(not_an_error), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(otp::Program::create(minimal, 1, 0, 0), ktl::errc::invalid_operation);
+    KTEST_EXPECT_ERR(otp::Program::create(minimal, 1, isa::VERSION + 1, 0), ktl::errc::invalid_operation);
+}
+
+// Storage accesses are bounded by the declared size at creation, never at execution; the extent
+// and write flag the dispatch path keys on come out of the same pass.
+KTEST_CASE(otp_validate_bounds) {
+    const otp::insn last_word[] = {op(isa::OP_LDS, 0, 0, 8, 56), op(isa::OP_STS, 0, 0, 4, 0), op(isa::OP_DISPATCH)};
+    KTEST_UNWRAP(program, build(last_word, 64));
+    KTEST_EXPECT_ALL(program->storage_extent() == 64, program->writes_storage(), program->length() == 3);
+    KTEST_EXPECT_ERR(build(last_word, 63), ktl::errc::out_of_range);
+    KTEST_EXPECT_ERR(build(last_word), ktl::errc::out_of_range);
+
+    const otp::insn meta_past_end[] = {op(isa::OP_LDM, 0, 0, 0, isa::META_COUNT), op(isa::OP_DISPATCH)};
+    KTEST_EXPECT_ERR(build(meta_past_end), ktl::errc::out_of_range);
+
+    const otp::insn read_only[] = {op(isa::OP_LDS, 0, 0, 1, 0), op(isa::OP_COMPLETE, 0, 0)};
+    KTEST_UNWRAP(reader, build(read_only, 1));
+    KTEST_EXPECT_ALL(reader->storage_extent() == 1, !reader->writes_storage());
+}
+
+// Length and worst-case cost are both budgeted: a full-length program of register work fits, the
+// same length of signal changes does not.
+KTEST_CASE(otp_validate_budget) {
+    static otp::insn code[isa::MAX_INSNS + 1];
+    for (auto& in : code) { in = op(isa::OP_ADD, 0, isa::SRC_IMM, 0, 0, 1); }
+    code[isa::MAX_INSNS - 1] = op(isa::OP_COMPLETE, 0, 0);
+    KTEST_UNWRAP(longest, otp::Program::create(code, isa::MAX_INSNS, isa::VERSION, 0));
+    KTEST_EXPECT_TRUE(longest->cost() == isa::MAX_INSNS);
+    code[isa::MAX_INSNS] = op(isa::OP_COMPLETE, 0, 0);
+    KTEST_EXPECT_ERR(otp::Program::create(code, isa::MAX_INSNS + 1, isa::VERSION, 0), ktl::errc::capacity_exhausted);
+
+    for (size_t i = 0; i + 1 < isa::MAX_INSNS; i++) { code[i] = op(isa::OP_SIGNAL_SET, 0, 0, 0, 0, 1); }
+    KTEST_EXPECT_ERR(otp::Program::create(code, isa::MAX_INSNS, isa::VERSION, 0), ktl::errc::capacity_exhausted);
+}
+
+// Arithmetic, comparison and forward jumps, run directly: clamp the argument to 100 and scale it.
+KTEST_CASE(otp_run_arithmetic_and_branches) {
+    const otp::insn clamp[] = {
+        op(isa::OP_LDM, 0, 0, 0, isa::META_ARG),
+        op(isa::OP_CMP_LT, 0, isa::SRC_IMM, 0, 0, 100),
+        op(isa::OP_JT, 0, 0, 0, 1),
+        op(isa::OP_LDI, 0, 0, 0, 0, 100),
+        op(isa::OP_MOV, 1, 0),
+        op(isa::OP_SHL, 1, 0, 0, 0, 2),
+        op(isa::OP_SUB, 1, 0),
+        op(isa::OP_XOR, 1, isa::SRC_IMM, 0, 0, 0x1),
+        op(isa::OP_COMPLETE, 0, 1),
+    };
+    KTEST_UNWRAP(program, build(clamp));
+    otp::context small{{0, 0, 7, 0}};
+    otp::context large{{0, 0, 5000, 0}};
+    otp::verdict a = otp::run(*program, small);
+    otp::verdict b = otp::run(*program, large);
+    KTEST_EXPECT_ALL(a.kind == otp::outcome::COMPLETE, a.value == ((7 * 3) ^ 1), b.value == ((100 * 3) ^ 1));
+}
+
+// The whole pipeline: reads and writes complete in the kernel, a rights check rejects, and an
+// opcode the program does not handle reaches the dispatch stage, which has no server to go to.
+KTEST_CASE(otp_dispatch_completes_rejects_and_dispatches) {
+    KTEST_REQUIRE_TRUE(attach(COUNTER).is_ok());
+    HandleTable table;
+    KTEST_UNWRAP(id, table.emplace<TestObjStored>(RIGHT_READ | RIGHT_WRITE | RIGHT_DUPLICATE));
+    KTEST_UNWRAP(read_only, table.duplicate(id, RIGHT_READ));
+
+    KTEST_EXPECT_TRUE(invoke(table, id, 1) == 0);
+    for (uint64_t i = 1; i <= 3; i++) { KTEST_EXPECT_TRUE(invoke(table, id, 2) == i); }
+    KTEST_EXPECT_TRUE(invoke(table, read_only, 1) == 3);
+    KTEST_UNWRAP(object, table.get<TestObjStored>(id));
+    KTEST_EXPECT_TRUE((object->signals() & 1) != 0);
+
+    KTEST_EXPECT_TRUE(invoke(table, read_only, 3) == as_ret(ktl::errc::rights_violation));
+    KTEST_EXPECT_TRUE(invoke(table, id, 3) == as_ret(ktl::errc::invalid_operation));
+    KTEST_EXPECT_TRUE(invoke(table, id, 9) == as_ret(ktl::errc::invalid_operation));
+    KTEST_EXPECT_TRUE(invoke(table, id, 1) == 3);
+}
+
+// A program that stores and signals, then dispatches, leaves no trace: both effects apply only on
+// completion.
+KTEST_CASE(otp_dispatch_discards_effects_of_uncompleted_runs) {
+    const otp::insn scribble[] = {
+        op(isa::OP_LDI, 0, 0, 0, 0, 0xFF),
+        op(isa::OP_STS, 0, 0, 1, 0),
+        op(isa::OP_SIGNAL_SET, 0, 0, 0, 0, 2),
+        op(isa::OP_DISPATCH),
+    };
+    KTEST_REQUIRE_TRUE(attach(scribble).is_ok());
+    HandleTable table;
+    KTEST_UNWRAP(id, table.emplace<TestObjStored>(RIGHT_READ));
+    KTEST_EXPECT_TRUE(invoke(table, id, 0) == as_ret(ktl::errc::invalid_operation));
+    KTEST_UNWRAP(object, table.get<TestObjStored>(id));
+    KTEST_EXPECT_ALL(object->inline_storage().data()[0] == 0, (object->signals() & 2) == 0);
+}
+
+// Attachment is all-or-nothing: a failed attach keeps the previous program, and kernel-defined
+// operations never run one.
+KTEST_CASE(otp_attach_replaces_only_on_success) {
+    KTEST_REQUIRE_TRUE(attach(COUNTER).is_ok());
+    auto before = g_type_registry.program(TEST_TYPE_STORED);
+    const otp::insn out_of_bounds[] = {op(isa::OP_LDS, 0, 0, 8, TEST_STORED_BYTES), op(isa::OP_DISPATCH)};
+    KTEST_EXPECT_ERR(attach(out_of_bounds), ktl::errc::out_of_range);
+    KTEST_EXPECT_TRUE(g_type_registry.program(TEST_TYPE_STORED).get() == before.get());
+    KTEST_EXPECT_ERR(g_type_registry.attach_program(TEST_TYPE_UNREGISTERED, COUNTER, 1, isa::VERSION),
+                     ktl::errc::wrong_type);
+
+    HandleTable table;
+    KTEST_UNWRAP(id, table.emplace<TestObjStored>(RIGHT_READ));
+    uint64_t info = dispatch_handle_op(table, sys::SYS_OBJ_INFO, pack_handle(id), 0);
+    KTEST_EXPECT_TRUE((info & 0xFFFFFFFF) == TEST_TYPE_STORED);
+}
+
+// A type may declare at most CONFIG_OBJECT_MAX_INLINE_STORAGE bytes.
+KTEST_CASE(otp_storage_declaration_is_bounded) {
+    TypeRegistry registry;
+    constexpr uint32_t MAX = CONFIG_OBJECT_MAX_INLINE_STORAGE;
+    KTEST_EXPECT_TRUE(registry.register_type(10, "fits", RIGHTS_ALL, RIGHT_READ, MAX).is_ok());
+    KTEST_EXPECT_ERR(registry.register_type(11, "too_big", RIGHTS_ALL, RIGHT_READ, MAX + 1), ktl::errc::out_of_range);
+}
@@ -113,3 +113,42 @@ KTEST_CASE(obj_port_two_sources_fifo) {
     KTEST_EXPECT_TRUE(packet.key == 100);
     KTEST_EXPECT_FALSE(port->dequeue(packet));
 }
+
+// A multi-packet dequeue pops oldest first up to its capacity and leaves READABLE up while any
+// remain. One object bound to two ports feeds both, and unbinding from one leaves the other's
+// binding on the object's list and delivering.
+KTEST_CASE(obj_port_dequeue_many_across_ports) {
+    auto port   = ktl::make_ref<Port>();
+    auto other  = ktl::make_ref<Port>();
+    auto first  = ktl::make_ref<Event>();
+    auto second = ktl::make_ref<Event>();
+    auto third  = ktl::make_ref<Event>();
+    KTEST_REQUIRE_TRUE(port && other && first && second && third);
+    KTEST_REQUIRE_TRUE(port->bind(first, 1, 0b1).is_ok());
+    KTEST_REQUIRE_TRUE(port->bind(second, 2, 0b1).is_ok());
+    KTEST_REQUIRE_TRUE(port->bind(third, 3, 0b1).is_ok());
+    KTEST_REQUIRE_TRUE(other->bind(first, 10, 0b1).is_ok());
+
+    third->signal_set(0b1);
+    first->signal_set(0b1);
+    second->signal_set(0b1);
+
+    Port::Packet packets[4];
+    KTEST_REQUIRE_TRUE(port->dequeue(packets, 2) == 2);
+    KTEST_EXPECT_ALL(packets[0].key == 3, packets[1].key == 1);
+    KTEST_EXPECT_TRUE((port->signals() & Port::SIGNAL_READABLE) != 0);
+    KTEST_REQUIRE_TRUE(port->dequeue(packets, 4) == 1);
+    KTEST_EXPECT_TRUE(packets[0].key == 2);
+    KTEST_EXPECT_TRUE((port->signals() & Port::SIGNAL_READABLE) == 0);
+    KTEST_EXPECT_TRUE(port->dequeue(packets, 4) == 0);
+
+    KTEST_REQUIRE_TRUE(other->dequeue(packets, 4) == 1);
+    KTEST_EXPECT_TRUE(packets[0].key == 10);
+
+    KTEST_EXPECT_TRUE(port->unbind(1) == 1);
+    first->signal_clear(0b1);
+    first->signal_set(0b1);
+    KTEST_EXPECT_TRUE(port->dequeue(packets, 4) == 0);
+    KTEST_REQUIRE_TRUE(other->dequeue(packets, 4) == 1);
+    KTEST_EXPECT_TRUE(packets[0].key == 10);
+}
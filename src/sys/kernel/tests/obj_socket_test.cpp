@@ -136,3 +136,98 @@ KTEST_CASE(obj_socket_peer_close_semantics) {
     char buf[8];
     KTEST_EXPECT_ERR(pair.second->read(buf, sizeof(buf)), ktl::errc::peer_closed);
 }
+
+// A multi-page ring: capacity rounds up to whole pages and bounds the buffer, the byte pattern
+// survives the page seams and the wrap, and create refuses sizes it cannot honour.
+KTEST_CASE(obj_socket_multi_page_ring) {
+    KTEST_EXPECT_ERR(Socket::create(0), ktl::errc::out_of_range);
+    KTEST_EXPECT_ERR(Socket::create(Socket::MAX_BUFFER_BYTES + 1), ktl::errc::out_of_range);
+    KTEST_UNWRAP(pair, Socket::create(3 * 4096 - 100));
+    KTEST_EXPECT_EQUAL(pair.first->capacity(), 3u * 4096);
+
+    uint8_t chunk[1000];
+    size_t total = 0;
+    for (;;) {
+        for (size_t i = 0; i < sizeof(chunk); i++) { chunk[i] = static_cast<uint8_t>((total + i) * 7); }
+        auto wrote = pair.first->write(chunk, sizeof(chunk));
+        if (wrote.is_err()) { break; }
+        total += wrote.unwrap();
+    }
+    KTEST_EXPECT_EQUAL(total, 3u * 4096);
+
+    // Drain and refill part of it so the next pass reads across the wrap.
+    size_t expect = 0;
+    for (size_t pass = 0; pass < 2; pass++) {
+        uint8_t out[1500];
+        for (size_t drained = 0; drained < 2 * 4096;) {
+            KTEST_UNWRAP(got, pair.second->read(out, sizeof(out)));
+            for (size_t i = 0; i < got; i++) {
+                KTEST_REQUIRE_TRUE(out[i] == static_cast<uint8_t>((expect + i) * 7));
+            }
+            expect  += got;
+            drained += got;
+        }
+        for (size_t refill = 0; refill < 2 * 4096;) {
+            for (size_t i = 0; i < sizeof(chunk); i++) { chunk[i] = static_cast<uint8_t>((total + i) * 7); }
+            KTEST_UNWRAP(wrote, pair.first->write(chunk, sizeof(chunk)));
+            total  += wrote;
+            refill += wrote;
+        }
+    }
+}
+
+// Vectored transfer: runs gather into one stream and scatter back across a different split,
+// and a vector longer than the free space stops where the buffer fills.
+KTEST_CASE(obj_socket_vectored_runs) {
+    KTEST_UNWRAP(pair, Socket::create());
+
+    char a[] = "scatter", b[] = "/gather";
+    const Socket::run out[] = {{reinterpret_cast<uint8_t*>(a), 7}, {reinterpret_cast<uint8_t*>(b), 7}};
+    KTEST_UNWRAP(wrote, pair.first->write(out, 2));
+    KTEST_EXPECT_EQUAL(wrote, 14u);
+
+    char x[3], y[32];
+    const Socket::run in[] = {{reinterpret_cast<uint8_t*>(x), sizeof(x)}, {reinterpret_cast<uint8_t*>(y), sizeof(y)}};
+    KTEST_UNWRAP(got, pair.second->read(in, 2));
+    KTEST_EXPECT_EQUAL(got, 14u);
+    KTEST_EXPECT_ALL(x[0] == 's', x[2] == 'a', y[0] == 't', y[10] == 'r');
+
+    static uint8_t big[Socket::BUFFER_BYTES];
+    const Socket::run fill[] = {{big, Socket::BUFFER_BYTES - 10}, {big, 100}, {big, 100}};
+    KTEST_UNWRAP(filled, pair.first->write(fill, 3));
+    KTEST_EXPECT_EQUAL(filled, Socket::BUFFER_BYTES);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Socket::SIGNAL_WRITABLE) == 0);
+}
+
+// Watermarks: READABLE waits for the read mark, WRITABLE stays down after a fill until the ring
+// drains to the write mark, bounds are enforced, and a hangup short of the read mark still
+// asserts READABLE on the remainder.
+KTEST_CASE(obj_socket_watermarks) {
+    KTEST_UNWRAP(pair, Socket::create());
+    KTEST_EXPECT_ERR(pair.second->set_watermarks(0, 0), ktl::errc::out_of_range);
+    KTEST_EXPECT_ERR(pair.first->set_watermarks(1, Socket::BUFFER_BYTES), ktl::errc::out_of_range);
+    KTEST_EXPECT_TRUE(pair.second->set_watermarks(100, 0).is_ok());
+    KTEST_EXPECT_TRUE(pair.first->set_watermarks(1, 1024).is_ok());
+
+    static uint8_t bytes[Socket::BUFFER_BYTES];
+    KTEST_EXPECT_EQUAL(pair.first->write(bytes, 60).unwrap(), 60u);
+    KTEST_EXPECT_TRUE((pair.second->signals() & Socket::SIGNAL_READABLE) == 0);
+    KTEST_EXPECT_EQUAL(pair.first->write(bytes, 40).unwrap(), 40u);
+    KTEST_EXPECT_TRUE((pair.second->signals() & Socket::SIGNAL_READABLE) != 0);
+
+    // Fill, then drain in steps: WRITABLE returns only at the 1024-byte mark.
+    KTEST_EXPECT_EQUAL(pair.first->write(bytes, sizeof(bytes)).unwrap(), Socket::BUFFER_BYTES - 100);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Socket::SIGNAL_WRITABLE) == 0);
+    KTEST_EXPECT_EQUAL(pair.second->read(bytes, 2048).unwrap(), 2048u);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Socket::SIGNAL_WRITABLE) == 0);
+    KTEST_EXPECT_EQUAL(pair.second->read(bytes, 1024).unwrap(), 1024u);
+    KTEST_EXPECT_TRUE((pair.first->signals() & Socket::SIGNAL_WRITABLE) != 0);
+
+    // 1024 left, above the read mark; drain to 50, under it, and READABLE drops.
+    KTEST_EXPECT_EQUAL(pair.second->read(bytes, 974).unwrap(), 974u);
+    KTEST_EXPECT_TRUE((pair.second->signals() & Socket::SIGNAL_READABLE) == 0);
+    pair.first = ktl::ref<Socket>{};
+    KTEST_EXPECT_TRUE((pair.second->signals() & Socket::SIGNAL_READABLE) != 0);
+    KTEST_EXPECT_EQUAL(pair.second->read(bytes, sizeof(bytes)).unwrap(), 50u);
+    KTEST_EXPECT_ERR(pair.second->read(bytes, 1), ktl::errc::peer_closed);
+}
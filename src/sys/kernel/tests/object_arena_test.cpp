@@ -47,6 +47,53 @@ KTEST_CASE(object_arena_zero_on_free_roundtrip) {
     arena.free(anchor);
 }
 
+// Freed slots are scrubbed on the freeing core before they park in its magazine, so a slot
+// served from the cache is as zero as one from a slab.
+KTEST_CASE(object_arena_magazine_slots_come_back_zero) {
+    object_arena arena("test-mag", sizeof(three_words), alignof(three_words));
+    constexpr size_t N = 40;
+    three_words* held[N];
+    for (auto& p : held) {
+        p = static_cast<three_words*>(arena.alloc());
+        KTEST_REQUIRE_TRUE(p != nullptr);
+        *p = {~0ull, ~0ull, ~0ull};
+    }
+    for (auto* p : held) { arena.free(p); }
+    auto parked = arena.stats();
+    KTEST_EXPECT_ALL(parked.live == 0, parked.cached >= N, parked.depot_exchanges > 0);
+
+    for (auto& p : held) {
+        p = static_cast<three_words*>(arena.alloc());
+        KTEST_REQUIRE_TRUE(p != nullptr);
+        KTEST_EXPECT_TRUE(slot_is_zero(p, sizeof(three_words)));
+    }
+    auto reused = arena.stats();
+    KTEST_EXPECT_ALL(reused.magazine_misses == parked.magazine_misses, reused.live == N);
+    for (auto* p : held) { arena.free(p); }
+}
+
+KTEST_CASE_CRASH(object_arena_double_free_of_cached_slot_panics) {
+    object_arena arena("test-twice", sizeof(three_words), alignof(three_words));
+    void* p = arena.alloc();
+    KTEST_REQUIRE_TRUE(p != nullptr);
+    arena.free(p);
+    arena.free(p);
+}
+
+// A slot whose payload starts with the word that once served as an in-slot cached mark frees like
+// any other: the cached state lives in the slab header, out of the caller's reach.
+KTEST_CASE(object_arena_free_ignores_slot_contents) {
+    object_arena arena("test-payload", sizeof(three_words), alignof(three_words));
+    auto* p = static_cast<three_words*>(arena.alloc());
+    KTEST_REQUIRE_TRUE(p != nullptr);
+    *p = {0x6d61677a6361636bull, 0, 0};
+    arena.free(p);
+    auto* again = static_cast<three_words*>(arena.alloc());
+    KTEST_EXPECT_TRUE(again == p);
+    KTEST_EXPECT_TRUE(slot_is_zero(again, sizeof(three_words)));
+    arena.free(again);
+}
+
 // Slabs grow one page at a time as slots run out and pages return to the source when a slab
 // empties; the registry sees the arena while it lives and not after.
 KTEST_CASE(object_arena_slab_lifecycle) {
@@ -70,6 +117,7 @@ KTEST_CASE(object_arena_slab_lifecycle) {
         KTEST_EXPECT_TRUE(per_slab >= 2);
 
         for (size_t i = 0; i < count; i++) { arena.free(held[i]); }
+        arena.drain();  // freed slots park in this core's magazine until flushed back to their slabs
         auto drained = arena.stats();
         KTEST_EXPECT_ALL(drained.slabs == 0, drained.live == 0, drained.free_calls == count);
 
@@ -83,3 +131,16 @@ KTEST_CASE(object_arena_slab_lifecycle) {
         KTEST_EXPECT_TRUE(a->stats().object_size != BIG);
     }
 }
+
+// An FP save area holds whatever the thread left in its registers -- on riscv64 its first word is
+// f0 -- so the fpu arena must free any contents, the old in-slot cached mark's bit pattern too.
+KTEST_CASE(object_arena_fpu_area_frees_any_register_state) {
+    auto* area = static_cast<uint64_t*>(g_fpu_arena.alloc());
+    KTEST_REQUIRE_TRUE(area != nullptr);
+    area[0] = 0x6d61677a6361636bull;
+    g_fpu_arena.free(area);
+    void* again = g_fpu_arena.alloc();
+    KTEST_EXPECT_TRUE(again == area);
+    KTEST_EXPECT_TRUE(slot_is_zero(again, g_fpu_arena.stats().object_size));
+    g_fpu_arena.free(again);
+}
@@ -26,7 +26,8 @@ extern "C" kernel::testing::ktest __stop__ktests[];
 namespace {
 
 jmp_buf g_test_jmp;
-bool g_test_failed = false;
+bool g_test_failed         = false;
+const char* g_current_test = nullptr;
 
 uint64_t now_ns() {
     struct timespec ts;
@@ -114,6 +115,7 @@ bool expects_crash(const kernel::testing::ktest& t) {
 // Runs one test in the forked child and returns the child exit code (0 pass, 1 fail).
 int run_test_child(const kernel::testing::ktest& t) {
     g_test_failed  = false;
+    g_current_test = t.name;
     uint64_t start = now_ns();
     emit_test_start(t.name);
     if (setjmp(g_test_jmp) == 0) {
@@ -168,6 +170,13 @@ void report_assertion(bool passed, bool fatal, const char* file, int line, const
     if (fatal) { abort(1); }
 }
 
+void report_metric(const char* key, uint64_t value) {
+    char line[384];
+    snprintf(line, sizeof line, "{\"event\":\"test_meta\",\"name\":\"%s\",\"%s\":%llu}",
+             g_current_test ? g_current_test : "?", key, static_cast<unsigned long long>(value));
+    emit_raw(line);
+}
+
 void abort(unsigned char exit_code) {
     g_test_failed = true;
     longjmp(g_test_jmp, exit_code ? static_cast<int>(exit_code) : 1);
@@ -193,6 +202,13 @@ void hcf() { longjmp(g_test_jmp, 1); }
 namespace kernel::arch {
 uint64_t save_and_disable_interrupts() { return 0; }
 void restore_interrupts(uint64_t) {}
+// Magazine caches index per-core state by it; one thread, one core.
+size_t current_core_index() { return 0; }
+// Queued spinlocks time and pace their contended waits; a forked test never contends.
+uint64_t timestamp() { return 0; }
+void cpu_relax() {}
+// Thread seeds its FPU area on first use, which hosted tests never reach; zero is state enough.
+void fpu_init(void*) {}
 }  // namespace kernel::arch
 
 // Object signal wakes route into the scheduler, which does not exist on the host. Hosted tests
@@ -202,10 +218,10 @@ class Object;
 void object_signal_wake(Object*) {}
 }  // namespace kernel::obj
 
-// Channel message pages come from the PMM in kernel builds; the host has malloc. Sized at the
-// kernel's page size so ASan redzones sit exactly where the real page boundary would.
+// Channel message pages come from the PMM's zeroed pool in kernel builds; the host has calloc. Sized
+// at the kernel's page size so ASan redzones sit exactly where the real page boundary would.
 namespace kernel::obj {
-uintptr_t channel_page_alloc() { return reinterpret_cast<uintptr_t>(malloc(4096)); }
+uintptr_t channel_page_alloc() { return reinterpret_cast<uintptr_t>(calloc(1, 4096)); }
 void channel_page_free(uintptr_t page) { free(reinterpret_cast<void*>(page)); }
 }  // namespace kernel::obj
 
@@ -0,0 +1,213 @@
+// src/sys/kernel/tests/sched_timer_wheel_test.cpp
+#include <kernel/sched/timer_wheel.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::sched;
+
+KTEST_MODULE("sched/timer_wheel");
+
+namespace {
+
+// Deterministic xorshift so failures replay; seeded per case.
+struct rng {
+    uint64_t state;
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// Records the tick each timer fired on, indexed by its position in the case's entry array.
+struct probe : timer_entry {
+    uint64_t fired_at = 0;
+    bool fired        = false;
+};
+
+constexpr size_t BENCH_MAX = 100000;
+probe g_entries[BENCH_MAX];
+
+void reset_entries(size_t n) {
+    for (size_t i = 0; i < n; ++i) { g_entries[i] = probe{}; }
+}
+
+// Fire callback shared by the cases: stamps the tick being processed.
+struct stamp {
+    timer_wheel* wheel;
+    void operator()(timer_entry& e) const {
+        auto& p    = static_cast<probe&>(e);
+        p.fired    = true;
+        p.fired_at = wheel->next_tick();
+    }
+};
+
+}  // namespace
+
+// Deadlines straddling every level boundary the first few levels have: each must fire on exactly
+// its own tick, after however many cascades it took to get to level 0.
+KTEST_CASE(sched_timer_wheel_fires_on_deadline_across_levels) {
+    timer_wheel wheel;
+    const uint64_t deadlines[] = {1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 262143, 262144, 262145, 300001};
+    constexpr size_t n         = sizeof(deadlines) / sizeof(deadlines[0]);
+    reset_entries(n);
+    for (size_t i = 0; i < n; ++i) { wheel.insert(g_entries[i], deadlines[i]); }
+    KTEST_EXPECT_EQUAL(wheel.armed(), n);
+    for (uint64_t t = 0; t <= 300001; ++t) { wheel.advance(t, stamp{&wheel}); }
+    for (size_t i = 0; i < n; ++i) {
+        KTEST_EXPECT_TRUE(g_entries[i].fired);
+        KTEST_EXPECT_EQUAL(g_entries[i].fired_at, deadlines[i]);
+    }
+    KTEST_EXPECT_EQUAL(wheel.armed(), 0u);
+}
+
+// Random deadlines armed at random points, advanced in irregular strides: every timer fires on
+// the first tick >= its deadline, never early and never skipped by a multi-tick advance.
+KTEST_CASE(sched_timer_wheel_random_deadlines_fire_in_order) {
+    timer_wheel wheel(1000);
+    rng r{0x9e3779b97f4a7c15ull};
+    constexpr size_t n = 4096;
+    reset_entries(n);
+    uint64_t armed_at[n];
+    size_t inserted = 0;
+    uint64_t now    = 1000;
+    while (wheel.armed() > 0 || inserted < n) {
+        for (size_t k = 0; k < 16 && inserted < n; ++k, ++inserted) {
+            // Mostly near, sometimes a level or three out, occasionally already past.
+            uint64_t span  = uint64_t{1} << (r.next() % 20);
+            uint64_t delta = r.next() % span;
+            uint64_t when  = (r.next() % 32 == 0) ? now - (delta % 500) : now + 1 + delta;
+            armed_at[inserted] = wheel.next_tick();
+            wheel.insert(g_entries[inserted], when);
+        }
+        now += 1 + r.next() % 97;
+        wheel.advance(now, stamp{&wheel});
+    }
+    for (size_t i = 0; i < n; ++i) {
+        KTEST_REQUIRE_TRUE(g_entries[i].fired);
+        uint64_t due = g_entries[i].deadline > armed_at[i] ? g_entries[i].deadline : armed_at[i];
+        KTEST_EXPECT_EQUAL(g_entries[i].fired_at, due);
+    }
+}
+
+KTEST_CASE(sched_timer_wheel_cancel_and_past_deadlines) {
+    timer_wheel wheel(500);
+    reset_entries(4);
+    wheel.insert(g_entries[0], 510);
+    wheel.insert(g_entries[1], 100000);  // cascades from level 2
+    wheel.insert(g_entries[2], 10);      // already past: due on the next tick processed
+    wheel.insert(g_entries[3], 520);
+    KTEST_EXPECT_TRUE(wheel.cancel(g_entries[1]));
+    KTEST_EXPECT_FALSE(g_entries[1].armed());
+    KTEST_EXPECT_FALSE(wheel.cancel(g_entries[1]));  // double cancel is a no-op
+    KTEST_EXPECT_TRUE(wheel.cancel(g_entries[3]));
+
+    KTEST_EXPECT_EQUAL(wheel.advance(500, stamp{&wheel}), 1u);
+    KTEST_EXPECT_EQUAL(g_entries[2].fired_at, 500u);
+    KTEST_EXPECT_FALSE(wheel.cancel(g_entries[2]));  // already fired
+    KTEST_EXPECT_EQUAL(wheel.advance(200000, stamp{&wheel}), 1u);
+    KTEST_EXPECT_EQUAL(g_entries[0].fired_at, 510u);
+    KTEST_EXPECT_FALSE(g_entries[1].fired);
+    KTEST_EXPECT_FALSE(g_entries[3].fired);
+
+    // A fired entry is already unlinked, so it can simply be armed again.
+    wheel.insert(g_entries[0], 200005);
+    KTEST_EXPECT_EQUAL(wheel.advance(200005, stamp{&wheel}), 1u);
+    KTEST_EXPECT_EQUAL(g_entries[0].fired_at, 200005u);
+}
+
+// A deadline past the top level's reach is parked in the farthest slot, not wrapped into the
+// near future; it stays armed and cancellable.
+KTEST_CASE(sched_timer_wheel_clamps_far_deadlines) {
+    timer_wheel wheel;
+    reset_entries(1);
+    wheel.insert(g_entries[0], ~uint64_t{0});
+    KTEST_EXPECT_EQUAL(wheel.advance(1 << 16, stamp{&wheel}), 0u);
+    KTEST_EXPECT_TRUE(g_entries[0].armed());
+    KTEST_EXPECT_TRUE(wheel.cancel(g_entries[0]));
+}
+
+// next_event never runs past the earliest deadline, and names the deadline itself once the timer
+// has cascaded to level 0 -- the value a one-shot timer is programmed for.
+KTEST_CASE(sched_timer_wheel_next_event_bounds_deadline) {
+    timer_wheel wheel(100);
+    reset_entries(3);
+    KTEST_EXPECT_EQUAL(wheel.next_event(), timer_wheel::NONE);
+    wheel.insert(g_entries[0], 130);
+    KTEST_EXPECT_EQUAL(wheel.next_event(), 130u);
+    wheel.insert(g_entries[1], 5000);  // level 2: first event is its cascade, not its deadline
+    wheel.insert(g_entries[2], 110);
+    KTEST_EXPECT_EQUAL(wheel.next_event(), 110u);
+    KTEST_EXPECT_TRUE(wheel.cancel(g_entries[2]));
+    KTEST_EXPECT_EQUAL(wheel.next_event(), 130u);
+    KTEST_EXPECT_EQUAL(wheel.advance(130, stamp{&wheel}), 1u);
+    // Follow next_event alone, as the one-shot timer does: it lands exactly on the deadline.
+    uint64_t steps = 0;
+    while (!g_entries[1].fired) {
+        uint64_t event = wheel.next_event();
+        KTEST_REQUIRE_TRUE(event <= 5000);
+        wheel.advance(event, stamp{&wheel});
+        steps += 1;
+    }
+    KTEST_EXPECT_EQUAL(g_entries[1].fired_at, 5000u);
+    KTEST_EXPECT_TRUE(steps <= timer_wheel::LEVELS);
+    KTEST_EXPECT_EQUAL(wheel.next_event(), timer_wheel::NONE);
+}
+
+// A core that was tickless for a long stretch catches up in one advance whose work is bounded by
+// the timers armed, not the ticks skipped.
+KTEST_CASE(sched_timer_wheel_long_gap_skips_idle_ticks) {
+    timer_wheel wheel;
+    reset_entries(2);
+    wheel.insert(g_entries[0], 1'000'000);
+    wheel.insert(g_entries[1], 50'000'000);
+    KTEST_EXPECT_EQUAL(wheel.advance(60'000'000, stamp{&wheel}), 2u);
+    KTEST_EXPECT_EQUAL(g_entries[0].fired_at, 1'000'000u);
+    KTEST_EXPECT_EQUAL(g_entries[1].fired_at, 50'000'000u);
+    KTEST_EXPECT_EQUAL(wheel.next_tick(), 60'000'001u);
+    KTEST_EXPECT(wheel.stats().slots_visited < 64);
+}
+
+// Benchmark: per-tick cost of the wheel with 10 to 100k sleepers armed. Each population sleeps
+// well past the measured window while a fixed set of short sleepers keeps firing and re-arming,
+// as a busy system's tick looks. The old linear scan touched every sleeper on every tick; here
+// the work per tick (slots examined + timers moved or fired) must be identical at every size.
+KTEST_CASE(sched_timer_wheel_tick_cost_flat) {
+    constexpr size_t sizes[]  = {10, 100, 1000, 10000, 100000};
+    constexpr uint64_t WINDOW = 4096;
+    constexpr size_t SHORT    = 8;
+    const char* const names[] = {"tick_work_max_10", "tick_work_max_100", "tick_work_max_1000", "tick_work_max_10000",
+                                 "tick_work_max_100000"};
+    uint64_t baseline_max     = 0;
+    uint64_t baseline_total   = 0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t n = sizes[s];
+        reset_entries(n);
+        timer_wheel wheel;
+        rng r{0x2545f4914f6cdd1dull};
+        // Long sleepers: 4096 ticks to ~16M ticks out, the shape a mostly-idle thread population has.
+        for (size_t i = SHORT; i < n; ++i) { wheel.insert(g_entries[i], WINDOW + r.next() % (uint64_t{1} << 24)); }
+        for (size_t i = 0; i < SHORT && i < n; ++i) { wheel.insert(g_entries[i], 1 + i); }
+
+        uint64_t worst = 0;
+        for (uint64_t t = 0; t < WINDOW; ++t) {
+            uint64_t before = wheel.stats().slots_visited + wheel.stats().cascaded + wheel.stats().fired;
+            wheel.advance(t, [&](timer_entry& e) {
+                size_t idx = static_cast<size_t>(static_cast<probe*>(&e) - g_entries);
+                wheel.insert(e, t + 1 + idx % SHORT);
+            });
+            uint64_t work = wheel.stats().slots_visited + wheel.stats().cascaded + wheel.stats().fired - before;
+            if (work > worst) { worst = work; }
+        }
+        uint64_t total = wheel.stats().slots_visited + wheel.stats().cascaded + wheel.stats().fired;
+        KTEST_METRIC(names[s], worst);
+        if (s == 0) {
+            baseline_max   = worst;
+            baseline_total = total;
+        }
+        KTEST_EXPECT_EQUAL(worst, baseline_max);
+        KTEST_EXPECT_EQUAL(total, baseline_total);
+    }
+    // A tick never does more than one slot per level plus the short sleepers that fire in it.
+    KTEST_EXPECT(baseline_max <= timer_wheel::LEVELS + SHORT);
+}
@@ -47,6 +47,31 @@ KTEST_CASE(sched_trace_ring_copy_caps_and_clear) {
     KTEST_EXPECT_EQUAL(ring.copy_newest(out, 2), 0u);
 }
 
+// Sequence reads are what the per-core merge walks: valid exactly for the retained window, stale
+// once overwritten or cleared, and never past the newest record.
+KTEST_CASE(sched_trace_ring_sequence_window) {
+    trace_ring<4> ring;
+    trace_record r;
+    KTEST_EXPECT_FALSE(ring.read_seq(0, r));
+    for (uint64_t i = 1; i <= 6; ++i) { ring.push(rec(i)); }
+    KTEST_EXPECT_EQUAL(ring.end_seq(), 6u);
+    KTEST_EXPECT_FALSE(ring.read_seq(1, r));  // overwritten by the wrap
+    KTEST_REQUIRE_TRUE(ring.read_seq(2, r));
+    KTEST_EXPECT_EQUAL(r.timestamp, 3u);
+    KTEST_REQUIRE_TRUE(ring.read_seq(5, r));
+    KTEST_EXPECT_EQUAL(r.timestamp, 6u);
+    KTEST_EXPECT_FALSE(ring.read_seq(6, r));
+
+    ring.clear();
+    KTEST_EXPECT_FALSE(ring.read_seq(5, r));
+    ring.push(rec(7));
+    KTEST_REQUIRE_TRUE(ring.read_seq(6, r));
+    KTEST_EXPECT_EQUAL(r.timestamp, 7u);
+    trace_record out[4];
+    KTEST_EXPECT_EQUAL(ring.copy_newest(out, 4), 1u);
+    KTEST_EXPECT_EQUAL(out[0].timestamp, 7u);
+}
+
 KTEST_CASE(sched_cycles_to_human_units) {
     // hz=0: uncalibrated fallback, raw cycles
     KTEST_EXPECT_TRUE(cycles_to_human(1234, 0).unit[0] == 'c');
@@ -2,6 +2,7 @@
 #include <kernel/synchronization/guard.h>
 #include <kernel/synchronization/lockdep.h>
 #include <kernel/synchronization/mutex.h>
+#include <kernel/synchronization/spinlock.h>
 #include <kernel/testing/testing.h>
 
 using namespace kernel::synchronization;
@@ -60,3 +61,25 @@ KTEST(sync_lockdep_reclaims_identities, "sync/lockdep") {
     }
     KTEST_EXPECT_EQUAL(current_execution_context().held_count, 0u);
 }
+
+KTEST(sync_spinlock_counts_acquisitions, "sync/spinlock") {
+    init_execution_context(0);
+    lockdep::reset_for_testing();
+    spinlock lock("counted");
+    for (int i = 0; i < 3; ++i) { critical_lock_guard guard(lock); }
+    {
+        critical_section section;
+        KTEST_REQUIRE_TRUE(lock.try_lock());
+        KTEST_EXPECT_FALSE(lock.try_lock());
+        lock.unlock();
+    }
+    lockdep::lock_row rows[CONFIG_LOCKDEP_MAX_LOCKS];
+    size_t count                 = lockdep::snapshot_locks(rows, CONFIG_LOCKDEP_MAX_LOCKS);
+    const lockdep::lock_row* row = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        if (rows[i].address == &lock) { row = &rows[i]; }
+    }
+    KTEST_REQUIRE_TRUE(row != nullptr);
+    KTEST_EXPECT_EQUAL(row->stats.acquires, 4u);
+    KTEST_EXPECT_EQUAL(row->stats.contended, 0u);
+}
@@ -0,0 +1,177 @@
+#include <kernel/synchronization/rcu.h>
+#include <kernel/testing/testing.h>
+
+using namespace kernel::synchronization;
+
+KTEST_MODULE("sync/rcu");
+
+namespace {
+
+// Counts its own runs; the head comes first so the callback recovers the probe from it.
+struct probe {
+    rcu_head head;
+    int runs = 0;
+};
+
+void count_run(rcu_head* head) { reinterpret_cast<probe*>(head)->runs++; }
+
+// Runs whatever the state has made ready, the way the callback thread does.
+size_t drain(rcu_state& rcu) {
+    size_t ran = 0;
+    for (rcu_head* head = rcu.take_ready(); head != nullptr; ran++) {
+        rcu_head* next = head->next;
+        head->func(head);
+        head = next;
+    }
+    return ran;
+}
+
+// Deterministic xorshift so failures replay.
+struct rng {
+    uint64_t state;
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// One published version of a read-mostly object in the model below.
+struct version {
+    rcu_head head;
+    bool freed = false;
+};
+
+void mark_freed(rcu_head* head) { reinterpret_cast<version*>(head)->freed = true; }
+
+constexpr size_t MODEL_CORES    = 4;
+constexpr size_t MODEL_VERSIONS = 4096;
+constexpr size_t MODEL_STEPS    = 200000;
+version g_versions[MODEL_VERSIONS];
+
+}  // namespace
+
+// A grace period completes on the report that covers the last online core, and only then does
+// the callback queued before it run. Repeat reports are free and change nothing.
+KTEST_CASE(rcu_grace_period_waits_for_every_online_core) {
+    rcu_state rcu;
+    for (size_t core = 0; core < 3; core++) { rcu.set_online(core); }
+    probe p;
+    KTEST_EXPECT_TRUE(rcu.enqueue(&p.head, count_run));
+    KTEST_EXPECT_TRUE(rcu.start());
+    KTEST_EXPECT_FALSE(rcu.start());  // one is already running
+    KTEST_EXPECT_EQUAL(rcu.pending_cores(), 0b111u);
+
+    rcu.note_quiescent(0);
+    rcu.note_quiescent(0);
+    rcu.note_quiescent(2);
+    KTEST_EXPECT_EQUAL(rcu.pending_cores(), 0b010u);
+    KTEST_EXPECT_EQUAL(rcu.completed(), 0u);
+    KTEST_EXPECT_EQUAL(drain(rcu), 0u);
+
+    rcu.note_quiescent(1);
+    KTEST_EXPECT_EQUAL(rcu.completed(), 1u);
+    KTEST_EXPECT_EQUAL(rcu.pending_cores(), 0u);
+    KTEST_EXPECT_EQUAL(drain(rcu), 1u);
+    KTEST_EXPECT_EQUAL(p.runs, 1);
+    KTEST_EXPECT_FALSE(rcu.has_callbacks());
+    KTEST_EXPECT_FALSE(rcu.start());  // nothing is owed one
+}
+
+// A callback queued while a grace period runs may protect a reader that began after it started,
+// so it waits for the next one.
+KTEST_CASE(rcu_callback_queued_mid_grace_period_waits_for_the_next) {
+    rcu_state rcu;
+    rcu.set_online(0);
+    rcu.set_online(1);
+    probe early;
+    probe late;
+    KTEST_EXPECT_TRUE(rcu.enqueue(&early.head, count_run));
+    KTEST_REQUIRE_TRUE(rcu.start());
+    rcu.note_quiescent(0);
+    KTEST_EXPECT_FALSE(rcu.enqueue(&late.head, count_run));
+    rcu.note_quiescent(1);
+
+    KTEST_EXPECT_EQUAL(drain(rcu), 1u);
+    KTEST_EXPECT_ALL(early.runs == 1, late.runs == 0, rcu.has_callbacks());
+
+    KTEST_REQUIRE_TRUE(rcu.start());
+    rcu.note_quiescent(1);
+    rcu.note_quiescent(0);
+    KTEST_EXPECT_EQUAL(drain(rcu), 1u);
+    KTEST_EXPECT_EQUAL(late.runs, 1);
+    KTEST_EXPECT_EQUAL(rcu.completed(), 2u);
+}
+
+// Offline cores hold nothing up, and a core that joins mid grace period is waited for: it may
+// already be reading.
+KTEST_CASE(rcu_core_joining_mid_grace_period_is_waited_for) {
+    rcu_state rcu;
+    rcu.set_online(0);
+    probe p;
+    rcu.enqueue(&p.head, count_run);
+    KTEST_REQUIRE_TRUE(rcu.start());
+    rcu.set_online(3);
+    rcu.note_quiescent(0);
+    KTEST_EXPECT_EQUAL(rcu.completed(), 0u);
+    KTEST_EXPECT_EQUAL(rcu.pending_cores(), 0b1000u);
+    rcu.note_quiescent(3);
+    KTEST_EXPECT_EQUAL(drain(rcu), 1u);
+    KTEST_EXPECT_EQUAL(p.runs, 1);
+}
+
+// Model: MODEL_CORES simulated cores open and close read-side sections on whatever version is
+// published, report quiescent states only outside a section, and an updater keeps replacing the
+// version and deferring the old one's free; the callback thread starts grace periods and runs
+// callbacks at random points in between. No reader may ever hold a freed version, and once every
+// reader has closed, every displaced version must come free.
+KTEST_CASE(rcu_model_never_frees_under_a_reader) {
+    rcu_state rcu;
+    for (size_t core = 0; core < MODEL_CORES; core++) { rcu.set_online(core); }
+    for (auto& v : g_versions) { v = version{}; }
+    version* published            = &g_versions[0];
+    size_t next_version           = 1;
+    version* reading[MODEL_CORES] = {};
+    bool ok                       = true;
+
+    rng r{0x9E3779B97F4A7C15ull};
+    for (size_t step = 0; step < MODEL_STEPS && ok; step++) {
+        size_t core = r.next() % MODEL_CORES;
+        switch (r.next() % 5) {
+            case 0:
+                if (reading[core] == nullptr) { reading[core] = published; }
+                break;
+            case 1: reading[core] = nullptr; break;
+            case 2:
+                if (reading[core] == nullptr) { rcu.note_quiescent(core); }
+                break;
+            case 3:
+                if (next_version < MODEL_VERSIONS) {
+                    version* old = published;
+                    published    = &g_versions[next_version++];
+                    rcu.enqueue(&old->head, mark_freed);
+                }
+                break;
+            default:
+                rcu.start();
+                drain(rcu);
+                break;
+        }
+        for (auto* held : reading) { ok = ok && (held == nullptr || !held->freed); }
+    }
+    KTEST_EXPECT_TRUE(ok);
+    KTEST_EXPECT_TRUE(rcu.completed() > 0);
+
+    for (auto& held : reading) { held = nullptr; }
+    for (size_t round = 0; round < 4 && rcu.has_callbacks(); round++) {
+        rcu.start();
+        for (size_t core = 0; core < MODEL_CORES; core++) { rcu.note_quiescent(core); }
+        drain(rcu);
+    }
+    KTEST_EXPECT_FALSE(rcu.has_callbacks());
+    size_t freed = 0;
+    for (size_t i = 0; i < next_version; i++) { freed += g_versions[i].freed ? 1 : 0; }
+    KTEST_EXPECT_EQUAL(freed, next_version - 1);
+    KTEST_EXPECT_FALSE(published->freed);
+}
@@ -60,6 +60,15 @@ void lapic_timer_start_periodic(uint8_t vector, uint32_t initial_count) {
     reg_write(REG_TIMER_INIT, initial_count);
 }
 
+void lapic_timer_start_oneshot(uint8_t vector, uint32_t count) {
+    reg_write(REG_TIMER_DIV, DIVIDE_BY_16);
+    reg_write(REG_LVT_TIMER, vector);
+    reg_write(REG_TIMER_INIT, count);
+}
+
+// An initial count of zero stops the timer in either mode.
+void lapic_timer_stop() { reg_write(REG_TIMER_INIT, 0); }
+
 void lapic_send_ipi(uint32_t destination, uint8_t vector) {
     // xAPIC's ICR destination field is eight bits. Limine's x86 MP interface supplies LAPIC ids
     // in that format; reject a malformed id instead of silently targeting a different CPU.
@@ -24,6 +24,27 @@ constexpr uint32_t RFLAGS_DF = 1u << 10;
 constexpr uint32_t RFLAGS_NT = 1u << 14;
 constexpr uint32_t RFLAGS_RF = 1u << 16;
 constexpr uint32_t RFLAGS_AC = 1u << 18;
+
+constexpr uint64_t CR0_TS       = 1ull << 3;
+constexpr uint64_t CR4_OSXSAVE  = 1ull << 18;
+constexpr uint32_t CPUID1_XSAVE = 1u << 26;  // leaf 1, ECX
+constexpr uint32_t CPUID1_AVX   = 1u << 28;
+constexpr uint64_t XCR0_X87     = 1u << 0;
+constexpr uint64_t XCR0_SSE     = 1u << 1;
+constexpr uint64_t XCR0_AVX     = 1u << 2;
+
+// How fpu_save writes an area, chosen once on the boot processor by fpu_cpu_init. XSAVEOPT skips
+// components still in their init state and those unchanged since this core last restored the
+// same area -- a thread that only read its vector registers, or touched x87 alone, saves little.
+// XSAVEC has only the first half; its compacted layout saves no space here, where x87, SSE and
+// AVX sit at their standard offsets either way. XRSTOR reads both layouts.
+enum class fpu_save_insn : uint8_t { FXSAVE, XSAVE, XSAVEC, XSAVEOPT };
+fpu_save_insn g_fpu_save  = fpu_save_insn::FXSAVE;
+uint64_t g_fpu_components = 0;  // XCR0: the requested-feature mask of every XSAVE-family access
+
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t (&out)[4]) {
+    asm volatile("cpuid" : "=a"(out[0]), "=b"(out[1]), "=c"(out[2]), "=d"(out[3]) : "a"(leaf), "c"(subleaf));
+}
 }  // namespace
 
 [[noreturn]] void hcf() {
@@ -110,6 +131,8 @@ uintptr_t active_translation_root() {
 
 void wait_for_interrupt() { asm volatile("hlt"); }
 
+void cpu_relax() { asm volatile("pause"); }
+
 extern "C" void thread_entry_trampoline();
 
 uintptr_t prepare_thread_stack(uintptr_t stack_top, void (*entry)(void*), void* arg) {
@@ -132,17 +155,77 @@ uint64_t timestamp() {
     return (static_cast<uint64_t>(hi) << 32) | lo;
 }
 
+void fpu_cpu_init(bool is_boot_processor) {
+    uint32_t regs[4];
+    cpuid(1, 0, regs);
+    if ((regs[2] & CPUID1_XSAVE) == 0) { return; }
+    uint64_t xcr0 = XCR0_X87 | XCR0_SSE | ((regs[2] & CPUID1_AVX) != 0 ? XCR0_AVX : 0);
+    uint64_t cr4;
+    asm volatile("mov %%cr4, %0" : "=r"(cr4));
+    asm volatile("mov %0, %%cr4" : : "r"(cr4 | CR4_OSXSAVE));
+    asm volatile("xsetbv" : : "c"(0u), "a"(static_cast<uint32_t>(xcr0)), "d"(static_cast<uint32_t>(xcr0 >> 32)));
+    if (!is_boot_processor) { return; }
+
+    // Leaf 0Dh subleaf 0 EBX: the standard-format size of what XCR0 now enables.
+    cpuid(0xD, 0, regs);
+    if (regs[1] > FPU_AREA_SIZE) { panic("x86: XSAVE area exceeds FPU_AREA_SIZE"); }
+    cpuid(0xD, 1, regs);
+    g_fpu_components = xcr0;
+    if ((regs[0] & 1u) != 0) {
+        g_fpu_save = fpu_save_insn::XSAVEOPT;
+    } else if ((regs[0] & 2u) != 0) {
+        g_fpu_save = fpu_save_insn::XSAVEC;
+    } else {
+        g_fpu_save = fpu_save_insn::XSAVE;
+    }
+}
+
 void fpu_init(void* area) {
-    // FXSAVE layout: FCW at +0, MXCSR at +24, both at their reset defaults (all exceptions masked,
-    // round-to-nearest). Everything else is zero in the entry image -- empty x87 tag word, cleared
-    // registers -- which the area already holds, so the first fxrstor of a fresh thread loads
-    // exactly the state the ABI promises at entry.
+    // FXSAVE layout, which the XSAVE legacy region shares: FCW at +0, MXCSR at +24, both at their
+    // reset defaults (all exceptions masked, round-to-nearest). Everything else is zero in the
+    // entry image -- empty x87 tag word, cleared registers, and an XSAVE header whose zero
+    // XSTATE_BV puts every component in its init state -- which the area already holds, so the
+    // first restore of a fresh thread loads exactly the state the ABI promises at entry.
     *static_cast<uint16_t*>(area)                                  = 0x037F;
     *reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(area) + 24) = 0x1F80;
 }
 
-void fpu_save(void* area) { asm volatile("fxsave64 (%0)" : : "r"(area) : "memory"); }
+void fpu_save(void* area) {
+    auto lo = static_cast<uint32_t>(g_fpu_components);
+    auto hi = static_cast<uint32_t>(g_fpu_components >> 32);
+    switch (g_fpu_save) {
+        case fpu_save_insn::XSAVEOPT: asm volatile("xsaveopt64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory"); break;
+        case fpu_save_insn::XSAVEC: asm volatile("xsavec64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory"); break;
+        case fpu_save_insn::XSAVE: asm volatile("xsave64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory"); break;
+        case fpu_save_insn::FXSAVE: asm volatile("fxsave64 (%0)" : : "r"(area) : "memory"); break;
+    }
+}
+
+void fpu_restore(void* area) {
+    if (g_fpu_save == fpu_save_insn::FXSAVE) {
+        asm volatile("fxrstor64 (%0)" : : "r"(area) : "memory");
+        return;
+    }
+    auto lo = static_cast<uint32_t>(g_fpu_components);
+    auto hi = static_cast<uint32_t>(g_fpu_components >> 32);
+    asm volatile("xrstor64 (%0)" : : "r"(area), "a"(lo), "d"(hi) : "memory");
+}
+
+// CR0.TS makes the next x87/SSE/AVX instruction raise #NM. The per-core copy saves a CR0 write
+// on the switches that leave it as it was: back-to-back kernel threads, or the owner returning.
+void fpu_set_trap(bool armed) {
+    auto& local = kernel::x86::local();
+    if (local.fpu_trap_armed == armed) { return; }
+    local.fpu_trap_armed = armed;
+    if (armed) {
+        uint64_t cr0;
+        asm volatile("mov %%cr0, %0" : "=r"(cr0));
+        asm volatile("mov %0, %%cr0" : : "r"(cr0 | CR0_TS));
+    } else {
+        asm volatile("clts");
+    }
+}
 
-void fpu_restore(void* area) { asm volatile("fxrstor64 (%0)" : : "r"(area) : "memory"); }
+bool fpu_take_dirty() { return !kernel::x86::local().fpu_trap_armed; }
 
 }  // namespace kernel::arch
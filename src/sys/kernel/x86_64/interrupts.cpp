@@ -3,6 +3,7 @@
 #include <kernel/log.h>
 #include <kernel/panic.h>
 #include <kernel/registers.h>
+#include <kernel/sched/scheduler.h>
 #include <kernel/sched/user_task.h>
 #include <kernel/synchronization/execution_context.h>
 #include <kernel/x86/apic.h>
@@ -22,6 +23,14 @@ extern "C" void k_exception_handler(register_frame_t* regs) {
         return;
     }
 
+    // #NM from user mode: the thread's first FP/SIMD instruction since it was switched in. Loading
+    // its state clears CR0.TS, and the iret retries the instruction. Without an FPU area to load
+    // into, it is a fault like any other.
+    if (regs->int_no == 7 && (regs->cs & 0x3) == 0x3 && kernel::sched::fpu_first_use()) {
+        kernel::synchronization::fault_exit();
+        return;
+    }
+
     // The privilege level saved by the CPU is authoritative for every exception, unlike the page
     // fault error-code U bit, which is meaningful only for #PF. Leave fault context before the
     // non-returning scheduler handoff so it cannot block on the faulting thread's kernel stack.
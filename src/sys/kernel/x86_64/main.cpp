@@ -39,11 +39,11 @@ static void enable_nxe() {
 
 // Enable x87/SSE execution: CR0.MP and NE set, EM and TS clear, CR4.OSFXSR and OSXMMEXCPT set.
 // This is for user code -- the kernel itself is built without vector instructions, and the
-// scheduler carries the state per thread (arch::fpu_save/fpu_restore). TS stays clear for good:
-// state is switched eagerly, so the lazy-#NM machinery is never armed. NE routes unmasked x87
-// errors to #MF instead of the legacy FERR#/IRQ13 path, which nothing here handles -- and Limine
-// clears it. Every core, not just the BP, so the guarantee does not lean on what the boot
-// protocol set up.
+// scheduler carries the state per thread, loading it lazily: a switch to a user thread whose state
+// is not in the registers sets TS (arch::fpu_set_trap), and the thread's first FP instruction
+// raises #NM. NE routes unmasked x87 errors to #MF instead of the legacy FERR#/IRQ13 path, which
+// nothing here handles -- and Limine clears it. Every core, not just the BP, so the guarantee does
+// not lean on what the boot protocol set up.
 static void enable_sse() {
     uint64_t cr;
     asm volatile("mov %%cr0, %0" : "=r"(cr));
@@ -65,6 +65,7 @@ void core_init(uint32_t core_index, uint32_t lapic_id, bool is_boot_processor) {
 
     enable_nxe();
     enable_sse();
+    kernel::arch::fpu_cpu_init(is_boot_processor);
 
     // Start basic hardware initialisation
     g_log.debug("cpu{0} (lapic {1}): Initializing", core_index, lapic_id);
@@ -12,6 +12,7 @@ namespace pte {
 constexpr uint64_t PRESENT       = 1ull << 0;
 constexpr uint64_t WRITABLE      = 1ull << 1;
 constexpr uint64_t USER          = 1ull << 2;
+constexpr uint64_t WRITE_THROUGH = 1ull << 3;
 constexpr uint64_t CACHE_DISABLE = 1ull << 4;
 constexpr uint64_t HUGE          = 1ull << 7;
 constexpr uint64_t NO_EXECUTE    = 1ull << 63;
@@ -37,6 +38,24 @@ uint64_t make_table_ptr(vm_paddr_t child, uint64_t leaf_flags) {
 void widen_table_ptr(uint64_t& slot, uint64_t leaf_flags) { slot |= leaf_flags & pte::USER; }
 
 uint64_t make_leaf(vm_paddr_t paddr, uint64_t flags) { return (paddr & pte::ADDR_MASK) | flags | pte::PRESENT; }
+uint64_t make_large_leaf(vm_paddr_t paddr, uint64_t flags) { return make_leaf(paddr, flags) | pte::HUGE; }
+
+// Bit 7 is PAT in a 4K entry and PS above it. Pages using the PAT index bits
+// (PAT or PWT) come from the bootloader's PAT setup, which the kernel does not
+// model, so they stay 4K.
+uint64_t pte_promote(uint64_t entry) {
+    if (entry & (pte::HUGE | pte::WRITE_THROUGH)) { return 0; }
+    return entry | pte::HUGE;
+}
+
+// 2 MiB pages are architectural on x86_64; 1 GiB ones are CPUID 0x80000001 EDX.Page1GB.
+bool large_page_supported(size_t size) {
+    if (size == LARGE_PAGE_2M) { return true; }
+    if (size != LARGE_PAGE_1G) { return false; }
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0x80000001u), "c"(0u));
+    return (edx & (1u << 26)) != 0;
+}
 
 // Translate arch-neutral leaf attributes into x86_64 PTE permission/cache bits.
 uint64_t leaf_flags(vm_prot_t prot, vm_cache_mode cache) {
@@ -59,7 +78,7 @@ vm_translation attrs_from_pte(uint64_t entry, vm_paddr_t paddr) {
     if (entry & pte::USER) { prot |= vm_prot::USER; }
     if (!(entry & pte::NO_EXECUTE)) { prot |= vm_prot::EXECUTE; }
     vm_cache_mode cache = (entry & pte::CACHE_DISABLE) ? vm_cache_mode::DEVICE : vm_cache_mode::CACHED;
-    return {paddr, prot, cache};
+    return {paddr, prot, cache, 0};  // the walk knows the leaf size
 }
 
 vm_paddr_t current_root() {
@@ -82,5 +101,6 @@ void flush_new_leaf(vm_paddr_t, uintptr_t) {}
 
 // The APs park rather than schedule, so no other core ever has a user space live.
 void shootdown_tlb_page(uint64_t, uintptr_t) {}
+void shootdown_tlb_range(uint64_t, uintptr_t, size_t) {}
 
 }  // namespace kernel::mm::arch
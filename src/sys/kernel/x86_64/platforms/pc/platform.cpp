@@ -75,6 +75,24 @@ void timer_start_local() {
     kernel::x86::lapic_timer_start_periodic(kernel::x86::IRQ0, g_lapic_counts_per_ms);
 }
 
+// One-shot LAPIC countdown to the deadline. The count register is 32 bits, so a deadline past its
+// reach (~a minute at QEMU's bus rate) fires early; the scheduler finds nothing due and re-arms.
+bool timer_set_deadline(int64_t deadline_ns) {
+    if (g_lapic_counts_per_ms == 0) { return false; }
+    if (deadline_ns == kernel::time::NEVER) {
+        kernel::x86::lapic_timer_stop();
+        return true;
+    }
+    time_ns_t now  = kernel::time::ns_since_boot();
+    uint64_t delta = deadline_ns > now ? static_cast<uint64_t>(deadline_ns - now) : 0;
+    uint64_t count = (delta / 1'000'000ull) * g_lapic_counts_per_ms +
+                     ((delta % 1'000'000ull) * g_lapic_counts_per_ms + 999'999ull) / 1'000'000ull;
+    if (count == 0) { count = 1; }  // zero would stop the timer instead of firing it
+    if (count > 0xFFFFFFFFull) { count = 0xFFFFFFFFull; }
+    kernel::x86::lapic_timer_start_oneshot(kernel::x86::IRQ0, static_cast<uint32_t>(count));
+    return true;
+}
+
 // QEMU's isa-debug-exit device, wired to port 0x604 by the test harness. The 0x2000 bias matches
 // what the harness expects to decode from QEMU's exit status.
 void harness_exit(uint8_t code) { outw(0x604, static_cast<uint16_t>(code | 0x2000)); }
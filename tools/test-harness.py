@@ -725,6 +725,14 @@ def _to_protocol_result(result: TestResult) -> harness_protocol.TestResult:
         "attempts": len(result.attempts),
         "expects_crash": result.expects_crash,
     }
+    if final:
+        # Benchmark metrics (KTEST_METRIC) arrive as test_meta events, as on the host tier.
+        for event in final.events:
+            payload = event.payload or {}
+            if payload.get("event") == "test_meta":
+                for k, v in payload.items():
+                    if k not in ("event", "name"):
+                        pr.diagnostics[k] = v
     if final and final.crash is not None:
         pr.diagnostics["crash"] = _crash_summary(final.crash)
     return pr